@@ -0,0 +1,793 @@
+/**
+ ****************************************************************
+ * @file            : allocator.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of pluggable allocators (plain 'malloc', a thread-local cache, a hugepage-backed
+ *                      region, and NUMA-local arenas).
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#define _GNU_SOURCE                                     /* for 'sched_getcpu', 'MAP_ANONYMOUS' and 'MADV_HUGEPAGE' */
+
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "allocator.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Size class of a small block, and the size it is rounded up to.
+**/
+#define ALLOC_CLASS(size)           (((size) - 1) / ALLOC_ALIGNMENT)
+#define ALLOC_CLASS_SIZE(c)         (((c) + 1) * ALLOC_ALIGNMENT)
+
+/**
+ *  @brief      : Max. no. of NUMA nodes looked up, and size of a cache line (that arenas are padded to).
+**/
+#define ALLOC_MAX_NODES             64
+#define ALLOC_CACHE_LINE            64
+
+/**
+ *  @brief      : Min. size of a chunk of a NUMA arena.
+**/
+#define ALLOC_MIN_CHUNK             (1 << 16)
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : (For internal use) Block on a free list (its storage is re-used as the link).
+**/
+typedef struct ALLOC_BLOCK {
+    struct ALLOC_BLOCK *next;
+} alloc_block;
+
+/**
+ *  @brief      : (For internal use) Free lists of a thread (see 'alloc_cache').
+**/
+typedef struct ALLOC_THREAD_CACHE {
+    alloc_block *heads[ALLOC_N_CLASSES];
+    unsigned int counts[ALLOC_N_CLASSES];
+} alloc_thread_cache;
+
+/**
+ *  @brief      : (For internal use) Region (see 'alloc_create_region'). The allocator is its first member, so a
+ *                  pointer to one is a pointer to the other.
+**/
+typedef struct ALLOC_REGION {
+    alloc_allocator allocator;
+    char *map;                                      /* mapping (hugepage-aligned 'base', and the slack around it) */
+    size_t map_size;
+    char *base;
+    size_t capacity;
+    size_t used;                                    /* bytes carved off the start of 'base' */
+    alloc_block *heads[ALLOC_N_CLASSES];
+} alloc_region;
+
+/**
+ *  @brief      : (For internal use) Header at the start of a chunk of a NUMA arena (chunks are aligned to their size,
+ *                  so the chunk of a block is found by masking its address).
+**/
+typedef struct ALLOC_CHUNK {
+    struct ALLOC_CHUNK *next;                       /* next chunk of the arena */
+    int node;
+} alloc_chunk;
+
+/**
+ *  @brief      : (For internal use) Arena of a NUMA node, padded to a cache line against false sharing of its lock.
+**/
+typedef struct ALLOC_ARENA {
+    pthread_mutex_t lock;
+    alloc_chunk *chunks;
+    char *top;                                      /* free space at the end of the current chunk */
+    size_t left;
+    alloc_block *heads[ALLOC_N_CLASSES];
+    char padding[ALLOC_CACHE_LINE];
+} alloc_arena;
+
+/**
+ *  @brief      : (For internal use) NUMA-aware allocator (see 'alloc_create_numa'). The allocator is its first member.
+**/
+typedef struct ALLOC_NUMA {
+    alloc_allocator allocator;
+    size_t chunk_size;
+    long page_size;
+    int n_nodes;                                    /* max. node id, plus one */
+    long n_cpus;
+    int *cpu_nodes;                                 /* node of each cpu */
+    alloc_arena *arenas;
+} alloc_numa;
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static void * alloc_malloc_alloc(void *ctx, size_t size);
+static void alloc_malloc_free(void *ctx, void *ptr, size_t size);
+static void * alloc_cache_alloc(void *ctx, size_t size);
+static void alloc_cache_free(void *ctx, void *ptr, size_t size);
+static alloc_thread_cache * alloc_cache_self();
+static void alloc_cache_create_key();
+static void alloc_cache_exit(void *cache);
+static void * alloc_region_alloc(void *ctx, size_t size);
+static void alloc_region_free(void *ctx, void *ptr, size_t size);
+static void alloc_region_free_all(void *ctx);
+static void alloc_region_destroy(void *ctx);
+static void * alloc_numa_alloc(void *ctx, size_t size);
+static void alloc_numa_free(void *ctx, void *ptr, size_t size);
+static void alloc_numa_destroy(void *ctx);
+static unsigned char alloc_numa_grow(alloc_numa *numa, alloc_arena *arena, int node);
+static int alloc_numa_node(alloc_numa *numa);
+static void alloc_numa_read_nodes(alloc_numa *numa);
+
+/* ********************* static variable(s) SECTION ********************** */
+
+/**
+ *  @brief      : Static allocators.
+**/
+static alloc_allocator alloc_malloc_allocator = {alloc_malloc_alloc, alloc_malloc_free, NULL, NULL, NULL};
+static alloc_allocator alloc_cache_allocator = {alloc_cache_alloc, alloc_cache_free, NULL, NULL, NULL};
+
+/**
+ *  @brief      : Cache of the calling thread (NULL until its first allocation), and the key that de-allocates it on
+ *                  thread exit.
+**/
+static _Thread_local alloc_thread_cache *alloc_self = NULL;
+static pthread_key_t alloc_cache_key;
+static pthread_once_t alloc_cache_once = PTHREAD_ONCE_INIT;
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Returns the plain allocator.
+ *  @param      : None.
+ *  @return     : Pointer to allocator.
+**/
+alloc_allocator * alloc_malloc() {
+    return &alloc_malloc_allocator;
+}
+
+/**
+ *  @brief      : (for internal use) Allocates a block through 'malloc'.
+ *  @param      : [ Context (unused). ]
+ *                [ Size (in bytes). ]
+ *  @return     : Pointer to block (NULL on failure).
+**/
+static void * alloc_malloc_alloc(void *ctx, size_t size) {
+    (void) ctx;
+    return malloc(size);
+}
+
+/**
+ *  @brief      : (for internal use) De-allocates a block through 'free'.
+ *  @param      : [ Context (unused). ]
+ *                [ Block. ]
+ *                [ Size (in bytes, unused). ]
+ *  @return     : None.
+**/
+static void alloc_malloc_free(void *ctx, void *ptr, size_t size) {
+    (void) ctx, (void) size;
+    free(ptr);
+}
+
+/**
+ *  @brief      : Returns the thread-local cache allocator.
+ *  @param      : None.
+ *  @return     : Pointer to allocator.
+**/
+alloc_allocator * alloc_cache() {
+    return &alloc_cache_allocator;
+}
+
+/**
+ *  @brief      : (for internal use) Allocates a block, popping the free list of its size class in the cache of the
+ *                  calling thread, if not empty, else through 'malloc' (rounded up to its class, so that any block of
+ *                  a class may serve any size of it).
+ *  @param      : [ Context (unused). ]
+ *                [ Size (in bytes). ]
+ *  @return     : Pointer to block (NULL on failure).
+**/
+static void * alloc_cache_alloc(void *ctx, size_t size) {
+    (void) ctx;
+    if (size - 1 < ALLOC_MAX_SMALL) {
+        alloc_thread_cache *cache = alloc_self != NULL ? alloc_self : alloc_cache_self();
+        size_t c = ALLOC_CLASS(size);
+        if (cache != NULL && cache->heads[c] != NULL) {
+            alloc_block *block = cache->heads[c];
+            cache->heads[c] = block->next;
+            cache->counts[c]--;
+            return block;
+        }
+        size = ALLOC_CLASS_SIZE(c);
+    }
+    return malloc(size);
+}
+
+/**
+ *  @brief      : (for internal use) De-allocates a block, pushing it onto the free list of its size class in the cache
+ *                  of the calling thread (whichever thread allocated it), unless the list is full, or the block is
+ *                  large, then through 'free'.
+ *  @param      : [ Context (unused). ]
+ *                [ Block. ]
+ *                [ Size (in bytes). ]
+ *  @return     : None.
+**/
+static void alloc_cache_free(void *ctx, void *ptr, size_t size) {
+    (void) ctx;
+    if (size - 1 < ALLOC_MAX_SMALL) {
+        alloc_thread_cache *cache = alloc_self != NULL ? alloc_self : alloc_cache_self();
+        size_t c = ALLOC_CLASS(size);
+        if (cache != NULL && cache->counts[c] < ALLOC_CACHE_LIMIT) {
+            alloc_block *block = (alloc_block *) ptr;
+            block->next = cache->heads[c];
+            cache->heads[c] = block;
+            cache->counts[c]++;
+            return;
+        }
+    }
+    free(ptr);
+}
+
+/**
+ *  @brief      : (for internal use) Allocates the cache of the calling thread, and registers it with the key, so that
+ *                  it is de-allocated on thread exit.
+ *  @param      : None.
+ *  @return     : Pointer to cache (NULL on failure).
+**/
+static alloc_thread_cache * alloc_cache_self() {
+    pthread_once(&alloc_cache_once, alloc_cache_create_key);
+    alloc_self = (alloc_thread_cache *) calloc(1, sizeof(alloc_thread_cache));
+    if (alloc_self != NULL) {
+        pthread_setspecific(alloc_cache_key, alloc_self);
+    }
+    return alloc_self;
+}
+
+/**
+ *  @brief      : (for internal use) Creates the key of thread caches (once).
+ *  @param      : None.
+ *  @return     : None.
+**/
+static void alloc_cache_create_key() {
+    pthread_key_create(&alloc_cache_key, alloc_cache_exit);
+}
+
+/**
+ *  @brief      : (for internal use) Passes the blocks of a thread cache to 'free', then de-allocates the cache.
+ *  @param      : [ Cache. ]
+ *  @return     : None.
+**/
+static void alloc_cache_exit(void *cache) {
+    alloc_thread_cache *self = (alloc_thread_cache *) cache;
+    for (int c = 0; c < ALLOC_N_CLASSES; c++) {
+        while (self->heads[c] != NULL) {
+            alloc_block *block = self->heads[c];
+            self->heads[c] = block->next;
+            free(block);
+        }
+    }
+    free(self);
+    alloc_self = NULL;
+}
+
+/**
+ *  @brief      : Passes the blocks cached by the calling thread to 'free' (and its cache, re-allocated on its next
+ *                  allocation).
+ *  @param      : None.
+ *  @return     : None.
+**/
+void alloc_cache_release() {
+    if (alloc_self != NULL) {
+        pthread_setspecific(alloc_cache_key, NULL);
+        alloc_cache_exit(alloc_self);
+    }
+}
+
+/**
+ *  @brief      : Maps a region of the capacity (rounded up to hugepages), plus one hugepage of slack, so that its base
+ *                  can be aligned to a hugepage, and advises the kernel to back it by transparent hugepages (which it
+ *                  does as pages are first touched, so unused capacity costs no memory).
+ *  @param      : [ Capacity (in bytes). ]
+ *  @return     : Pointer to allocator (NULL on failure).
+**/
+alloc_allocator * alloc_create_region(size_t capacity) {
+    capacity = capacity == 0 ? ALLOC_HUGEPAGE : (capacity + ALLOC_HUGEPAGE - 1) & ~((size_t) ALLOC_HUGEPAGE - 1);
+    size_t map_size = capacity + ALLOC_HUGEPAGE;
+    char *map = (char *) mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+    alloc_region *region = (alloc_region *) calloc(1, sizeof(alloc_region));
+    if (region == NULL) {
+        munmap(map, map_size);
+        return NULL;
+    }
+    region->map = map, region->map_size = map_size;
+    region->base = (char *) (((uintptr_t) map + ALLOC_HUGEPAGE - 1) & ~((uintptr_t) ALLOC_HUGEPAGE - 1));
+    region->capacity = capacity, region->used = 0;
+#ifdef MADV_HUGEPAGE
+    madvise(region->base, capacity, MADV_HUGEPAGE);
+#endif
+    region->allocator.f_alloc = alloc_region_alloc;
+    region->allocator.f_free = alloc_region_free;
+    region->allocator.f_free_all = alloc_region_free_all;
+    region->allocator.f_destroy = alloc_region_destroy;
+    region->allocator.ctx = region;
+    return &region->allocator;
+}
+
+/**
+ *  @brief      : (for internal use) Allocates a block from a region, popping the free list of its size class if not
+ *                  empty, else carving it off the unused end of the region.
+ *  @param      : [ Region. ]
+ *                [ Size (in bytes). ]
+ *  @return     : Pointer to block (NULL if the region is used up).
+**/
+static void * alloc_region_alloc(void *ctx, size_t size) {
+    alloc_region *region = (alloc_region *) ctx;
+    if (size - 1 < ALLOC_MAX_SMALL) {
+        size_t c = ALLOC_CLASS(size);
+        if (region->heads[c] != NULL) {
+            alloc_block *block = region->heads[c];
+            region->heads[c] = block->next;
+            return block;
+        }
+        size = ALLOC_CLASS_SIZE(c);
+    } else {
+        size = (size + ALLOC_ALIGNMENT - 1) & ~((size_t) ALLOC_ALIGNMENT - 1);
+    }
+    if (size > region->capacity - region->used) {
+        return NULL;
+    }
+    void *ptr = region->base + region->used;
+    region->used += size;
+    return ptr;
+}
+
+/**
+ *  @brief      : (for internal use) De-allocates a block of a region, pushing it onto the free list of its size class.
+ *                  Large blocks are only reclaimed by 'alloc_region_free_all'.
+ *  @param      : [ Region. ]
+ *                [ Block. ]
+ *                [ Size (in bytes). ]
+ *  @return     : None.
+**/
+static void alloc_region_free(void *ctx, void *ptr, size_t size) {
+    alloc_region *region = (alloc_region *) ctx;
+    if (size - 1 < ALLOC_MAX_SMALL) {
+        alloc_block *block = (alloc_block *) ptr;
+        size_t c = ALLOC_CLASS(size);
+        block->next = region->heads[c];
+        region->heads[c] = block;
+    }
+}
+
+/**
+ *  @brief      : (for internal use) De-allocates all blocks of a region at once (keeping its pages mapped).
+ *  @param      : [ Region. ]
+ *  @return     : None.
+**/
+static void alloc_region_free_all(void *ctx) {
+    alloc_region *region = (alloc_region *) ctx;
+    region->used = 0;
+    memset(region->heads, 0, sizeof(region->heads));
+}
+
+/**
+ *  @brief      : (for internal use) Unmaps a region, and de-allocates it.
+ *  @param      : [ Region. ]
+ *  @return     : None.
+**/
+static void alloc_region_destroy(void *ctx) {
+    alloc_region *region = (alloc_region *) ctx;
+    munmap(region->map, region->map_size);
+    free(region);
+}
+
+/**
+ *  @brief      : Allocates a NUMA-aware allocator, reading the nodes of cpus, with an (empty) arena per node. Chunks
+ *                  are only mapped by the first allocation from an arena.
+ *  @param      : [ Size (in bytes) of each chunk (0 for 'ALLOC_HUGEPAGE'). ]
+ *  @return     : Pointer to allocator (NULL on failure).
+**/
+alloc_allocator * alloc_create_numa(size_t chunk_size) {
+    alloc_numa *numa = (alloc_numa *) calloc(1, sizeof(alloc_numa));
+    if (numa == NULL) {
+        return NULL;
+    }
+    numa->chunk_size = ALLOC_MIN_CHUNK;
+    while (numa->chunk_size < (chunk_size == 0 ? ALLOC_HUGEPAGE : chunk_size)) {
+        numa->chunk_size <<= 1;
+    }
+    numa->page_size = sysconf(_SC_PAGESIZE);
+    numa->n_cpus = sysconf(_SC_NPROCESSORS_CONF);
+    if (numa->page_size <= 0) { numa->page_size = 4096; }
+    if (numa->n_cpus <= 0) { numa->n_cpus = 1; }
+    numa->cpu_nodes = (int *) calloc(numa->n_cpus, sizeof(int));
+    if (numa->cpu_nodes == NULL) {
+        free(numa);
+        return NULL;
+    }
+    alloc_numa_read_nodes(numa);
+    numa->arenas = (alloc_arena *) calloc(numa->n_nodes, sizeof(alloc_arena));
+    if (numa->arenas == NULL) {
+        free(numa->cpu_nodes);
+        free(numa);
+        return NULL;
+    }
+    for (int i = 0; i < numa->n_nodes; i++) {
+        pthread_mutex_init(&numa->arenas[i].lock, NULL);
+    }
+    numa->allocator.f_alloc = alloc_numa_alloc;
+    numa->allocator.f_free = alloc_numa_free;
+    numa->allocator.f_free_all = NULL;
+    numa->allocator.f_destroy = alloc_numa_destroy;
+    numa->allocator.ctx = numa;
+    return &numa->allocator;
+}
+
+/**
+ *  @brief      : (for internal use) Reads the cpus of each NUMA node ('/sys/devices/system/node/nodeN/cpulist', as a
+ *                  comma-separated list of cpus, or ranges of them). Nodes may be sparse, so all ids up to
+ *                  'ALLOC_MAX_NODES' are looked up. Without any, there's one node (cpus default to node 0).
+ *  @param      : [ NUMA-aware allocator. ]
+ *  @return     : None.
+**/
+static void alloc_numa_read_nodes(alloc_numa *numa) {
+    char path[64];
+    numa->n_nodes = 1;
+    for (int node = 0; node < ALLOC_MAX_NODES; node++) {
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE *file = fopen(path, "r");
+        if (file == NULL) {
+            continue;
+        }
+        long first, last;
+        int c;
+        while (fscanf(file, "%ld", &first) == 1) {
+            last = first;
+            if ((c = fgetc(file)) == '-') {
+                if (fscanf(file, "%ld", &last) != 1) { break; }
+                c = fgetc(file);
+            }
+            for (long cpu = first; cpu <= last && cpu < numa->n_cpus; cpu++) {
+                numa->cpu_nodes[cpu] = node;
+            }
+            if (c != ',') { break; }
+        }
+        fclose(file);
+        numa->n_nodes = node + 1;
+    }
+}
+
+/**
+ *  @brief      : (for internal use) Returns the NUMA node of the cpu the calling thread runs on (0 if unknown).
+ *  @param      : [ NUMA-aware allocator. ]
+ *  @return     : Node.
+**/
+static int alloc_numa_node(alloc_numa *numa) {
+#ifdef __linux__
+    int cpu = sched_getcpu();
+    if (cpu >= 0 && cpu < numa->n_cpus) {
+        return numa->cpu_nodes[cpu];
+    }
+#else
+    (void) numa;
+#endif
+    return 0;
+}
+
+/**
+ *  @brief      : (for internal use) Allocates a block from the arena of the node of the calling thread, popping the
+ *                  free list of its size class if not empty, else carving it off its current chunk (mapping a new one
+ *                  if too little is left). Large blocks are allocated through 'malloc'.
+ *  @param      : [ NUMA-aware allocator. ]
+ *                [ Size (in bytes). ]
+ *  @return     : Pointer to block (NULL on failure).
+**/
+static void * alloc_numa_alloc(void *ctx, size_t size) {
+    alloc_numa *numa = (alloc_numa *) ctx;
+    if (size - 1 >= ALLOC_MAX_SMALL) {
+        return malloc(size);
+    }
+    int node = alloc_numa_node(numa);
+    alloc_arena *arena = numa->arenas + node;
+    size_t c = ALLOC_CLASS(size);
+    void *ptr = NULL;
+
+    size = ALLOC_CLASS_SIZE(c);
+    pthread_mutex_lock(&arena->lock);
+    if (arena->heads[c] != NULL) {
+        ptr = arena->heads[c];
+        arena->heads[c] = arena->heads[c]->next;
+    } else if (arena->left >= size || alloc_numa_grow(numa, arena, node)) {
+        ptr = arena->top;
+        arena->top += size, arena->left -= size;
+    }
+    pthread_mutex_unlock(&arena->lock);
+    return ptr;
+}
+
+/**
+ *  @brief      : (for internal use) Maps a chunk for an arena (aligned to its size, by mapping twice as much, and
+ *                  unmapping the slack), and touches each of its pages from the calling thread, so that they're placed
+ *                  on its node. The rest of the current chunk is dropped.
+ *  @param      : [ NUMA-aware allocator. ]
+ *                [ Arena (locked). ]
+ *                [ Node of the arena. ]
+ *  @return     : 1 if mapped, 0 on failure.
+**/
+static unsigned char alloc_numa_grow(alloc_numa *numa, alloc_arena *arena, int node) {
+    size_t chunk_size = numa->chunk_size;
+    char *map = (char *) mmap(NULL, 2 * chunk_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) {
+        return 0;
+    }
+    char *start = (char *) (((uintptr_t) map + chunk_size - 1) & ~((uintptr_t) chunk_size - 1));
+    if (start != map) {
+        munmap(map, start - map);
+    }
+    munmap(start + chunk_size, map + chunk_size - start);
+    for (size_t offset = 0; offset < chunk_size; offset += numa->page_size) {
+        start[offset] = 0;
+    }
+
+    alloc_chunk *chunk = (alloc_chunk *) start;
+    chunk->node = node;
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    size_t header = (sizeof(alloc_chunk) + ALLOC_ALIGNMENT - 1) & ~((size_t) ALLOC_ALIGNMENT - 1);
+    arena->top = start + header, arena->left = chunk_size - header;
+    return 1;
+}
+
+/**
+ *  @brief      : (for internal use) De-allocates a block to the arena of its chunk (so it is re-used for memory of the
+ *                  same node), pushing it onto the free list of its size class. Large blocks are passed to 'free'.
+ *  @param      : [ NUMA-aware allocator. ]
+ *                [ Block. ]
+ *                [ Size (in bytes). ]
+ *  @return     : None.
+**/
+static void alloc_numa_free(void *ctx, void *ptr, size_t size) {
+    alloc_numa *numa = (alloc_numa *) ctx;
+    if (size - 1 >= ALLOC_MAX_SMALL) {
+        free(ptr);
+        return;
+    }
+    alloc_chunk *chunk = (alloc_chunk *) ((uintptr_t) ptr & ~((uintptr_t) numa->chunk_size - 1));
+    alloc_arena *arena = numa->arenas + chunk->node;
+    alloc_block *block = (alloc_block *) ptr;
+    size_t c = ALLOC_CLASS(size);
+
+    pthread_mutex_lock(&arena->lock);
+    block->next = arena->heads[c];
+    arena->heads[c] = block;
+    pthread_mutex_unlock(&arena->lock);
+}
+
+/**
+ *  @brief      : (for internal use) Unmaps the chunks of all arenas, and de-allocates the allocator.
+ *  @param      : [ NUMA-aware allocator. ]
+ *  @return     : None.
+**/
+static void alloc_numa_destroy(void *ctx) {
+    alloc_numa *numa = (alloc_numa *) ctx;
+    for (int i = 0; i < numa->n_nodes; i++) {
+        alloc_chunk *chunk = numa->arenas[i].chunks;
+        while (chunk != NULL) {
+            alloc_chunk *next = chunk->next;
+            munmap(chunk, numa->chunk_size);
+            chunk = next;
+        }
+        pthread_mutex_destroy(&numa->arenas[i].lock);
+    }
+    free(numa->arenas);
+    free(numa->cpu_nodes);
+    free(numa);
+}
+
+/**
+ *  @brief      : Destroys an allocator, if it is not static.
+ *  @param      : [ Allocator. ]
+ *  @return     : None.
+**/
+void alloc_destroy(alloc_allocator *allocator) {
+    if (allocator != NULL && allocator->f_destroy != NULL) {
+        allocator->f_destroy(allocator->ctx);
+    }
+}
+
+/* ********************* 'main' function defintion SECTION (TEST) ********************** */
+
+#ifdef _MAIN_ALLOCATOR_                 /* compile-time switch */
+
+#include "linked_list.h"
+#include "avl_tree.h"
+
+/**
+ *  @brief      : No. of items of each test, and no. of threads of the concurrent test.
+**/
+#define T_N             100000
+#define T_THREADS       4
+
+unsigned char f_compare(void *new_data, void *old_data);
+int f_compare3(void *new_data, void *old_data);
+unsigned char t_sorted(avl_tree *tree);
+void * t_next(void *arg);
+void t_backends();
+void t_no_allocator();
+void t_failure();
+void t_concurrent();
+
+int main() {
+    t_backends();
+    t_no_allocator();
+    t_failure();
+    t_concurrent();
+    return 0;
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return (long) new_data < (long) old_data;
+}
+
+int f_compare3(void *new_data, void *old_data) {
+    return ((long) new_data > (long) old_data) - ((long) new_data < (long) old_data);
+}
+
+unsigned char t_sorted(avl_tree *tree) {                /* by index, so sizes are checked too */
+    LENGTH_DT n = tree->length - tree->buffer_length;
+    unsigned char sorted = tree->root == NULL ? n == 0 : tree->root->size == n;
+    for (LENGTH_DT i = 1; i < tree->length; i++) {
+        sorted &= (long) avl_get(tree, i - 1) <= (long) avl_get(tree, i);
+    }
+    return sorted;
+}
+
+void * t_next(void *arg) {
+    return (void *) (*((long *) arg))++;
+}
+
+void t_backends() {
+    printf("*************** TEST (BACKENDS) ***************\n");
+    const char *names[] = {"malloc", "cache", "region", "numa"};
+    alloc_allocator *allocators[] = {alloc_malloc(), alloc_cache(), alloc_create_region(T_N * 64), alloc_create_numa(0)};
+    for (int a = 0; a < 4; a++) {
+        avl_tree *tree = avl_create_alloc(allocators[a]);
+        ll_list *list = ll_create_alloc(sizeof(long), allocators[a]);
+        long sum = 0;
+        for (long i = 0; i < T_N; i++) {
+            long key = (i * 7919) % T_N;
+            avl_insert(tree, (void *) key, f_compare);
+            ll_append(list, &key);
+        }
+        for (long i = 0; i < T_N / 2; i++) {
+            avl_delete(tree, (i * 31) % tree->length, f_compare);
+            sum += *((long *) ll_get(list, 0));
+            ll_delete(list, 0);
+        }
+        for (long i = 0; i < T_N / 2; i++) {                    /* re-uses de-allocated blocks */
+            avl_insert(tree, (void *) i, f_compare);
+        }
+        printf("%-7s -> tree: %ld (sorted: %d, failed: %d), list: %ld (sum of deleted: %ld, failed: %d)\n", names[a],
+                (long) tree->length, t_sorted(tree), tree->failed, (long) list->length, sum, list->failed);
+        avl_destroy(tree);
+        ll_destroy(list);
+        alloc_destroy(allocators[a]);
+    }
+    alloc_cache_release();
+}
+
+void t_no_allocator() {
+    printf("*************** TEST (NO ALLOCATOR) ***************\n");
+    avl_tree *tree = avl_create();
+    ll_list *list = ll_create();
+    avl_set_free(tree, NULL);                                           /* restores 'free', as neither has an allocator */
+    ll_set_free(list, NULL);
+    for (long i = 0; i < 1000; i++) {
+        avl_insert(tree, (void *) i, f_compare);
+        ll_append(list, (void *) i);
+    }
+    avl_delete(tree, 0, f_compare);
+    ll_delete(list, 0);
+    printf("Set free (NULL) -> tree: %ld, sorted: %d, list: %ld\n", (long) tree->length, t_sorted(tree), (long) list->length);
+    avl_delete_all(tree);
+    ll_delete_all(list);
+    printf("Delete all -> tree: %ld, list: %ld\n", (long) tree->length, (long) list->length);
+    avl_destroy(tree);
+    ll_destroy(list);
+}
+
+void t_failure() {
+    printf("*************** TEST (FAILURE) ***************\n");
+    alloc_allocator *region = alloc_create_region(ALLOC_HUGEPAGE);
+    avl_tree *tree = avl_create_alloc(region);
+    long i = 0;
+    while (!tree->failed) {
+        avl_insert(tree, (void *) (i++ % 1000), f_compare);
+    }
+    printf("Insert -> inserted: %ld of %ld, length: %ld, sorted: %d\n", i - 1, i, (long) tree->length, t_sorted(tree));
+
+    tree->failed = 0;
+    avl_insert_finger(tree, (void *) 5, f_compare);
+    avl_insert_multi(tree, (void *) 5, f_compare3);
+    LENGTH_DT length = tree->length;
+    avl_set_buffer(tree, 64, f_compare);
+    for (long k = 0; k < 64; k++) {
+        avl_insert_buffered(tree, (void *) k);
+    }
+    avl_flush(tree);
+    printf("Finger, multi, buffered -> failed: %d, length: %ld (+%ld, kept buffered: %ld), sorted: %d\n", tree->failed,
+            (long) tree->length, (long) (tree->length - length), (long) tree->buffer_length, t_sorted(tree));
+    long next = 0;
+    length = tree->length;
+    avl_bulk_load(tree, T_N, t_next, &next);
+    printf("Bulk load -> length: %ld (unchanged: %d), sorted: %d\n", (long) tree->length, tree->length == length,
+            t_sorted(tree));
+
+    avl_delete_all(tree);                                               /* releases the region at once */
+    tree->failed = 0;
+    for (long k = 0; k < 1000; k++) {
+        avl_insert(tree, (void *) k, f_compare);
+    }
+    printf("After delete all -> length: %ld, failed: %d, sorted: %d\n", (long) tree->length, tree->failed, t_sorted(tree));
+    avl_destroy(tree);
+
+    ll_list *list = ll_create_alloc(0, region);
+    i = 0;
+    while (!list->failed) {
+        ll_append(list, (void *) i++);
+    }
+    LENGTH_DT n = 0;
+    for (ll_node *node = list->head; node != NULL; node = node->next) { n++; }
+    printf("List -> appended: %ld of %ld, length: %ld (counted: %ld)\n", i - 1, i, (long) list->length, (long) n);
+    ll_destroy(list);
+    alloc_destroy(region);
+}
+
+void * t_worker(void *arg) {
+    avl_tree *tree = avl_create_alloc((alloc_allocator *) arg);
+    for (long i = 0; i < T_N; i++) {
+        avl_insert(tree, (void *) ((i * 7919) % T_N), f_compare);
+    }
+    for (long i = 0; i < T_N / 2; i++) {
+        avl_pop_min(tree);
+    }
+    long length = tree->length + !t_sorted(tree) * T_N;
+    avl_destroy(tree);
+    return (void *) length;
+}
+
+void t_concurrent() {
+    printf("*************** TEST (CONCURRENT) ***************\n");
+    alloc_allocator *numa = alloc_create_numa(1 << 16);
+    pthread_t threads[T_THREADS];
+    long total = 0;
+    for (int t = 0; t < T_THREADS; t++) {
+        pthread_create(threads + t, NULL, t_worker, numa);
+    }
+    for (int t = 0; t < T_THREADS; t++) {
+        void *result;
+        pthread_join(threads[t], &result);
+        total += (long) result;
+    }
+    printf("Threads: %d, items left (expected %d): %ld\n", T_THREADS, T_THREADS * T_N / 2, total);
+    alloc_destroy(numa);
+
+    for (int t = 0; t < T_THREADS; t++) {                       /* caches are released on thread exit */
+        pthread_create(threads + t, NULL, t_worker, alloc_cache());
+    }
+    total = 0;
+    for (int t = 0; t < T_THREADS; t++) {
+        void *result;
+        pthread_join(threads[t], &result);
+        total += (long) result;
+    }
+    printf("Threads (cache): %d, items left (expected %d): %ld\n", T_THREADS, T_THREADS * T_N / 2, total);
+}
+
+#endif
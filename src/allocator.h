@@ -0,0 +1,127 @@
+/**
+ ****************************************************************
+ * @file            : allocator.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of pluggable allocators, that lists and trees may allocate their
+ *                      nodes from (see 'll_create_alloc', 'avl_create_alloc'), instead of 'malloc'. Backends are plain
+ *                      'malloc', a thread-local cache, a hugepage-backed region, and NUMA-local arenas.
+ *                      (Note: This header only is needed by lists and trees, 'allocator.c' only by users of the backends.
+ *                      The backends require C11 (thread-local storage), and POSIX/Linux ('mmap', 'pthread').)
+ * **************************************************************
+ **/
+
+#ifndef _ALLOCATOR_H_
+#define _ALLOCATOR_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Allocate (or de-allocate) a block of a size through an allocator, or through 'malloc' (or 'free') if
+ *                  it is NULL (the default of lists and trees, at the cost of a single branch).
+**/
+#define ALLOC_ALLOC(allocator, size)    ((allocator) != NULL ? (allocator)->f_alloc((allocator)->ctx, size) : malloc(size))
+#define ALLOC_FREE(allocator, ptr, size) ((allocator) != NULL ? (allocator)->f_free((allocator)->ctx, ptr, size) : free(ptr))
+
+/**
+ *  @brief      : Blocks up to 'ALLOC_MAX_SMALL' bytes are rounded up to a multiple of 'ALLOC_ALIGNMENT' (a size
+ *                  class), and kept on a free list of their class once de-allocated (by the cache, region and NUMA
+ *                  backends).
+ *                  Larger blocks are passed to 'malloc' (by the cache and NUMA backends).
+**/
+#define ALLOC_ALIGNMENT             16
+#define ALLOC_MAX_SMALL             512
+#define ALLOC_N_CLASSES             (ALLOC_MAX_SMALL / ALLOC_ALIGNMENT)
+
+/**
+ *  @brief      : Max. no. of blocks of each size class kept by the thread-local cache of each thread (the rest are
+ *                  passed to 'free').
+**/
+#define ALLOC_CACHE_LIMIT           1024
+
+/**
+ *  @brief      : Size (and alignment) of a hugepage (transparent, on Linux x86-64).
+**/
+#define ALLOC_HUGEPAGE              (2 << 20)
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Allocator structure (a table of functions, and the context they receive). De-allocation is sized
+ *                  (the size passed is the one the block was allocated with), so backends need no block headers.
+ *                  An allocator with a bulk de-allocation ('f_free_all', optional) must serve a single list or tree,
+ *                  since it is called (instead of de-allocating nodes one by one) when all of its items are deleted.
+**/
+typedef struct ALLOC_ALLOCATOR {
+    void * (*f_alloc)(void *ctx, size_t size);      /* returns NULL on failure */
+    void (*f_free)(void *ctx, void *ptr, size_t size);
+    void (*f_free_all)(void *ctx);                  /* de-allocates all blocks at once (NULL if not supported) */
+    void (*f_destroy)(void *ctx);                   /* de-allocates the allocator itself (NULL if static) */
+    void *ctx;
+} alloc_allocator;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Get the plain allocator ('malloc' and 'free'). Lists and trees created with it behave like default
+ *                  ones (a NULL allocator), at the cost of an indirect call.
+ *  @param      : None.
+ *  @return     : Pointer to allocator (static).
+**/
+alloc_allocator * alloc_malloc();
+
+/**
+ *  @brief      : Get the thread-local cache allocator. Small blocks de-allocated by a thread are kept on free lists
+ *                  of that thread (up to 'ALLOC_CACHE_LIMIT' per size class), and re-used by its next allocations of
+ *                  the same class, with no locking. Cached blocks are passed to 'free' when the thread exits. It may be
+ *                  shared by any no. of lists and trees, and threads.
+ *  @param      : None.
+ *  @return     : Pointer to allocator (static).
+**/
+alloc_allocator * alloc_cache();
+
+/**
+ *  @brief      : Pass the blocks cached by the calling thread (see 'alloc_cache') to 'free'.
+ *  @param      : None.
+ *  @return     : None.
+**/
+void alloc_cache_release();
+
+/**
+ *  @brief      : Create a region allocator (dynamically, on heap), over a hugepage-aligned memory mapping of a capacity
+ *                  (rounded up to hugepages), advised to be backed by transparent hugepages, so that nodes spread over
+ *                  it take few TLB entries. Blocks are carved off its start, and re-used once de-allocated (if small).
+ *                  Once the capacity is used up, allocations fail (NULL). Its bulk de-allocation releases all blocks
+ *                  (keeping the mapping), so it must serve a single list or tree. It is not thread-safe.
+ *  @param      : [ Capacity (in bytes). ]
+ *  @return     : Pointer to allocator (NULL if the mapping fails).
+**/
+alloc_allocator * alloc_create_region(size_t capacity);
+
+/**
+ *  @brief      : Create a NUMA-aware allocator (dynamically, on heap), with an arena per NUMA node. A thread allocates
+ *                  from the arena of the node it runs on, which maps chunks (of a size, rounded up to a power of two),
+ *                  and touches them first, from that thread, so the kernel places their pages on its node (first-touch
+ *                  policy). A block is de-allocated to the arena of its chunk. Arenas are locked, so it may be shared
+ *                  by many threads.
+ *                  (Note: Nodes are read from '/sys/devices/system/node' (one node if missing), and no library is
+ *                  needed, but a thread that migrates between nodes may allocate remote memory.)
+ *  @param      : [ Size (in bytes) of each chunk (0 for 'ALLOC_HUGEPAGE'). ]
+ *  @return     : Pointer to allocator.
+**/
+alloc_allocator * alloc_create_numa(size_t chunk_size);
+
+/**
+ *  @brief      : Destroy an allocator (if not static), unmapping its memory. Lists and trees using it must be destroyed
+ *                  first.
+ *  @param      : [ Allocator. ]
+ *  @return     : None.
+**/
+void alloc_destroy(alloc_allocator *allocator);
+
+#endif
@@ -0,0 +1,463 @@
+/**
+ ****************************************************************
+ * @file            : array_list.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of an array list (a growable, contiguous array), with stack and queue functions.
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#include "array_list.h"
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static void al_resize(al_list *list, LENGTH_DT capacity);
+static void al_grow(al_list *list);
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Allocating dynamic memory for a list structure, initializing and returning the pointer. The array is
+ *                  allocated on first insertion.
+ *  @param      : None.
+ *  @return     : Pointer to list.
+**/
+al_list * al_create() {
+    al_list *new_list = (al_list *) malloc(sizeof(al_list));
+    new_list->items = NULL;
+    new_list->length = new_list->capacity = 0;
+    return new_list;
+}
+
+/**
+ *  @brief      : (For internal use) Re-allocate the array of a list, with a capacity (not less than its length).
+ *  @param      : [ List. ]
+ *                [ Capacity (no. of items). ]
+ *  @return     : None.
+**/
+static void al_resize(al_list *list, LENGTH_DT capacity) {
+    list->items = (DATA_TYPE *) realloc(list->items, capacity * sizeof(DATA_TYPE));
+    list->capacity = capacity;
+}
+
+/**
+ *  @brief      : (For internal use) Make room for one more item. If the list is full, its capacity is multiplied by
+ *                  'AL_GROWTH_FACTOR', so that 'n' appends re-allocate only O(log n) times (amortised O(1) each).
+ *  @param      : [ List. ]
+ *  @return     : None.
+**/
+static void al_grow(al_list *list) {
+    if (list->length == list->capacity) {
+        al_resize(list, list->capacity == 0 ? AL_INITIAL_CAPACITY : list->capacity * AL_GROWTH_FACTOR);
+    }
+}
+
+/**
+ *  @brief      : Get the value at an index in the list. If fails, because index is out of bounds,
+ *                  then, return a default value, set in the header file.
+ *                  (Note: Allows negative indexing if LENGTH_DT is signed.)
+ *  @param      : [ List to search in. ]
+ *                [ Index to use. ]
+ *  @return     : Stored data.
+**/
+DATA_TYPE al_get(al_list *list, LENGTH_DT i) {
+    if (i < 0) { i += list->length; }                    /* to allow reverse indexing */
+
+    if (i >= 0 && i < list->length) {
+        return list->items[i];
+    }
+    return DEFAULT_VALUE;
+}
+
+/**
+ *  @brief      : Replace value at an index in the list.
+ *                  (Note: Allows negative indexing if LENGTH_DT is signed.)
+ *  @param      : [ List to search in. ]
+ *                [ Data to substitute. ]
+ *                [ Index to use. ]
+ *  @return     : None.
+**/
+void al_replace(al_list *list, DATA_TYPE data, LENGTH_DT i) {
+    if (i < 0) { i += list->length; }                    /* to allow reverse indexing */
+
+    if (i >= 0 && i < list->length) {
+        list->items[i] = data;
+    }
+}
+
+/**
+ *  @brief      : Inserting value at a specific index. It will occupy that index, and the items from that index onwards
+ *                  are shifted to the right (with a single 'memmove'). Inserting at the length appends.
+ *  @param      : [ List to work with. ]
+ *                [ Data to insert. ]
+ *                [ Index to insert at. ]
+ *  @return     : None.
+**/
+void al_insert(al_list *list, DATA_TYPE data, LENGTH_DT i) {
+    if (i >= 0 && i <= list->length) {
+        al_grow(list);
+        memmove(list->items + i + 1, list->items + i, (list->length - i) * sizeof(DATA_TYPE));
+        list->items[i] = data;
+        list->length++;
+    }
+}
+
+/**
+ *  @brief      : Deleting value at a specific index. The items after that index are shifted to the left (with a single
+ *                  'memmove'). The array is not shrunk (see 'al_shrink_to_fit').
+ *                  (Note: Allows negative indexing if LENGTH_DT is signed.)
+ *  @param      : [ List to delete from. ]
+ *                [ Index to work with. ]
+ *  @return     : Stored data.
+**/
+DATA_TYPE al_delete(al_list *list, LENGTH_DT i) {
+    if (i < 0) { i += list->length; }                    /* to allow reverse indexing */
+
+    if (i >= 0 && i < list->length) {
+        DATA_TYPE data = list->items[i];
+        list->length--;
+        memmove(list->items + i, list->items + i + 1, (list->length - i) * sizeof(DATA_TYPE));
+        return data;
+    }
+    return DEFAULT_VALUE;
+}
+
+/**
+ *  @brief      : Append value to end of list.
+ *  @param      : [ List to append to. ]
+ *                [ Data to append. ]
+ *  @return     : None.
+**/
+void al_append(al_list *list, DATA_TYPE data) {
+    al_grow(list);
+    list->items[list->length++] = data;
+}
+
+/**
+ *  @brief      : Prepend value to start of list.
+ *  @param      : [ List to prepend to. ]
+ *                [ Data to prepend. ]
+ *  @return     : None.
+**/
+void al_prepend(al_list *list, DATA_TYPE data) {
+    al_insert(list, data, 0);
+}
+
+/**
+ *  @brief      : Copy a list into a new list, in the same order, or in reverse. The new list's capacity is the
+ *                  length of the list.
+ *  @param      : [ List to copy. ]
+ *                [ Reverse flag (1 to reverse). ]
+ *  @return     : Pointer to new list.
+**/
+al_list * al_copy(al_list *list, unsigned char rev_flag) {
+    al_list *new_list = al_create();
+    if (list->length != 0) {
+        al_resize(new_list, list->length);
+        if (rev_flag) {
+            for (LENGTH_DT i = 0; i < list->length; i++) {
+                new_list->items[i] = list->items[list->length - 1 - i];
+            }
+        } else {
+            memcpy(new_list->items, list->items, list->length * sizeof(DATA_TYPE));
+        }
+        new_list->length = list->length;
+    }
+    return new_list;
+}
+
+/**
+ *  @brief      : Make room for a number of items. If the capacity is already enough, nothing happens.
+ *  @param      : [ List. ]
+ *                [ Capacity (no. of items). ]
+ *  @return     : None.
+**/
+void al_reserve(al_list *list, LENGTH_DT capacity) {
+    if (capacity > list->capacity) {
+        al_resize(list, capacity);
+    }
+}
+
+/**
+ *  @brief      : Shrink the capacity of a list to its length. An empty list releases its array.
+ *  @param      : [ List. ]
+ *  @return     : None.
+**/
+void al_shrink_to_fit(al_list *list) {
+    if (list->length == 0) {
+        free(list->items);
+        list->items = NULL;
+        list->capacity = 0;
+    } else if (list->length < list->capacity) {
+        al_resize(list, list->length);
+    }
+}
+
+/**
+ *  @brief      : Delete all items in a list.
+ *  @param      : [ List to delete all items from. ]
+ *  @return     : None.
+**/
+void al_delete_all(al_list *list) {
+    list->length = 0;
+}
+
+/**
+ *  @brief      : Destroy list (de-allocate its array, then the list itself).
+ *  @param      : [ List to destroy. ]
+ *  @return     : None.
+**/
+void al_destroy(al_list *list) {
+    free(list->items);
+    free(list);
+}
+
+/**
+ *  @brief      : Print a list. Must pass a two function pointers, one is used to print each item, and another is called
+ *                  at the end (passed a reference to the list).
+ *  @param      : [ List to print. ]
+ *                [ Function to be called at each item (passed each item consecutively). ]
+ *                [ Function to be called after all items have been printed (passed list and used for clean-up). ]
+ *  @return     : None.
+**/
+void al_print(al_list *list, void (*f_print)(DATA_TYPE data), void (*f_clean)(al_list *list)) {
+    if (list->length != 0) {
+        for (LENGTH_DT i = 0; i < list->length; i++) {
+            f_print(list->items[i]);
+        }
+        f_clean(list);
+    }
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_ARRAY_LIST_                /* compile-time switch */
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+void t_insert();
+void t_replace();
+void t_get();
+void t_delete();
+void t_append_prepend();
+void t_stack();
+void t_copy();
+void t_capacity();
+
+void print(void *data);
+
+void f_clean(al_list *list);
+void f_print(void *data);
+
+int main() {
+    t_insert();
+    t_replace();
+    t_get();
+    t_delete();
+    t_append_prepend();
+    t_stack();
+    t_copy();
+    t_capacity();
+    return 0;
+}
+
+void t_insert() {
+    printf("*************** TEST (INSERT) ***************\n");
+    al_list *list = al_create();
+    int arr_data[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    int arr_index[] = {0, 0, 1, 2, 3, 2, 7, 6};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        printf("Inserting: %d at (i=%d)\n", arr_data[i], arr_index[i]);
+        al_insert(list, arr_data+i, arr_index[i]);
+        al_print(list, f_print, f_clean);
+    }
+    al_destroy(list);
+}
+
+void t_replace() {
+    printf("*************** TEST (REPLACE) ***************\n");
+    al_list *list = al_create();
+    int zero = 0;
+    for (int i = 0; i < 6; i++) {
+        al_append(list, &zero);
+    }
+    al_print(list, f_print, f_clean);
+    int arr_data[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    int arr_index[] = {0, 0, 1, 2, -1, -3, 7, 5};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        printf("Replacing: %d at (i=%d)\n", arr_data[i], arr_index[i]);
+        al_replace(list, arr_data+i, arr_index[i]);
+        al_print(list, f_print, f_clean);
+    }
+    al_destroy(list);
+}
+
+void t_get() {
+    printf("*************** TEST (GET) ***************\n");
+    al_list *list = al_create();
+    int arr_data[] = {1, 2, 3, 4, 5};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        al_append(list, arr_data+i);
+    }
+    al_print(list, f_print, f_clean);
+    int arr_index[] = {0, 4, -1, -5, 5, -6};
+    for (int i = 0; i < LEN(arr_index); i++) {
+        printf("Getting (i=%d)\n", arr_index[i]);
+        print(al_get(list, arr_index[i]));
+    }
+    al_destroy(list);
+}
+
+void t_delete() {
+    printf("*************** TEST (DELETE) ***************\n");
+    al_list *list = al_create();
+    int arr_data[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        al_insert(list, arr_data+i, i);
+    }
+    al_print(list, f_print, f_clean);
+    int arr_index[] = {0, 5, 2, -1, 4, 11};
+    for (int i = 0; i < LEN(arr_index); i++) {
+        printf("Deleting (i=%d)\n", arr_index[i]);
+        print(al_delete(list, arr_index[i]));
+        al_print(list, f_print, f_clean);
+    }
+    al_destroy(list);
+}
+
+void t_append_prepend() {
+    printf("*************** TEST (APPEND/PREPEND) ***************\n");
+    al_list *list = al_create();
+    int arr_data[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    int len = LEN(arr_data);
+    for (int i = 0; i < len/2; i++) {
+        printf("Appending %d\n", arr_data[i]);
+        al_append(list, arr_data+i);
+        al_print(list, f_print, f_clean);
+    }
+    for (int i = len/2; i < len; i++) {
+        printf("Prepending %d\n", arr_data[i]);
+        al_prepend(list, arr_data+i);
+        al_print(list, f_print, f_clean);
+    }
+    al_destroy(list);
+}
+
+void t_stack() {
+    printf("*************** TEST (STACK/QUEUE) ***************\n");
+    al_list *list = al_create();
+    int arr_data[] = {1, 2, 3, 4, 5};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        al_push(list, arr_data+i);
+    }
+    printf("Top: "), print(al_top(list));
+    printf("Popping: "), print(al_pop(list));
+    printf("Popping: "), print(al_pop(list));
+    printf("Dequeuing: "), print(al_dequeue(list));
+    al_print(list, f_print, f_clean);
+    al_destroy(list);
+}
+
+void t_copy() {
+    printf("*************** TEST (COPY) ***************\n");
+    al_list *list = al_create();
+    int arr_data[] = {1, 2, 3, 4, 5};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        al_append(list, arr_data+i);
+    }
+    al_list *list_copy = al_copy(list, 0);
+    al_list *list_rev = al_copy(list, 1);
+    al_print(list_copy, f_print, f_clean);
+    al_print(list_rev, f_print, f_clean);
+    al_destroy(list);
+    al_destroy(list_copy);
+    al_destroy(list_rev);
+}
+
+void t_capacity() {
+    printf("*************** TEST (CAPACITY) ***************\n");
+    al_list *list = al_create();
+    int one = 1;
+    for (int i = 0; i < 20; i++) {
+        al_append(list, &one);
+    }
+    printf("Length: %ld, capacity: %ld\n", (long) list->length, (long) list->capacity);
+    al_reserve(list, 100);
+    printf("Reserved, length: %ld, capacity: %ld\n", (long) list->length, (long) list->capacity);
+    al_shrink_to_fit(list);
+    printf("Shrunk, length: %ld, capacity: %ld\n", (long) list->length, (long) list->capacity);
+    al_delete_all(list);
+    al_shrink_to_fit(list);
+    printf("Emptied and shrunk, length: %ld, capacity: %ld\n", (long) list->length, (long) list->capacity);
+    al_append(list, &one);
+    al_print(list, f_print, f_clean);
+    al_destroy(list);
+}
+
+void print(void *data) {
+    if (data != NULL) {
+        printf("%d\n", *((int *) data));
+    } else {
+        printf("NULL\n");
+    }
+}
+
+void f_clean(al_list *list) {
+    printf("\b\b \n");
+}
+
+void f_print(void *data) {
+    printf("%d, ", *((int *) data));
+}
+
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_ARRAY_LIST_               /* compile-time switch */
+
+#include <time.h>
+#include "linked_list.h"
+
+double elapsed_ns(clock_t start, LENGTH_DT ops);
+
+/**
+ *  @brief      : Benchmark of the array list against the linked list, for appending items then scanning them in order
+ *                  (the linked list is scanned through its nodes, since 'll_get' is O(n)).
+ *                  (Usage: <no. of items (default: 10^7)>)
+**/
+int main(int argc, char *argv[]) {
+    LENGTH_DT n = argc > 1 ? atol(argv[1]) : 10000000;
+    uintptr_t checksum = 0;
+    clock_t start;
+
+    start = clock();
+    ll_list *ll = ll_create();
+    for (LENGTH_DT i = 0; i < n; i++) { ll_append(ll, (void *) (uintptr_t) i); }
+    printf("linked_list append: %6.2f ns/item\n", elapsed_ns(start, n));
+    start = clock();
+    for (ll_node *node = ll->head; node != NULL; node = node->next) { checksum += (uintptr_t) node->data; }
+    printf("linked_list scan:   %6.2f ns/item\n", elapsed_ns(start, n));
+    ll_destroy(ll);
+
+    start = clock();
+    al_list *al = al_create();
+    for (LENGTH_DT i = 0; i < n; i++) { al_append(al, (void *) (uintptr_t) i); }
+    printf("array_list append:  %6.2f ns/item\n", elapsed_ns(start, n));
+    start = clock();
+    for (LENGTH_DT i = 0; i < al->length; i++) { checksum -= (uintptr_t) al_get(al, i); }
+    printf("array_list scan:    %6.2f ns/item\n", elapsed_ns(start, n));
+    printf("Memory: linked_list %ld bytes/item, array_list %ld bytes/item (capacity %ld)\n",
+            (long) sizeof(ll_node), (long) (al->capacity * sizeof(DATA_TYPE) / n), (long) al->capacity);
+    al_destroy(al);
+
+    if (checksum != 0) { printf("(checksum mismatch)\n"); }
+    return 0;
+}
+
+double elapsed_ns(clock_t start, LENGTH_DT ops) {
+    return (double) (clock() - start) / CLOCKS_PER_SEC * 1e9 / ops;
+}
+
+#endif
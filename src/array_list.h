@@ -0,0 +1,167 @@
+/**
+ ****************************************************************
+ * @file            : array_list.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the implementation of an array list (a growable, contiguous
+ *                      array), with stack and queue functions.
+ * **************************************************************
+ **/
+
+#ifndef _ARRAY_LIST_H_
+#define _ARRAY_LIST_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "shared_defs.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Stack functions, implemented as macro functions, aliasing list functions.
+ *                  (Note: Unlike a linked list, the top of the stack is the end of the array, so that push and pop
+ *                  are O(1).)
+**/
+#define al_push(list, data)         al_append(list, data)
+#define al_pop(list)                al_delete(list, -1)
+#define al_top(list)                al_get(list, -1)
+
+/**
+ *  @brief      : Queue functions, implemented as macro functions, aliasing list functions.
+ *                  (Note: Dequeuing shifts all items, so it is O(n).)
+**/
+#define al_enqueue(list, data)      al_append(list, data)
+#define al_dequeue(list)            al_delete(list, 0)
+#define al_front(list)              al_get(list, 0)
+
+/**
+ *  @brief      : Initial capacity of a list (allocated on first insertion), and the factor it grows by when full.
+**/
+#define AL_INITIAL_CAPACITY         8
+#define AL_GROWTH_FACTOR            2
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : List structure. Items are stored contiguously, in 'items[0]' to 'items[length - 1]'.
+**/
+typedef struct AL_LIST {
+    DATA_TYPE *items;
+    LENGTH_DT length;
+    LENGTH_DT capacity;
+} al_list;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Create an array list (dynamically, on heap).
+ *  @param      : None.
+ *  @return     : Pointer to list.
+**/
+al_list * al_create();
+
+/**
+ *  @brief      : Get the item at an index in the list. If index is out of bounds, returns DEFAULT_VALUE stored in
+ *                  'shared_defs.h'.
+ *                  (Note: Allows negative indexing if LENGTH_DT is signed.)
+ *  @param      : [ List to search in. ]
+ *                [ Index to use. ]
+ *  @return     : Stored data.
+**/
+DATA_TYPE al_get(al_list *list, LENGTH_DT i);
+
+/**
+ *  @brief      : Replace item at an index in the list. If index is out of bounds, nothing happens.
+ *                  (Note: Allows negative indexing if LENGTH_DT is signed.)
+ *  @param      : [ List to search in. ]
+ *                [ Data to substitute. ]
+ *                [ Index to use. ]
+ *  @return     : None.
+**/
+void al_replace(al_list *list, DATA_TYPE data, LENGTH_DT i);
+
+/**
+ *  @brief      : Insert item at an index. Allows appending. If index is out of bounds, nothing happens.
+ *  @param      : [ List to work with. ]
+ *                [ Data to insert. ]
+ *                [ Index to insert at. ]
+ *  @return     : None.
+**/
+void al_insert(al_list *list, DATA_TYPE data, LENGTH_DT i);
+
+/**
+ *  @brief      : Deleting item at index. If index does not exist, nothing happens, and returns DEFAULT_VALUE.
+ *                  (Note: Allows negative indexing if LENGTH_DT is signed.)
+ *  @param      : [ List to delete from. ]
+ *                [ Index to work with. ]
+ *  @return     : Stored data.
+**/
+DATA_TYPE al_delete(al_list *list, LENGTH_DT i);
+
+/**
+ *  @brief      : Append item to list (amortised O(1)).
+ *  @param      : [ List to append to. ]
+ *                [ Data to append. ]
+ *  @return     : None.
+**/
+void al_append(al_list *list, DATA_TYPE data);
+
+/**
+ *  @brief      : Prepend item to list (O(n), shifts all items).
+ *  @param      : [ List to prepend to. ]
+ *                [ Data to prepend. ]
+ *  @return     : None.
+**/
+void al_prepend(al_list *list, DATA_TYPE data);
+
+/**
+ *  @brief      : Copy a list into a new list, in the same order, or in reverse.
+ *  @param      : [ List to copy. ]
+ *                [ Reverse flag (1 to reverse). ]
+ *  @return     : Pointer to new list.
+**/
+al_list * al_copy(al_list *list, unsigned char rev_flag);
+
+/**
+ *  @brief      : Make room for a number of items, so that inserting up to it does not re-allocate.
+ *  @param      : [ List. ]
+ *                [ Capacity (no. of items). ]
+ *  @return     : None.
+**/
+void al_reserve(al_list *list, LENGTH_DT capacity);
+
+/**
+ *  @brief      : Shrink the capacity of a list to its length, releasing unused memory.
+ *  @param      : [ List. ]
+ *  @return     : None.
+**/
+void al_shrink_to_fit(al_list *list);
+
+/**
+ *  @brief      : Delete all items in a list (the capacity is kept, for re-use).
+ *  @param      : [ List to delete all items from. ]
+ *  @return     : None.
+**/
+void al_delete_all(al_list *list);
+
+/**
+ *  @brief      : Destroy list (de-allocated off heap).
+ *                  (Note: If pointers are the data-type, they're de-allocated, and not the data they point to.)
+ *  @param      : [ List to destroy. ]
+ *  @return     : None.
+**/
+void al_destroy(al_list *list);
+
+/**
+ *  @brief      : Print a list of items.
+ *  @param      : [ List to print. ]
+ *                [ Function to be called at each item (passed each item consecutively). ]
+ *                [ Function to be called after all items have been printed (passed list and used for clean-up). ]
+ *  @return     : None.
+**/
+void al_print(al_list *list, void (*f_print)(DATA_TYPE data), void (*f_clean)(al_list *list));
+
+#endif
@@ -0,0 +1,310 @@
+/**
+ ****************************************************************
+ * @file            : avl_parallel.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of the parallel bulk operations of AVL trees (copying into an array, and
+ *                      de-allocation), split over the workers of a thread pool.
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#include "avl_parallel.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : No. of items in a subtree (0 if empty).
+**/
+#define AVL_SIZE(node)      ((node) != NULL ? (node)->size : 0)
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : (for internal use) Subtree of a tree to run a task on (copied starting at 'arr', if copying).
+**/
+typedef struct AVL_PARALLEL_TASK {
+    tp_pool *pool;
+    tp_group *group;
+    avl_tree *tree;
+    avl_node *node;
+    DATA_TYPE *arr;
+} avl_parallel_task;
+
+/* ********************* static function declaration(S) SECTION ********************** */
+
+static unsigned char avl_parallel_spawn(avl_parallel_task *parent, avl_node *node, DATA_TYPE *arr,
+                                        void (*f_run)(void *arg));
+static void avl_copy_run(void *arg);
+static void avl_free_run(void *arg);
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Copy all items of a tree into an array in order, in parallel (read '@brief' in 'avl_parallel.h').
+ *  @param      : [ Tree. ]
+ *                [ Array, of the length of the tree at least. ]
+ *                [ Pool. ]
+ *  @return     : None.
+**/
+void avl_make_array_parallel(avl_tree *tree, DATA_TYPE *arr, tp_pool *pool) {
+    tp_group group;
+    avl_parallel_task root = {pool, &group, tree, NULL, NULL};
+
+    avl_flush(tree);
+    tp_group_init(&group);
+    if (!avl_parallel_spawn(&root, tree->root, arr, avl_copy_run)) {
+        avl_make_array_subtree(tree, tree->root, arr);
+    }
+    tp_sync(pool, &group);
+}
+
+/**
+ *  @brief      : De-allocate a tree, freeing its subtrees in parallel (read '@brief' in 'avl_parallel.h').
+ *  @param      : [ Tree. ]
+ *                [ Pool. ]
+ *  @return     : None.
+**/
+void avl_destroy_parallel(avl_tree *tree, tp_pool *pool) {
+    tp_group group;
+    avl_parallel_task root = {pool, &group, tree, NULL, NULL};
+
+    if (tree->f_free == NULL && tree->allocator != NULL && tree->allocator->f_free_all != NULL) {
+        avl_destroy(tree);
+        return;
+    }
+    tp_group_init(&group);
+    if (!avl_parallel_spawn(&root, tree->root, NULL, avl_free_run)) {
+        avl_delete_subtree(tree, tree->root);
+    }
+    tp_sync(pool, &group);
+    tree->root = tree->min = tree->max = NULL;
+    tree->length = 0;
+    avl_destroy(tree);
+}
+
+/**
+ *  @brief      : (for internal use) Spawn a task on a subtree, in the group of its parent task.
+ *  @param      : [ Parent task. ]
+ *                [ Root of the subtree. ]
+ *                [ Array to copy the subtree into (NULL if not copying). ]
+ *                [ Function to run. ]
+ *  @return     : 1 if spawned, 0 if the task could not be allocated (so the caller must run it).
+**/
+static unsigned char avl_parallel_spawn(avl_parallel_task *parent, avl_node *node, DATA_TYPE *arr,
+                                        void (*f_run)(void *arg)) {
+    avl_parallel_task *task = (avl_parallel_task *) malloc(sizeof(avl_parallel_task));
+    if (task == NULL) { return 0; }
+    *task = (avl_parallel_task) {parent->pool, parent->group, parent->tree, node, arr};
+    tp_spawn(parent->pool, parent->group, f_run, task);
+    return 1;
+}
+
+/**
+ *  @brief      : (for internal use) Copy a subtree, spawning its right subtrees while they are large, and walking down
+ *                  its left spine. The items of a node follow those of its left subtree, and its right subtree follows
+ *                  all its items.
+ *  @param      : [ Task. ]
+ *  @return     : None.
+**/
+static void avl_copy_run(void *arg) {
+    avl_parallel_task *task = (avl_parallel_task *) arg;
+    avl_node *node = task->node;
+    DATA_TYPE *arr = task->arr;
+
+    while (node != NULL && node->size > AVL_PARALLEL_GRAIN) {
+        LENGTH_DT lsize = AVL_SIZE(node->lchild);
+        DATA_TYPE *rarr = arr + lsize + avl_node_items(node, arr + lsize);
+        if (node->rchild != NULL && !avl_parallel_spawn(task, node->rchild, rarr, avl_copy_run)) {
+            avl_make_array_subtree(task->tree, node->rchild, rarr);
+        }
+        node = node->lchild;
+    }
+    avl_make_array_subtree(task->tree, node, arr);
+    free(task);
+}
+
+/**
+ *  @brief      : (for internal use) De-allocate a subtree, spawning its right subtrees while they are large, and walking
+ *                  down its left spine. Each node is detached from its children before it is de-allocated.
+ *  @param      : [ Task. ]
+ *  @return     : None.
+**/
+static void avl_free_run(void *arg) {
+    avl_parallel_task *task = (avl_parallel_task *) arg;
+    avl_node *node = task->node;
+
+    while (node != NULL && node->size > AVL_PARALLEL_GRAIN) {
+        avl_node *left = node->lchild, *right = node->rchild;
+        node->lchild = node->rchild = NULL;
+        if (right != NULL && !avl_parallel_spawn(task, right, NULL, avl_free_run)) {
+            avl_delete_subtree(task->tree, right);
+        }
+        avl_delete_subtree(task->tree, node);
+        node = left;
+    }
+    avl_delete_subtree(task->tree, node);
+    free(task);
+}
+
+/* ********************* 'main' function defintion SECTION (TEST) ********************** */
+
+#ifdef _MAIN_AVL_PARALLEL_              /* compile-time switch */
+
+#include "allocator.h"
+
+/**
+ *  @brief      : No. of items, and no. of workers of the tests.
+**/
+#define T_ITEMS         200000
+#define T_WORKERS       4
+
+int f_compare3(void *new_data, void *old_data);
+unsigned char f_compare(void *new_data, void *old_data);
+avl_tree * t_build(alloc_allocator *allocator);
+
+void t_make_array(tp_pool *pool);
+void t_destroy(tp_pool *pool);
+
+int main() {
+    for (LENGTH_DT workers = 1; workers <= T_WORKERS; workers *= T_WORKERS) {
+        printf("*************** %ld WORKER(S) ***************\n", (long) workers);
+        tp_pool *pool = tp_create(workers);
+        t_make_array(pool);
+        t_destroy(pool);
+        tp_destroy(pool);
+    }
+    return 0;
+}
+
+void t_make_array(tp_pool *pool) {
+    printf("*************** TEST (MAKE ARRAY) ***************\n");
+    avl_tree *tree = t_build(NULL);
+    DATA_TYPE *arr = (DATA_TYPE *) malloc((T_ITEMS + 10) * sizeof(DATA_TYPE));
+    DATA_TYPE *expected = (DATA_TYPE *) malloc((T_ITEMS + 10) * sizeof(DATA_TYPE));
+    avl_set_buffer(tree, 64, f_compare);
+    for (long i = 0; i < 10; i++) {
+        avl_insert_buffered(tree, (void *) (i * 7));
+    }
+    avl_make_array_parallel(tree, arr, pool);
+    printf("Buffered -> length: %ld, buffered: %ld, failed: %d\n", (long) tree->length, (long) tree->buffer_length,
+            tree->failed);
+    avl_make_array(tree, expected);
+    printf("Parallel -> equal: %d\n", memcmp(arr, expected, tree->length * sizeof(DATA_TYPE)) == 0);
+    avl_destroy(tree);
+    tree = avl_create();
+    avl_make_array_parallel(tree, arr, pool);
+    printf("Empty -> length: %ld, failed: %d\n", (long) tree->length, tree->failed);
+    avl_destroy(tree);
+    free(arr);
+    free(expected);
+}
+
+void t_destroy(tp_pool *pool) {
+    printf("*************** TEST (DESTROY) ***************\n");
+    alloc_allocator *allocators[] = {NULL, alloc_cache(), alloc_create_region(1L << 24)};
+    const char *names[] = {"malloc", "cache", "region"};
+    for (int i = 0; i < 3; i++) {
+        avl_tree *tree = t_build(allocators[i]);
+        printf("%s -> length: %ld, failed: %d\n", names[i], (long) tree->length, tree->failed);
+        avl_destroy_parallel(tree, pool);
+    }
+    alloc_cache_release();
+    alloc_destroy(allocators[2]);
+}
+
+/**
+ *  @brief      : Build a tree of random items, drawn from a quarter as many values (so most nodes hold buckets).
+**/
+avl_tree * t_build(alloc_allocator *allocator) {
+    avl_tree *tree = avl_create_alloc(allocator);
+    uint64_t state = 88172645463325252ULL;
+    for (LENGTH_DT i = 0; i < T_ITEMS; i++) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        avl_insert_multi(tree, (void *) (uintptr_t) ((state >> 16) % (T_ITEMS / 4)), f_compare3);
+    }
+    return tree;
+}
+
+int f_compare3(void *new_data, void *old_data) {
+    return ((uintptr_t) new_data > (uintptr_t) old_data) - ((uintptr_t) new_data < (uintptr_t) old_data);
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return (uintptr_t) new_data < (uintptr_t) old_data;
+}
+
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_AVL_PARALLEL_             /* compile-time switch */
+
+#include <time.h>
+
+int f_compare3(void *new_data, void *old_data);
+avl_tree * build(LENGTH_DT n);
+double now();
+
+/**
+ *  @brief      : Benchmark of copying a tree into an array, and de-allocating it ('avl_make_array', 'avl_destroy'),
+ *                  against their parallel versions, at 1, 2, 4, ... workers. Keys are drawn from n / 4 values, so most
+ *                  nodes hold equal items (in buckets).
+ *                  (Usage: <max no. of workers (default: 8)> <no. of items (default: 2^22)>)
+**/
+int main(int argc, char *argv[]) {
+    LENGTH_DT max_workers = argc > 1 ? atol(argv[1]) : 8;
+    LENGTH_DT n = argc > 2 ? atol(argv[2]) : 1L << 22;
+    avl_tree *tree = build(n);
+    DATA_TYPE *arr = (DATA_TYPE *) malloc(n * sizeof(DATA_TYPE));
+    DATA_TYPE *expected = (DATA_TYPE *) malloc(n * sizeof(DATA_TYPE));
+
+    double start = now();
+    avl_make_array(tree, expected);
+    printf("%-20s %10.2f ms\n", "avl_make_array", (now() - start) * 1e3);
+    avl_destroy(tree);
+    tree = build(n);
+    start = now();
+    avl_destroy(tree);
+    printf("%-20s %10.2f ms\n", "avl_destroy", (now() - start) * 1e3);
+
+    printf("%8s %16s %16s\n", "workers", "make_array (ms)", "destroy (ms)");
+    for (LENGTH_DT workers = 1; workers <= max_workers; workers *= 2) {
+        tp_pool *pool = tp_create(workers);
+        tree = build(n);
+        start = now();
+        avl_make_array_parallel(tree, arr, pool);
+        double copy_ms = (now() - start) * 1e3;
+        int equal = memcmp(arr, expected, n * sizeof(DATA_TYPE)) == 0;
+        memset(arr, 0, n * sizeof(DATA_TYPE));
+        start = now();
+        avl_destroy_parallel(tree, pool);
+        printf("%8ld %16.2f %16.2f (equal: %d)\n", (long) workers, copy_ms, (now() - start) * 1e3, equal);
+        tp_destroy(pool);
+    }
+    free(arr);
+    free(expected);
+    return 0;
+}
+
+avl_tree * build(LENGTH_DT n) {
+    avl_tree *tree = avl_create();
+    uint64_t state = 88172645463325252ULL;
+    for (LENGTH_DT i = 0; i < n; i++) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        avl_insert_multi(tree, (void *) (uintptr_t) ((state >> 16) % (n / 4 + 1)), f_compare3);
+    }
+    return tree;
+}
+
+int f_compare3(void *new_data, void *old_data) {
+    return ((uintptr_t) new_data > (uintptr_t) old_data) - ((uintptr_t) new_data < (uintptr_t) old_data);
+}
+
+double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+#endif
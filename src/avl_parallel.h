@@ -0,0 +1,51 @@
+/**
+ ****************************************************************
+ * @file            : avl_parallel.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, and macros of the parallel bulk operations of AVL trees (copying into an array, and
+ *                      de-allocation), split over the workers of a thread pool.
+ *                      (Note: Requires C11 atomics, and POSIX threads.)
+ * **************************************************************
+ **/
+
+#ifndef _AVL_PARALLEL_H_
+#define _AVL_PARALLEL_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include "thread_pool.h"
+#include "avl_tree.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Min. no. of items of a subtree to split it into tasks (smaller subtrees are run as a single task).
+**/
+#define AVL_PARALLEL_GRAIN  4096
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Copy all items of a tree into an array in order (as 'avl_make_array'), in parallel. The subtree sizes
+ *                  give the position of each node, so subtrees are copied independently. Buffered items are inserted
+ *                  first. If a task fails to allocate its traversal stack, the tree's 'failed' flag is set, and part of
+ *                  the array is left unfilled. Must be called by the thread that created the pool (or a task on it).
+ *                  (Note: Counters of an instrumented tree are not atomic, so they may miscount.)
+ *  @param      : [ Tree. ]
+ *                [ Array, of the length of the tree at least. ]
+ *                [ Pool. ]
+ *  @return     : None.
+**/
+void avl_make_array_parallel(avl_tree *tree, DATA_TYPE *arr, tp_pool *pool);
+
+/**
+ *  @brief      : De-allocate a tree (as 'avl_destroy'), freeing its subtrees in parallel. A tree whose allocator frees
+ *                  all nodes at once is de-allocated by 'avl_destroy' alone. Must be called by the thread that created
+ *                  the pool (or a task on it), and the tree's free hook (or allocator) must be thread-safe.
+ *  @param      : [ Tree. ]
+ *                [ Pool. ]
+ *  @return     : None.
+**/
+void avl_destroy_parallel(avl_tree *tree, tp_pool *pool);
+
+#endif
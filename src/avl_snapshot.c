@@ -0,0 +1,597 @@
+/**
+ ****************************************************************
+ * @file            : avl_snapshot.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of snapshots of AVL trees (save, load, and read-only memory-mapped lookups).
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#define _POSIX_C_SOURCE 200809L                         /* for 'mmap' and 'posix_madvise' (and 'clock_gettime' in the benchmark) */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "avl_snapshot.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Size of the buffer of the file written by 'avl_save'.
+**/
+#define AVL_SNAPSHOT_BUFFER         (1 << 20)
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : (For internal use) Position of 'avl_load' in the records of a mapped file, passed to 'avl_bulk_load'.
+**/
+typedef struct AVL_SNAPSHOT_CURSOR {
+    const unsigned char *records;
+    const uint64_t *offsets;                        /* NULL if records are of fixed size */
+    size_t record_size;
+    LENGTH_DT i;                                    /* index of the next record */
+    avl_serializer *serializer;
+} avl_snapshot_cursor;
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static void * avl_snapshot_map(const char *path, size_t *map_size);
+static unsigned char avl_snapshot_check(void *map, size_t map_size);
+static DATA_TYPE avl_snapshot_next(void *arg);
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Save the items of a tree (in order) to a file. The items are copied out of the tree first (read
+ *                  '@brief' of 'avl_make_array'). The header is written, then, if records are of variable size, the
+ *                  offset of each record (computed from the sizes of all records before it), then the records.
+ *  @param      : [ Tree. ]
+ *                [ Path of file (overwritten). ]
+ *                [ Serializer. ]
+ *  @return     : 1 if saved, 0 if the file could not be written.
+**/
+unsigned char avl_save(avl_tree *tree, const char *path, avl_serializer *serializer) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        return 0;
+    }
+    setvbuf(file, NULL, _IOFBF, AVL_SNAPSHOT_BUFFER);
+
+    LENGTH_DT n = tree->length;
+    DATA_TYPE *items = (DATA_TYPE *) malloc((n + 1) * sizeof(DATA_TYPE));
+    avl_make_array(tree, items);
+
+    avl_snapshot_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, AVL_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = AVL_SNAPSHOT_VERSION;
+    header.byte_order = AVL_SNAPSHOT_BYTE_ORDER;
+    header.record_size = (uint32_t) serializer->size;
+    header.length = (uint64_t) n;
+    if (serializer->size != 0) {
+        header.data_size = (uint64_t) n * serializer->size;
+    } else {
+        for (LENGTH_DT i = 0; i < n; i++) {
+            header.data_size += serializer->f_size(items[i]);
+        }
+    }
+    fwrite(&header, sizeof(header), 1, file);
+
+    size_t capacity = serializer->size != 0 ? serializer->size : 64;
+    if (serializer->size == 0) {
+        uint64_t offset = 0;
+        for (LENGTH_DT i = 0; i < n; i++) {
+            size_t size = serializer->f_size(items[i]);
+            if (size > capacity) { capacity = size; }
+            fwrite(&offset, sizeof(offset), 1, file);
+            offset += size;
+        }
+        fwrite(&offset, sizeof(offset), 1, file);
+    }
+
+    unsigned char *record = (unsigned char *) malloc(capacity);
+    for (LENGTH_DT i = 0; i < n; i++) {
+        size_t size = serializer->size != 0 ? serializer->size : serializer->f_size(items[i]);
+        serializer->f_write(items[i], record);
+        fwrite(record, 1, size, file);
+    }
+    free(record);
+    free(items);
+
+    unsigned char saved = !ferror(file);
+    return fclose(file) == 0 && saved;
+}
+
+/**
+ *  @brief      : Load a tree from a file. The file is mapped (and read sequentially), and its records are passed, in
+ *                  order, to 'avl_bulk_load', through 'avl_snapshot_next'. The file is un-mapped thereafter.
+ *  @param      : [ Path of file. ]
+ *                [ Serializer. ]
+ *  @return     : Pointer to tree, or NULL if the file could not be read, or is not a snapshot of this version.
+**/
+avl_tree * avl_load(const char *path, avl_serializer *serializer) {
+    size_t map_size;
+    void *map = avl_snapshot_map(path, &map_size);
+    if (map == NULL) {
+        return NULL;
+    }
+    if (!avl_snapshot_check(map, map_size)) {
+        munmap(map, map_size);
+        return NULL;
+    }
+    posix_madvise(map, map_size, POSIX_MADV_SEQUENTIAL);
+
+    avl_snapshot_header *header = (avl_snapshot_header *) map;
+    avl_snapshot_cursor cursor;
+    cursor.offsets = header->record_size == 0 ? (const uint64_t *) (header + 1) : NULL;
+    cursor.records = (const unsigned char *) (header + 1) + (cursor.offsets != NULL ? (header->length + 1) * sizeof(uint64_t) : 0);
+    cursor.record_size = header->record_size;
+    cursor.i = 0;
+    cursor.serializer = serializer;
+
+    avl_tree *tree = avl_create();
+    avl_bulk_load(tree, (LENGTH_DT) header->length, avl_snapshot_next, &cursor);
+    munmap(map, map_size);
+    return tree;
+}
+
+/**
+ *  @brief      : (for internal use) Returns the item of the next record of a loaded file (see 'avl_load').
+ *  @param      : [ Cursor. ]
+ *  @return     : Item.
+**/
+static DATA_TYPE avl_snapshot_next(void *arg) {
+    avl_snapshot_cursor *cursor = (avl_snapshot_cursor *) arg;
+    LENGTH_DT i = cursor->i++;
+    if (cursor->offsets != NULL) {
+        return cursor->serializer->f_read(cursor->records + cursor->offsets[i], cursor->offsets[i + 1] - cursor->offsets[i]);
+    }
+    return cursor->serializer->f_read(cursor->records + i * cursor->record_size, cursor->record_size);
+}
+
+/**
+ *  @brief      : (for internal use) Map a file (read-only).
+ *  @param      : [ Path of file. ]
+ *                [ Pointer to store the size of the mapping in. ]
+ *  @return     : Pointer to mapping, or NULL if the file could not be mapped.
+**/
+static void * avl_snapshot_map(const char *path, size_t *map_size) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    void *map = NULL;
+
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t) sizeof(avl_snapshot_header)) {
+        *map_size = (size_t) st.st_size;
+        map = mmap(NULL, *map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) { map = NULL; }
+    }
+    close(fd);
+    return map;
+}
+
+/**
+ *  @brief      : (for internal use) Check that a mapped file is a snapshot of this version (and byte order), that it
+ *                  is large enough to hold all the records its header tells of, and that the offsets of its records
+ *                  (if of variable size) are non-decreasing, and end at the size of all records. Sizes are bounded by
+ *                  division, rather than multiplied, so that a corrupt header cannot overflow them.
+ *  @param      : [ Mapping. ]
+ *                [ Size of mapping. ]
+ *  @return     : 1 if valid, else 0.
+**/
+static unsigned char avl_snapshot_check(void *map, size_t map_size) {
+    avl_snapshot_header *header = (avl_snapshot_header *) map;
+    uint64_t available = (uint64_t) map_size - sizeof(avl_snapshot_header);
+    if (memcmp(header->magic, AVL_SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 ||
+            header->version != AVL_SNAPSHOT_VERSION || header->byte_order != AVL_SNAPSHOT_BYTE_ORDER) {
+        return 0;
+    }
+    if (header->record_size != 0) {
+        return header->length <= available / header->record_size &&
+                header->data_size == header->length * header->record_size;
+    }
+    if (header->length >= available / sizeof(uint64_t)) {
+        return 0;
+    }
+    available -= (header->length + 1) * sizeof(uint64_t);
+    const uint64_t *offsets = (const uint64_t *) (header + 1);
+    for (uint64_t i = 0; i < header->length; i++) {
+        if (offsets[i] > offsets[i + 1]) {
+            return 0;
+        }
+    }
+    return header->data_size <= available && offsets[header->length] == header->data_size;
+}
+
+/**
+ *  @brief      : Open a file as a read-only snapshot, mapping it, and locating its offsets and records.
+ *  @param      : [ Path of file. ]
+ *  @return     : Pointer to snapshot, or NULL if the file could not be mapped, or is not a snapshot of this version.
+**/
+avl_view * avl_view_open(const char *path) {
+    size_t map_size;
+    void *map = avl_snapshot_map(path, &map_size);
+    if (map == NULL) {
+        return NULL;
+    }
+    if (!avl_snapshot_check(map, map_size)) {
+        munmap(map, map_size);
+        return NULL;
+    }
+
+    avl_snapshot_header *header = (avl_snapshot_header *) map;
+    avl_view *view = (avl_view *) malloc(sizeof(avl_view));
+    view->map = map, view->map_size = map_size;
+    view->length = (LENGTH_DT) header->length;
+    view->record_size = header->record_size;
+    view->offsets = header->record_size == 0 ? (const uint64_t *) (header + 1) : NULL;
+    view->records = (const unsigned char *) (header + 1) + (view->offsets != NULL ? (header->length + 1) * sizeof(uint64_t) : 0);
+    return view;
+}
+
+/**
+ *  @brief      : Get the record at an index, through the offsets (or the fixed size) of records.
+ *  @param      : [ Snapshot. ]
+ *                [ Index. ]
+ *                [ Pointer to store the size of the record in (or NULL). ]
+ *  @return     : Pointer to record.
+**/
+DATA_TYPE avl_view_get(avl_view *view, LENGTH_DT i, size_t *size) {
+    if (i < 0) { i += view->length; }                    /* to allow reverse indexing */
+
+    if (i < 0 || i >= view->length) {
+        return DEFAULT_VALUE;
+    }
+    if (view->offsets != NULL) {
+        if (size != NULL) { *size = view->offsets[i + 1] - view->offsets[i]; }
+        return (DATA_TYPE) (view->records + view->offsets[i]);
+    }
+    if (size != NULL) { *size = view->record_size; }
+    return (DATA_TYPE) (view->records + i * view->record_size);
+}
+
+/**
+ *  @brief      : Find the record equal to a key, through binary search for the right-most record not on the right of
+ *                  the key. The key is equal to that record, if that record is not on the left of the key either
+ *                  (as in 'avl_find').
+ *  @param      : [ Snapshot. ]
+ *                [ Key. ]
+ *                [ Function that receives two records, and returns 1 if the first is on the left of the second, else 0. ]
+ *  @return     : Pointer to record.
+**/
+DATA_TYPE avl_view_find(avl_view *view, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    LENGTH_DT lo = 0, hi = view->length;
+    while (lo < hi) {
+        LENGTH_DT mid = lo + (hi - lo) / 2;
+        if (f_compare(key, avl_view_get(view, mid, NULL))) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    if (lo != 0) {
+        DATA_TYPE candidate = avl_view_get(view, lo - 1, NULL);
+        if (!f_compare(candidate, key)) {
+            return candidate;
+        }
+    }
+    return DEFAULT_VALUE;
+}
+
+/**
+ *  @brief      : Get the rank of a key, through binary search for the first record not on the left of the key.
+ *  @param      : [ Snapshot. ]
+ *                [ Key. ]
+ *                [ Function that receives two records, and returns 1 if the first is on the left of the second, else 0. ]
+ *  @return     : Rank.
+**/
+LENGTH_DT avl_view_rank(avl_view *view, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    LENGTH_DT lo = 0, hi = view->length;
+    while (lo < hi) {
+        LENGTH_DT mid = lo + (hi - lo) / 2;
+        if (f_compare(avl_view_get(view, mid, NULL), key)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ *  @brief      : Close a read-only snapshot, un-mapping its file, and de-allocating it.
+ *  @param      : [ Snapshot. ]
+ *  @return     : None.
+**/
+void avl_view_close(avl_view *view) {
+    munmap(view->map, view->map_size);
+    free(view);
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_AVL_SNAPSHOT_              /* compile-time switch */
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+unsigned char f_compare_int(void *new_data, void *old_data);
+void f_write_int(void *data, void *record);
+void * f_read_int(const void *record, size_t size);
+unsigned char f_compare_str(void *new_data, void *old_data);
+size_t f_size_str(void *data);
+void f_write_str(void *data, void *record);
+void * f_read_str(const void *record, size_t size);
+void f_print(void *data);
+
+void t_fixed();
+void t_variable();
+void t_invalid();
+const char * t_check(avl_snapshot_header *header, const uint64_t *body, size_t n_body);
+
+int main() {
+    t_fixed();
+    t_variable();
+    t_invalid();
+    return 0;
+}
+
+void t_fixed() {
+    printf("*************** TEST (FIXED-SIZE) ***************\n");
+    avl_serializer serializer = {sizeof(int), NULL, f_write_int, f_read_int};
+    avl_tree *tree = avl_create();
+    int arr_data[] = {8, 3, 12, 1, 15, 6, 10, 2, 14, 5, 9, 13, 4, 11, 7};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        avl_insert(tree, arr_data+i, f_compare_int);
+    }
+    printf("Saved: %d\n", avl_save(tree, "avl_snapshot_test.bin", &serializer));
+    avl_destroy(tree);
+
+    tree = avl_load("avl_snapshot_test.bin", &serializer);
+    avl_print(tree, f_print, 4);
+    printf("Length: %ld, height: %ld, min: %d, max: %d\n", (long) tree->length, (long) avl_height(tree),
+            *((int *) avl_min(tree)), *((int *) avl_max(tree)));
+    for (LENGTH_DT i = 0; i < tree->length; i++) {
+        free(avl_get(tree, i));
+    }
+    avl_destroy(tree);
+
+    avl_view *view = avl_view_open("avl_snapshot_test.bin");
+    int arr_key[] = {1, 0, 7, 15, 16};
+    for (int i = 0; i < LEN(arr_key); i++) {
+        void *found = avl_view_find(view, arr_key+i, f_compare_int);
+        printf("Finding: %d -> %s, rank: %ld\n", arr_key[i], found != NULL ? "found" : "not found",
+                (long) avl_view_rank(view, arr_key+i, f_compare_int));
+    }
+    printf("Getting (i=-1): %d\n", *((int *) avl_view_get(view, -1, NULL)));
+    avl_view_close(view);
+    remove("avl_snapshot_test.bin");
+}
+
+void t_variable() {
+    printf("*************** TEST (VARIABLE-SIZE) ***************\n");
+    avl_serializer serializer = {0, f_size_str, f_write_str, f_read_str};
+    avl_tree *tree = avl_create();
+    char *arr_data[] = {"pear", "fig", "banana", "apple", "kiwi", "cherry", "date"};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        avl_insert(tree, arr_data[i], f_compare_str);
+    }
+    printf("Saved: %d\n", avl_save(tree, "avl_snapshot_test.bin", &serializer));
+    avl_destroy(tree);
+
+    tree = avl_load("avl_snapshot_test.bin", &serializer);
+    for (LENGTH_DT i = 0; i < tree->length; i++) {
+        printf("%s, ", (char *) avl_get(tree, i));
+        free(avl_get(tree, i));
+    }
+    printf("\b\b \n");
+    avl_destroy(tree);
+
+    avl_view *view = avl_view_open("avl_snapshot_test.bin");
+    char *arr_key[] = {"apple", "grape", "pear", "zucchini"};
+    for (int i = 0; i < LEN(arr_key); i++) {
+        size_t size = 0;
+        LENGTH_DT rank = avl_view_rank(view, arr_key[i], f_compare_str);
+        void *found = avl_view_find(view, arr_key[i], f_compare_str);
+        avl_view_get(view, rank, &size);
+        printf("Finding: %s -> %s, rank: %ld, size at rank: %lu\n", arr_key[i], found != NULL ? "found" : "not found",
+                (long) rank, (unsigned long) size);
+    }
+    avl_view_close(view);
+    remove("avl_snapshot_test.bin");
+}
+
+void t_invalid() {
+    printf("*************** TEST (INVALID) ***************\n");
+    avl_serializer serializer = {sizeof(int), NULL, f_write_int, f_read_int};
+    FILE *file = fopen("avl_snapshot_test.bin", "wb");
+    for (int i = 0; i < 100; i++) { fputc('x', file); }
+    fclose(file);
+    printf("Load: %s, view: %s, missing: %s\n", avl_load("avl_snapshot_test.bin", &serializer) == NULL ? "rejected" : "accepted",
+            avl_view_open("avl_snapshot_test.bin") == NULL ? "rejected" : "accepted",
+            avl_view_open("avl_snapshot_missing.bin") == NULL ? "rejected" : "accepted");
+    remove("avl_snapshot_test.bin");
+
+    avl_snapshot_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, AVL_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = AVL_SNAPSHOT_VERSION;
+    header.byte_order = AVL_SNAPSHOT_BYTE_ORDER;
+    header.record_size = sizeof(int);
+    header.length = 1ULL << 62;                     /* 'length * record_size' wraps to 0 */
+    printf("Overflowing length: %s\n", t_check(&header, NULL, 0));
+    uint64_t body[] = {0, 10, 4, 0};                /* offsets of 2 records, then 4 bytes of records */
+    header.record_size = 0;
+    header.length = 2;
+    header.data_size = 4;
+    printf("Decreasing offsets: %s\n", t_check(&header, body, LEN(body)));
+    body[1] = 2;
+    printf("Increasing offsets: %s\n", t_check(&header, body, LEN(body)));
+    header.length = UINT64_MAX;                     /* '(length + 1) * 8' wraps to 0 */
+    header.data_size = 0;
+    printf("Overflowing offsets: %s\n", t_check(&header, NULL, 0));
+}
+
+/**
+ *  @brief      : Write a file of a header (and a body), and return whether it is accepted as a read-only snapshot.
+**/
+const char * t_check(avl_snapshot_header *header, const uint64_t *body, size_t n_body) {
+    FILE *file = fopen("avl_snapshot_test.bin", "wb");
+    fwrite(header, sizeof(*header), 1, file);
+    if (n_body > 0) { fwrite(body, sizeof(uint64_t), n_body, file); }
+    fclose(file);
+    avl_view *view = avl_view_open("avl_snapshot_test.bin");
+    remove("avl_snapshot_test.bin");
+    if (view == NULL) {
+        return "rejected";
+    }
+    avl_view_close(view);
+    return "accepted";
+}
+
+unsigned char f_compare_int(void *new_data, void *old_data) {
+    return *((int *) new_data) < *((int *) old_data);
+}
+
+void f_write_int(void *data, void *record) {
+    memcpy(record, data, sizeof(int));
+}
+
+void * f_read_int(const void *record, size_t size) {
+    int *data = (int *) malloc(sizeof(int));
+    memcpy(data, record, sizeof(int));
+    return data;
+}
+
+unsigned char f_compare_str(void *new_data, void *old_data) {
+    return strcmp((char *) new_data, (char *) old_data) < 0;
+}
+
+size_t f_size_str(void *data) {
+    return strlen((char *) data) + 1;
+}
+
+void f_write_str(void *data, void *record) {
+    strcpy((char *) record, (char *) data);
+}
+
+void * f_read_str(const void *record, size_t size) {
+    char *data = (char *) malloc(size);
+    memcpy(data, record, size);
+    return data;
+}
+
+void f_print(void *data) {
+    printf("%4d", *((int *) data));
+}
+
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_AVL_SNAPSHOT_             /* compile-time switch */
+
+#include <time.h>
+
+unsigned char f_compare_long(void *new_data, void *old_data);
+unsigned char f_compare_record(void *new_data, void *old_data);
+void f_write_long(void *data, void *record);
+void * f_read_long(const void *record, size_t size);
+double now();
+
+/**
+ *  @brief      : Compares rebuilding a tree by inserting each item of a file, with loading it ('avl_load'), and with
+ *                  opening it read-only ('avl_view_open'), then compares lookups in the tree and in the snapshot.
+ *                  Items are integer keys, stored in the pointers themselves (no allocation per item).
+ *                  (Usage: ./a.out [no. of items (default: 10^6)])
+**/
+int main(int argc, char **argv) {
+    LENGTH_DT n = argc > 1 ? atol(argv[1]) : 1000000;
+    LENGTH_DT n_lookups = 1000000;
+    avl_serializer serializer = {sizeof(long), NULL, f_write_long, f_read_long};
+    long sink = 0;
+
+    avl_tree *tree = avl_create();
+    uint64_t seed = 88172645463325252ull;
+    for (LENGTH_DT i = 0; i < n; i++) {
+        seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+        avl_insert(tree, (void *) (long) (seed >> 2), f_compare_long);
+    }
+    double t0 = now();
+    avl_save(tree, "avl_snapshot_bench.bin", &serializer);
+    double t_save = now() - t0;
+    avl_destroy(tree);
+
+    t0 = now();
+    avl_view *view = avl_view_open("avl_snapshot_bench.bin");
+    tree = avl_create();
+    for (LENGTH_DT i = 0; i < view->length; i++) {
+        avl_insert(tree, f_read_long(avl_view_get(view, i, NULL), sizeof(long)), f_compare_long);
+    }
+    double t_insert = now() - t0;
+    avl_view_close(view);
+    avl_destroy(tree);
+
+    t0 = now();
+    tree = avl_load("avl_snapshot_bench.bin", &serializer);
+    double t_load = now() - t0;
+
+    t0 = now();
+    view = avl_view_open("avl_snapshot_bench.bin");
+    double t_open = now() - t0;
+
+    t0 = now();
+    for (LENGTH_DT i = 0; i < n_lookups; i++) {
+        sink += (long) avl_find(tree, avl_get(tree, (i * 7919) % n), f_compare_long);
+    }
+    double t_find_tree = now() - t0;
+    t0 = now();
+    for (LENGTH_DT i = 0; i < n_lookups; i++) {
+        sink += (long) avl_view_find(view, avl_view_get(view, (i * 7919) % n, NULL), f_compare_record);
+    }
+    double t_find_view = now() - t0;
+
+    printf("Items: %ld (sink: %ld)\n", (long) n, sink & 1);
+    printf("%-28s: %10.3f ms\n", "avl_save", t_save * 1e3);
+    printf("%-28s: %10.3f ms\n", "rebuild (avl_insert each)", t_insert * 1e3);
+    printf("%-28s: %10.3f ms\n", "avl_load", t_load * 1e3);
+    printf("%-28s: %10.3f ms\n", "avl_view_open", t_open * 1e3);
+    printf("%-28s: %10.1f ns/op\n", "get + find (tree)", t_find_tree * 1e9 / n_lookups);
+    printf("%-28s: %10.1f ns/op\n", "get + find (read-only view)", t_find_view * 1e9 / n_lookups);
+
+    avl_view_close(view);
+    avl_destroy(tree);
+    remove("avl_snapshot_bench.bin");
+    return 0;
+}
+
+unsigned char f_compare_long(void *new_data, void *old_data) {
+    return (long) new_data < (long) old_data;
+}
+
+unsigned char f_compare_record(void *new_data, void *old_data) {
+    return *((long *) new_data) < *((long *) old_data);
+}
+
+void f_write_long(void *data, void *record) {
+    long key = (long) data;
+    memcpy(record, &key, sizeof(long));
+}
+
+void * f_read_long(const void *record, size_t size) {
+    long key;
+    memcpy(&key, record, sizeof(long));
+    return (void *) key;
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#endif
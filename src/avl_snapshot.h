@@ -0,0 +1,144 @@
+/**
+ ****************************************************************
+ * @file            : avl_snapshot.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the implementation of snapshots of AVL trees: a compact,
+ *                      versioned binary file of the items of a tree (in order), loaded back into a balanced tree in O(n),
+ *                      or memory-mapped and searched in place (read-only), with no de-serialization.
+ *                      (Note: Requires POSIX 'mmap'.)
+ * **************************************************************
+ **/
+
+#ifndef _AVL_SNAPSHOT_H_
+#define _AVL_SNAPSHOT_H_
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L                     /* for 'mmap' under strict C99 */
+#endif
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "shared_defs.h"
+#include "avl_tree.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Magic bytes and version of the file format. The version is incremented whenever the format changes,
+ *                  and files of other versions are rejected.
+**/
+#define AVL_SNAPSHOT_MAGIC          "AVLS"
+#define AVL_SNAPSHOT_VERSION        1
+
+/**
+ *  @brief      : Written as is, to reject files saved with another byte order.
+**/
+#define AVL_SNAPSHOT_BYTE_ORDER     0x01020304u
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Header of a snapshot file (64 bytes). It is followed by 'length + 1' offsets (8 bytes each) of the
+ *                  records, if they're of variable size, then by the records themselves, packed in order.
+ *                  (Note: Fixed-size records start at byte 64, so they're 8-byte aligned if their size is a multiple of 8.)
+**/
+typedef struct AVL_SNAPSHOT_HEADER {
+    char magic[4];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t record_size;                           /* 0 if records are of variable size */
+    uint64_t length;                                /* no. of records */
+    uint64_t data_size;                             /* no. of bytes of all records */
+    uint64_t reserved[4];
+} avl_snapshot_header;
+
+/**
+ *  @brief      : Serializer of the data-type. Records are the serialized items, and must sort (through 'f_compare' of a
+ *                  read-only snapshot) as the items do.
+**/
+typedef struct AVL_SERIALIZER {
+    size_t size;                                    /* size of every record, or 0 if of variable size (see 'f_size') */
+    size_t (*f_size)(DATA_TYPE data);               /* size of the record of an item (unused if 'size' is not 0) */
+    void (*f_write)(DATA_TYPE data, void *record);  /* writes the record of an item */
+    DATA_TYPE (*f_read)(const void *record, size_t size);   /* returns a (new) item from a record, that must not point into it */
+} avl_serializer;
+
+/**
+ *  @brief      : Read-only snapshot (a memory-mapped file). Its items are pointers to the records in the file.
+**/
+typedef struct AVL_VIEW {
+    void *map;
+    size_t map_size;
+    const unsigned char *records;
+    const uint64_t *offsets;                        /* NULL if records are of fixed size */
+    size_t record_size;
+    LENGTH_DT length;
+} avl_view;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Save the items of a tree (in order) to a file.
+ *  @param      : [ Tree. ]
+ *                [ Path of file (overwritten). ]
+ *                [ Serializer. ]
+ *  @return     : 1 if saved, 0 if the file could not be written.
+**/
+unsigned char avl_save(avl_tree *tree, const char *path, avl_serializer *serializer);
+
+/**
+ *  @brief      : Load a tree (dynamically, on heap) from a file, building it balanced in O(n).
+ *  @param      : [ Path of file. ]
+ *                [ Serializer. ]
+ *  @return     : Pointer to tree, or NULL if the file could not be read, or is not a snapshot of this version.
+**/
+avl_tree * avl_load(const char *path, avl_serializer *serializer);
+
+/**
+ *  @brief      : Open a file as a read-only snapshot (in O(1), records are only read by the lookups that visit them).
+ *  @param      : [ Path of file. ]
+ *  @return     : Pointer to snapshot, or NULL if the file could not be mapped, or is not a snapshot of this version.
+**/
+avl_view * avl_view_open(const char *path);
+
+/**
+ *  @brief      : Get the record at an index. If index out of bounds, returns DEFAULT_VALUE stored in 'shared_defs.h'.
+ *                  (Note: Allows negative indexing if LENGTH_DT is signed.)
+ *  @param      : [ Snapshot. ]
+ *                [ Index. ]
+ *                [ Pointer to store the size of the record in (or NULL). ]
+ *  @return     : Pointer to record.
+**/
+DATA_TYPE avl_view_get(avl_view *view, LENGTH_DT i, size_t *size);
+
+/**
+ *  @brief      : Find the record equal to a key (itself a record). If not found, returns DEFAULT_VALUE stored in
+ *                  'shared_defs.h'.
+ *  @param      : [ Snapshot. ]
+ *                [ Key. ]
+ *                [ Function that receives two records, and returns 1 if the first is on the left of the second, else 0. ]
+ *  @return     : Pointer to record.
+**/
+DATA_TYPE avl_view_find(avl_view *view, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Get the rank of a key (itself a record), the no. of records on its left.
+ *  @param      : [ Snapshot. ]
+ *                [ Key. ]
+ *                [ Function that receives two records, and returns 1 if the first is on the left of the second, else 0. ]
+ *  @return     : Rank.
+**/
+LENGTH_DT avl_view_rank(avl_view *view, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Close a read-only snapshot (un-mapping its file). Its records must not be used thereafter.
+ *  @param      : [ Snapshot. ]
+ *  @return     : None.
+**/
+void avl_view_close(avl_view *view);
+
+#endif
@@ -26,18 +26,148 @@
 #define LHIGH       1
 #define RHIGH       -1
 
+/**
+ *  @brief      : No. of nodes in a subtree (zero if the subtree is empty).
+**/
+#define AVL_SIZE(node)      ((node) != NULL ? (node)->size : 0)
+
+/**
+ *  @brief      : No. of items in a node (its own, and those of its bucket), and its item at an index (0 for its own).
+**/
+#define AVL_COUNT(node)     ((node)->bucket != NULL ? (node)->bucket->length + 1 : 1)
+#define AVL_ITEM(node, k)   ((k) == 0 ? (node)->data : (node)->bucket->items[(node)->bucket->start + (k) - 1])
+
+/**
+ *  @brief      : Re-computation of the size of a node from its items and children.
+**/
+#define AVL_RESIZE(node)    ((node)->size = AVL_SIZE((node)->lchild) + AVL_SIZE((node)->rchild) + AVL_COUNT(node))
+
+/**
+ *  @brief      : Initial capacity of the bucket of a node (doubled whenever full).
+**/
+#define AVL_BUCKET_CAPACITY     4
+
+/**
+ *  @brief      : Size of a bucket of a capacity, and de-allocation of a node or bucket of a size (through the set
+ *                  function, if any, else through the allocator).
+**/
+#define AVL_BUCKET_SIZE(capacity)   (sizeof(avl_bucket) + (capacity) * sizeof(DATA_TYPE))
+#define AVL_FREE(tree, ptr, size)   ((tree)->f_free != NULL ? (tree)->f_free(ptr) : ALLOC_FREE((tree)->allocator, ptr, size))
+
+/**
+ *  @brief      : All nodes of a tree may be de-allocated at once (by its allocator, with no traversal).
+**/
+#define AVL_FREE_ALL(tree)          ((tree)->f_free == NULL && (tree)->allocator != NULL && (tree)->allocator->f_free_all != NULL)
+
+/**
+ *  @brief      : Size of a node (followed by its summary, if the tree is augmented), and re-computation of the summary of
+ *                  a node from its items and children (if the tree is augmented).
+**/
+#define AVL_NODE_SIZE(tree)         (sizeof(avl_node) + ((tree)->augment != NULL ? (tree)->augment->summary_size : 0))
+#define AVL_UPDATE(tree, node)      if ((tree)->augment != NULL) { avl_summarize(tree, node); }
+
+/**
+ *  @brief      : No. of lookups traversed at once (interleaved), by the batched lookup functions.
+**/
+#define AVL_BATCH_SIZE      16
+
+/**
+ *  @brief      : Max. height of a tree built by 'avl_bulk_load' (that of a tree of 2^63 - 1 items).
+**/
+#define AVL_MAX_HEIGHT      64
+
+/**
+ *  @brief      : Hint to fetch memory into cache ahead of its use, where supported by the compiler.
+**/
+#if defined(__GNUC__) || defined(__clang__)
+#define AVL_PREFETCH(addr)  __builtin_prefetch(addr)
+#else
+#define AVL_PREFETCH(addr)  ((void) 0)
+#endif
+
+/**
+ *  @brief      : Push onto a traversal stack (or enqueue onto a traversal queue), counting it if instrumented.
+**/
+#define AVL_PUSH(tree, stack, data)         (INSTR_COUNT(tree, stack_pushes), ll_push(stack, data))
+#define AVL_ENQUEUE(tree, queue, data)      (INSTR_COUNT(tree, stack_pushes), ll_enqueue(queue, data))
+
+/**
+ *  @brief      : Merge the insert buffer into the nodes, if not empty (by functions that do not consult the buffer).
+**/
+#define AVL_FLUSH(tree)     if ((tree)->buffer_length != 0) { avl_flush(tree); }
+
+/**
+ *  @brief      : Length of a (new) unsorted tail of the insert buffer, at or below which it is sorted into the buffer
+ *                  by binary insertion, rather than by merge sort.
+**/
+#define AVL_BUFFER_INSERTION    16
+
+/**
+ *  @brief      : A flush rebuilds the tree (rather than inserting buffered items one by one) if the buffer holds at least
+ *                  1 item per 'AVL_REBUILD_RATIO' nodes. Rebuilding visits every node (and re-allocates it), so it only
+ *                  pays off for a buffer that is large relative to the tree.
+**/
+#define AVL_REBUILD_RATIO       4
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : (For internal use) Merge of the items of a tree with its (sorted) insert buffer, passed to
+ *                  'avl_bulk_load' by 'avl_flush'.
+**/
+typedef struct AVL_MERGE_CURSOR {
+    DATA_TYPE *nodes;
+    LENGTH_DT n_nodes;
+    DATA_TYPE *buffer;
+    LENGTH_DT n_buffer;
+    LENGTH_DT i;                                    /* index of the next item of 'nodes' */
+    LENGTH_DT j;                                    /* index of the next item of 'buffer' */
+    unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data);
+} avl_merge_cursor;
+
+/**
+ *  @brief      : (For internal use) Storage of a summary (aligned for any scalar it may hold).
+**/
+typedef union AVL_SUMMARY_BUFFER {
+    DATA_TYPE data;
+    long long integer;
+    double real;
+    unsigned char bytes[AVL_MAX_SUMMARY];
+} avl_summary_buffer;
+
 /* ********************* static function declaration(s) SECTION ********************** */
 
-static avl_node * avl_create_node(DATA_TYPE data);
-static avl_node * avl_get_node(avl_tree *tree, LENGTH_DT i);
-static void avl_deallocate_all(avl_tree *tree);
+static avl_node * avl_create_node(avl_tree *tree, DATA_TYPE data);
+static ll_list * avl_create_stack(avl_tree *tree);
+static unsigned char avl_stack_failed(avl_tree *tree, ll_list *stack);
+static avl_node * avl_get_node(avl_tree *tree, LENGTH_DT *i);
+static void avl_unlink_min_max(avl_tree *tree, avl_node *node);
+static void avl_deallocate_all(avl_tree *tree, avl_node *root);
+static LENGTH_DT avl_height_bfs(avl_tree *tree);
+static signed char avl_bit_length(LENGTH_DT n);
+static int avl_finger_climb(avl_tree *tree, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static int avl_retrace_insert(avl_tree *tree, avl_node **path, int depth);
+static unsigned char avl_bucket_append(avl_tree *tree, avl_node *node, DATA_TYPE data);
+static DATA_TYPE avl_bucket_remove(avl_tree *tree, avl_node *node, LENGTH_DT k);
+static void avl_summarize_items(avl_tree *tree, avl_node *node, void *summary);
+static void avl_summarize(avl_tree *tree, avl_node *node);
+static void avl_summarize_all(avl_tree *tree, avl_node *root);
+static void avl_update_path(avl_tree *tree, avl_node **path, int depth);
+static void avl_update_stack(avl_tree *tree, ll_list *stack);
+static DATA_TYPE avl_merge_next(void *arg);
+static void avl_buffer_sort(avl_tree *tree);
+static void avl_buffer_merge(DATA_TYPE *src, LENGTH_DT lo, LENGTH_DT mid, LENGTH_DT hi, DATA_TYPE *dest,
+                                unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static LENGTH_DT avl_buffer_bound(avl_tree *tree, DATA_TYPE key, unsigned char upper,
+                                    unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static LENGTH_DT avl_upper_rank(avl_tree *tree, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
 
-static avl_node * left_balance_insert(avl_node *node);
-static avl_node * left_balance_delete(avl_node *node, unsigned char *signal);
-static avl_node * right_balance_insert(avl_node *node);
-static avl_node * right_balance_delete(avl_node *node, unsigned char *signal);
-static avl_node * rotate_left(avl_node *node);
-static avl_node * rotate_right(avl_node *node);
+static avl_node * left_balance_insert(avl_tree *tree, avl_node *node);
+static avl_node * left_balance_delete(avl_tree *tree, avl_node *node, unsigned char *signal);
+static avl_node * right_balance_insert(avl_tree *tree, avl_node *node);
+static avl_node * right_balance_delete(avl_tree *tree, avl_node *node, unsigned char *signal);
+static avl_node * rotate_left(avl_tree *tree, avl_node *node);
+static avl_node * rotate_right(avl_tree *tree, avl_node *node);
 
 static void putchar_n(char c, unsigned int n);
 
@@ -49,72 +179,362 @@ static void putchar_n(char c, unsigned int n);
  *  @return     : Pointer to tree.
 **/
 avl_tree * avl_create() {
+    return avl_create_alloc(NULL);
+}
+
+/**
+ *  @brief      : Create (dynamically, on heap) and intialize an AVL tree, whose nodes are allocated through an allocator,
+ *                  and return a pointer to it. Without an allocator, nodes are de-allocated by 'free' (as set by
+ *                  'avl_set_free'), else by the allocator.
+ *  @param      : [ Allocator (NULL for 'malloc'). ]
+ *  @return     : Pointer to tree (NULL on failure).
+**/
+avl_tree * avl_create_alloc(alloc_allocator *allocator) {
+    return avl_create_augmented(NULL, allocator);
+}
+
+/**
+ *  @brief      : Create (dynamically, on heap) and intialize an AVL tree, whose nodes each keep a summary of their
+ *                  subtree (if augmented), and return a pointer to it. Each node is allocated with room for its summary
+ *                  after it (read '@brief' of 'avl_summarize').
+ *  @param      : [ Augmentation (NULL for none). ]
+ *                [ Allocator (NULL for 'malloc'). ]
+ *  @return     : Pointer to tree (NULL on failure).
+**/
+avl_tree * avl_create_augmented(const avl_augment *augment, alloc_allocator *allocator) {
+    if (augment != NULL && augment->summary_size > AVL_MAX_SUMMARY) {
+        return NULL;
+    }
     avl_tree *new_tree = (avl_tree *) malloc(sizeof(avl_tree));
-    new_tree->length = 0, new_tree->root = NULL;
+    if (new_tree != NULL) {
+        new_tree->length = 0, new_tree->root = NULL;
+        new_tree->min = new_tree->max = NULL;
+        new_tree->f_free = allocator == NULL ? free : NULL;
+        new_tree->allocator = allocator;
+        new_tree->failed = 0;
+        new_tree->unbalanced = 0;
+        new_tree->buffer = NULL;
+        new_tree->buffer_length = new_tree->buffer_capacity = new_tree->buffer_sorted = 0;
+        new_tree->f_buffer_compare = NULL;
+        new_tree->finger = NULL, new_tree->finger_depth = 0;
+        new_tree->augment = augment;
+        INSTR_INIT(new_tree);
+    }
     return new_tree;
 }
 
 /**
- *  @brief      : (internal use only) Create a node (dynamically, on heap) and initialize it with data, etc, 
- *                  then return pointer to it.
- *  @param      : [ Data to store. ]
- *  @return     : Pointer to node.
+ *  @brief      : Set the function that de-allocates the nodes deleted from a tree.
+ *  @param      : [ Tree. ]
+ *                [ Function that receives a node, and de-allocates it. ]
+ *  @return     : None.
+**/
+void avl_set_free(avl_tree *tree, void (*f_free)(void *node)) {
+    tree->f_free = f_free;
+}
+
+/**
+ *  @brief      : (internal use only) Create a node (dynamically, through the allocator of a tree) and initialize it
+ *                  with data, etc, then return pointer to it. If the allocation fails, the tree is marked as failed.
+ *  @param      : [ Tree. ]
+ *                [ Data to store. ]
+ *  @return     : Pointer to node (NULL on failure).
 **/
-static avl_node * avl_create_node(DATA_TYPE data) {
-    avl_node *new_node = (avl_node *) malloc(sizeof(avl_node));
+static avl_node * avl_create_node(avl_tree *tree, DATA_TYPE data) {
+    avl_node *new_node = (avl_node *) ALLOC_ALLOC(tree->allocator, AVL_NODE_SIZE(tree));
+    if (new_node == NULL) {
+        tree->failed = 1;
+        return NULL;
+    }
     new_node->rchild = new_node->lchild = NULL;
-    new_node->balance = 0, new_node->data = data;
+    new_node->balance = 0, new_node->data = data, new_node->size = 1;
+    new_node->bucket = NULL;
     return new_node;
 }
 
+/**
+ *  @brief      : (for internal use) Create a traversal stack. If the allocation fails, the tree is marked as failed.
+ *  @param      : [ Tree. ]
+ *  @return     : Pointer to stack (NULL on failure).
+**/
+static ll_list * avl_create_stack(avl_tree *tree) {
+    ll_list *stack = ll_create();
+    if (stack == NULL) {
+        tree->failed = 1;
+    }
+    return stack;
+}
+
+/**
+ *  @brief      : (for internal use) Check whether a push onto a traversal stack failed (so the path on it is not
+ *                  whole), marking the tree as failed if so. Callers check it before modifying the tree.
+ *  @param      : [ Tree. ]
+ *                [ Stack. ]
+ *  @return     : 1 if a push failed, else 0.
+**/
+static unsigned char avl_stack_failed(avl_tree *tree, ll_list *stack) {
+    if (stack->failed) {
+        tree->failed = 1;
+    }
+    return stack->failed;
+}
+
 /**
  *  @brief      : Returns data stored at a specific index. If the index is out of bounds, returns DEFAULT_VALUE
- *                  set in the header file. Utilizes 'avl_get_node' function.
+ *                  set in the header file. Utilizes 'avl_get_node' function. If items are buffered, the buffer is sorted,
+ *                  and the buffered item at index 'j' is at index 'j' plus the no. of nodes not on its right (buffered
+ *                  items follow equal ones in nodes). Those indices increase with 'j', so the no. of buffered items
+ *                  at or before the index is found by binary search. If the last of them is not at the index itself,
+ *                  the node at the index, less their no., is returned.
  *  @param      : [ Tree. ]
  *                [ Index. ]
  *  @return     : Data stored.
 **/
 DATA_TYPE avl_get(avl_tree *tree, LENGTH_DT i) {
+    DATA_TYPE data = DEFAULT_VALUE;
+    avl_node *node = NULL;
+    INSTR_ENTER(tree);
     if (i < 0) { i += tree->length; }                    /* to allow reverse indexing */
 
-    avl_node *node = avl_get_node(tree, i);
+    if (tree->buffer_length != 0 && i >= 0 && i < tree->length) {
+        LENGTH_DT lo = 0, hi = tree->buffer_length;
+        avl_buffer_sort(tree);
+        while (lo < hi) {
+            LENGTH_DT mid = lo + (hi - lo) / 2;
+            if (mid + avl_upper_rank(tree, tree->buffer[mid], tree->f_buffer_compare) <= i) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo != 0 && lo - 1 + avl_upper_rank(tree, tree->buffer[lo - 1], tree->f_buffer_compare) == i) {
+            data = tree->buffer[lo - 1];
+        } else {
+            i -= lo;
+            node = avl_get_node(tree, &i);
+        }
+    } else {
+        node = avl_get_node(tree, &i);
+    }
     if (node != NULL) {
-        return node->data;
+        data = AVL_ITEM(node, i);
     }
-    return DEFAULT_VALUE;
+    INSTR_EXIT(tree);
+    return data;
 }
 
 /**
- *  @brief      : (for internal use) Returns a node at a specific index. If the index is out of bounds, returns NULL.
- *                  In-order traversal is performed using a stack (iterative solution, not recursive. The left-child 
- *                  of the current element is continously pushed onto the stack, and set as the current element, until 
- *                  the current element is NULL. In that case, an item is popped, consumed (i++), and then its right-child
- *                  is set as the current element. The process then repeats while the current element is not NULL, or
- *                  the stack is not empty.
- *  @param      : [ Tree, ] 
- *                [ Index. ]
+ *  @brief      : (for internal use) Returns the node holding the item at a specific index, and sets the index to that of
+ *                  the item within the node. If the index is out of bounds, returns NULL. The size of the left subtree
+ *                  of the current node is the index of the current node's (first) item within its subtree. If the index
+ *                  is smaller, the left child is set as the current node, if within the items of the current node, the
+ *                  current node is returned, and if larger, the index is reduced by the size of the left subtree plus
+ *                  the no. of items of the node, and the right child is set as the current node.
+ *  @param      : [ Tree, ]
+ *                [ Pointer to index. ]
  *  @return     : Pointer to node.
 **/
-static avl_node * avl_get_node(avl_tree *tree, LENGTH_DT i) {
-    ll_list *stack = ll_create();
-    LENGTH_DT j = 0;
-    avl_node *node = NULL;
+static avl_node * avl_get_node(avl_tree *tree, LENGTH_DT *i) {
     avl_node *curr_node = tree->root;
 
-    while (curr_node != NULL || stack->length != 0) {
-        while (curr_node != NULL) {
-            ll_push(stack, curr_node);
+    while (curr_node != NULL) {
+        LENGTH_DT lsize = AVL_SIZE(curr_node->lchild);
+        INSTR_PATH(tree);
+        if (*i < lsize) {
             curr_node = curr_node->lchild;
-        }
-        curr_node = ll_pop(stack);
-        if (j++ == i) {
-            node = curr_node;
+        } else if (*i < lsize + AVL_COUNT(curr_node)) {
+            *i -= lsize;
             break;
+        } else {
+            *i -= lsize + AVL_COUNT(curr_node);
+            curr_node = curr_node->rchild;
         }
-        curr_node = curr_node->rchild;
     }
-    ll_destroy(stack);
-    return node;
+    return curr_node;
+}
+
+/**
+ *  @brief      : Returns data stored at many indices. Lookups are traversed in groups (of 'AVL_BATCH_SIZE'), one level
+ *                  at a time for all lookups of the group, while prefetching the next node of each, so that the
+ *                  (independent) cache misses of a group overlap. Each lookup follows the steps of 'avl_get_node'.
+ *                  If an index is out of bounds, its result is DEFAULT_VALUE set in the header file.
+ *                  (Note: Allows negative indexing if LENGTH_DT is signed.)
+ *  @param      : [ Tree. ]
+ *                [ Array of indices. ]
+ *                [ No. of indices. ]
+ *                [ Array to store results in (one per index). ]
+ *  @return     : None.
+**/
+void avl_get_many(avl_tree *tree, LENGTH_DT *indices, LENGTH_DT n, DATA_TYPE *results) {
+    avl_node *curr_node[AVL_BATCH_SIZE];
+    LENGTH_DT i[AVL_BATCH_SIZE];
+
+    INSTR_ENTER(tree);
+    AVL_FLUSH(tree);
+    for (LENGTH_DT base = 0; base < n; base += AVL_BATCH_SIZE) {
+        int width = n - base < AVL_BATCH_SIZE ? (int) (n - base) : AVL_BATCH_SIZE;
+        int active = 0;
+        for (int k = 0; k < width; k++) {
+            i[k] = indices[base + k];
+            if (i[k] < 0) { i[k] += tree->length; }          /* to allow reverse indexing */
+            curr_node[k] = (i[k] >= 0 && i[k] < tree->length) ? tree->root : NULL;
+            results[base + k] = DEFAULT_VALUE;
+            active += curr_node[k] != NULL;
+        }
+        while (active != 0) {
+            active = 0;
+            for (int k = 0; k < width; k++) {
+                if (curr_node[k] != NULL) {
+                    LENGTH_DT lsize = AVL_SIZE(curr_node[k]->lchild);
+                    INSTR_PATH(tree);
+                    if (i[k] < lsize) {
+                        curr_node[k] = curr_node[k]->lchild;
+                    } else if (i[k] < lsize + AVL_COUNT(curr_node[k])) {
+                        results[base + k] = AVL_ITEM(curr_node[k], i[k] - lsize);
+                        curr_node[k] = NULL;
+                        continue;
+                    } else {
+                        i[k] -= lsize + AVL_COUNT(curr_node[k]);
+                        curr_node[k] = curr_node[k]->rchild;
+                    }
+                    AVL_PREFETCH(curr_node[k]);
+                    active++;
+                }
+            }
+        }
+    }
+    INSTR_EXIT(tree);
+}
+
+/**
+ *  @brief      : Finds data equal to a key. The tree is traversed like a sorted binary tree, while remembering the last
+ *                  node that the key is not on the left of (the right-most node not larger than the key). The key is
+ *                  equal to that node's data, if that data is not on the left of the key either. If not found, the
+ *                  (sorted) insert buffer is binary searched the same way. If not found, returns DEFAULT_VALUE set in
+ *                  the header file.
+ *                  (Note: For information on 'f_compare', read '@brief' of 'avl_insert_unbalanced'.)
+ *  @param      : [ Tree. ]
+ *                [ Key to find. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE avl_find(avl_tree *tree, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    avl_node *curr_node = tree->root;
+    avl_node *candidate = NULL;
+    DATA_TYPE data = DEFAULT_VALUE;
+
+    INSTR_ENTER(tree);
+    while (curr_node != NULL) {
+        INSTR_PATH(tree);
+        if (INSTR_COMPARE(tree, f_compare(key, curr_node->data))) {
+            curr_node = curr_node->lchild;
+        } else {
+            candidate = curr_node;
+            curr_node = curr_node->rchild;
+        }
+    }
+    if (candidate != NULL && !INSTR_COMPARE(tree, f_compare(candidate->data, key))) {
+        data = candidate->data;
+    } else if (tree->buffer_length != 0) {
+        avl_buffer_sort(tree);
+        LENGTH_DT j = avl_buffer_bound(tree, key, 0, f_compare);
+        if (j < tree->buffer_length && !INSTR_COMPARE(tree, f_compare(key, tree->buffer[j]))) {
+            data = tree->buffer[j];
+        }
+    }
+    INSTR_EXIT(tree);
+    return data;
+}
+
+/**
+ *  @brief      : Finds data equal to each of many keys. Lookups are traversed in groups (of 'AVL_BATCH_SIZE'), one level
+ *                  at a time for all lookups of the group, so that their (independent) cache misses overlap. At each
+ *                  level, the data of each group's current nodes is prefetched first (nodes were prefetched in the
+ *                  previous level), then each lookup is advanced, following the steps of 'avl_find', and its next
+ *                  node is prefetched.
+ *                  (Note: For information on 'f_compare', read '@brief' of 'avl_insert_unbalanced'.)
+ *  @param      : [ Tree. ]
+ *                [ Array of keys. ]
+ *                [ No. of keys. ]
+ *                [ Array to store results in (one per key). ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : None.
+**/
+void avl_find_many(avl_tree *tree, DATA_TYPE *keys, LENGTH_DT n, DATA_TYPE *results,
+                    unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    avl_node *curr_node[AVL_BATCH_SIZE];
+    avl_node *candidate[AVL_BATCH_SIZE];
+
+    INSTR_ENTER(tree);
+    AVL_FLUSH(tree);
+    for (LENGTH_DT base = 0; base < n; base += AVL_BATCH_SIZE) {
+        int width = n - base < AVL_BATCH_SIZE ? (int) (n - base) : AVL_BATCH_SIZE;
+        int active = tree->root != NULL ? width : 0;
+        for (int k = 0; k < width; k++) {
+            curr_node[k] = tree->root;
+            candidate[k] = NULL;
+        }
+        while (active != 0) {
+            for (int k = 0; k < width; k++) {
+                if (curr_node[k] != NULL) { AVL_PREFETCH(curr_node[k]->data); }
+            }
+            active = 0;
+            for (int k = 0; k < width; k++) {
+                if (curr_node[k] != NULL) {
+                    INSTR_PATH(tree);
+                    if (INSTR_COMPARE(tree, f_compare(keys[base + k], curr_node[k]->data))) {
+                        curr_node[k] = curr_node[k]->lchild;
+                    } else {
+                        candidate[k] = curr_node[k];
+                        curr_node[k] = curr_node[k]->rchild;
+                    }
+                    if (curr_node[k] != NULL) {
+                        AVL_PREFETCH(curr_node[k]);
+                        active++;
+                    }
+                }
+            }
+        }
+        for (int k = 0; k < width; k++) {
+            if (candidate[k] != NULL && !INSTR_COMPARE(tree, f_compare(candidate[k]->data, keys[base + k]))) {
+                results[base + k] = candidate[k]->data;
+            } else {
+                results[base + k] = DEFAULT_VALUE;
+            }
+        }
+    }
+    INSTR_EXIT(tree);
+}
+
+/**
+ *  @brief      : Get the rank of a key, descending from the root. Whenever an item is on the left of the key, it and its
+ *                  left subtree (of a known size) are counted, and the traversal goes right, else it goes left. The
+ *                  buffered items on the left of the key are counted by binary search (of the sorted insert buffer).
+ *  @param      : [ Tree. ]
+ *                [ Key. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : Rank.
+**/
+LENGTH_DT avl_rank(avl_tree *tree, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    avl_node *curr_node = tree->root;
+    LENGTH_DT rank = 0;
+
+    INSTR_ENTER(tree);
+    while (curr_node != NULL) {
+        INSTR_PATH(tree);
+        if (INSTR_COMPARE(tree, f_compare(curr_node->data, key))) {
+            rank += AVL_SIZE(curr_node->lchild) + AVL_COUNT(curr_node);
+            curr_node = curr_node->rchild;
+        } else {
+            curr_node = curr_node->lchild;
+        }
+    }
+    if (tree->buffer_length != 0) {
+        avl_buffer_sort(tree);
+        rank += avl_buffer_bound(tree, key, 0, f_compare);
+    }
+    INSTR_EXIT(tree);
+    return rank;
 }
 
 /**
@@ -122,31 +542,65 @@ static avl_node * avl_get_node(avl_tree *tree, LENGTH_DT i) {
  *                  until a node is NULL. Then sets it to the new node, containing the data. A function must be passed
  *                  as a parameter. During the traversal, the function is called on the new data, and the data of the
  *                  node currently being traversed. The function should return '1' if the new data resides on the left
- *                  of the traverse node, and '0' if it resides on the right of.
+ *                  of the traverse node, and '0' if it resides on the right of. If the tree is augmented, the pointers
+ *                  to the nodes traversed are pushed onto a stack, and their summaries recomputed once it is linked
+ *                  (read '@brief' of 'avl_update_stack'). If the stack cannot be allocated, the increments of sizes
+ *                  are undone (by traversing again), and the tree is left unchanged.
  *  @param      : [ Tree. ]
  *                [ Data to insert. ]
  *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
  *  @return     : None.
 **/
 void avl_insert_unbalanced(avl_tree *tree, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
-    avl_node *new_node = avl_create_node(data);
+    INSTR_ENTER(tree);
+    ll_list *stack = tree->augment != NULL ? avl_create_stack(tree) : NULL;
+    avl_node *new_node = tree->augment == NULL || stack != NULL ? avl_create_node(tree, data) : NULL;
     avl_node **parent = &tree->root;
-    while (*parent != NULL) {
-        if (f_compare(new_node->data, (*parent)->data)) {
-            parent = &(*parent)->lchild;
+    unsigned char is_min = 1, is_max = 1;
+    if (new_node != NULL) {
+        INSTR_COUNT(tree, allocs);
+        while (*parent != NULL) {
+            (*parent)->size++;
+            INSTR_PATH(tree);
+            if (stack != NULL) { AVL_PUSH(tree, stack, (void *) parent); }
+            if (INSTR_COMPARE(tree, f_compare(new_node->data, (*parent)->data))) {
+                parent = &(*parent)->lchild;
+                is_max = 0;
+            } else {
+                parent = &(*parent)->rchild;
+                is_min = 0;
+            }
+        }
+        if (stack != NULL && avl_stack_failed(tree, stack)) {
+            for (avl_node *node = tree->root; node != NULL; ) {         /* undo the increments of sizes */
+                node->size--;
+                node = f_compare(data, node->data) ? node->lchild : node->rchild;
+            }
+            AVL_FREE(tree, new_node, AVL_NODE_SIZE(tree));
+            INSTR_COUNT(tree, frees);
         } else {
-            parent = &(*parent)->rchild;
+            AVL_UPDATE(tree, new_node);
+            *parent = new_node;
+            if (stack != NULL) { avl_update_stack(tree, stack); }
+            if (is_min) { tree->min = new_node; }
+            if (is_max) { tree->max = new_node; }
+            tree->length++;
+            tree->unbalanced = 1;
+            tree->finger_depth = 0;
         }
     }
-    *parent = new_node;
-    tree->length++;
+    if (stack != NULL) { ll_destroy(stack); }
+    INSTR_EXIT(tree);
 }
 
 /**
  *  @brief      : Inserts a new data into the tree, balancing the tree thereafter (AVL BST style). A stack is used to
  *                  store each node along the traversal path, following the way of a sorted binary tree. Items are
- *                  then continously popped off (along with the encoded direction of traversal), and adjusted
- *                  based on the AVL insertion algorithm.
+ *                  then continously popped off (along with the encoded direction of traversal), their sizes
+ *                  incremented, and adjusted based on the AVL insertion algorithm. Nothing is modified on the way down,
+ *                  so if the stack (or the node) cannot be allocated, the tree is left unchanged. If the tree is
+ *                  augmented, the summary of each popped node is recomputed once its child is linked (before it is
+ *                  re-balanced).
  *                  (Note: AVL insertion algorithm is complex, and demands a reference to understand.)
  *                  (Note: For information on 'f_compare', read '@brief' of 'avl_insert_unbalanced'.)
  *  @param      : [ Tree. ]
@@ -156,228 +610,1199 @@ void avl_insert_unbalanced(avl_tree *tree, DATA_TYPE data, unsigned char (*f_com
 **/
 void avl_insert(avl_tree *tree, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
     unsigned int signal = 1;
+    unsigned char is_min = 1, is_max = 1;
     avl_node *curr_node = tree->root;
     avl_node *prev_node = NULL;
-    ll_list *stack = ll_create();
+    avl_node *new_node = NULL;
 
-    while (curr_node != NULL) {
-        ll_push(stack, (void *) curr_node);
-        if (f_compare(data, curr_node->data)) {
-            ll_push(stack, LEFT);
-            curr_node = curr_node->lchild;
+    INSTR_ENTER(tree);
+    ll_list *stack = avl_create_stack(tree);
+    if (stack != NULL) {
+        while (curr_node != NULL) {
+            AVL_PUSH(tree, stack, (void *) curr_node);
+            INSTR_PATH(tree);
+            if (INSTR_COMPARE(tree, f_compare(data, curr_node->data))) {
+                AVL_PUSH(tree, stack, LEFT);
+                curr_node = curr_node->lchild;
+                is_max = 0;
+            } else {
+                AVL_PUSH(tree, stack, RIGHT);
+                curr_node = curr_node->rchild;
+                is_min = 0;
+            }
+        }
+        if (!avl_stack_failed(tree, stack)) {
+            new_node = avl_create_node(tree, data);
+        }
+    }
+    if (new_node != NULL) {
+        curr_node = new_node;
+        AVL_UPDATE(tree, curr_node);
+        INSTR_COUNT(tree, allocs);
+        if (is_min) { tree->min = curr_node; }
+        if (is_max) { tree->max = curr_node; }
+
+        while (stack->length != 0) {
+            void * left_or_right = ll_pop(stack);
+            prev_node = ll_pop(stack);
+            prev_node->size++;
+            if (left_or_right == LEFT) {
+                prev_node->lchild = curr_node;
+                AVL_UPDATE(tree, prev_node);
+                if (signal) {
+                    if (prev_node->balance == RHIGH) {
+                        prev_node->balance = BAL;
+                        signal = 0;
+                    } else if (prev_node->balance == BAL) {
+                        prev_node->balance = LHIGH;
+                    } else {
+                        prev_node = left_balance_insert(tree, prev_node);          /* 2x LHIGH */
+                        signal = 0;
+                    }
+                }
+            } else {
+                prev_node->rchild = curr_node;
+                AVL_UPDATE(tree, prev_node);
+                if (signal) {
+                    if (prev_node->balance == LHIGH) {
+                        prev_node->balance = BAL;
+                        signal = 0;
+                    } else if (prev_node->balance == BAL) {
+                        prev_node->balance = RHIGH;
+                    } else {
+                        prev_node = right_balance_insert(tree, prev_node);          /* 2x RHIGH */
+                        signal = 0;
+                    }
+                }
+            }
+            curr_node = prev_node;
+        }
+
+        tree->root = curr_node;
+        tree->length++;
+        tree->finger_depth = 0;
+    }
+    if (stack != NULL) { ll_destroy(stack); }
+    INSTR_EXIT(tree);
+}
+
+/**
+ *  @brief      : Inserts a new data into the tree, like 'avl_insert', but starts from a finger: the path from the root to
+ *                  the last node inserted by this function (kept in an array of 'AVL_MAX_HEIGHT' nodes, allocated once).
+ *                  If the new data goes on the right of the max, the finger is set to the right spine (with no
+ *                  comparisons), and the data is linked as the right child of the max. Otherwise, the finger is climbed
+ *                  until the data is within the range of its subtree (read '@brief' of 'avl_finger_climb'), and the
+ *                  descent resumes from there. Since the path is known, sizes are incremented, and balances retraced,
+ *                  with no further comparisons. A rotation replaces the node it is applied to, so the finger is cut
+ *                  above it (only nodes above it remain ancestors of the new node).
+ *                  (Note: The height of a balanced tree never nears 'AVL_MAX_HEIGHT', but that of an unbalanced one may,
+ *                  so, once modified by an unbalanced function, data is inserted by 'avl_insert' instead, as it is if
+ *                  the finger cannot be allocated.)
+ *  @param      : [ Tree. ]
+ *                [ Data to insert. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : None.
+**/
+void avl_insert_finger(avl_tree *tree, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    avl_node *child;
+
+    INSTR_ENTER(tree);
+    if (tree->finger == NULL) {
+        tree->finger = (avl_node **) malloc(AVL_MAX_HEIGHT * sizeof(avl_node *));
+    }
+    if (tree->unbalanced || tree->finger == NULL) {
+        avl_insert(tree, data, f_compare);
+    } else if ((child = avl_create_node(tree, data)) != NULL) {
+        avl_node **parent_ptr = &tree->root;
+        int depth = tree->finger_depth;
+        avl_node **finger = tree->finger;
+
+        if (tree->max != NULL && !INSTR_COMPARE(tree, f_compare(data, tree->max->data))) {      /* append at max */
+            if (depth == 0 || finger[depth - 1] != tree->max) {
+                depth = 0;
+                for (avl_node *node = tree->root; node != NULL; node = node->rchild) {
+                    finger[depth++] = node;
+                    INSTR_COUNT(tree, stack_pushes);
+                }
+            }
+            parent_ptr = &tree->max->rchild;
         } else {
-            ll_push(stack, RIGHT);
-            curr_node = curr_node->rchild;
+            if (depth != 0) {
+                depth = avl_finger_climb(tree, data, f_compare) + 1;
+                avl_node *node = finger[depth - 1];
+                INSTR_PATH(tree);
+                parent_ptr = INSTR_COMPARE(tree, f_compare(data, node->data)) ? &node->lchild : &node->rchild;
+            }
+            while (*parent_ptr != NULL) {
+                avl_node *node = *parent_ptr;
+                finger[depth++] = node;
+                INSTR_COUNT(tree, stack_pushes);
+                INSTR_PATH(tree);
+                parent_ptr = INSTR_COMPARE(tree, f_compare(data, node->data)) ? &node->lchild : &node->rchild;
+            }
         }
+
+        INSTR_COUNT(tree, allocs);
+        if (tree->min == NULL || parent_ptr == &tree->min->lchild) { tree->min = child; }
+        if (tree->max == NULL || parent_ptr == &tree->max->rchild) { tree->max = child; }
+        AVL_UPDATE(tree, child);
+        *parent_ptr = child;
+        for (int t = 0; t < depth; t++) {
+            finger[t]->size++;
+        }
+
+        finger[depth] = child;
+        tree->finger_depth = avl_retrace_insert(tree, finger, depth);
+        tree->length++;
     }
+    INSTR_EXIT(tree);
+}
 
-    curr_node = avl_create_node(data);
+/**
+ *  @brief      : (for internal use) Retraces the path of a new node (from its parent up), updating balances, and
+ *                  re-balancing at most one node, as in 'avl_insert'. The side of the child is known by comparing it to
+ *                  the node's left child, and the parent's pointer to a node by comparing the node to the parent's left
+ *                  child, so the path holds nodes only. If the tree is augmented, the summary of each node is recomputed
+ *                  (before it is re-balanced), including those above the node where retracing stops.
+ *  @param      : [ Tree. ]
+ *                [ Path (from the root) to the new node. ]
+ *                [ Depth of the new node (so, index of it in the path). ]
+ *  @return     : No. of nodes at the start of the path that are still ancestors of the new node (or the node itself), so
+ *                  all, unless a node was rotated.
+**/
+static int avl_retrace_insert(avl_tree *tree, avl_node **path, int depth) {
+    avl_node *child = path[depth];
+    int valid = depth + 1, t;
 
-    while (stack->length != 0) {
-        void * left_or_right = ll_pop(stack);
-        prev_node = ll_pop(stack);
-        if (left_or_right == LEFT) {
-            prev_node->lchild = curr_node;
-            if (signal) {
-                if (prev_node->balance == RHIGH) {
-                    prev_node->balance = BAL;
-                    signal = 0;
-                } else if (prev_node->balance == BAL) {
-                    prev_node->balance = LHIGH;
+    for (t = depth - 1; t >= 0; t--) {
+        avl_node *node = path[t];
+        avl_node **node_ptr = t == 0 ? &tree->root
+                                : (path[t - 1]->lchild == node ? &path[t - 1]->lchild : &path[t - 1]->rchild);
+        AVL_UPDATE(tree, node);
+        if (node->lchild == child) {
+            if (node->balance == RHIGH) {
+                node->balance = BAL;
+                break;
+            } else if (node->balance == BAL) {
+                node->balance = LHIGH;
+            } else {
+                *node_ptr = left_balance_insert(tree, node);          /* 2x LHIGH */
+                valid = t;
+                break;
+            }
+        } else {
+            if (node->balance == LHIGH) {
+                node->balance = BAL;
+                break;
+            } else if (node->balance == BAL) {
+                node->balance = RHIGH;
+            } else {
+                *node_ptr = right_balance_insert(tree, node);         /* 2x RHIGH */
+                valid = t;
+                break;
+            }
+        }
+        child = node;
+    }
+    avl_update_path(tree, path, t);
+    return valid;
+}
+
+/**
+ *  @brief      : (for internal use) Climbs the finger of a tree (from its deepest node), until new data is within the
+ *                  range of the subtree of the current node. The range of a subtree is bounded by its nearest ancestor
+ *                  it is on the right of (lower bound), and its nearest ancestor it is on the left of (upper bound), and
+ *                  it only widens while climbing. So, each bound is compared once it is met, and a bound that does not
+ *                  hold moves the current node up to it (and the data is then known to be on its side of it).
+ *                  Comparisons are thus proportional to the climb, not the depth.
+ *  @param      : [ Tree (with a non-empty finger). ]
+ *                [ Data to insert. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : Depth (in the finger) of the node.
+**/
+static int avl_finger_climb(avl_tree *tree, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    avl_node **finger = tree->finger;
+    int k = tree->finger_depth - 1;
+    unsigned char low = 0, high = 0;                /* set once the nearest lower (upper) bound of the subtree at 'k' holds */
+
+    for (int i = k; i > 0 && !(low && high); i--) {
+        avl_node *parent = finger[i - 1];
+        INSTR_PATH(tree);
+        if (parent->lchild == finger[i]) {
+            if (!high) {
+                if (INSTR_COMPARE(tree, f_compare(data, parent->data))) {
+                    high = 1;
                 } else {
-                    prev_node = left_balance_insert(prev_node);          /* 2x LHIGH */
-                    signal = 0;
+                    k = i - 1, low = 1, high = 0;
                 }
             }
         } else {
-            prev_node->rchild = curr_node;
-            if (signal) {
-                if (prev_node->balance == LHIGH) {
-                    prev_node->balance = BAL;
-                    signal = 0;
-                } else if (prev_node->balance == BAL) {
-                    prev_node->balance = RHIGH;
+            if (!low) {
+                if (!INSTR_COMPARE(tree, f_compare(data, parent->data))) {
+                    low = 1;
                 } else {
-                    prev_node = right_balance_insert(prev_node);          /* 2x RHIGH */
-                    signal = 0;
+                    k = i - 1, low = 0, high = 1;
                 }
             }
         }
-        curr_node = prev_node;
     }
+    return k;
+}
 
-    tree->root = curr_node;
-    tree->length++;
-    ll_destroy(stack);
+/**
+ *  @brief      : Inserts a new data into the tree, keeping equal items in one node. The tree is traversed from the root
+ *                  (incrementing the size of each node, since an item is added either way), keeping the path in an
+ *                  array (read '@brief' of 'avl_insert_finger'), until a node equal to the data is found, or a leaf is
+ *                  reached. If equal, the data is appended to the node's bucket (read '@brief' of 'avl_bucket_append'),
+ *                  and the shape of the tree is unchanged. Else, a node is linked, and the path is retraced. If the node
+ *                  (or bucket, or stack) cannot be allocated, the sizes are restored by descending again. If the tree
+ *                  is augmented, the summaries along the path are recomputed (read '@brief' of 'avl_retrace_insert').
+ *                  (Note: Once modified by an unbalanced function, the path is not kept, nor retraced, but if the tree is
+ *                  augmented, pointers to its nodes are pushed onto a stack, as in 'avl_insert_unbalanced'.)
+ *  @param      : [ Tree. ]
+ *                [ Data to insert. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns a
+ *                  negative value (left), 0 (equal), or a positive value (right). ]
+ *  @return     : None.
+**/
+void avl_insert_multi(avl_tree *tree, DATA_TYPE data, int (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    avl_node *path[AVL_MAX_HEIGHT];
+    int depth = 0, order = 1;
+    avl_node **parent_ptr = &tree->root;
+    ll_list *stack = tree->unbalanced && tree->augment != NULL ? avl_create_stack(tree) : NULL;
+
+    INSTR_ENTER(tree);
+    while (*parent_ptr != NULL) {
+        avl_node *node = *parent_ptr;
+        node->size++;
+        INSTR_PATH(tree);
+        order = INSTR_COMPARE(tree, f_compare(data, node->data));
+        if (order == 0) {
+            break;
+        }
+        if (!tree->unbalanced) {
+            path[depth++] = node;
+            INSTR_COUNT(tree, stack_pushes);
+        } else if (stack != NULL) {
+            AVL_PUSH(tree, stack, (void *) parent_ptr);
+        }
+        parent_ptr = order < 0 ? &node->lchild : &node->rchild;
+    }
+
+    avl_node *child = NULL;
+    unsigned char path_kept = stack != NULL ? !avl_stack_failed(tree, stack) : !tree->unbalanced || tree->augment == NULL;
+    if (path_kept && (order == 0 ? avl_bucket_append(tree, *parent_ptr, data)
+                                 : (child = avl_create_node(tree, data)) != NULL)) {
+        if (child != NULL) {
+            INSTR_COUNT(tree, allocs);
+            if (tree->min == NULL || parent_ptr == &tree->min->lchild) { tree->min = child; }
+            if (tree->max == NULL || parent_ptr == &tree->max->rchild) { tree->max = child; }
+            AVL_UPDATE(tree, child);
+            *parent_ptr = child;
+            if (!tree->unbalanced) {
+                path[depth] = child;
+                avl_retrace_insert(tree, path, depth);
+            }
+        } else {
+            AVL_UPDATE(tree, *parent_ptr);
+            if (!tree->unbalanced) { avl_update_path(tree, path, depth); }
+        }
+        if (stack != NULL) { avl_update_stack(tree, stack); }
+        tree->length++;
+        tree->finger_depth = 0;
+    } else {
+        for (avl_node *node = tree->root; node != *parent_ptr; ) {      /* undo the increments of sizes */
+            node->size--;
+            order = f_compare(data, node->data);
+            node = order < 0 ? node->lchild : node->rchild;
+        }
+        if (*parent_ptr != NULL) { (*parent_ptr)->size--; }
+    }
+    if (stack != NULL) { ll_destroy(stack); }
+    INSTR_EXIT(tree);
+}
+
+/**
+ *  @brief      : (for internal use) Appends data to the bucket of a node. A bucket is allocated (of
+ *                  'AVL_BUCKET_CAPACITY' items) on the first append. Once its end is reached, its items are moved to its
+ *                  start if at most half of it is used (after removals from its front), else it is re-allocated, twice
+ *                  as large, so appends take amortised O(1).
+ *  @param      : [ Tree. ]
+ *                [ Node. ]
+ *                [ Data to append. ]
+ *  @return     : 1 if appended, 0 if the bucket could not be allocated (the node is unchanged).
+**/
+static unsigned char avl_bucket_append(avl_tree *tree, avl_node *node, DATA_TYPE data) {
+    avl_bucket *bucket = node->bucket;
+    if (bucket == NULL) {
+        bucket = (avl_bucket *) ALLOC_ALLOC(tree->allocator, AVL_BUCKET_SIZE(AVL_BUCKET_CAPACITY));
+        if (bucket == NULL) {
+            tree->failed = 1;
+            return 0;
+        }
+        INSTR_COUNT(tree, allocs);
+        bucket->start = bucket->length = 0, bucket->capacity = AVL_BUCKET_CAPACITY;
+        node->bucket = bucket;
+    } else if (bucket->start + bucket->length == bucket->capacity) {
+        if (bucket->length * 2 <= bucket->capacity) {
+            memmove(bucket->items, bucket->items + bucket->start, bucket->length * sizeof(DATA_TYPE));
+        } else {
+            avl_bucket *new_bucket = (avl_bucket *) ALLOC_ALLOC(tree->allocator, AVL_BUCKET_SIZE(2 * bucket->capacity));
+            if (new_bucket == NULL) {
+                tree->failed = 1;
+                return 0;
+            }
+            INSTR_COUNT(tree, allocs);
+            memcpy(new_bucket->items, bucket->items + bucket->start, bucket->length * sizeof(DATA_TYPE));
+            new_bucket->length = bucket->length, new_bucket->capacity = 2 * bucket->capacity;
+            AVL_FREE(tree, bucket, AVL_BUCKET_SIZE(bucket->capacity));
+            INSTR_COUNT(tree, frees);
+            bucket = node->bucket = new_bucket;
+        }
+        bucket->start = 0;
+    }
+    bucket->items[bucket->start + bucket->length++] = data;
+    return 1;
+}
+
+/**
+ *  @brief      : (for internal use) Removes an item from a node that holds more than one. If it is the node's own item,
+ *                  the first item of the bucket takes its place. Items are shifted from the nearer end of the bucket,
+ *                  so removals at either end take O(1). An emptied bucket is de-allocated.
+ *  @param      : [ Tree. ]
+ *                [ Node (with a bucket). ]
+ *                [ Index of the item within the node. ]
+ *  @return     : Item removed.
+**/
+static DATA_TYPE avl_bucket_remove(avl_tree *tree, avl_node *node, LENGTH_DT k) {
+    avl_bucket *bucket = node->bucket;
+    DATA_TYPE data = AVL_ITEM(node, k);
+    DATA_TYPE *items = bucket->items + bucket->start;
+
+    if (k == 0) {
+        node->data = items[0];
+        k = 1;
+    }
+    if (k - 1 < bucket->length / 2) {
+        memmove(items + 1, items, (k - 1) * sizeof(DATA_TYPE));
+        bucket->start++;
+    } else {
+        memmove(items + k - 1, items + k, (bucket->length - k) * sizeof(DATA_TYPE));
+    }
+    if (--bucket->length == 0) {
+        AVL_FREE(tree, bucket, AVL_BUCKET_SIZE(bucket->capacity));
+        INSTR_COUNT(tree, frees);
+        node->bucket = NULL;
+    }
+    return data;
+}
+
+/**
+ *  @brief      : Get the no. of items equal to a key, as the no. of items not on the right of it (read '@brief' of
+ *                  'avl_upper_rank'), less its rank (read '@brief' of 'avl_rank'). Equal items are counted wherever they
+ *                  are (in one node, or many).
+ *  @param      : [ Tree. ]
+ *                [ Key. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : No. of items.
+**/
+LENGTH_DT avl_count(avl_tree *tree, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    INSTR_ENTER(tree);
+    AVL_FLUSH(tree);
+    LENGTH_DT count = avl_upper_rank(tree, key, f_compare) - avl_rank(tree, key, f_compare);
+    INSTR_EXIT(tree);
+    return count;
+}
+
+/**
+ *  @brief      : Get the summary of the items within a range of keys. The tree is descended from the root, until a node
+ *                  is within the range (the split node), below which the paths to the bounds part. Along the path to the
+ *                  lower bound (in the left subtree of the split node), each node within the range is followed by all
+ *                  of its right subtree (which is bounded by the split node), so both are combined onto the front of the
+ *                  summary (since they precede those met before), and the path goes left, else it goes right. Then, the
+ *                  items of the split node are combined onto its back, and, symmetrically, along the path to the upper
+ *                  bound, each node within the range is preceded by all of its left subtree, and both are combined onto
+ *                  its back. Only the summaries of nodes on both paths and their children are read, so O(log n).
+ *  @param      : [ Tree (augmented). ]
+ *                [ Lower key. ]
+ *                [ Upper key. ]
+ *                [ Summary to set. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : None.
+**/
+void avl_reduce_range(avl_tree *tree, DATA_TYPE lo, DATA_TYPE hi, void *summary,
+                        unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    avl_summary_buffer items;
+
+    INSTR_ENTER(tree);
+    AVL_FLUSH(tree);
+    const avl_augment *augment = tree->augment;
+    avl_node *split = tree->root;
+    memcpy(summary, augment->identity, augment->summary_size);
+    while (split != NULL) {
+        INSTR_PATH(tree);
+        if (INSTR_COMPARE(tree, f_compare(split->data, lo))) {
+            split = split->rchild;
+        } else if (INSTR_COMPARE(tree, f_compare(hi, split->data))) {
+            split = split->lchild;
+        } else {
+            break;
+        }
+    }
+
+    if (split != NULL) {
+        avl_node *node = split->lchild;
+        while (node != NULL) {
+            INSTR_PATH(tree);
+            if (INSTR_COMPARE(tree, f_compare(node->data, lo))) {
+                node = node->rchild;
+            } else {
+                avl_summarize_items(tree, node, &items);
+                if (node->rchild != NULL) { augment->f_combine(&items, &items, AVL_SUMMARY(node->rchild)); }
+                augment->f_combine(summary, &items, summary);
+                node = node->lchild;
+            }
+        }
+        avl_summarize_items(tree, split, &items);
+        augment->f_combine(summary, summary, &items);
+        node = split->rchild;
+        while (node != NULL) {
+            INSTR_PATH(tree);
+            if (INSTR_COMPARE(tree, f_compare(hi, node->data))) {
+                node = node->lchild;
+            } else {
+                if (node->lchild != NULL) { augment->f_combine(summary, summary, AVL_SUMMARY(node->lchild)); }
+                avl_summarize_items(tree, node, &items);
+                augment->f_combine(summary, summary, &items);
+                node = node->rchild;
+            }
+        }
+    }
+    INSTR_EXIT(tree);
+}
+
+/**
+ *  @brief      : (for internal use) Sets a summary of the items of a node (its own, then those of its bucket, in order).
+ *  @param      : [ Tree (augmented). ]
+ *                [ Node. ]
+ *                [ Summary to set. ]
+ *  @return     : None.
+**/
+static void avl_summarize_items(avl_tree *tree, avl_node *node, void *summary) {
+    const avl_augment *augment = tree->augment;
+    augment->f_summarize(summary, node->data);
+    if (node->bucket != NULL) {
+        avl_summary_buffer item;
+        for (LENGTH_DT k = 1; k < AVL_COUNT(node); k++) {
+            augment->f_summarize(&item, AVL_ITEM(node, k));
+            augment->f_combine(summary, summary, &item);
+        }
+    }
+}
+
+/**
+ *  @brief      : (for internal use) Recomputes the summary of a node (stored right after it), as that of its left
+ *                  subtree, its items, then its right subtree. The summaries of its children must be correct, so nodes
+ *                  are recomputed bottom-up (from a modified node, up to the root), and a rotation, which changes the
+ *                  children of two nodes, recomputes the lower one (read '@brief' of 'rotate_left').
+ *  @param      : [ Tree (augmented). ]
+ *                [ Node. ]
+ *  @return     : None.
+**/
+static void avl_summarize(avl_tree *tree, avl_node *node) {
+    const avl_augment *augment = tree->augment;
+    void *summary = AVL_SUMMARY(node);
+    avl_summarize_items(tree, node, summary);
+    if (node->lchild != NULL) { augment->f_combine(summary, AVL_SUMMARY(node->lchild), summary); }
+    if (node->rchild != NULL) { augment->f_combine(summary, summary, AVL_SUMMARY(node->rchild)); }
+}
+
+/**
+ *  @brief      : (for internal use) Computes the summaries of all nodes from a root, through post-order traversal,
+ *                  using a stack (of 'AVL_MAX_HEIGHT' nodes, so the nodes must be balanced, as built by 'avl_bulk_load').
+ *                  Left children are pushed while descending, and the node on top is summarized and popped once it has
+ *                  no right child, or its right child was the last node summarized, else its right child is descended.
+ *  @param      : [ Tree (augmented). ]
+ *                [ Root of the nodes. ]
+ *  @return     : None.
+**/
+static void avl_summarize_all(avl_tree *tree, avl_node *root) {
+    avl_node *stack[AVL_MAX_HEIGHT];
+    int top = 0;
+    avl_node *node = root, *last = NULL;
+
+    while (node != NULL || top != 0) {
+        while (node != NULL) {
+            stack[top++] = node;
+            node = node->lchild;
+        }
+        avl_node *peek = stack[top - 1];
+        if (peek->rchild != NULL && peek->rchild != last) {
+            node = peek->rchild;
+        } else {
+            avl_summarize(tree, peek);
+            last = peek;
+            top--;
+        }
+    }
+}
+
+/**
+ *  @brief      : (for internal use) Recomputes the summaries of the nodes at the start of a path (if the tree is
+ *                  augmented), from the deepest up.
+ *  @param      : [ Tree. ]
+ *                [ Path (from the root). ]
+ *                [ No. of nodes to recompute. ]
+ *  @return     : None.
+**/
+static void avl_update_path(avl_tree *tree, avl_node **path, int depth) {
+    if (tree->augment != NULL) {
+        for (int t = depth - 1; t >= 0; t--) {
+            avl_summarize(tree, path[t]);
+        }
+    }
+}
+
+/**
+ *  @brief      : (for internal use) Recomputes the sizes and summaries of the nodes pointed to by the pointers on a
+ *                  stack, popping all of them (pushed from the root down, so from the deepest up). Used by unbalanced
+ *                  functions, whose paths may be longer than 'AVL_MAX_HEIGHT'.
+ *  @param      : [ Tree (augmented). ]
+ *                [ Stack of pointers to nodes. ]
+ *  @return     : None.
+**/
+static void avl_update_stack(avl_tree *tree, ll_list *stack) {
+    while (stack->length != 0) {
+        avl_node *node = *(avl_node **) ll_pop(stack);
+        AVL_RESIZE(node);
+        avl_summarize(tree, node);
+    }
+}
+
+/**
+ *  @brief      : Set the capacity of the insert buffer of a tree, flushing it first (if not empty). If the buffer cannot
+ *                  be allocated, the tree is left with none, and marked as failed.
+ *  @param      : [ Tree. ]
+ *                [ Capacity (0 for none). ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : None.
+**/
+void avl_set_buffer(avl_tree *tree, LENGTH_DT capacity, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    INSTR_ENTER(tree);
+    AVL_FLUSH(tree);
+    free(tree->buffer);
+    tree->buffer = capacity > 0 ? (DATA_TYPE *) malloc(capacity * sizeof(DATA_TYPE)) : NULL;
+    if (capacity > 0 && tree->buffer == NULL) {
+        tree->failed = 1;
+    }
+    tree->buffer_capacity = tree->buffer != NULL ? capacity : 0;
+    tree->f_buffer_compare = f_compare;
+    INSTR_EXIT(tree);
+}
+
+/**
+ *  @brief      : Inserts new data through the insert buffer. The data is appended to the buffer (in O(1), with no
+ *                  traversal or allocation), after flushing the buffer if it is full. Without a buffer, the data is
+ *                  inserted by 'avl_insert'. If no comparison function was set (see 'avl_set_buffer'), nothing is
+ *                  inserted, and the tree is marked as failed.
+ *  @param      : [ Tree. ]
+ *                [ Data to insert. ]
+ *  @return     : None.
+**/
+void avl_insert_buffered(avl_tree *tree, DATA_TYPE data) {
+    INSTR_ENTER(tree);
+    if (tree->f_buffer_compare == NULL) {
+        tree->failed = 1;                               /* no comparison function, so no place for the data */
+    } else if (tree->buffer_capacity == 0) {
+        avl_insert(tree, data, tree->f_buffer_compare);
+    } else {
+        if (tree->buffer_length == tree->buffer_capacity) {
+            avl_flush(tree);
+        }
+        tree->buffer[tree->buffer_length++] = data;
+        tree->length++;
+    }
+    INSTR_EXIT(tree);
+}
+
+/**
+ *  @brief      : Merges the insert buffer into the nodes. The buffer is sorted, then, if it is large relative to the
+ *                  tree (read '@brief' of 'AVL_REBUILD_RATIO'), or if the tree is unbalanced, the tree is rebuilt by
+ *                  'avl_bulk_load' from a linear merge of its items and the buffer (re-balancing it). Else (or if the
+ *                  array of its items cannot be allocated, or filled), buffered items are inserted one by one, in
+ *                  order, by 'avl_insert_finger', so that each insertion starts from the position of the previous one.
+ *                  Items that could not be allocated nodes remain buffered.
+ *  @param      : [ Tree. ]
+ *  @return     : None.
+**/
+void avl_flush(avl_tree *tree) {
+    INSTR_ENTER(tree);
+    if (tree->buffer_length != 0) {
+        LENGTH_DT n = tree->buffer_length, n_nodes = tree->length - n;
+        avl_merge_cursor cursor;
+        avl_buffer_sort(tree);
+        tree->buffer_length = tree->buffer_sorted = 0;
+        tree->length = n_nodes;
+        cursor.nodes = tree->unbalanced || n * AVL_REBUILD_RATIO >= n_nodes
+                            ? (DATA_TYPE *) malloc((n_nodes + 1) * sizeof(DATA_TYPE)) : NULL;
+        if (cursor.nodes != NULL && avl_make_array_subtree(tree, tree->root, cursor.nodes) == n_nodes) {
+            cursor.n_nodes = n_nodes, cursor.buffer = tree->buffer, cursor.n_buffer = n;
+            cursor.i = cursor.j = 0;
+            cursor.f_compare = tree->f_buffer_compare;
+            avl_bulk_load(tree, n_nodes + n, avl_merge_next, &cursor);
+            free(cursor.nodes);
+            if (tree->length == n_nodes) {                  /* not rebuilt, keep the buffer */
+                tree->buffer_length = tree->buffer_sorted = n;
+                tree->length += n;
+            }
+        } else {
+            free(cursor.nodes);
+            for (LENGTH_DT j = 0; j < n; j++) {
+                avl_insert_finger(tree, tree->buffer[j], tree->f_buffer_compare);
+                if (tree->length == n_nodes + j) {          /* not inserted, keep the rest buffered */
+                    memmove(tree->buffer, tree->buffer + j, (n - j) * sizeof(DATA_TYPE));
+                    tree->buffer_length = tree->buffer_sorted = n - j;
+                    tree->length += n - j;
+                    break;
+                }
+            }
+        }
+    }
+    INSTR_EXIT(tree);
+}
+
+/**
+ *  @brief      : (for internal use) Returns the next item of the merge of a tree's items with its insert buffer
+ *                  (see 'avl_flush'). On ties, items of the tree go first.
+ *  @param      : [ Cursor. ]
+ *  @return     : Item.
+**/
+static DATA_TYPE avl_merge_next(void *arg) {
+    avl_merge_cursor *cursor = (avl_merge_cursor *) arg;
+    if (cursor->j == cursor->n_buffer || (cursor->i != cursor->n_nodes &&
+            !cursor->f_compare(cursor->buffer[cursor->j], cursor->nodes[cursor->i]))) {
+        return cursor->nodes[cursor->i++];
+    }
+    return cursor->buffer[cursor->j++];
+}
+
+/**
+ *  @brief      : (for internal use) Sorts the insert buffer (stably), if items were appended since it was last sorted.
+ *                  A short unsorted tail is binary inserted into the sorted prefix. A longer one is sorted by bottom-up
+ *                  merge sort (into a temporary array, and back), then merged with the prefix (or binary inserted, if
+ *                  the temporary array cannot be allocated).
+ *  @param      : [ Tree. ]
+ *  @return     : None.
+**/
+static void avl_buffer_sort(avl_tree *tree) {
+    DATA_TYPE *buffer = tree->buffer;
+    LENGTH_DT n = tree->buffer_length, sorted = tree->buffer_sorted;
+    DATA_TYPE *tmp = n - sorted > AVL_BUFFER_INSERTION ? (DATA_TYPE *) malloc(n * sizeof(DATA_TYPE)) : NULL;
+
+    if (tmp == NULL) {
+        for (LENGTH_DT k = sorted; k < n; k++) {
+            DATA_TYPE data = buffer[k];
+            tree->buffer_sorted = k;
+            LENGTH_DT j = avl_buffer_bound(tree, data, 1, tree->f_buffer_compare);
+            memmove(buffer + j + 1, buffer + j, (k - j) * sizeof(DATA_TYPE));
+            buffer[j] = data;
+        }
+    } else {
+        DATA_TYPE *src = buffer, *dest = tmp;
+        for (LENGTH_DT width = 1; width < n - sorted; width *= 2) {
+            for (LENGTH_DT lo = sorted; lo < n; lo += 2 * width) {
+                LENGTH_DT mid = lo + width < n ? lo + width : n;
+                LENGTH_DT hi = mid + width < n ? mid + width : n;
+                avl_buffer_merge(src, lo, mid, hi, dest, tree->f_buffer_compare);
+            }
+            DATA_TYPE *swap = src;
+            src = dest, dest = swap;
+        }
+        if (src != buffer) {
+            memcpy(buffer + sorted, src + sorted, (n - sorted) * sizeof(DATA_TYPE));
+        }
+        if (sorted != 0) {
+            avl_buffer_merge(buffer, 0, sorted, n, tmp, tree->f_buffer_compare);
+            memcpy(buffer, tmp, n * sizeof(DATA_TYPE));
+        }
+        free(tmp);
+    }
+    tree->buffer_sorted = n;
+}
+
+/**
+ *  @brief      : (for internal use) Merges two adjacent sorted ranges of an array into the same range of another.
+ *                  On ties, items of the first range go first.
+ *  @param      : [ Source array. ]
+ *                [ Start of first range. ]
+ *                [ End of first range (start of second). ]
+ *                [ End of second range. ]
+ *                [ Destination array. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : None.
+**/
+static void avl_buffer_merge(DATA_TYPE *src, LENGTH_DT lo, LENGTH_DT mid, LENGTH_DT hi, DATA_TYPE *dest,
+                                unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    LENGTH_DT i = lo, j = mid, k = lo;
+    while (i < mid && j < hi) {
+        dest[k++] = f_compare(src[j], src[i]) ? src[j++] : src[i++];
+    }
+    while (i < mid) { dest[k++] = src[i++]; }
+    while (j < hi) { dest[k++] = src[j++]; }
+}
+
+/**
+ *  @brief      : (for internal use) Binary searches the sorted prefix of the insert buffer for the first item on the
+ *                  right of a key (upper bound), or the first item not on its left (lower bound).
+ *  @param      : [ Tree. ]
+ *                [ Key. ]
+ *                [ 1 for the upper bound, 0 for the lower bound. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : Index (the length of the sorted prefix, if none).
+**/
+static LENGTH_DT avl_buffer_bound(avl_tree *tree, DATA_TYPE key, unsigned char upper,
+                                    unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    LENGTH_DT lo = 0, hi = tree->buffer_sorted;
+    while (lo < hi) {
+        LENGTH_DT mid = lo + (hi - lo) / 2;
+        unsigned char go_left = upper ? INSTR_COMPARE(tree, f_compare(key, tree->buffer[mid]))
+                                      : !INSTR_COMPARE(tree, f_compare(tree->buffer[mid], key));
+        if (go_left) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+/**
+ *  @brief      : (for internal use) Get the no. of items in nodes not on the right of a key (so, including equal ones),
+ *                  descending from the root, like 'avl_rank'.
+ *  @param      : [ Tree. ]
+ *                [ Key. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : No. of items.
+**/
+static LENGTH_DT avl_upper_rank(avl_tree *tree, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    avl_node *curr_node = tree->root;
+    LENGTH_DT rank = 0;
+
+    while (curr_node != NULL) {
+        INSTR_PATH(tree);
+        if (INSTR_COMPARE(tree, f_compare(key, curr_node->data))) {
+            curr_node = curr_node->lchild;
+        } else {
+            rank += AVL_SIZE(curr_node->lchild) + AVL_COUNT(curr_node);
+            curr_node = curr_node->rchild;
+        }
+    }
+    return rank;
+}
+
+/**
+ *  @brief      : Replace the items of a tree with many sorted items, building a balanced tree. The root of a range of
+ *                  'm' items is its item at index '(m - 1) / 2', so the left subtree is never larger than the right one,
+ *                  and the height of a range is the bit length of 'm' (hence the balance of each node). Ranges are split
+ *                  like an in-order traversal (read '@brief' of 'avl_make_list'): the node of each range is created, and
+ *                  pushed, while descending left, and its item is only fetched when popped, so items are fetched in order.
+ *                  The new nodes are built apart, so that if one cannot be allocated, those built are de-allocated, and
+ *                  the tree is unchanged. Else, the old nodes are de-allocated (and, if the tree is augmented, the
+ *                  summaries of the new ones computed, read '@brief' of 'avl_summarize_all').
+ *  @param      : [ Tree. ]
+ *                [ No. of items. ]
+ *                [ Function that receives 'arg', and returns the next item. ]
+ *                [ Argument. ]
+ *  @return     : None.
+**/
+void avl_bulk_load(avl_tree *tree, LENGTH_DT n, DATA_TYPE (*f_next)(void *arg), void *arg) {
+    avl_node *stack[AVL_MAX_HEIGHT];
+    LENGTH_DT stack_hi[AVL_MAX_HEIGHT];
+    int top = 0;
+    avl_node *root = NULL;
+    avl_node **parent_ptr = &root;
+    LENGTH_DT lo = 0, hi = n;
+    unsigned char failed = 0;
+
+    INSTR_ENTER(tree);
+    while (1) {
+        while (lo < hi) {
+            LENGTH_DT mid = lo + (hi - lo - 1) / 2;
+            avl_node *node = avl_create_node(tree, DEFAULT_VALUE);
+            if (node == NULL) {
+                failed = 1;
+                break;
+            }
+            INSTR_COUNT(tree, allocs);
+            node->size = hi - lo;
+            node->balance = avl_bit_length(mid - lo) - avl_bit_length(hi - mid - 1);
+            *parent_ptr = node;
+            stack[top] = node, stack_hi[top++] = hi;
+            parent_ptr = &node->lchild, hi = mid;
+        }
+        *parent_ptr = NULL;
+        if (top == 0 || failed) {
+            break;
+        }
+        avl_node *node = stack[--top];
+        node->data = f_next(arg);
+        lo = hi + 1, hi = stack_hi[top];                /* its left range ended at its own index */
+        parent_ptr = &node->rchild;
+    }
+
+    if (failed) {
+        avl_deallocate_all(tree, root);
+    } else {
+        if (tree->augment != NULL) { avl_summarize_all(tree, root); }
+        avl_deallocate_all(tree, tree->root);
+        tree->root = root;
+        tree->length = n;
+        tree->unbalanced = 0;
+        tree->buffer_length = tree->buffer_sorted = 0;
+        tree->finger_depth = 0;
+        tree->min = tree->max = tree->root;
+        while (tree->min != NULL && tree->min->lchild != NULL) { tree->min = tree->min->lchild; }
+        while (tree->max != NULL && tree->max->rchild != NULL) { tree->max = tree->max->rchild; }
+    }
+    INSTR_EXIT(tree);
+}
+
+/**
+ *  @brief      : (for internal use) Returns the no. of bits needed to represent a non-negative number (0 for 0).
+ *  @param      : [ Number. ]
+ *  @return     : Bit length.
+**/
+static signed char avl_bit_length(LENGTH_DT n) {
+    signed char length = 0;
+    while (n != 0) {
+        n >>= 1;
+        length++;
+    }
+    return length;
 }
 
 /**
  *  @brief      : Deletes an item at an index. Uses the unbalanced BST deletion algorithm, and not that of
- *                  an AVL BST. Four cases are adhered to: No children, right child only, left child only, and
- *                  two children. In the last case, the next in-order node is located and its data is copied to the
- *                  previously to-be-deleted node, then that (in-order) node is itself deleted instead.
- *                  (Note: For information on 'f_compare', read '@brief' of 'avl_insert_unbalanced'.)
+ *                  an AVL BST. The node is located by index (read '@brief' of 'avl_get_node'), decrementing the size of
+ *                  each node along the way. If the node holds more than one item, only the item is removed from it
+ *                  (read '@brief' of 'avl_bucket_remove'). Else, four cases are adhered to: No children, right child
+ *                  only, left child only, and two children. In the last case, the next in-order node is located and its
+ *                  items are moved to the previously to-be-deleted node (so the size of each node between them drops by
+ *                  their no.), then that (in-order) node is itself deleted instead. If the tree is augmented, the
+ *                  pointers to the nodes traversed are pushed onto a stack instead, and their sizes (and summaries)
+ *                  recomputed once the node is unlinked (read '@brief' of 'avl_update_stack'), so if the stack cannot
+ *                  be allocated, the tree is left unchanged.
  *  @param      : [ Tree. ]
  *                [ Index to delete at. ]
- *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *                [ Function that receives two items (unused, since the item is located by index, but kept for API
+ *                  compatibility). ]
  *  @return     : None.
 **/
 DATA_TYPE avl_delete_unbalanced(avl_tree *tree, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
-    avl_node *node_to_del = avl_get_node(tree, i);
-    if (node_to_del != NULL) {
-        DATA_TYPE return_data = node_to_del->data;
-        avl_node **parent_ptr = &tree->root;
-        while (1) {
-            if (*parent_ptr == node_to_del) {
-                if ((*parent_ptr)->lchild == NULL && (*parent_ptr)->rchild == NULL) {       /* Case: No children. */
-                    free(*parent_ptr);
+    DATA_TYPE return_data = DEFAULT_VALUE;
+    ll_list *stack = NULL;
+    (void) f_compare;
+    INSTR_ENTER(tree);
+    AVL_FLUSH(tree);
+    if (i >= 0 && i < tree->length && (tree->augment == NULL || (stack = avl_create_stack(tree)) != NULL)) {
+        avl_node **parent_ptr = &tree->root, **next_ptr = NULL;
+        while (i < AVL_SIZE((*parent_ptr)->lchild) || i >= AVL_SIZE((*parent_ptr)->lchild) + AVL_COUNT(*parent_ptr)) {
+            LENGTH_DT lsize = AVL_SIZE((*parent_ptr)->lchild);
+            INSTR_PATH(tree);
+            if (stack != NULL) {
+                AVL_PUSH(tree, stack, (void *) parent_ptr);
+            } else {
+                (*parent_ptr)->size--;
+            }
+            if (i < lsize) {
+                parent_ptr = &(*parent_ptr)->lchild;
+            } else {
+                i -= lsize + AVL_COUNT(*parent_ptr);
+                parent_ptr = &(*parent_ptr)->rchild;
+            }
+        }
+        avl_node *tmp = *parent_ptr;
+        if (tmp->bucket == NULL && tmp->lchild != NULL && tmp->rchild != NULL) {    /* get next in-order */
+            avl_node *next = tmp->rchild;
+            while (next->lchild != NULL) { next = next->lchild; }
+            LENGTH_DT count = AVL_COUNT(next);
+            if (stack != NULL) {
+                AVL_PUSH(tree, stack, (void *) parent_ptr);
+            } else {
+                tmp->size--;
+            }
+            next_ptr = &tmp->rchild;
+            while ((*next_ptr)->lchild != NULL) {
+                INSTR_PATH(tree);
+                if (stack != NULL) {
+                    AVL_PUSH(tree, stack, (void *) next_ptr);
+                } else {
+                    (*next_ptr)->size -= count;
+                }
+                next_ptr = &(*next_ptr)->lchild;
+            }
+        }
+
+        if (stack == NULL || !avl_stack_failed(tree, stack)) {
+            if (tmp->bucket != NULL) {                                              /* Case: Equal items. */
+                tmp->size--;
+                return_data = avl_bucket_remove(tree, tmp, i - AVL_SIZE(tmp->lchild));
+                AVL_UPDATE(tree, tmp);
+            } else {
+                return_data = tmp->data;
+                if (tmp->lchild == NULL && tmp->rchild == NULL) {                   /* Case: No children. */
                     *parent_ptr = NULL;
-                    break;
-                } else if ((*parent_ptr)->lchild == NULL) {                                 /* Case: Right child. */
-                    avl_node *tmp = *parent_ptr;
+                } else if (tmp->lchild == NULL) {                                   /* Case: Right child. */
                     *parent_ptr = tmp->rchild;
-                    free(tmp);
-                    break;
-                } else if ((*parent_ptr)->rchild == NULL) {                                 /* Case: Left child. */
-                    avl_node *tmp = *parent_ptr;
+                } else if (tmp->rchild == NULL) {                                   /* Case: Left child. */
                     *parent_ptr = tmp->lchild;
-                    free(tmp);
-                    break;
-                } else {                                                                    /* Case: Two children. */
-                    avl_node **tmp_ptr = &(*parent_ptr)->rchild;                /* get next in-order */
-                    while ((*tmp_ptr)->lchild != NULL) {
-                        tmp_ptr = &(*tmp_ptr)->lchild;
-                    }
-                    (*parent_ptr)->data = (*tmp_ptr)->data;
-                    parent_ptr = tmp_ptr;
-                    node_to_del = *tmp_ptr;
+                } else {                                                            /* Case: Two children. */
+                    avl_node *next = *next_ptr;
+                    tmp->data = next->data, tmp->bucket = next->bucket;
+                    tmp = next;
+                    *next_ptr = tmp->rchild;
                 }
+                avl_unlink_min_max(tree, tmp);
+                AVL_FREE(tree, tmp, AVL_NODE_SIZE(tree));
+                INSTR_COUNT(tree, frees);
+                tree->unbalanced = 1;
+            }
+            if (stack != NULL) { avl_update_stack(tree, stack); }
+            tree->length--;
+            tree->finger_depth = 0;
+        }
+        if (stack != NULL) { ll_destroy(stack); }
+    }
+    INSTR_EXIT(tree);
+    return return_data;
+}
+
+/**
+ *  @brief      : Deletes an item at an index. Uses AVL BST deletion algorithm. It builds upon 'avl_delete unbalanced',
+ *                  by storing the nodes along the traversal path in a stack, then tracing them back, and re-balancing.
+ *                  Nothing is modified on the way down, so if the stack cannot be allocated, the tree is left
+ *                  unchanged. The size (and summary, if augmented) of each node popped is recomputed (before it is
+ *                  re-balanced), and the rest of the stack is still popped once re-balancing stops, to recompute those
+ *                  above. If the node holds more than one item, the shape of the tree is unchanged, so nothing is
+ *                  re-balanced.
+ *                  (Note: AVL deletion algorithm is complex, and demands a reference to understand.)
+ *  @param      : [ Tree. ]
+ *                [ Index to delete at. ]
+ *                [ Function that receives two items (unused, since the item is located by index, but kept for API
+ *                  compatibility). ]
+ *  @return     : None.
+**/
+DATA_TYPE avl_delete(avl_tree *tree, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    DATA_TYPE return_data = DEFAULT_VALUE;
+    ll_list *stack = NULL;
+    (void) f_compare;
+    INSTR_ENTER(tree);
+    AVL_FLUSH(tree);
+    if (i >= 0 && i < tree->length && (stack = avl_create_stack(tree)) != NULL) {
+        avl_node **parent_ptr = &tree->root, **next_ptr = NULL;
+        unsigned char signal, retrace;
+
+        while (i < AVL_SIZE((*parent_ptr)->lchild) || i >= AVL_SIZE((*parent_ptr)->lchild) + AVL_COUNT(*parent_ptr)) {
+            LENGTH_DT lsize = AVL_SIZE((*parent_ptr)->lchild);
+            INSTR_PATH(tree);
+            AVL_PUSH(tree, stack, (void *) parent_ptr);
+            if (i < lsize) {
+                AVL_PUSH(tree, stack, LEFT);
+                parent_ptr = &(*parent_ptr)->lchild;
             } else {
-                if (f_compare(node_to_del->data, (*parent_ptr)->data)) {
-                    parent_ptr = &(*parent_ptr)->lchild;
+                i -= lsize + AVL_COUNT(*parent_ptr);
+                AVL_PUSH(tree, stack, RIGHT);
+                parent_ptr = &(*parent_ptr)->rchild;
+            }
+        }
+        avl_node *tmp = *parent_ptr;
+        if (tmp->bucket == NULL && tmp->lchild != NULL && tmp->rchild != NULL) {    /* get next in-order */
+            AVL_PUSH(tree, stack, (void *) parent_ptr);
+            AVL_PUSH(tree, stack, RIGHT);
+            next_ptr = &tmp->rchild;
+            while ((*next_ptr)->lchild != NULL) {
+                INSTR_PATH(tree);
+                AVL_PUSH(tree, stack, (void *) next_ptr);
+                AVL_PUSH(tree, stack, LEFT);
+                next_ptr = &(*next_ptr)->lchild;
+            }
+        }
+
+        if (!avl_stack_failed(tree, stack)) {
+            retrace = tmp->bucket == NULL;
+            if (tmp->bucket != NULL) {                                              /* Case: Equal items. */
+                tmp->size--;
+                return_data = avl_bucket_remove(tree, tmp, i - AVL_SIZE(tmp->lchild));
+                AVL_UPDATE(tree, tmp);
+            } else {
+                return_data = tmp->data;
+                if (tmp->lchild == NULL && tmp->rchild == NULL) {                   /* Case: No children. */
+                    *parent_ptr = NULL;
+                } else if (tmp->lchild == NULL) {                                   /* Case: Right child. */
+                    *parent_ptr = tmp->rchild;
+                } else if (tmp->rchild == NULL) {                                   /* Case: Left child. */
+                    *parent_ptr = tmp->lchild;
+                } else {                                                            /* Case: Two children. */
+                    avl_node *next = *next_ptr;
+                    tmp->data = next->data, tmp->bucket = next->bucket;
+                    tmp = next;
+                    *next_ptr = tmp->rchild;
+                }
+                avl_unlink_min_max(tree, tmp);
+                AVL_FREE(tree, tmp, AVL_NODE_SIZE(tree));
+                INSTR_COUNT(tree, frees);
+            }
+
+            while (stack->length != 0) {
+                void *left_or_right = ll_pop(stack);
+                avl_node **parent_ptr = (avl_node **) ll_pop(stack);
+                AVL_RESIZE(*parent_ptr);
+                AVL_UPDATE(tree, *parent_ptr);
+                if (!retrace) {
+                    continue;
+                }
+                if (left_or_right == LEFT) {
+                    if ((*parent_ptr)->balance == BAL) {
+                        (*parent_ptr)->balance = RHIGH;
+                        retrace = 0;
+                    } else if ((*parent_ptr)->balance == LHIGH) {
+                        (*parent_ptr)->balance = BAL;
+                    } else {                                            /* 2x RHIGH */
+                        signal = 0;
+                        *parent_ptr = right_balance_delete(tree, *parent_ptr, &signal);
+                        retrace = !signal;
+                    }
                 } else {
-                    parent_ptr = &(*parent_ptr)->rchild;
+                    if ((*parent_ptr)->balance == BAL) {
+                        (*parent_ptr)->balance = LHIGH;
+                        retrace = 0;
+                    } else if ((*parent_ptr)->balance == RHIGH) {
+                        (*parent_ptr)->balance = BAL;
+                    } else {                                            /* 2x LHIGH */
+                        signal = 0;
+                        *parent_ptr = left_balance_delete(tree, *parent_ptr, &signal);
+                        retrace = !signal;
+                    }
                 }
             }
+            tree->length--;
+            tree->finger_depth = 0;
+        }
+        ll_destroy(stack);
+    }
+    INSTR_EXIT(tree);
+    return return_data;
+}
+
+/**
+ *  @brief      : (for internal use) Called when a node is unlinked from a tree. If it is the left-most (or right-most)
+ *                  node, the new left-most (or right-most) node is located, starting at the root. Otherwise, nothing
+ *                  happens. Rotations do not change which node is left-most or right-most, so they need no attention.
+ *  @param      : [ Tree. ]
+ *                [ Unlinked node. ]
+ *  @return     : None.
+**/
+static void avl_unlink_min_max(avl_tree *tree, avl_node *node) {
+    if (node == tree->min) {
+        tree->min = tree->root;
+        while (tree->min != NULL && tree->min->lchild != NULL) {
+            tree->min = tree->min->lchild;
+        }
+    }
+    if (node == tree->max) {
+        tree->max = tree->root;
+        while (tree->max != NULL && tree->max->rchild != NULL) {
+            tree->max = tree->max->rchild;
+        }
+    }
+}
+
+/**
+ *  @brief      : Returns the smallest (left-most) data stored, through the left-most node kept in the tree (or the
+ *                  first item of the sorted insert buffer, if smaller).
+ *                  If the tree is empty, returns DEFAULT_VALUE set in the header file.
+ *  @param      : [ Tree. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE avl_min(avl_tree *tree) {
+    INSTR_ENTER(tree);
+    DATA_TYPE data = tree->min != NULL ? tree->min->data : DEFAULT_VALUE;
+    if (tree->buffer_length != 0) {
+        avl_buffer_sort(tree);
+        if (tree->min == NULL || INSTR_COMPARE(tree, tree->f_buffer_compare(tree->buffer[0], data))) {
+            data = tree->buffer[0];
+        }
+    }
+    INSTR_EXIT(tree);
+    return data;
+}
+
+/**
+ *  @brief      : Returns the largest (right-most) data stored, through (the last item of) the right-most node kept in
+ *                  the tree (or the last item of the sorted insert buffer, if not smaller).
+ *                  If the tree is empty, returns DEFAULT_VALUE set in the header file.
+ *  @param      : [ Tree. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE avl_max(avl_tree *tree) {
+    INSTR_ENTER(tree);
+    DATA_TYPE data = tree->max != NULL ? AVL_ITEM(tree->max, AVL_COUNT(tree->max) - 1) : DEFAULT_VALUE;
+    if (tree->buffer_length != 0) {
+        avl_buffer_sort(tree);
+        DATA_TYPE last = tree->buffer[tree->buffer_length - 1];
+        if (tree->max == NULL || !INSTR_COMPARE(tree, tree->f_buffer_compare(last, data))) {
+            data = last;
         }
-        tree->length--;
-        return return_data;
     }
-    return NULL;
+    INSTR_EXIT(tree);
+    return data;
 }
 
 /**
- *  @brief      : Deletes an item at an index. Uses AVL BST deletion algorithm. It builds upon 'avl_delete unbalanced',
- *                  by tracing the nodes back along the traversal path, and re-balancing.
- *                  (Note: AVL deletion algorithm is complex, and demands a reference to understand.)
- *                  (Note: For information on 'f_compare', read '@brief' of 'avl_insert_unbalanced'.)
+ *  @brief      : Deletes the smallest (left-most) item, through 'avl_delete' at the first index. The item is located by
+ *                  index, through subtree sizes, with no calls to a comparison function.
  *  @param      : [ Tree. ]
- *                [ Index to delete at. ]
- *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
- *  @return     : None.
+ *  @return     : Data stored.
 **/
-DATA_TYPE avl_delete(avl_tree *tree, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
-    avl_node *node_to_del = avl_get_node(tree, i);
-    if (node_to_del != NULL) {
-        DATA_TYPE return_data = node_to_del->data;
-        ll_list *stack = ll_create();
-        avl_node **parent_ptr = &tree->root;
-        unsigned char signal;
-
-        while (1) {
-            if (*parent_ptr == node_to_del) {
-                if ((*parent_ptr)->lchild == NULL && (*parent_ptr)->rchild == NULL) {       /* Case: No children. */
-                    free(*parent_ptr);
-                    *parent_ptr = NULL;
-                    break;
-                } else if ((*parent_ptr)->lchild == NULL) {                                 /* Case: Right child. */
-                    avl_node *tmp = *parent_ptr;
-                    *parent_ptr = tmp->rchild;
-                    free(tmp);
-                    break;
-                } else if ((*parent_ptr)->rchild == NULL) {                                 /* Case: Left child. */
-                    avl_node *tmp = *parent_ptr;
-                    *parent_ptr = tmp->lchild;
-                    free(tmp);
-                    break;
-                } else {                                                                    /* Case: Two children. */
-                    avl_node *tmp = (*parent_ptr)->rchild;              /* get next in-order */
-                    while (tmp->lchild != NULL) {
-                        tmp = tmp->lchild;
-                    }
-                    (*parent_ptr)->data = tmp->data;
-                    parent_ptr = &tree->root;
-                    node_to_del = tmp;
-                    ll_delete_all(stack);
-                }
-            } else {
-                ll_push(stack, (void *) parent_ptr);
-                if (f_compare(node_to_del->data, (*parent_ptr)->data)) {
-                    ll_push(stack, LEFT);
-                    parent_ptr = &(*parent_ptr)->lchild;
-                } else {
-                    ll_push(stack, RIGHT);
-                    parent_ptr = &(*parent_ptr)->rchild;
-                }
-            }
-        }
+DATA_TYPE avl_pop_min(avl_tree *tree) {
+    INSTR_ENTER(tree);
+    DATA_TYPE data = avl_delete(tree, 0, NULL);
+    INSTR_EXIT(tree);
+    return data;
+}
 
-        while (stack->length != 0) {
-            void *left_or_right = ll_pop(stack);
-            avl_node **parent_ptr = (avl_node **) ll_pop(stack);
-            if (left_or_right == LEFT) {
-                if ((*parent_ptr)->balance == BAL) {
-                    (*parent_ptr)->balance = RHIGH;
-                    break;
-                } else if ((*parent_ptr)->balance == LHIGH) {
-                    (*parent_ptr)->balance = BAL;
-                } else {                                                /* 2x RHIGH */
-                    signal = 0;
-                    *parent_ptr = right_balance_delete(*parent_ptr, &signal);
-                    if (signal) {
-                        break;
-                    }
-                }
-            } else {
-                if ((*parent_ptr)->balance == BAL) {
-                    (*parent_ptr)->balance = LHIGH;
-                    break;
-                } else if ((*parent_ptr)->balance == RHIGH) {
-                    (*parent_ptr)->balance = BAL;
-                } else {                                                /* 2x LHIGH */
-                    signal = 0;
-                    *parent_ptr = left_balance_delete(*parent_ptr, &signal);
-                    if (signal) {
-                        break;
-                    }
-                }
-            }
-        }
-        tree->length--;
-        ll_destroy(stack);
-        return return_data;
-    }
-    return NULL;
+/**
+ *  @brief      : Deletes the largest (right-most) item, through 'avl_delete' at the last index. The item is located by
+ *                  index, through subtree sizes, with no calls to a comparison function.
+ *  @param      : [ Tree. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE avl_pop_max(avl_tree *tree) {
+    INSTR_ENTER(tree);
+    DATA_TYPE data = avl_delete(tree, tree->length - 1, NULL);
+    INSTR_EXIT(tree);
+    return data;
 }
 
 /**
  *  @brief      : Balance a 2x LHIGH node in an AVL tree (for deletion).
- *  @param      : [ Node to rebalance. ]
+ *  @param      : [ Tree (for its counters). ]
+ *                [ Node to rebalance. ]
  *  @return     : [ Node after rebalancing (may not be the same node). ]
 **/
-static avl_node * left_balance_delete(avl_node *node, unsigned char *signal) {
+static avl_node * left_balance_delete(avl_tree *tree, avl_node *node, unsigned char *signal) {
     avl_node *lsub, *lrsub;
     lsub = node->lchild;
     switch (lsub->balance) {
         case LHIGH:                                                 /* single rotation */
             node->balance = BAL;
             lsub->balance = BAL;
-            node = rotate_right(node);
+            node = rotate_right(tree, node);
             break;
         case BAL:                                                   /* single rotation */
             node->balance = LHIGH;
             lsub->balance = RHIGH;
-            node = rotate_right(node);
+            node = rotate_right(tree, node);
             *signal = 1;               /* height unchanged */
             break;
         case RHIGH:                                                 /* double rotation */
@@ -397,8 +1822,8 @@ static avl_node * left_balance_delete(avl_node *node, unsigned char *signal) {
                     break;
             }
             lrsub->balance = BAL;
-            node->lchild = rotate_left(lsub);
-            node = rotate_right(node);
+            node->lchild = rotate_left(tree, lsub);
+            node = rotate_right(tree, node);
             break;
     }
     return node;
@@ -406,22 +1831,23 @@ static avl_node * left_balance_delete(avl_node *node, unsigned char *signal) {
 
 /**
  *  @brief      : Balance a 2x RHIGH node in an AVL tree (for deletion).
- *  @param      : [ Node to rebalance. ]
+ *  @param      : [ Tree (for its counters). ]
+ *                [ Node to rebalance. ]
  *  @return     : [ Node after rebalancing (may not be the same node). ]
 **/
-static avl_node * right_balance_delete(avl_node *node, unsigned char *signal) {
+static avl_node * right_balance_delete(avl_tree *tree, avl_node *node, unsigned char *signal) {
     avl_node *rsub, *rlsub;
     rsub = node->rchild;
     switch (rsub->balance) {
         case RHIGH:                                                 /* single rotation */
             node->balance = BAL;
             rsub->balance = BAL;
-            node = rotate_left(node);
+            node = rotate_left(tree, node);
             break;
         case BAL:                                                   /* single rotation */
             node->balance = RHIGH;
             rsub->balance = LHIGH;
-            node = rotate_left(node);
+            node = rotate_left(tree, node);
             *signal = 1;                /* height unchanged */
             break;
         case LHIGH:                                                 /* double rotation */
@@ -441,8 +1867,8 @@ static avl_node * right_balance_delete(avl_node *node, unsigned char *signal) {
                     break;
             }
             rlsub->balance = BAL;
-            node->rchild = rotate_right(rsub);
-            node = rotate_left(node);
+            node->rchild = rotate_right(tree, rsub);
+            node = rotate_left(tree, node);
             break;
     }
     return node;
@@ -450,17 +1876,18 @@ static avl_node * right_balance_delete(avl_node *node, unsigned char *signal) {
 
 /**
  *  @brief      : Balance a 2x LHIGH node in an AVL tree (for insertion).
- *  @param      : [ Node to rebalance. ]
+ *  @param      : [ Tree (for its counters). ]
+ *                [ Node to rebalance. ]
  *  @return     : [ Node after rebalancing (may not be the same node). ]
 **/
-static avl_node * left_balance_insert(avl_node *node) {
+static avl_node * left_balance_insert(avl_tree *tree, avl_node *node) {
     avl_node *lsub, *lrsub;
     lsub = node->lchild;
     switch (lsub->balance) {
         case LHIGH:                                                 /* single rotation */
             node->balance = BAL;
             lsub->balance = BAL;
-            node = rotate_right(node);
+            node = rotate_right(tree, node);
             break;
         case RHIGH:                                                 /* double rotation */
             lrsub = lsub->rchild;
@@ -479,8 +1906,8 @@ static avl_node * left_balance_insert(avl_node *node) {
                     break;
             }
             lrsub->balance = BAL;
-            node->lchild = rotate_left(lsub);
-            node = rotate_right(node);
+            node->lchild = rotate_left(tree, lsub);
+            node = rotate_right(tree, node);
             break;
     }
     return node;
@@ -488,17 +1915,18 @@ static avl_node * left_balance_insert(avl_node *node) {
 
 /**
  *  @brief      : Balance a 2x RHIGH node in an AVL tree (for insertion).
- *  @param      : [ Node to rebalance. ]
+ *  @param      : [ Tree (for its counters). ]
+ *                [ Node to rebalance. ]
  *  @return     : [ Node after rebalancing (may not be the same node). ]
 **/
-static avl_node * right_balance_insert(avl_node *node) {
+static avl_node * right_balance_insert(avl_tree *tree, avl_node *node) {
     avl_node *rsub, *rlsub;
     rsub = node->rchild;
     switch (rsub->balance) {
         case RHIGH:                                                 /* single rotation */
             node->balance = BAL;
             rsub->balance = BAL;
-            node = rotate_left(node);
+            node = rotate_left(tree, node);
             break;
         case LHIGH:                                                 /* double rotation */
             rlsub = rsub->lchild;
@@ -517,56 +1945,104 @@ static avl_node * right_balance_insert(avl_node *node) {
                     break;
             }
             rlsub->balance = BAL;
-            node->rchild = rotate_right(rsub);
-            node = rotate_left(node);
+            node->rchild = rotate_right(tree, rsub);
+            node = rotate_left(tree, node);
             break;
     }
     return node;
 }
 
 /**
- *  @brief      : Left rotation (AVL BST terminology).
- *  @param      : [ Node to rotate. ]
+ *  @brief      : Left rotation (AVL BST terminology). The rotated subtree keeps its size (and summary, if augmented),
+ *                  which is moved to the new root of the subtree, while that of the old root is recomputed from its new
+ *                  children.
+ *  @param      : [ Tree (for its counters). ]
+ *                [ Node to rotate. ]
  *  @return     : [ Node after rotation (may not be the same node). ]
 **/
-static avl_node * rotate_left(avl_node *node) {
+static avl_node * rotate_left(avl_tree *tree, avl_node *node) {
     avl_node *tmp = node->rchild;
+    INSTR_COUNT(tree, rotations);
     node->rchild = tmp->lchild;
     tmp->lchild = node;
+    tmp->size = node->size;
+    AVL_RESIZE(node);
+    if (tree->augment != NULL) {
+        memcpy(AVL_SUMMARY(tmp), AVL_SUMMARY(node), tree->augment->summary_size);
+        avl_summarize(tree, node);
+    }
     return tmp;
 }
 
 /**
- *  @brief      : Right rotation (AVL BST terminology).
- *  @param      : [ Node to rotate. ]
+ *  @brief      : Right rotation (AVL BST terminology). The rotated subtree keeps its size (and summary, if augmented),
+ *                  which is moved to the new root of the subtree, while that of the old root is recomputed from its new
+ *                  children.
+ *  @param      : [ Tree (for its counters). ]
+ *                [ Node to rotate. ]
  *  @return     : [ Node after rotation (may not be the same node). ]
 **/
-static avl_node * rotate_right(avl_node *node) {
+static avl_node * rotate_right(avl_tree *tree, avl_node *node) {
     avl_node *tmp = node->lchild;
+    INSTR_COUNT(tree, rotations);
     node->lchild = tmp->rchild;
     tmp->rchild = node;
+    tmp->size = node->size;
+    AVL_RESIZE(node);
+    if (tree->augment != NULL) {
+        memcpy(AVL_SUMMARY(tmp), AVL_SUMMARY(node), tree->augment->summary_size);
+        avl_summarize(tree, node);
+    }
     return tmp;
 }
 
 /**
- *  @brief      : Get the height of a tree, implementing breadth-first (level-by-level) traversal, using a queue.
+ *  @brief      : Get the height of a tree, descending from the root along the taller side of each node (the right
+ *                  child if it is right-high, else the left child), as told by its balance, so a single path of
+ *                  O(log n) nodes is visited. Once the tree is modified by an unbalanced function, balances are stale,
+ *                  so 'avl_height_bfs' is used instead.
  *  @param      : [ Tree. ]
  *  @return     : Height of tree.
 **/
 LENGTH_DT avl_height(avl_tree *tree) {
+    LENGTH_DT height = 0;
+
+    INSTR_ENTER(tree);
+    AVL_FLUSH(tree);
+    if (tree->unbalanced) {
+        height = avl_height_bfs(tree);
+    } else {
+        avl_node *node = tree->root;
+        while (node != NULL) {
+            height++;
+            INSTR_PATH(tree);
+            node = node->balance == RHIGH ? node->rchild : node->lchild;
+        }
+    }
+    INSTR_EXIT(tree);
+    return height;
+}
+
+/**
+ *  @brief      : (for internal use) Get the height of a tree, implementing breadth-first (level-by-level) traversal,
+ *                  using a queue. Does not rely on balances.
+ *  @param      : [ Tree. ]
+ *  @return     : Height of tree.
+**/
+static LENGTH_DT avl_height_bfs(avl_tree *tree) {
     ll_list *queue = ll_create();
     LENGTH_DT height = 0;
     avl_node *node = NULL;
 
     if (tree->root != NULL) {
-        ll_enqueue(queue, tree->root);
+        AVL_ENQUEUE(tree, queue, tree->root);
         while (queue->length != 0) {
             height++;
             LENGTH_DT fixed_length = queue->length;
             while (fixed_length-- != 0) {
                 node = ll_dequeue(queue);
-                if (node->lchild != NULL) { ll_enqueue(queue, node->lchild); }
-                if (node->rchild != NULL) { ll_enqueue(queue, node->rchild); }
+                if (node->lchild != NULL) { AVL_ENQUEUE(tree, queue, node->lchild); }
+                if (node->rchild != NULL) { AVL_ENQUEUE(tree, queue, node->rchild); }
             }
         }
     }
@@ -574,9 +2050,57 @@ LENGTH_DT avl_height(avl_tree *tree) {
     return height;
 }
 
+/**
+ *  @brief      : Get structural statistics of a tree. The no. of items and memory footprint (of a node per item, so an
+ *                  upper bound if nodes hold buckets) are known at once, and the height is found by 'avl_height'. If
+ *                  sampled, the nodes at evenly spread indices (the middle of each of 'n_samples' equal ranges) are
+ *                  located by index (read '@brief' of 'avl_get_node'), counting the depth of each. Sampling all nodes
+ *                  gives their exact average depth.
+ *  @param      : [ Tree. ]
+ *                [ Statistics to fill in. ]
+ *                [ No. of nodes to sample the depth of (0 for none, at least the no. of nodes for all). ]
+ *  @return     : None.
+**/
+void avl_stats(avl_tree *tree, avl_statistics *stats, LENGTH_DT n_samples) {
+    INSTR_ENTER(tree);
+    AVL_FLUSH(tree);
+    stats->length = tree->length;
+    stats->height = avl_height(tree);
+    stats->memory = sizeof(avl_tree) + (size_t) tree->length * AVL_NODE_SIZE(tree)
+                        + (size_t) tree->buffer_capacity * sizeof(DATA_TYPE)
+                        + (tree->finger != NULL ? AVL_MAX_HEIGHT * sizeof(avl_node *) : 0);
+    stats->n_samples = n_samples < tree->length ? n_samples : tree->length;
+    stats->avg_depth = 0.0, stats->max_depth = 0;
+
+    double sum = 0.0;
+    for (LENGTH_DT k = 0; k < stats->n_samples; k++) {
+        LENGTH_DT i = stats->n_samples == tree->length ? k : (LENGTH_DT) ((k + 0.5) * tree->length / stats->n_samples);
+        avl_node *curr_node = tree->root;
+        LENGTH_DT depth = 1;
+        while (i < AVL_SIZE(curr_node->lchild) || i >= AVL_SIZE(curr_node->lchild) + AVL_COUNT(curr_node)) {
+            LENGTH_DT lsize = AVL_SIZE(curr_node->lchild);
+            if (i < lsize) {
+                curr_node = curr_node->lchild;
+            } else {
+                i -= lsize + AVL_COUNT(curr_node);
+                curr_node = curr_node->rchild;
+            }
+            depth++;
+            INSTR_PATH(tree);
+        }
+        sum += depth;
+        if (depth > stats->max_depth) { stats->max_depth = depth; }
+    }
+    if (stats->n_samples != 0) { stats->avg_depth = sum / stats->n_samples; }
+    INSTR_EXIT(tree);
+}
+
 /**
  *  @brief      : Returns a list from a tree, using in-order traversal through a stack. Tree is unmodified.
- *                  (Note: For more info on in-order traversal, check '@brief' at 'avl_get_node'.)
+ *                  The left-child of the current element is continously pushed onto the stack, and set as the current
+ *                  element, until the current element is NULL. In that case, an item is popped, consumed, and then its
+ *                  right-child is set as the current element. The process then repeats while the current element is
+ *                  not NULL, or the stack is not empty.
  *  @param      : [ Tree. ]
  *  @return     : [ List. ]
 **/
@@ -584,39 +2108,107 @@ ll_list * avl_make_list(avl_tree *tree) {
     ll_list *list = ll_create();
     ll_list *stack = ll_create();
 
+    INSTR_ENTER(tree);
+    AVL_FLUSH(tree);
     avl_node *curr_node = tree->root;
     while (curr_node != NULL || stack->length != 0) {
         while (curr_node != NULL) {
-            ll_push(stack, curr_node);
+            AVL_PUSH(tree, stack, curr_node);
             curr_node = curr_node->lchild;
         }
         curr_node = ll_pop(stack);
-        ll_append(list, curr_node->data);
+        for (LENGTH_DT k = 0; k < AVL_COUNT(curr_node); k++) {
+            ll_append(list, AVL_ITEM(curr_node, k));
+        }
         curr_node = curr_node->rchild;
     }
     ll_destroy(stack);
+    INSTR_EXIT(tree);
     return list;
 }
 
 /**
- *  @brief      : (for internal use) Deallocate all nodes in a tree, through breadth-first traversal (level-by-level),
- *                  using a queue. Does not reset the tree length of root pointer, or deallocate it.
+ *  @brief      : Copies the items of a tree into an array, using in-order traversal through a stack (read '@brief' of
+ *                  'avl_make_array_subtree'). Tree is unmodified.
+ *                  (Note: For information on the traversal, read '@brief' of 'avl_make_list'.)
+ *  @param      : [ Tree. ]
+ *                [ Array to copy into. ]
+ *  @return     : None.
+**/
+void avl_make_array(avl_tree *tree, DATA_TYPE *arr) {
+    INSTR_ENTER(tree);
+    AVL_FLUSH(tree);
+    avl_make_array_subtree(tree, tree->root, arr);
+    INSTR_EXIT(tree);
+}
+
+/**
+ *  @brief      : Copies the items of a subtree into an array, using in-order traversal through a stack, like
+ *                  'avl_make_array'. If the stack cannot be allocated, the tree is marked as failed, and fewer items are
+ *                  copied.
+ *  @param      : [ Tree. ]
+ *                [ Root of the subtree. ]
+ *                [ Array to copy into. ]
+ *  @return     : No. of items copied.
+**/
+LENGTH_DT avl_make_array_subtree(avl_tree *tree, avl_node *root, DATA_TYPE *arr) {
+    ll_list *stack = avl_create_stack(tree);
+    avl_node *curr_node = root;
+    LENGTH_DT i = 0;
+
+    while (stack != NULL && (curr_node != NULL || stack->length != 0)) {
+        while (curr_node != NULL) {
+            AVL_PUSH(tree, stack, curr_node);
+            curr_node = curr_node->lchild;
+        }
+        if (avl_stack_failed(tree, stack)) {
+            break;
+        }
+        curr_node = ll_pop(stack);
+        i += avl_node_items(curr_node, arr + i);
+        curr_node = curr_node->rchild;
+    }
+    if (stack != NULL) { ll_destroy(stack); }
+    return i;
+}
+
+/**
+ *  @brief      : Copies the items of a node (its own, then those of its bucket) into an array.
+ *  @param      : [ Node. ]
+ *                [ Array to copy into. ]
+ *  @return     : No. of items copied.
+**/
+LENGTH_DT avl_node_items(avl_node *node, DATA_TYPE *arr) {
+    arr[0] = node->data;
+    if (node->bucket == NULL) {
+        return 1;
+    }
+    memcpy(arr + 1, node->bucket->items + node->bucket->start, node->bucket->length * sizeof(DATA_TYPE));
+    return node->bucket->length + 1;
+}
+
+/**
+ *  @brief      : (for internal use) Deallocate all nodes of a tree from a root, through breadth-first traversal
+ *                  (level-by-level), using a queue. Does not reset the tree length of root pointer, or deallocate it.
  *  @param      : [ Tree. ]
+ *                [ Root of the nodes. ]
  *  @return     : None.
 **/
-static void avl_deallocate_all(avl_tree *tree) {
+static void avl_deallocate_all(avl_tree *tree, avl_node *root) {
     ll_list *queue = ll_create();
     avl_node *node = NULL;
 
-    if (tree->root != NULL) {
-        ll_enqueue(queue, tree->root);
+    if (root != NULL) {
+        AVL_ENQUEUE(tree, queue, root);
         while (queue->length != 0) {
             LENGTH_DT fixed_length = queue->length;
             while (fixed_length-- != 0) {
                 node = ll_dequeue(queue);
-                if (node->lchild != NULL) { ll_enqueue(queue, node->lchild); }
-                if (node->rchild != NULL) { ll_enqueue(queue, node->rchild); }
-                free(node);
+                if (node->lchild != NULL) { AVL_ENQUEUE(tree, queue, node->lchild); }
+                if (node->rchild != NULL) { AVL_ENQUEUE(tree, queue, node->rchild); }
+                if (node->bucket != NULL) { AVL_FREE(tree, node->bucket, AVL_BUCKET_SIZE(node->bucket->capacity)); }
+                AVL_FREE(tree, node, AVL_NODE_SIZE(tree));
+                INSTR_COUNT(tree, frees);
             }
         }
     }
@@ -624,22 +2216,52 @@ static void avl_deallocate_all(avl_tree *tree) {
 }
 
 /**
- *  @brief      : Deletes (free) all nodes in a tree, then resets the tree root pointer and length.
+ *  @brief      : De-allocates the nodes of a subtree (read '@brief' of 'avl_deallocate_all').
+ *  @param      : [ Tree. ]
+ *                [ Root of the subtree. ]
+ *  @return     : None.
+**/
+void avl_delete_subtree(avl_tree *tree, avl_node *root) {
+    avl_deallocate_all(tree, root);
+}
+
+/**
+ *  @brief      : Deletes (free) all nodes in a tree, then resets the tree root pointer and length. If the allocator
+ *                  supports it (and no de-allocation function is set), all nodes are de-allocated at once.
  *  @param      : [ Tree. ]
  *  @return     : None.
 **/
 void avl_delete_all(avl_tree *tree) {
-    avl_deallocate_all(tree);
+    INSTR_ENTER(tree);
+    if (AVL_FREE_ALL(tree)) {
+        tree->allocator->f_free_all(tree->allocator->ctx);
+    } else {
+        avl_deallocate_all(tree, tree->root);
+    }
     tree->root = NULL, tree->length = 0;
+    tree->min = tree->max = NULL;
+    tree->unbalanced = 0;
+    tree->buffer_length = tree->buffer_sorted = 0;
+    tree->finger_depth = 0;
+    INSTR_EXIT(tree);
 }
 
 /**
- *  @brief      : Deletes (free) all nodes in a tree, then deletes the tree itself.
+ *  @brief      : Deletes (free) all nodes in a tree (at once, like 'avl_delete_all', if supported), then deletes the
+ *                  tree itself.
  *  @param      : [ Tree. ]
  *  @return     : None.
 **/
 void avl_destroy(avl_tree *tree) {
-    avl_deallocate_all(tree);
+    INSTR_ENTER(tree);
+    if (AVL_FREE_ALL(tree)) {
+        tree->allocator->f_free_all(tree->allocator->ctx);
+    } else {
+        avl_deallocate_all(tree, tree->root);
+    }
+    INSTR_EXIT(tree);
+    free(tree->buffer);
+    free(tree->finger);
     free(tree);
 }
 
@@ -661,8 +2283,9 @@ void avl_print(avl_tree *tree, void (*f_print)(DATA_TYPE data), unsigned char un
     unsigned int factor = 0;
     LENGTH_DT fixed_length;
 
+    INSTR_ENTER(tree);
     for (int i = 1; i < height; i++) { factor = factor * 2 + 1; }
-    ll_enqueue(queue, tree->root);
+    AVL_ENQUEUE(tree, queue, tree->root);
     while (height-- != 0) {
         fixed_length = queue->length;
         while (fixed_length-- != 0) {
@@ -672,18 +2295,19 @@ void avl_print(avl_tree *tree, void (*f_print)(DATA_TYPE data), unsigned char un
              /* printf("[%2d]", node->balance); */
                 f_print(node->data);                       
                 putchar_n(' ', (factor+1)*unit_size);
-                ll_enqueue(queue, node->lchild);
-                ll_enqueue(queue, node->rchild);
+                AVL_ENQUEUE(tree, queue, node->lchild);
+                AVL_ENQUEUE(tree, queue, node->rchild);
             } else {
                 putchar_n(' ', (factor + 1 << 1)*unit_size);
-                ll_enqueue(queue, NULL);
-                ll_enqueue(queue, NULL);
+                AVL_ENQUEUE(tree, queue, NULL);
+                AVL_ENQUEUE(tree, queue, NULL);
             }
         }
         factor = factor - 1 >> 1;
         putchar('\n');
     }
     ll_destroy(queue);
+    INSTR_EXIT(tree);
 }
 
 /**
@@ -703,6 +2327,7 @@ static void putchar_n(char c, unsigned int n) {
 #define LEN(ARR) (*(&ARR+1)-ARR)
 
 unsigned char f_compare(void *new_data, void *old_data);
+int f_compare3(void *new_data, void *old_data);
 void f_print(void *data);
 void f_print_ll(void *data);
 void f_clean_ll(ll_list *list);
@@ -713,6 +2338,19 @@ void t_delete_unbalanced();
 void t_delete();
 void t_get();
 void t_make_list();
+void t_get_many();
+void t_find();
+void t_min_max();
+void t_stats();
+void t_bulk_load();
+void t_buffered();
+void t_finger();
+void t_multiset();
+void t_augment();
+LENGTH_DT t_nodes(avl_node *node);
+void * f_next(void *arg);
+LENGTH_DT t_height(avl_node *node);
+unsigned char t_valid(avl_node *node);
 
 int main() {
     t_insert_unbalanced();
@@ -721,9 +2359,418 @@ int main() {
     t_delete();
     t_get();
     t_make_list();
+    t_get_many();
+    t_find();
+    t_min_max();
+    t_stats();
+    t_bulk_load();
+    t_buffered();
+    t_finger();
+    t_multiset();
+    t_augment();
     return 0;
 }
 
+void t_stats() {
+    printf("*************** TEST (HEIGHT/STATS) ***************\n");
+    avl_tree *tree = avl_create();
+    avl_statistics stats;
+    int arr_data[1000];
+    for (int i = 0; i < LEN(arr_data); i++) {
+        arr_data[i] = (i * 7919) % LEN(arr_data);
+        avl_insert(tree, arr_data+i, f_compare);
+        if (avl_height(tree) != t_height(tree->root)) {
+            printf("Height mismatch after inserting %d\n", arr_data[i]);
+        }
+    }
+    for (int i = 0; i < 500; i++) {
+        avl_delete(tree, (i * 31) % tree->length, f_compare);
+        if (avl_height(tree) != t_height(tree->root)) {
+            printf("Height mismatch after deleting\n");
+        }
+    }
+    LENGTH_DT arr_samples[] = {0, 16, 1000};
+    for (int i = 0; i < LEN(arr_samples); i++) {
+        avl_stats(tree, &stats, arr_samples[i]);
+        printf("Samples: %ld -> length: %ld, height: %ld, memory: %lu, avg. depth: %.2f, max. depth: %ld\n",
+                (long) arr_samples[i], (long) stats.length, (long) stats.height, (unsigned long) stats.memory,
+                stats.avg_depth, (long) stats.max_depth);
+    }
+    avl_insert_unbalanced(tree, arr_data, f_compare);
+    printf("Height (unbalanced): %ld, expected: %ld\n", (long) avl_height(tree), (long) t_height(tree->root));
+    avl_destroy(tree);
+}
+
+void t_bulk_load() {
+    printf("*************** TEST (BULK-LOAD) ***************\n");
+    int arr_data[1000];
+    for (int i = 0; i < LEN(arr_data); i++) { arr_data[i] = 2 * i; }
+    LENGTH_DT arr_n[] = {0, 1, 2, 3, 7, 10, 1000};
+    for (int k = 0; k < LEN(arr_n); k++) {
+        avl_tree *tree = avl_create();
+        int *next = arr_data;
+        avl_bulk_load(tree, arr_n[k], f_next, &next);
+        unsigned char is_sorted = 1;
+        for (LENGTH_DT i = 0; i < tree->length; i++) {
+            is_sorted &= avl_get(tree, i) == arr_data + i;
+        }
+        int key = 5;
+        avl_insert(tree, &key, f_compare);
+        if (tree->length > 1) { avl_delete(tree, tree->length / 2, f_compare); }
+        printf("n: %ld -> sorted: %d, height: %ld, expected: %ld, min: %d, max: %d\n", (long) arr_n[k], is_sorted,
+                (long) avl_height(tree), (long) t_height(tree->root), *((int *) avl_min(tree)), *((int *) avl_max(tree)));
+        avl_destroy(tree);
+    }
+}
+
+void t_buffered() {
+    printf("*************** TEST (BUFFERED) ***************\n");
+    avl_tree *tree = avl_create();
+    int arr_data[300], arr_sorted[300], arr_keys[] = {-1, 0, 150, 299, 300};
+    unsigned char is_correct = 1;
+    avl_insert_buffered(tree, arr_keys);                /* no comparison function set yet */
+    printf("Unset -> length: %ld, failed: %d\n", (long) tree->length, tree->failed);
+    tree->failed = 0;
+    avl_set_buffer(tree, 0, f_compare);
+    avl_insert_buffered(tree, arr_keys);                /* no buffer, so inserted at once */
+    printf("Unbuffered -> length: %ld, buffered: %ld, failed: %d\n", (long) tree->length, (long) tree->buffer_length,
+            tree->failed);
+    avl_delete(tree, 0, f_compare);
+    avl_set_buffer(tree, 16, f_compare);
+    for (int i = 0; i < LEN(arr_data); i++) {
+        arr_data[i] = (i * 7919) % 150;                 /* each key twice */
+        if (i % 50 == 49) {
+            avl_insert(tree, arr_data + i, f_compare);  /* mixed with unbuffered inserts */
+        } else {
+            avl_insert_buffered(tree, arr_data + i);
+        }
+        if (i % 7 == 0) {                               /* reads must see buffered items */
+            int n = 0;
+            for (int j = 0; j <= i; j++) {
+                int k = n++;
+                while (k > 0 && arr_sorted[k - 1] > arr_data[j]) { arr_sorted[k] = arr_sorted[k - 1], k--; }
+                arr_sorted[k] = arr_data[j];
+            }
+            for (int j = 0; j <= i; j++) {
+                is_correct &= *((int *) avl_get(tree, j)) == arr_sorted[j];
+                is_correct &= avl_rank(tree, arr_sorted + j, f_compare) == (LENGTH_DT) (j == 0 || arr_sorted[j - 1] != arr_sorted[j]
+                                    ? j : avl_rank(tree, arr_sorted + j - 1, f_compare));
+                is_correct &= *((int *) avl_find(tree, arr_sorted + j, f_compare)) == arr_sorted[j];
+            }
+            is_correct &= *((int *) avl_min(tree)) == arr_sorted[0] && *((int *) avl_max(tree)) == arr_sorted[i];
+            is_correct &= *((int *) avl_get(tree, -1)) == arr_sorted[i] && tree->length == i + 1;
+        }
+    }
+    printf("Length: %ld, buffered: %ld, correct: %d\n", (long) tree->length, (long) tree->buffer_length, is_correct);
+    printf("find(-1): %p, rank(-1): %ld, rank(150): %ld\n", avl_find(tree, arr_keys, f_compare),
+            (long) avl_rank(tree, arr_keys, f_compare), (long) avl_rank(tree, arr_keys + 2, f_compare));
+    avl_flush(tree);
+    printf("Flushed -> length: %ld, buffered: %ld, height: %ld, expected: %ld\n", (long) tree->length,
+            (long) tree->buffer_length, (long) avl_height(tree), (long) t_height(tree->root));
+    for (int i = 0; i < 20; i++) {                      /* flush triggered by a delete */
+        avl_insert_buffered(tree, arr_keys + 4);
+    }
+    avl_delete(tree, 0, f_compare);
+    printf("Delete -> length: %ld, buffered: %ld, max: %d, height: %ld, expected: %ld\n", (long) tree->length,
+            (long) tree->buffer_length, *((int *) avl_max(tree)), (long) avl_height(tree), (long) t_height(tree->root));
+    avl_destroy(tree);
+}
+
+void t_finger() {
+    printf("*************** TEST (FINGER) ***************\n");
+    const char *arr_names[] = {"increasing", "decreasing", "nearly sorted", "random", "mixed"};
+    int arr_data[2000];
+    for (int k = 0; k < LEN(arr_names); k++) {
+        avl_tree *tree = avl_create();
+        int *arr_sorted[LEN(arr_data)];
+        unsigned char is_correct = 1;
+        for (int i = 0; i < LEN(arr_data); i++) {
+            switch (k) {
+                case 0: arr_data[i] = i / 2; break;                                 /* each key twice */
+                case 1: arr_data[i] = LEN(arr_data) - i; break;
+                case 2: arr_data[i] = i + (i * 7919) % 50; break;
+                default: arr_data[i] = (i * 7919) % 500; break;
+            }
+            if (k == 4 && i % 100 == 50) {
+                avl_insert(tree, arr_data + i, f_compare);                        /* resets the finger */
+            } else {
+                avl_insert_finger(tree, arr_data + i, f_compare);
+            }
+            if (k == 4 && i % 100 == 99) {
+                int *data = avl_delete(tree, tree->length / 3, f_compare);
+                *data = -1;                                                         /* marks it deleted */
+            }
+        }
+        int n = 0;                                                                  /* stable (insertion) order */
+        for (int i = 0; i < LEN(arr_data); i++) {
+            if (arr_data[i] < 0) { continue; }
+            int j = n++;
+            while (j > 0 && *arr_sorted[j - 1] > arr_data[i]) { arr_sorted[j] = arr_sorted[j - 1], j--; }
+            arr_sorted[j] = arr_data + i;
+        }
+        is_correct &= tree->length == n && t_valid(tree->root);
+        for (int i = 0; i < n; i++) {
+            is_correct &= avl_get(tree, i) == arr_sorted[i];
+        }
+        is_correct &= avl_min(tree) == arr_sorted[0] && avl_max(tree) == arr_sorted[n - 1];
+        printf("%s -> length: %ld, height: %ld, expected: %ld, correct: %d\n", arr_names[k], (long) tree->length,
+                (long) avl_height(tree), (long) t_height(tree->root), is_correct);
+        avl_destroy(tree);
+    }
+}
+
+void t_multiset() {
+    printf("*************** TEST (MULTISET) ***************\n");
+    avl_tree *tree = avl_create();
+    int arr_data[3000], arr_keys[] = {0, 25, 49, 50, -1};
+    int *arr_sorted[LEN(arr_data) + 1];
+    unsigned char is_correct = 1, is_valid = 1;
+    int n = 0;
+    for (int i = 0; i < LEN(arr_data); i++) {
+        arr_data[i] = (i * 7919) % 50;                                              /* each key 60 times */
+        avl_insert_multi(tree, arr_data + i, f_compare3);
+        int j = n++;                                                                /* stable (insertion) order */
+        while (j > 0 && *arr_sorted[j - 1] > arr_data[i]) { arr_sorted[j] = arr_sorted[j - 1], j--; }
+        arr_sorted[j] = arr_data + i;
+    }
+    printf("Length: %ld, nodes: %ld, height: %ld, expected: %ld, valid: %d\n", (long) tree->length,
+            (long) t_nodes(tree->root), (long) avl_height(tree), (long) t_height(tree->root), t_valid(tree->root));
+    for (int k = 0; k < LEN(arr_keys); k++) {
+        printf("count(%d): %ld, rank: %ld\n", arr_keys[k], (long) avl_count(tree, arr_keys + k, f_compare),
+                (long) avl_rank(tree, arr_keys + k, f_compare));
+    }
+    for (int i = 0; i < n; i++) {
+        is_correct &= avl_get(tree, i) == arr_sorted[i];
+    }
+    is_correct &= avl_min(tree) == arr_sorted[0] && avl_max(tree) == arr_sorted[n - 1];
+    DATA_TYPE *arr = (DATA_TYPE *) malloc(n * sizeof(DATA_TYPE));                /* subtrees of the root copied apart */
+    LENGTH_DT lsize = avl_make_array_subtree(tree, tree->root->lchild, arr);
+    LENGTH_DT count = avl_node_items(tree->root, arr + lsize);
+    is_correct &= lsize + count + avl_make_array_subtree(tree, tree->root->rchild, arr + lsize + count) == n;
+    for (int i = 0; i < n; i++) {
+        is_correct &= arr[i] == arr_sorted[i];
+    }
+    free(arr);
+    for (int k = 0; k < 2950; k++) {                                                /* front, back, and middle */
+        LENGTH_DT i = k % 3 == 0 ? 0 : (k % 3 == 1 ? tree->length - 1 : (k * 7) % tree->length);
+        DATA_TYPE data = k < 2900 ? avl_delete(tree, i, f_compare) : avl_delete_unbalanced(tree, i, f_compare);
+        is_correct &= data == arr_sorted[i];
+        memmove(arr_sorted + i, arr_sorted + i + 1, (--n - i) * sizeof(int *));
+        if (k == 2899) { is_valid = t_valid(tree->root); }
+    }
+    avl_insert(tree, arr_keys + 1, f_compare);                                      /* a separate equal node */
+    int j = n++;
+    while (j > 0 && *arr_sorted[j - 1] > arr_keys[1]) { arr_sorted[j] = arr_sorted[j - 1], j--; }
+    arr_sorted[j] = arr_keys + 1;
+    ll_list *list = avl_make_list(tree);
+    for (int i = 0; i < n; i++) {
+        is_correct &= avl_get(tree, i) == arr_sorted[i] && ll_get(list, i) == arr_sorted[i];
+    }
+    printf("Deleted -> length: %ld, nodes: %ld, count(25): %ld, valid: %d, correct: %d\n", (long) tree->length,
+            (long) t_nodes(tree->root), (long) avl_count(tree, arr_keys + 1, f_compare), is_valid, is_correct);
+    ll_destroy(list);
+    avl_destroy(tree);
+}
+
+/**
+ *  @brief      : Summary of a range of items (for testing augmented trees): their sum, and whether they are in order, so
+ *                  that summaries combined out of order are detected.
+**/
+typedef struct T_SUMMARY {
+    long sum;
+    int count;
+    int first;
+    int last;
+    int ordered;
+} t_summary;
+
+const t_summary t_identity = {0, 0, 0, 0, 1};
+
+void t_summarize(void *summary, void *data) {
+    t_summary *dest = (t_summary *) summary;
+    dest->sum = dest->first = dest->last = *((int *) data);
+    dest->count = dest->ordered = 1;
+}
+
+void t_combine(void *summary, const void *left, const void *right) {
+    const t_summary *l = (const t_summary *) left, *r = (const t_summary *) right;
+    t_summary result = l->count == 0 ? *r : *l;
+    if (l->count != 0 && r->count != 0) {
+        result.sum = l->sum + r->sum, result.count = l->count + r->count;
+        result.last = r->last;
+        result.ordered = l->ordered && r->ordered && l->last <= r->first;
+    }
+    *((t_summary *) summary) = result;
+}
+
+unsigned char t_summaries(avl_node *node, t_summary *summary) {
+    t_summary left, right, item;
+    if (node == NULL) {
+        *summary = t_identity;
+        return 1;
+    }
+    unsigned char is_valid = t_summaries(node->lchild, &left) & t_summaries(node->rchild, &right);
+    *summary = left;
+    for (LENGTH_DT k = 0; k < AVL_COUNT(node); k++) {
+        t_summarize(&item, AVL_ITEM(node, k));
+        t_combine(summary, summary, &item);
+    }
+    t_combine(summary, summary, &right);
+    return is_valid && memcmp(summary, AVL_SUMMARY(node), sizeof(t_summary)) == 0;
+}
+
+unsigned char t_ranges(avl_tree *tree) {
+    DATA_TYPE *arr = (DATA_TYPE *) malloc((tree->length + 1) * sizeof(DATA_TYPE));
+    t_summary expected, result, item;
+    unsigned char is_correct = 1;
+    avl_make_array(tree, arr);
+    for (int q = 0; q < 200; q++) {
+        int lo = (q * 7919) % 520 - 10, hi = lo + (q * 104729) % (q % 2 == 0 ? 20 : 600) - 5;
+        expected = t_identity;
+        for (LENGTH_DT i = 0; i < tree->length; i++) {
+            int key = *((int *) arr[i]);
+            if (key >= lo && key <= hi) {
+                t_summarize(&item, arr[i]);
+                t_combine(&expected, &expected, &item);
+            }
+        }
+        avl_reduce_range(tree, &lo, &hi, &result, f_compare);
+        is_correct &= memcmp(&expected, &result, sizeof(t_summary)) == 0 && result.ordered;
+    }
+    free(arr);
+    return is_correct;
+}
+
+void t_augment() {
+    printf("*************** TEST (AUGMENT) ***************\n");
+    avl_augment augment = {sizeof(t_summary), t_summarize, t_combine, &t_identity};
+    avl_augment oversized = {AVL_MAX_SUMMARY + 1, t_summarize, t_combine, &t_identity};
+    avl_tree *tree = avl_create_augmented(&augment, NULL);
+    int arr_data[3000];
+    int *arr_sorted[LEN(arr_data)];
+    t_summary summary;
+    printf("Oversized: %s\n", avl_create_augmented(&oversized, NULL) == NULL ? "rejected" : "accepted");
+    avl_set_buffer(tree, 0, f_compare);
+    for (int i = 0; i < LEN(arr_data); i++) {
+        arr_data[i] = (i * 7919) % 500;
+        switch (i % 6) {
+            case 0: avl_insert(tree, arr_data + i, f_compare); break;
+            case 1: avl_insert_finger(tree, arr_data + i, f_compare); break;
+            case 2: avl_insert_multi(tree, arr_data + i, f_compare3); break;
+            case 3: avl_insert_buffered(tree, arr_data + i); break;
+            case 4: avl_insert(tree, arr_data + i, f_compare); break;
+            default: avl_delete(tree, (i * 31) % tree->length, f_compare); break;
+        }
+        if (i == 1000) { avl_set_buffer(tree, 64, f_compare); }
+        if (i % 500 == 499) { avl_pop_min(tree), avl_pop_max(tree); }
+    }
+    printf("Balanced -> length: %ld, valid: %d, summaries: %d, ranges: %d\n", (long) tree->length,
+            t_valid(tree->root), t_summaries(tree->root, &summary), t_ranges(tree));
+
+    for (int i = 0; i < LEN(arr_data); i++) {
+        arr_data[i] = i / 6;
+        arr_sorted[i] = arr_data + i;
+    }
+    int **next = arr_sorted;
+    avl_bulk_load(tree, LEN(arr_data), f_next, &next);
+    printf("Bulk loaded -> length: %ld, valid: %d, summaries: %d, ranges: %d\n", (long) tree->length,
+            t_valid(tree->root), t_summaries(tree->root, &summary), t_ranges(tree));
+
+    for (int i = 0; i < 1500; i++) {                                                /* balances are stale from here */
+        switch (i % 3) {
+            case 0: avl_insert_unbalanced(tree, arr_data + (i * 7) % LEN(arr_data), f_compare); break;
+            case 1: avl_insert_multi(tree, arr_data + (i * 13) % LEN(arr_data), f_compare3); break;
+            default: avl_delete_unbalanced(tree, (i * 31) % tree->length, f_compare); break;
+        }
+    }
+    printf("Unbalanced -> length: %ld, summaries: %d, ranges: %d\n", (long) tree->length,
+            t_summaries(tree->root, &summary), t_ranges(tree));
+    avl_destroy(tree);
+}
+
+LENGTH_DT t_nodes(avl_node *node) {
+    return node == NULL ? 0 : t_nodes(node->lchild) + t_nodes(node->rchild) + 1;
+}
+
+void * f_next(void *arg) {
+    int **next = (int **) arg;
+    return (*next)++;
+}
+
+LENGTH_DT t_height(avl_node *node) {
+    if (node == NULL) { return 0; }
+    LENGTH_DT lheight = t_height(node->lchild), rheight = t_height(node->rchild);
+    return (lheight > rheight ? lheight : rheight) + 1;
+}
+
+unsigned char t_valid(avl_node *node) {
+    if (node == NULL) { return 1; }
+    return t_valid(node->lchild) && t_valid(node->rchild) && node->size == AVL_SIZE(node->lchild) + AVL_SIZE(node->rchild) + AVL_COUNT(node)
+            && node->balance == t_height(node->lchild) - t_height(node->rchild);
+}
+
+void t_min_max() {
+    printf("*************** TEST (MIN/MAX) ***************\n");
+    avl_tree *tree = avl_create();
+    int arr_data[] = {8, 3, 12, 1, 15, 6, 10, 2, 14, 5, 9, 13, 4, 11, 7};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        avl_insert(tree, arr_data+i, f_compare);
+    }
+    avl_print(tree, f_print, 4);
+    for (int i = 0; i < 3; i++) {
+        printf("Min: %d, Max: %d\n", *((int *) avl_min(tree)), *((int *) avl_max(tree)));
+        printf("Popping min: %d\n", *((int *) avl_pop_min(tree)));
+        printf("Popping max: %d\n", *((int *) avl_pop_max(tree)));
+        avl_print(tree, f_print, 4);
+    }
+    printf("Min: %d, Max: %d\n", *((int *) avl_min(tree)), *((int *) avl_max(tree)));
+    avl_destroy(tree);
+}
+
+void t_get_many() {
+    printf("*************** TEST (GET-MANY) ***************\n");
+    avl_tree *tree = avl_create();
+    int arr_data[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        avl_insert(tree, arr_data+i, f_compare);
+    }
+    avl_print(tree, f_print, 4);
+    LENGTH_DT arr_index[] = {5, 8, 1, -1, 3, 14, 0, 15, -16};
+    void *arr_result[LEN(arr_index)];
+    avl_get_many(tree, arr_index, LEN(arr_index), arr_result);
+    for (int i = 0; i < LEN(arr_index); i++) {
+        printf("Getting (i=%ld)\n", (long) arr_index[i]);
+        if (arr_result[i] != NULL) {
+            printf("%d\n", *((int *) arr_result[i]));
+        } else {
+            printf("Not found\n");
+        }
+    }
+    avl_destroy(tree);
+}
+
+void t_find() {
+    printf("*************** TEST (FIND/FIND-MANY/RANK) ***************\n");
+    avl_tree *tree = avl_create();
+    int arr_data[] = {2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        avl_insert(tree, arr_data+i, f_compare);
+    }
+    avl_print(tree, f_print, 4);
+    int arr_key[] = {2, 3, 16, 17, 30, 31, 0, 24};
+    void *arr_keys[LEN(arr_key)], *arr_result[LEN(arr_key)];
+    for (int i = 0; i < LEN(arr_key); i++) {
+        arr_keys[i] = arr_key+i;
+    }
+    avl_find_many(tree, arr_keys, LEN(arr_key), arr_result, f_compare);
+    for (int i = 0; i < LEN(arr_key); i++) {
+        void *found = avl_find(tree, arr_keys[i], f_compare);
+        printf("Finding: %d -> %s, %s, rank: %ld\n", arr_key[i], found != NULL ? "found" : "not found",
+                arr_result[i] != NULL ? "found" : "not found", (long) avl_rank(tree, arr_keys[i], f_compare));
+    }
+    avl_destroy(tree);
+}
+
 void t_make_list() {
     printf("*************** TEST (MAKE-LIST) ***************\n");
     avl_tree *tree = avl_create();
@@ -851,6 +2898,10 @@ void t_insert() {
     avl_destroy(tree);
 }
 
+int f_compare3(void *new_data, void *old_data) {
+    return (*((int *) new_data) > *((int *) old_data)) - (*((int *) new_data) < *((int *) old_data));
+}
+
 unsigned char f_compare(void *new_data, void *old_data) {
     return *((int *) new_data) < *((int *) old_data) ? 1 : 0;
 }
@@ -867,4 +2918,86 @@ void f_print_ll(void *data) {
     printf("%d, ", *((int *) data));
 }
 
-#endif
\ No newline at end of file
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_AVL_TREE_                 /* compile-time switch */
+
+#include <time.h>
+
+unsigned char f_compare(void *new_data, void *old_data);
+
+double elapsed_ns(clock_t start, LENGTH_DT ops);
+
+/**
+ *  @brief      : Benchmark of batched lookups ('avl_find_many', 'avl_get_many') against one-at-a-time lookups
+ *                  ('avl_find', 'avl_get'), on a tree of random keys. The tree should be larger than the last-level cache.
+ *                  (Usage: <no. of items (default: 2^22)> <no. of lookups (default: 2^20)>)
+**/
+int main(int argc, char *argv[]) {
+    LENGTH_DT n = argc > 1 ? atol(argv[1]) : 1L << 22;
+    LENGTH_DT m = argc > 2 ? atol(argv[2]) : 1L << 20;
+    int *arr_data = (int *) malloc(n * sizeof(int));
+    void **arr_keys = (void **) malloc(m * sizeof(void *));
+    LENGTH_DT *arr_index = (LENGTH_DT *) malloc(m * sizeof(LENGTH_DT));
+    void **arr_result = (void **) malloc(m * sizeof(void *));
+    avl_tree *tree = avl_create();
+    LENGTH_DT checksum = 0;
+    clock_t start;
+
+    srand(1);
+    for (LENGTH_DT i = 0; i < n; i++) {
+        arr_data[i] = (int) i;
+    }
+    for (LENGTH_DT i = n - 1; i > 0; i--) {                             /* shuffle */
+        LENGTH_DT j = ((LENGTH_DT) rand() * RAND_MAX + rand()) % (i + 1);
+        int tmp = arr_data[i];
+        arr_data[i] = arr_data[j], arr_data[j] = tmp;
+    }
+    for (LENGTH_DT i = 0; i < n; i++) {
+        avl_insert(tree, arr_data+i, f_compare);
+    }
+    for (LENGTH_DT i = 0; i < m; i++) {
+        arr_keys[i] = arr_data + ((LENGTH_DT) rand() * RAND_MAX + rand()) % n;
+        arr_index[i] = ((LENGTH_DT) rand() * RAND_MAX + rand()) % n;
+    }
+    printf("items: %ld, lookups: %ld\n", (long) n, (long) m);
+
+    start = clock();
+    for (LENGTH_DT i = 0; i < m; i++) {
+        checksum += avl_find(tree, arr_keys[i], f_compare) != NULL;
+    }
+    printf("avl_find      : %8.1f ns/lookup\n", elapsed_ns(start, m));
+
+    start = clock();
+    avl_find_many(tree, arr_keys, m, arr_result, f_compare);
+    printf("avl_find_many : %8.1f ns/lookup\n", elapsed_ns(start, m));
+    for (LENGTH_DT i = 0; i < m; i++) { checksum += arr_result[i] != NULL; }
+
+    start = clock();
+    for (LENGTH_DT i = 0; i < m; i++) {
+        checksum += avl_get(tree, arr_index[i]) != NULL;
+    }
+    printf("avl_get       : %8.1f ns/lookup\n", elapsed_ns(start, m));
+
+    start = clock();
+    avl_get_many(tree, arr_index, m, arr_result);
+    printf("avl_get_many  : %8.1f ns/lookup\n", elapsed_ns(start, m));
+    for (LENGTH_DT i = 0; i < m; i++) { checksum += arr_result[i] != NULL; }
+
+    printf("(checksum: %ld)\n", (long) checksum);
+    avl_destroy(tree);
+    free(arr_data), free(arr_keys), free(arr_index), free(arr_result);
+    return 0;
+}
+
+double elapsed_ns(clock_t start, LENGTH_DT ops) {
+    return (double) (clock() - start) / CLOCKS_PER_SEC * 1e9 / ops;
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return *((int *) new_data) < *((int *) old_data) ? 1 : 0;
+}
+
+#endif
@@ -15,9 +15,35 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include "shared_defs.h"
+#include "instrument.h"
+#include "allocator.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Summary of a node of an augmented tree (see 'avl_create_augmented'), stored right after the node (and
+ *                  aligned as it is), covering the items of its subtree.
+**/
+#define AVL_SUMMARY(node)       ((void *) ((node) + 1))
+
+/**
+ *  @brief      : Max. size (in bytes) of a summary.
+**/
+#define AVL_MAX_SUMMARY         64
 
 /* ********************* struct(s) SECTION ********************** */
 
+/**
+ *  @brief      : (For internal use) Items of a node equal to its own, inserted after it by 'avl_insert_multi' (a deque,
+ *                  holding 'length' items from 'items[start]').
+**/
+typedef struct AVL_BUCKET {
+    LENGTH_DT start;
+    LENGTH_DT length;
+    LENGTH_DT capacity;
+    DATA_TYPE items[];
+} avl_bucket;
+
 /**
  *  @brief      : Node structure (where items are stored).
 **/
@@ -25,17 +51,61 @@ typedef struct AVL_NODE {
     struct AVL_NODE *lchild;
     struct AVL_NODE *rchild;
     DATA_TYPE data;
+    avl_bucket *bucket;                             /* more items equal to 'data', that follow it (or NULL) */
+    LENGTH_DT size;                                 /* no. of items in the subtree rooted at this node (buckets included) */
     signed char balance;
 } avl_node;
 
+/**
+ *  @brief      : Augmentation of a tree (see 'avl_create_augmented'): how to summarize a range of items (e.g: their sum,
+ *                  min or max), from the summaries of its parts. 'f_combine' must be associative (not necessarily
+ *                  commutative, since its ranges are passed in order), and 'identity' neutral to it.
+**/
+typedef struct AVL_AUGMENT {
+    size_t summary_size;                            /* bytes of a summary (at most 'AVL_MAX_SUMMARY') */
+    void (*f_summarize)(void *summary, DATA_TYPE data);                             /* sets the summary of an item */
+    void (*f_combine)(void *summary, const void *left, const void *right);          /* may be either of 'left' and 'right' */
+    const void *identity;                           /* summary of no items */
+} avl_augment;
+
 /**
  *  @brief      : Tree structure.
 **/
 typedef struct AVL_TREE {
     avl_node *root;
-    LENGTH_DT length;
+    avl_node *min;                                  /* left-most node (NULL if empty) */
+    avl_node *max;                                  /* right-most node (NULL if empty) */
+    LENGTH_DT length;                               /* no. of items (buffered ones included) */
+    void (*f_free)(void *node);                     /* de-allocates deleted nodes ('free', unless set by 'avl_set_free') */
+    alloc_allocator *allocator;                     /* allocates nodes and buckets ('malloc' if NULL, see 'avl_create_alloc') */
+    unsigned char failed;                           /* 1 once an allocation failed (that modification was not made) */
+    unsigned char unbalanced;                       /* 1 once modified by an unbalanced function (balances are stale) */
+    DATA_TYPE *buffer;                              /* items inserted by 'avl_insert_buffered', not yet in nodes (see 'avl_set_buffer') */
+    LENGTH_DT buffer_length;
+    LENGTH_DT buffer_capacity;
+    LENGTH_DT buffer_sorted;                        /* length of the sorted prefix of 'buffer' */
+    unsigned char (*f_buffer_compare)(DATA_TYPE new_data, DATA_TYPE old_data);     /* orders buffered items */
+    avl_node **finger;                              /* path from the root towards the last node inserted by 'avl_insert_finger' */
+    int finger_depth;                               /* no. of valid nodes in 'finger' (reset by any other modification) */
+    const avl_augment *augment;                     /* summaries kept in nodes (NULL if none, see 'avl_create_augmented') */
+#ifdef _INSTRUMENT_
+    instr_stats stats;                              /* counters (see 'instrument.h') */
+#endif
 } avl_tree;
 
+/**
+ *  @brief      : Structural statistics of a tree (see 'avl_stats'). Deep statistics (depths) are only filled in if
+ *                  sampled, else they're zero.
+**/
+typedef struct AVL_STATISTICS {
+    LENGTH_DT length;                               /* no. of items */
+    LENGTH_DT height;
+    size_t memory;                                  /* bytes used by the tree and its nodes (not the data they point to) */
+    LENGTH_DT n_samples;                            /* no. of nodes whose depth was sampled */
+    double avg_depth;                               /* average depth of the sampled nodes (the root is at depth 1) */
+    LENGTH_DT max_depth;                            /* max. depth of the sampled nodes */
+} avl_statistics;
+
 /* ********************* #include SECTION (2) ********************** */
 
 #include "linked_list.h"                            /* This section is for #include's that must follow the struct definitions */
@@ -49,6 +119,39 @@ typedef struct AVL_TREE {
 **/
 avl_tree * avl_create();
 
+/**
+ *  @brief      : Create a tree, whose nodes (and buckets) are allocated and de-allocated through an allocator (see
+ *                  'allocator.h'), unless a de-allocation function is set (see 'avl_set_free'). If an insertion cannot
+ *                  allocate, the tree is left unchanged, and 'failed' is set.
+ *                  (Note: The tree structure, its insert buffer and finger are allocated by 'malloc'.)
+ *  @param      : [ Allocator (NULL for 'malloc'). ]
+ *  @return     : Pointer to tree (NULL on failure).
+**/
+avl_tree * avl_create_alloc(alloc_allocator *allocator);
+
+/**
+ *  @brief      : Create a tree, whose nodes each keep a summary of the items of their subtree (e.g: their sum), kept
+ *                  correct by every modification, so that the summary of a range of keys is found in O(log n) (see
+ *                  'avl_reduce_range'), rather than by folding over 'avl_make_list' in O(n).
+ *                  (Note: Summaries are recomputed along each modified path, and on each rotation, so modifications call
+ *                  'f_combine' O(log n) times, and nodes grow by 'summary_size'. Nodes holding many equal items (see
+ *                  'avl_insert_multi') summarize all of them whenever they are recomputed.)
+ *  @param      : [ Augmentation (must outlive the tree). ]
+ *                [ Allocator (NULL for 'malloc'). ]
+ *  @return     : Pointer to tree (NULL on failure, or if summaries are larger than 'AVL_MAX_SUMMARY').
+**/
+avl_tree * avl_create_augmented(const avl_augment *augment, alloc_allocator *allocator);
+
+/**
+ *  @brief      : Set the function that de-allocates the nodes deleted from a tree (e.g: 'ebr_free', so that nodes are
+ *                  only de-allocated once no concurrent reader can still hold them). Default is 'free', or the allocator's
+ *                  de-allocation, which is restored by setting NULL (so 'free', if the tree has no allocator).
+ *  @param      : [ Tree. ]
+ *                [ Function that receives a node, and de-allocates it. ]
+ *  @return     : None.
+**/
+void avl_set_free(avl_tree *tree, void (*f_free)(void *node));
+
 /**
  *  @brief      : Get data stored at an index. If index out of bounds, returns DEFAULT_VALUE stored in 'shared_defs.h'.
  *  @param      : [ Tree. ]
@@ -57,6 +160,50 @@ avl_tree * avl_create();
 **/
 DATA_TYPE avl_get(avl_tree *tree, LENGTH_DT i);
 
+/**
+ *  @brief      : Get data stored at many indices, traversing for all of them at once. If an index is out of bounds,
+ *                  its result is DEFAULT_VALUE stored in 'shared_defs.h'.
+ *  @param      : [ Tree. ]
+ *                [ Array of indices. ]
+ *                [ No. of indices. ]
+ *                [ Array to store results in (one per index). ]
+ *  @return     : None.
+**/
+void avl_get_many(avl_tree *tree, LENGTH_DT *indices, LENGTH_DT n, DATA_TYPE *results);
+
+/**
+ *  @brief      : Find data equal to a key (neither is on the left of the other). If not found, returns DEFAULT_VALUE
+ *                  stored in 'shared_defs.h'.
+ *  @param      : [ Tree. ]
+ *                [ Key to find. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE avl_find(avl_tree *tree, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Find data equal to each of many keys, traversing for all of them at once. If a key is not found,
+ *                  its result is DEFAULT_VALUE stored in 'shared_defs.h'.
+ *  @param      : [ Tree. ]
+ *                [ Array of keys. ]
+ *                [ No. of keys. ]
+ *                [ Array to store results in (one per key). ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : None.
+**/
+void avl_find_many(avl_tree *tree, DATA_TYPE *keys, LENGTH_DT n, DATA_TYPE *results,
+                    unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Get the rank of a key, the no. of items on its left (smaller than it), which is also the index of the
+ *                  first item equal to it, if any.
+ *  @param      : [ Tree. ]
+ *                [ Key. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : Rank.
+**/
+LENGTH_DT avl_rank(avl_tree *tree, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
 /**
  *  @brief      : Insert data in a tree, and ignore balances (unbalanced BST insertion).
  *  @param      : [ Tree. ]
@@ -75,11 +222,102 @@ void avl_insert_unbalanced(avl_tree *tree, DATA_TYPE data, unsigned char (*f_com
 **/
 void avl_insert(avl_tree *tree, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
 
+/**
+ *  @brief      : Insert data in a tree, and balance, starting from the position of the last insertion (a finger) rather
+ *                  than the root. Inserting a key at distance 'd' (in rank) from the last inserted one takes O(log d)
+ *                  comparisons, and appending at the max (e.g: increasing timestamps) takes one. Any other modification
+ *                  of the tree resets the finger, so the next insertion starts from the root.
+ *  @param      : [ Tree. ]
+ *                [ Data to insert. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : None.
+**/
+void avl_insert_finger(avl_tree *tree, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Insert data in a tree, and balance, keeping equal items in one node (multiset insertion). If an item
+ *                  equal to the data is found, the data is added to its node (after it), with no allocation of a node
+ *                  and no re-balancing. Index functions ('avl_get', 'avl_delete', ...) count every item of a node.
+ *                  (Note: Other insertion functions make a node per item, so equal items may also be spread over nodes.)
+ *  @param      : [ Tree. ]
+ *                [ Data to insert. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns a
+ *                  negative value (left), 0 (equal), or a positive value (right). ]
+ *  @return     : None.
+**/
+void avl_insert_multi(avl_tree *tree, DATA_TYPE data, int (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Get the no. of items equal to a key (neither is on the left of the other), in O(log n).
+ *  @param      : [ Tree. ]
+ *                [ Key. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : No. of items.
+**/
+LENGTH_DT avl_count(avl_tree *tree, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Get the summary of the items of an augmented tree within a range of keys (neither on the left of the
+ *                  lower key, nor on the right of the upper key), in O(log n). The summary of an empty range is the
+ *                  identity.
+ *  @param      : [ Tree (augmented). ]
+ *                [ Lower key. ]
+ *                [ Upper key. ]
+ *                [ Summary to set (of 'summary_size' bytes). ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : None.
+**/
+void avl_reduce_range(avl_tree *tree, DATA_TYPE lo, DATA_TYPE hi, void *summary,
+                        unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Set the capacity of the insert buffer of a tree (flushing it first, if not empty). Items inserted by
+ *                  'avl_insert_buffered' are appended to the buffer, and only merged into the tree (in bulk) once it is
+ *                  full, or once an operation needs them in nodes. 'avl_get', 'avl_find', 'avl_rank', 'avl_min' and
+ *                  'avl_max' consult the buffer instead, and every other function flushes it first.
+ *  @param      : [ Tree. ]
+ *                [ Capacity (0 for none, so 'avl_insert_buffered' inserts at once). ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : None.
+**/
+void avl_set_buffer(avl_tree *tree, LENGTH_DT capacity, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Insert data in a tree, through its insert buffer (read '@brief' of 'avl_set_buffer'). Equal items are
+ *                  kept in order of insertion, as with 'avl_insert'. The comparison function is the one set by
+ *                  'avl_set_buffer' (so it must be called first, even with no capacity), else nothing is inserted, and
+ *                  'failed' is set.
+ *  @param      : [ Tree. ]
+ *                [ Data to insert. ]
+ *  @return     : None.
+**/
+void avl_insert_buffered(avl_tree *tree, DATA_TYPE data);
+
+/**
+ *  @brief      : Merge the insert buffer of a tree into its nodes (keeping the tree balanced).
+ *  @param      : [ Tree. ]
+ *  @return     : None.
+**/
+void avl_flush(avl_tree *tree);
+
+/**
+ *  @brief      : Replace the items of a tree with many sorted items, building a balanced tree in O(n) (with no
+ *                  comparisons). Items are fetched one at a time, in order (e.g: read sequentially from a file).
+ *                  If a node cannot be allocated, the tree is left unchanged (and the items fetched are dropped).
+ *  @param      : [ Tree. ]
+ *                [ No. of items. ]
+ *                [ Function that receives 'arg', and returns the next item. ]
+ *                [ Argument. ]
+ *  @return     : None.
+**/
+void avl_bulk_load(avl_tree *tree, LENGTH_DT n, DATA_TYPE (*f_next)(void *arg), void *arg);
+
 /**
  *  @brief      : Index to delete item from. If index out of bounds, nothing happens. Ignores balances (unbalanced BST deletion).
  *  @param      : [ Tree. ]
  *                [ Index to delete at. ]
- *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *                [ Function that receives two items (unused, since the item is located by index, but kept for API
+ *                  compatibility). ]
  *  @return     : None.
 **/
 DATA_TYPE avl_delete_unbalanced(avl_tree *tree, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
@@ -88,18 +326,57 @@ DATA_TYPE avl_delete_unbalanced(avl_tree *tree, LENGTH_DT i, unsigned char (*f_c
  *  @brief      : Index to delete item from. If index out of bounds, nothing happens. Balances (AVL BST deletion).
  *  @param      : [ Tree. ]
  *                [ Index to delete at. ]
- *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *                [ Function that receives two items (unused, since the item is located by index, but kept for API
+ *                  compatibility). ]
  *  @return     : None.
 **/
 DATA_TYPE avl_delete(avl_tree *tree, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
 
 /**
- *  @brief      : Get the height of a tree.
+ *  @brief      : Get the smallest (left-most) data stored, in constant time. If tree is empty, returns DEFAULT_VALUE.
+ *  @param      : [ Tree. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE avl_min(avl_tree *tree);
+
+/**
+ *  @brief      : Get the largest (right-most) data stored, in constant time. If tree is empty, returns DEFAULT_VALUE.
+ *  @param      : [ Tree. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE avl_max(avl_tree *tree);
+
+/**
+ *  @brief      : Delete the smallest (left-most) item, and balance. If tree is empty, returns DEFAULT_VALUE.
+ *  @param      : [ Tree. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE avl_pop_min(avl_tree *tree);
+
+/**
+ *  @brief      : Delete the largest (right-most) item, and balance. If tree is empty, returns DEFAULT_VALUE.
+ *  @param      : [ Tree. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE avl_pop_max(avl_tree *tree);
+
+/**
+ *  @brief      : Get the height of a tree, in O(log n) (or in O(n), once modified by an unbalanced function).
  *  @param      : [ Tree. ]
  *  @return     : Height of tree.
 **/
 LENGTH_DT avl_height(avl_tree *tree);
 
+/**
+ *  @brief      : Get structural statistics of a tree (no. of nodes, height, and memory footprint) in O(log n), and
+ *                  optionally the depths of a no. of nodes spread evenly over the tree, in O(log n) each.
+ *  @param      : [ Tree. ]
+ *                [ Statistics to fill in. ]
+ *                [ No. of nodes to sample the depth of (0 for none, at least the no. of nodes for all). ]
+ *  @return     : None.
+**/
+void avl_stats(avl_tree *tree, avl_statistics *stats, LENGTH_DT n_samples);
+
 /**
  *  @brief      : Returns a list from a tree (left-to-right). Tree is unmodified.
  *  @param      : [ Tree. ]
@@ -107,6 +384,36 @@ LENGTH_DT avl_height(avl_tree *tree);
 **/
 ll_list * avl_make_list(avl_tree *tree);
 
+/**
+ *  @brief      : Copies the items of a tree into an array (left-to-right), e.g: to be searched by 'search.h'.
+ *                  Tree is unmodified.
+ *  @param      : [ Tree. ]
+ *                [ Array to copy into (of at least 'tree->length' items). ]
+ *  @return     : None.
+**/
+void avl_make_array(avl_tree *tree, DATA_TYPE *arr);
+
+/**
+ *  @brief      : Copies the items of a subtree of a tree into an array (left-to-right), e.g: to copy subtrees apart (in
+ *                  parallel), since the items of a node follow the 'size' items of its left subtree, and those of its
+ *                  right subtree follow its own (see 'avl_node_items'). Buffered items are not copied (see 'avl_flush').
+ *                  (Note: Counters of an instrumented tree are not atomic, so they may miscount concurrent copies.)
+ *  @param      : [ Tree. ]
+ *                [ Root of the subtree (NULL for an empty one). ]
+ *                [ Array to copy into (of at least 'root->size' items). ]
+ *  @return     : No. of items copied (fewer than 'root->size' only if an allocation failed, then 'failed' is set).
+**/
+LENGTH_DT avl_make_array_subtree(avl_tree *tree, avl_node *root, DATA_TYPE *arr);
+
+/**
+ *  @brief      : Copies the items of a node of a tree (its own, then the equal ones of its bucket, in order of insertion)
+ *                  into an array.
+ *  @param      : [ Node. ]
+ *                [ Array to copy into. ]
+ *  @return     : No. of items copied (1, unless the node has a bucket, see 'avl_insert_multi').
+**/
+LENGTH_DT avl_node_items(avl_node *node, DATA_TYPE *arr);
+
 /**
  *  @brief      : Deletes all items in a tree (resets a tree).
  *  @param      : [ Tree. ]
@@ -114,6 +421,17 @@ ll_list * avl_make_list(avl_tree *tree);
 **/
 void avl_delete_all(avl_tree *tree);
 
+/**
+ *  @brief      : De-allocates the nodes of a subtree of a tree (e.g: to de-allocate subtrees apart, in parallel). The
+ *                  subtree must be unlinked from the tree first (or the tree discarded), since its root, length, min and
+ *                  max are not updated.
+ *                  (Note: Counters of an instrumented tree are not atomic, so they may miscount concurrent calls.)
+ *  @param      : [ Tree. ]
+ *                [ Root of the subtree (NULL for an empty one). ]
+ *  @return     : None.
+**/
+void avl_delete_subtree(avl_tree *tree, avl_node *root);
+
 /**
  *  @brief      : De-allocates a tree and all its items.
  *  @param      : [ Tree. ]
@@ -0,0 +1,393 @@
+/**
+ ****************************************************************
+ * @file            : ebr.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of epoch-based memory reclamation (EBR), that defers de-allocating memory removed
+ *                      from a concurrent structure, until no thread can still be reading it.
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#include "ebr.h"
+
+/* ********************* static variable(s) SECTION ********************** */
+
+/**
+ *  @brief      : Thread the calling thread registered last (NULL if none), used by 'ebr_free'.
+**/
+static _Thread_local ebr_thread *ebr_self = NULL;
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static LENGTH_DT ebr_empty_bag(ebr_bag *bag);
+static unsigned char ebr_advance(ebr_domain *domain);
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Allocating dynamic memory for a domain structure, initializing and returning a pointer to it.
+ *  @param      : None.
+ *  @return     : Pointer to domain.
+**/
+ebr_domain * ebr_create() {
+    ebr_domain *domain = (ebr_domain *) malloc(sizeof(ebr_domain));
+    atomic_init(&domain->epoch, 0);
+    atomic_init(&domain->threads, NULL);
+    return domain;
+}
+
+/**
+ *  @brief      : Register the calling thread. An unused thread of the domain is reused (claimed with a CAS), else a
+ *                  new one is allocated, and pushed onto the list of threads (with a CAS).
+ *  @param      : [ Domain. ]
+ *  @return     : Pointer to thread.
+**/
+ebr_thread * ebr_register(ebr_domain *domain) {
+    ebr_thread *thread = atomic_load(&domain->threads);
+    for (; thread != NULL; thread = thread->next) {
+        unsigned char expected = 0;
+        if (atomic_compare_exchange_strong(&thread->in_use, &expected, 1)) {
+            return ebr_self = thread;
+        }
+    }
+
+    thread = (ebr_thread *) calloc(1, sizeof(ebr_thread));
+    atomic_init(&thread->state, 0);
+    atomic_init(&thread->in_use, 1);
+    thread->domain = domain;
+    thread->next = atomic_load(&domain->threads);
+    while (!atomic_compare_exchange_weak(&domain->threads, &thread->next, thread));
+    return ebr_self = thread;
+}
+
+/**
+ *  @brief      : Get the thread the calling thread registered last.
+ *  @param      : None.
+ *  @return     : Pointer to thread (NULL if none).
+**/
+ebr_thread * ebr_current() {
+    return ebr_self;
+}
+
+/**
+ *  @brief      : Unregister a thread, marking it as unused.
+ *  @param      : [ Thread. ]
+ *  @return     : None.
+**/
+void ebr_unregister(ebr_thread *thread) {
+    atomic_store_explicit(&thread->state, 0, memory_order_release);
+    if (ebr_self == thread) {
+        ebr_self = NULL;
+    }
+    atomic_store(&thread->in_use, 0);
+}
+
+/**
+ *  @brief      : Enter a critical section, by announcing the global epoch as the thread's own. The full fence orders
+ *                  the announcement before any pointer is read, so that a thread advancing the epoch either sees it,
+ *                  or has advanced before the pointers were read (and they were reachable in the new epoch).
+ *  @param      : [ Thread. ]
+ *  @return     : None.
+**/
+void ebr_enter(ebr_thread *thread) {
+    uint64_t epoch = atomic_load_explicit(&thread->domain->epoch, memory_order_relaxed);
+    atomic_store_explicit(&thread->state, epoch << 1 | 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+/**
+ *  @brief      : Exit a critical section (release, so that all reads within it precede it).
+ *  @param      : [ Thread. ]
+ *  @return     : None.
+**/
+void ebr_exit(ebr_thread *thread) {
+    atomic_store_explicit(&thread->state, 0, memory_order_release);
+}
+
+/**
+ *  @brief      : (for internal use) De-allocate all pointers of a bag, and empty it.
+ *  @param      : [ Bag. ]
+ *  @return     : No. of pointers de-allocated.
+**/
+static LENGTH_DT ebr_empty_bag(ebr_bag *bag) {
+    LENGTH_DT n = bag->length;
+    for (LENGTH_DT i = 0; i < n; i++) {
+        bag->items[i].f_free(bag->items[i].ptr);
+    }
+    bag->length = 0;
+    return n;
+}
+
+/**
+ *  @brief      : Retire a pointer, into the bag of the current epoch. If the bag still holds the pointers of an older
+ *                  epoch (at least 3 epochs old, so safe), they're de-allocated first.
+ *  @param      : [ Thread. ]
+ *                [ Pointer. ]
+ *                [ Function to de-allocate the pointer with. ]
+ *  @return     : None.
+**/
+void ebr_retire(ebr_thread *thread, void *ptr, void (*f_free)(void *ptr)) {
+    atomic_thread_fence(memory_order_seq_cst);                  /* the epoch must not be read before the pointer was unlinked */
+    uint64_t epoch = atomic_load_explicit(&thread->domain->epoch, memory_order_relaxed);
+    ebr_bag *bag = thread->bags + epoch % 3;
+
+    if (bag->epoch != epoch) {
+        ebr_empty_bag(bag);
+        bag->epoch = epoch;
+    }
+    if (bag->length == bag->capacity) {
+        bag->capacity = bag->capacity == 0 ? EBR_BATCH : 2 * bag->capacity;
+        bag->items = (ebr_retired *) realloc(bag->items, bag->capacity * sizeof(ebr_retired));
+    }
+    bag->items[bag->length].ptr = ptr;
+    bag->items[bag->length++].f_free = f_free;
+    if (++thread->n_retired >= EBR_BATCH) {
+        ebr_reclaim(thread);
+    }
+}
+
+/**
+ *  @brief      : Retire a pointer through the thread the calling thread registered last, else de-allocate it.
+ *  @param      : [ Pointer. ]
+ *  @return     : None.
+**/
+void ebr_free(void *ptr) {
+    if (ebr_self != NULL) { ebr_retire(ebr_self, ptr, free); }
+    else { free(ptr); }
+}
+
+/**
+ *  @brief      : (for internal use) Advance the epoch of a domain (with a CAS), if every thread in a critical section
+ *                  has announced the current epoch.
+ *  @param      : [ Domain. ]
+ *  @return     : 1 if advanced (by this thread, or another), else 0.
+**/
+static unsigned char ebr_advance(ebr_domain *domain) {
+    uint64_t epoch = atomic_load(&domain->epoch);
+    for (ebr_thread *thread = atomic_load(&domain->threads); thread != NULL; thread = thread->next) {
+        uint64_t state = atomic_load(&thread->state);
+        if ((state & 1) && (state >> 1) != epoch) {
+            return 0;
+        }
+    }
+    atomic_compare_exchange_strong(&domain->epoch, &epoch, epoch + 1);
+    return 1;
+}
+
+/**
+ *  @brief      : Try to advance the epoch, then de-allocate the bags of a thread that are at least 2 epochs old.
+ *  @param      : [ Thread. ]
+ *  @return     : No. of pointers de-allocated.
+**/
+LENGTH_DT ebr_reclaim(ebr_thread *thread) {
+    LENGTH_DT n = 0;
+    ebr_advance(thread->domain);
+    uint64_t epoch = atomic_load(&thread->domain->epoch);
+    for (int i = 0; i < 3; i++) {
+        if (thread->bags[i].epoch + 2 <= epoch) {
+            n += ebr_empty_bag(thread->bags + i);
+        }
+    }
+    thread->n_retired = 0;
+    return n;
+}
+
+/**
+ *  @brief      : De-allocate all retired pointers and threads of a domain, then the domain itself.
+ *  @param      : [ Domain. ]
+ *  @return     : None.
+**/
+void ebr_destroy(ebr_domain *domain) {
+    ebr_thread *thread = atomic_load(&domain->threads);
+    while (thread != NULL) {
+        ebr_thread *next = thread->next;
+        for (int i = 0; i < 3; i++) {
+            ebr_empty_bag(thread->bags + i);
+            free(thread->bags[i].items);
+        }
+        if (ebr_self == thread) {
+            ebr_self = NULL;
+        }
+        free(thread);
+        thread = next;
+    }
+    free(domain);
+}
+
+/* ********************* 'main' function defintion SECTION (TEST) ********************** */
+
+#ifdef _MAIN_EBR_                       /* compile-time switch */
+
+#include <pthread.h>
+#include "linked_list.h"
+
+/**
+ *  @brief      : No. of reader threads, and no. of replacements by the writer, of the concurrent test.
+**/
+#define T_READERS       3
+#define T_WRITES        100000
+
+/**
+ *  @brief      : Shared slot, that the writer replaces, and readers read (each value holds a canary, checked by readers).
+**/
+typedef struct T_VALUE {
+    long canary;
+    long n;
+} t_value;
+
+static t_value *_Atomic t_slot;
+static _Atomic unsigned char t_done;
+static _Atomic long t_freed;
+
+void t_free_count(void *ptr);
+void t_hook();
+void t_concurrent();
+
+int main() {
+    t_hook();
+    t_concurrent();
+    return 0;
+}
+
+void t_free_count(void *ptr) {
+    atomic_fetch_add(&t_freed, 1);
+    ((t_value *) ptr)->canary = 0;
+    free(ptr);
+}
+
+void t_hook() {
+    printf("*************** TEST (NODE-FREE HOOK) ***************\n");
+    ebr_domain *domain = ebr_create();
+    ebr_thread *self = ebr_register(domain);
+    ll_list *list = ll_create();
+    ll_set_free(list, ebr_free);
+    for (long i = 0; i < 10; i++) {
+        ll_append(list, (void *) i);
+    }
+    ebr_enter(self);
+    ll_node *node = list->head;                                 /* a reader holds the head, while it's deleted */
+    ll_delete(list, 0);
+    ll_delete(list, 0);
+    printf("Deleted 2, retired: %ld, read (still valid): %ld\n", (long) self->bags[0].length, (long) node->data);
+    printf("Reclaimed (in a critical section): %ld\n", (long) ebr_reclaim(self));
+    ebr_exit(self);
+    LENGTH_DT n = 0;
+    for (int i = 0; i < 3; i++) {
+        n += ebr_reclaim(self);
+    }
+    printf("Reclaimed (after exiting): %ld, epoch: %lu\n", (long) n, (unsigned long) atomic_load(&domain->epoch));
+    ll_destroy(list);                                           /* remaining nodes are retired too */
+    ebr_unregister(self);
+    ebr_destroy(domain);
+}
+
+void * t_reader(void *arg) {
+    ebr_thread *self = ebr_register((ebr_domain *) arg);
+    long errors = 0, reads = 0;
+    while (!atomic_load(&t_done)) {
+        ebr_enter(self);
+        t_value *value = atomic_load_explicit(&t_slot, memory_order_acquire);
+        errors += value->canary != 0x5AFE;
+        reads++;
+        ebr_exit(self);
+    }
+    ebr_unregister(self);
+    return (void *) errors;
+}
+
+void t_concurrent() {
+    printf("*************** TEST (CONCURRENT) ***************\n");
+    ebr_domain *domain = ebr_create();
+    ebr_thread *self = ebr_register(domain);
+    pthread_t threads[T_READERS];
+    long errors = 0;
+    t_value *value = (t_value *) malloc(sizeof(t_value));
+    value->canary = 0x5AFE, value->n = 0;
+    atomic_store(&t_slot, value);
+    atomic_store(&t_done, 0);
+
+    for (int t = 0; t < T_READERS; t++) {
+        pthread_create(threads + t, NULL, t_reader, domain);
+    }
+    for (long i = 1; i <= T_WRITES; i++) {
+        value = (t_value *) malloc(sizeof(t_value));
+        value->canary = 0x5AFE, value->n = i;
+        ebr_retire(self, atomic_exchange(&t_slot, value), t_free_count);
+    }
+    atomic_store(&t_done, 1);
+    for (int t = 0; t < T_READERS; t++) {
+        void *result;
+        pthread_join(threads[t], &result);
+        errors += (long) result;
+    }
+    long freed_before = atomic_load(&t_freed);
+    ebr_destroy(domain);
+    printf("Readers: %d, writes: %d, errors: %ld, freed before the end: %s, freed in all: %ld\n", T_READERS, T_WRITES,
+            errors, freed_before > 0 ? "yes" : "no", atomic_load(&t_freed));
+    free(atomic_load(&t_slot));
+}
+
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_EBR_                      /* compile-time switch */
+
+#include <time.h>
+
+double now();
+
+/**
+ *  @brief      : Benchmark of the overhead per operation of a critical section (enter/exit), and of retiring a pointer
+ *                  (with batched reclamation), against de-allocating it at once.
+ *                  (Usage: <no. of operations (default: 2^24)>)
+**/
+int main(int argc, char *argv[]) {
+    LENGTH_DT n = argc > 1 ? atol(argv[1]) : 1L << 24;
+    ebr_domain *domain = ebr_create();
+    ebr_thread *self = ebr_register(domain);
+    volatile LENGTH_DT sink = 0;
+    double start;
+
+    start = now();
+    for (LENGTH_DT i = 0; i < n; i++) {
+        sink += i;
+    }
+    double base = now() - start;
+    start = now();
+    for (LENGTH_DT i = 0; i < n; i++) {
+        ebr_enter(self);
+        sink += i;
+        ebr_exit(self);
+    }
+    printf("%-24s %8.2f ns/op\n", "enter/exit", (now() - start - base) / n * 1e9);
+
+    start = now();
+    for (LENGTH_DT i = 0; i < n; i++) {
+        void *volatile ptr = malloc(32);                        /* volatile, so that the pair is not optimized out */
+        free(ptr);
+    }
+    double plain = now() - start;
+    printf("%-24s %8.2f ns/op\n", "malloc+free", plain / n * 1e9);
+    start = now();
+    for (LENGTH_DT i = 0; i < n; i++) {
+        ebr_enter(self);
+        ebr_retire(self, malloc(32), free);
+        ebr_exit(self);
+    }
+    double retired = now() - start;
+    printf("%-24s %8.2f ns/op (+%.2f)\n", "malloc+enter/retire/exit", retired / n * 1e9, (retired - plain) / n * 1e9);
+
+    ebr_unregister(self);
+    ebr_destroy(domain);
+    return 0;
+}
+
+double now() {
+    struct timespec t;
+    timespec_get(&t, TIME_UTC);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ ****************************************************************
+ * @file            : ebr.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the implementation of epoch-based memory reclamation (EBR),
+ *                      that defers de-allocating memory removed from a concurrent structure, until no thread can
+ *                      still be reading it.
+ *                      (Note: Requires C11 atomics.)
+ * **************************************************************
+ **/
+
+#ifndef _EBR_H_
+#define _EBR_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "shared_defs.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : No. of pointers a thread retires, before it tries to advance the epoch, and de-allocate those that
+ *                  are safe to (so that reclamation is amortised over many retires, and kept off the hot path).
+**/
+#define EBR_BATCH           128
+
+/**
+ *  @brief      : Size of a cache line, that the state of each thread is kept on (read by all threads, but written by
+ *                  its own only).
+**/
+#define EBR_CACHE_LINE      64
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Retired pointer, and the function to de-allocate it with.
+**/
+typedef struct EBR_RETIRED {
+    void *ptr;
+    void (*f_free)(void *ptr);
+} ebr_retired;
+
+/**
+ *  @brief      : Bag structure (growable array of the pointers a thread retired in one epoch).
+**/
+typedef struct EBR_BAG {
+    ebr_retired *items;
+    LENGTH_DT length;
+    LENGTH_DT capacity;
+    uint64_t epoch;                                 /* epoch the pointers were retired in */
+} ebr_bag;
+
+/**
+ *  @brief      : Thread structure (a registered thread). Its state is its epoch shifted left by one, with the lowest
+ *                  bit set while in a critical section (0 while outside). A pointer retired in epoch 'e' is de-allocated
+ *                  once the global epoch reaches 'e + 2', since the epoch advances only when all threads in a critical
+ *                  section have seen the current epoch. Pointers of epoch 'e' are kept in bag 'e % 3'.
+**/
+typedef struct EBR_THREAD {
+    _Atomic uint64_t state;
+    char padding[EBR_CACHE_LINE - sizeof(uint64_t)];
+    struct EBR_THREAD *next;                        /* next thread of the domain */
+    struct EBR_DOMAIN *domain;
+    _Atomic unsigned char in_use;                   /* 0 once unregistered (and reusable by a new thread) */
+    LENGTH_DT n_retired;                            /* no. of pointers retired since the last reclamation */
+    ebr_bag bags[3];
+} ebr_thread;
+
+/**
+ *  @brief      : Domain structure (a global epoch, and the threads registered in it). Threads are never removed from
+ *                  the list, only marked as unused, and reused.
+**/
+typedef struct EBR_DOMAIN {
+    _Atomic uint64_t epoch;
+    ebr_thread *_Atomic threads;
+} ebr_domain;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Create a domain (dynamically, on heap).
+ *  @param      : None.
+ *  @return     : Pointer to domain.
+**/
+ebr_domain * ebr_create();
+
+/**
+ *  @brief      : Register the calling thread in a domain. It becomes the thread used by 'ebr_free' (for the calling
+ *                  thread).
+ *  @param      : [ Domain. ]
+ *  @return     : Pointer to thread.
+**/
+ebr_thread * ebr_register(ebr_domain *domain);
+
+/**
+ *  @brief      : Get the thread the calling thread registered last (e.g: for a structure to retire its nodes through).
+ *  @param      : None.
+ *  @return     : Pointer to thread, or NULL if the calling thread is not registered.
+**/
+ebr_thread * ebr_current();
+
+/**
+ *  @brief      : Unregister a thread (outside a critical section). Its retired pointers are kept, and de-allocated
+ *                  by the next thread that reuses it, or when the domain is destroyed.
+ *  @param      : [ Thread. ]
+ *  @return     : None.
+**/
+void ebr_unregister(ebr_thread *thread);
+
+/**
+ *  @brief      : Enter a critical section, in which pointers read from a concurrent structure stay valid (are not
+ *                  de-allocated), even if they're retired meanwhile. Critical sections must not be nested.
+ *  @param      : [ Thread. ]
+ *  @return     : None.
+**/
+void ebr_enter(ebr_thread *thread);
+
+/**
+ *  @brief      : Exit a critical section. Pointers read within it must not be used thereafter.
+ *  @param      : [ Thread. ]
+ *  @return     : None.
+**/
+void ebr_exit(ebr_thread *thread);
+
+/**
+ *  @brief      : Retire a pointer (already unreachable for threads entering a critical section from now on), to be
+ *                  de-allocated once no thread can still be reading it.
+ *  @param      : [ Thread. ]
+ *                [ Pointer. ]
+ *                [ Function to de-allocate the pointer with (e.g: 'free'). ]
+ *  @return     : None.
+**/
+void ebr_retire(ebr_thread *thread, void *ptr, void (*f_free)(void *ptr));
+
+/**
+ *  @brief      : Retire a pointer, through the thread the calling thread registered last (to be de-allocated with
+ *                  'free'). If the calling thread is not registered, the pointer is de-allocated at once.
+ *                  It may be set as the node de-allocation function of a list or a tree ('ll_set_free', 'avl_set_free').
+ *  @param      : [ Pointer. ]
+ *  @return     : None.
+**/
+void ebr_free(void *ptr);
+
+/**
+ *  @brief      : Try to advance the epoch of a domain, and de-allocate the retired pointers of a thread that are safe
+ *                  to. Done every 'EBR_BATCH' retires, but may be called at any time (e.g: when a thread is idle).
+ *  @param      : [ Thread. ]
+ *  @return     : No. of pointers de-allocated.
+**/
+LENGTH_DT ebr_reclaim(ebr_thread *thread);
+
+/**
+ *  @brief      : Destroy domain (de-allocated off heap), de-allocating all retired pointers, when no thread is in a
+ *                  critical section anymore. Its threads must not be used thereafter.
+ *  @param      : [ Domain. ]
+ *  @return     : None.
+**/
+void ebr_destroy(ebr_domain *domain);
+
+#endif
@@ -0,0 +1,828 @@
+/**
+ ****************************************************************
+ * @file            : external_sort.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of an external (out-of-core) merge sort.
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#define _POSIX_C_SOURCE 200809L                         /* for 'mkstemp' and 'posix_fadvise' (and 'clock_gettime' in the benchmark) */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "external_sort.h"
+#include "sort.h"
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static unsigned char xs_spill(xs_sorter *sorter);
+static unsigned char xs_merge_pass(xs_sorter *sorter, LENGTH_DT fan_in);
+static xs_run * xs_run_create(xs_sorter *sorter);
+static void xs_run_rewind(xs_sorter *sorter, xs_run *run);
+static unsigned char xs_run_advance(xs_sorter *sorter, xs_run *run);
+static const unsigned char * xs_run_read(xs_run *run, size_t size);
+static void xs_run_destroy(xs_sorter *sorter, xs_run *run);
+static unsigned char xs_write_record(xs_sorter *sorter, int fd, size_t *pos, DATA_TYPE data);
+static unsigned char xs_write_all(int fd, const unsigned char *bytes, size_t n);
+static void xs_merger_init(xs_sorter *sorter, xs_merger *merger, xs_run **runs, LENGTH_DT k);
+static unsigned char xs_merger_beats(xs_sorter *sorter, xs_merger *merger, LENGTH_DT a, LENGTH_DT b);
+static DATA_TYPE xs_merger_next(xs_sorter *sorter, xs_merger *merger);
+static void xs_merger_destroy(xs_sorter *sorter, xs_merger *merger);
+static DATA_TYPE xs_next_item(void *arg);
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Create an external sort (dynamically, on heap).
+ *  @param      : [ Configuration (or NULL for defaults). ]
+ *                [ Serializer (kept, not copied). ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *                [ Function that de-allocates an item, once spilled (or NULL if items need no de-allocation). ]
+ *  @return     : Pointer to external sort.
+**/
+xs_sorter * xs_create(xs_config *config, avl_serializer *serializer,
+                        unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data), void (*f_free)(DATA_TYPE data)) {
+    xs_sorter *sorter = (xs_sorter *) malloc(sizeof(xs_sorter));
+    memset(&sorter->config, 0, sizeof(xs_config));
+    if (config != NULL) { sorter->config = *config; }
+    if (sorter->config.budget == 0) { sorter->config.budget = XS_DEFAULT_BUDGET; }
+    if (sorter->config.buffer_size == 0) { sorter->config.buffer_size = XS_DEFAULT_BUFFER_SIZE; }
+    if (sorter->config.temp_dir == NULL) {
+        sorter->config.temp_dir = getenv("TMPDIR") != NULL ? getenv("TMPDIR") : "/tmp";
+    }
+
+    sorter->serializer = serializer;
+    sorter->f_compare = f_compare;
+    sorter->f_free = f_free;
+    sorter->capacity = 64;
+    sorter->items = (DATA_TYPE *) malloc(sorter->capacity * sizeof(DATA_TYPE));
+    sorter->n_items = 0;
+    sorter->used = 0;
+    sorter->runs = ll_create();
+    sorter->write_buffer = NULL;
+    sorter->length = sorter->remaining = 0;
+    sorter->finished = sorter->failed = 0;
+    sorter->merger.runs = NULL, sorter->merger.k = 0, sorter->merger.losers = NULL;
+    return sorter;
+}
+
+/**
+ *  @brief      : Push an item. An item takes its record size, plus two pointers (its own, and its share of the buffer
+ *                  of 'sort_merge'), of the budget. If it does not fit, the items in memory are spilled first, so on
+ *                  failure, the item is not pushed (and still owned by the caller).
+ *  @param      : [ External sort. ]
+ *                [ Item. ]
+ *  @return     : 1 if pushed, 0 if a run could not be written (or the external sort is finished).
+**/
+unsigned char xs_push(xs_sorter *sorter, DATA_TYPE data) {
+    if (sorter->finished) {
+        return 0;
+    }
+    avl_serializer *serializer = sorter->serializer;
+    size_t size = (serializer->size != 0 ? serializer->size : serializer->f_size(data)) + 2 * sizeof(DATA_TYPE);
+    if (sorter->used + size > sorter->config.budget && sorter->n_items != 0) {
+        if (!xs_spill(sorter)) {
+            return 0;
+        }
+    }
+    if (sorter->n_items == sorter->capacity) {
+        sorter->capacity *= 2;
+        sorter->items = (DATA_TYPE *) realloc(sorter->items, sorter->capacity * sizeof(DATA_TYPE));
+    }
+    sorter->items[sorter->n_items++] = data;
+    sorter->used += size;
+    sorter->length++;
+    return 1;
+}
+
+/**
+ *  @brief      : Finish pushing, and prepare the output. Runs are merged in passes, each merging consecutive groups
+ *                  of 'fan_in' runs (the no. of run buffers, plus a write buffer, that fit in the budget), so that the
+ *                  order of runs (hence, of equal items) is kept, until at most 'fan_in' are left.
+ *  @param      : [ External sort. ]
+ *  @return     : 1 if ready, 0 if a run could not be written or read.
+**/
+unsigned char xs_finish(xs_sorter *sorter) {
+    if (sorter->finished) {
+        return !sorter->failed;
+    }
+    sorter->finished = 1;
+    sorter->remaining = sorter->length;
+    if (sorter->runs->length == 0) {
+        sort_merge(sorter->items, sorter->n_items, sorter->f_compare);
+        return 1;
+    }
+    if (sorter->n_items != 0 && !xs_spill(sorter)) {
+        sorter->failed = 1;
+        return 0;
+    }
+    free(sorter->items);
+    sorter->items = NULL, sorter->capacity = 0;
+
+    LENGTH_DT fan_in = (LENGTH_DT) (sorter->config.budget / sorter->config.buffer_size) - 1;
+    if (fan_in < 2) { fan_in = 2; }
+    while (sorter->runs->length > fan_in) {
+        if (!xs_merge_pass(sorter, fan_in)) {
+            sorter->failed = 1;
+            return 0;
+        }
+    }
+
+    LENGTH_DT k = sorter->runs->length;
+    xs_run **runs = (xs_run **) malloc(k * sizeof(xs_run *));
+    for (LENGTH_DT i = 0; i < k; i++) {
+        runs[i] = ll_dequeue(sorter->runs);
+    }
+    xs_merger_init(sorter, &sorter->merger, runs, k);
+    return !sorter->failed;
+}
+
+/**
+ *  @brief      : Get the next item in order, once finished (from memory, or from the merger of the last runs).
+ *  @param      : [ External sort. ]
+ *  @return     : Item.
+**/
+DATA_TYPE xs_next(xs_sorter *sorter) {
+    if (!sorter->finished || sorter->remaining == 0) {
+        return DEFAULT_VALUE;
+    }
+    if (sorter->merger.k == 0) {
+        return sorter->items[sorter->n_items - sorter->remaining--];
+    }
+    if (sorter->merger.runs[sorter->merger.losers[0]]->exhausted) {
+        sorter->remaining = 0;                      /* a run could not be read */
+        return DEFAULT_VALUE;
+    }
+    sorter->remaining--;
+    return xs_merger_next(sorter, &sorter->merger);
+}
+
+/**
+ *  @brief      : Get the remaining items in order, once finished, in a list (dynamically, on heap).
+ *  @param      : [ External sort. ]
+ *  @return     : Pointer to list.
+**/
+ll_list * xs_make_list(xs_sorter *sorter) {
+    ll_list *list = ll_create();
+    while (sorter->remaining != 0) {
+        DATA_TYPE data = xs_next(sorter);
+        if (sorter->failed && data == DEFAULT_VALUE) { break; }
+        ll_append(list, data);
+    }
+    return list;
+}
+
+/**
+ *  @brief      : Get the remaining items in order, once finished, in a tree (dynamically, on heap), passing them
+ *                  straight to 'avl_bulk_load'.
+ *  @param      : [ External sort. ]
+ *  @return     : Pointer to tree.
+**/
+avl_tree * xs_make_tree(xs_sorter *sorter) {
+    avl_tree *tree = avl_create();
+    avl_bulk_load(tree, sorter->remaining, xs_next_item, sorter);
+    return tree;
+}
+
+/**
+ *  @brief      : De-allocate an external sort (and its temporary files, that were unlinked when created, so closing
+ *                  them removes them).
+ *  @param      : [ External sort. ]
+ *  @return     : None.
+**/
+void xs_destroy(xs_sorter *sorter) {
+    if (sorter->f_free != NULL && sorter->items != NULL) {
+        LENGTH_DT first = sorter->finished ? sorter->n_items - sorter->remaining : 0;
+        for (LENGTH_DT i = first; i < sorter->n_items; i++) {
+            sorter->f_free(sorter->items[i]);
+        }
+    }
+    free(sorter->items);
+    xs_merger_destroy(sorter, &sorter->merger);
+    while (sorter->runs->length != 0) {
+        xs_run_destroy(sorter, ll_dequeue(sorter->runs));
+    }
+    ll_destroy(sorter->runs);
+    free(sorter->write_buffer);
+    free(sorter);
+}
+
+/**
+ *  @brief      : (for internal use) Sort the items in memory (stably), and write them to a new run. The items are
+ *                  de-allocated only once all are written.
+ *  @param      : [ External sort. ]
+ *  @return     : 1 if spilled, 0 if the run could not be written (the items are kept).
+**/
+static unsigned char xs_spill(xs_sorter *sorter) {
+    xs_run *run = xs_run_create(sorter);
+    if (run == NULL) {
+        return 0;
+    }
+    sort_merge(sorter->items, sorter->n_items, sorter->f_compare);
+
+    size_t pos = 0;
+    unsigned char written = 1;
+    for (LENGTH_DT i = 0; i < sorter->n_items && written; i++) {
+        written = xs_write_record(sorter, run->fd, &pos, sorter->items[i]);
+    }
+    if (!written || !xs_write_all(run->fd, sorter->write_buffer, pos)) {
+        xs_run_destroy(sorter, run);
+        return 0;
+    }
+
+    if (sorter->f_free != NULL) {
+        for (LENGTH_DT i = 0; i < sorter->n_items; i++) {
+            sorter->f_free(sorter->items[i]);
+        }
+    }
+    run->length = sorter->n_items;
+    sorter->n_items = 0;
+    sorter->used = 0;
+    ll_enqueue(sorter->runs, run);
+    return 1;
+}
+
+/**
+ *  @brief      : (for internal use) Merge pass: merge consecutive groups of (up to) 'fan_in' runs, each into a new run,
+ *                  queued in the same order.
+ *  @param      : [ External sort. ]
+ *                [ Max. no. of runs merged at once. ]
+ *  @return     : 1 if merged, 0 if a run could not be written or read.
+**/
+static unsigned char xs_merge_pass(xs_sorter *sorter, LENGTH_DT fan_in) {
+    ll_list *queue = ll_create();
+    unsigned char merged = 1;
+
+    while (sorter->runs->length != 0 && merged) {
+        LENGTH_DT k = sorter->runs->length < fan_in ? sorter->runs->length : fan_in;
+        if (k == 1) {
+            ll_enqueue(queue, ll_dequeue(sorter->runs));
+            continue;
+        }
+        xs_run *run = xs_run_create(sorter);
+        if (run == NULL) {
+            merged = 0;
+            break;
+        }
+        xs_run **runs = (xs_run **) malloc(k * sizeof(xs_run *));
+        run->length = 0;
+        for (LENGTH_DT i = 0; i < k; i++) {
+            runs[i] = ll_dequeue(sorter->runs);
+            run->length += runs[i]->length;
+        }
+
+        xs_merger merger;
+        xs_merger_init(sorter, &merger, runs, k);
+        size_t pos = 0;
+        for (LENGTH_DT i = 0; i < run->length && merged; i++) {
+            if (merger.runs[merger.losers[0]]->exhausted) {
+                merged = 0;                         /* a run could not be read */
+                break;
+            }
+            DATA_TYPE data = xs_merger_next(sorter, &merger);
+            merged = xs_write_record(sorter, run->fd, &pos, data);
+            if (sorter->f_free != NULL) { sorter->f_free(data); }
+        }
+        merged = merged && xs_write_all(run->fd, sorter->write_buffer, pos);
+        xs_merger_destroy(sorter, &merger);
+        ll_enqueue(queue, run);
+    }
+
+    while (sorter->runs->length != 0) {             /* the runs left (if failed) go after the merged ones */
+        ll_enqueue(queue, ll_dequeue(sorter->runs));
+    }
+    ll_destroy(sorter->runs);
+    sorter->runs = queue;
+    return merged;
+}
+
+/**
+ *  @brief      : (for internal use) Create a run, on a new temporary file (unlinked at once, so it is removed when
+ *                  closed, even if the process ends first). The write buffer is allocated on first use.
+ *  @param      : [ External sort. ]
+ *  @return     : Pointer to run, or NULL if the file could not be created.
+**/
+static xs_run * xs_run_create(xs_sorter *sorter) {
+    size_t dir_length = strlen(sorter->config.temp_dir);
+    char *path = (char *) malloc(dir_length + sizeof("/xs_XXXXXX"));
+    memcpy(path, sorter->config.temp_dir, dir_length);
+    memcpy(path + dir_length, "/xs_XXXXXX", sizeof("/xs_XXXXXX"));
+    int fd = mkstemp(path);
+    if (fd >= 0) {
+        unlink(path);
+    }
+    free(path);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (sorter->write_buffer == NULL) {
+        sorter->write_buffer = (unsigned char *) malloc(sorter->config.buffer_size);
+    }
+
+    xs_run *run = (xs_run *) malloc(sizeof(xs_run));
+    run->fd = fd;
+    run->length = 0;
+    run->buffer = NULL;
+    run->capacity = run->start = run->end = 0;
+    run->head = DEFAULT_VALUE;
+    run->exhausted = 1;
+    return run;
+}
+
+/**
+ *  @brief      : (for internal use) Prepare a run to be read from its start, through a buffer of 'buffer_size'.
+ *  @param      : [ External sort. ]
+ *                [ Run. ]
+ *  @return     : None.
+**/
+static void xs_run_rewind(xs_sorter *sorter, xs_run *run) {
+    lseek(run->fd, 0, SEEK_SET);
+    posix_fadvise(run->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    run->capacity = sorter->config.buffer_size;
+    run->buffer = (unsigned char *) malloc(run->capacity);
+    run->start = run->end = 0;
+}
+
+/**
+ *  @brief      : (for internal use) Read the next record of a run into its 'head'. Once none is left, the buffer is
+ *                  de-allocated (so, during a merge, exhausted runs free their share of the budget).
+ *  @param      : [ External sort. ]
+ *                [ Run. ]
+ *  @return     : 1 if read, 0 if no record is left (or it could not be read, setting 'failed').
+**/
+static unsigned char xs_run_advance(xs_sorter *sorter, xs_run *run) {
+    avl_serializer *serializer = sorter->serializer;
+    const unsigned char *record = NULL;
+    size_t size = serializer->size;
+
+    if (run->length != 0) {
+        if (size == 0) {
+            const unsigned char *header = xs_run_read(run, sizeof(uint64_t));
+            uint64_t size64 = 0;
+            if (header != NULL) { memcpy(&size64, header, sizeof(uint64_t)); }
+            size = (size_t) size64;
+            record = header != NULL ? xs_run_read(run, size) : NULL;
+        } else {
+            record = xs_run_read(run, size);
+        }
+        if (record == NULL) { sorter->failed = 1; }
+    }
+    if (record == NULL) {
+        run->exhausted = 1;
+        run->length = 0;
+        free(run->buffer);
+        run->buffer = NULL;
+        return 0;
+    }
+    run->head = serializer->f_read(record, size);
+    run->exhausted = 0;
+    run->length--;
+    return 1;
+}
+
+/**
+ *  @brief      : (for internal use) Read bytes from a run, refilling its buffer (with as large a read as fits) if not
+ *                  enough are buffered. The buffer is grown if a record is larger than it.
+ *  @param      : [ Run. ]
+ *                [ No. of bytes. ]
+ *  @return     : Pointer to bytes (valid until the next read), or NULL if the file ended (or could not be read) first.
+**/
+static const unsigned char * xs_run_read(xs_run *run, size_t size) {
+    if (run->end - run->start < size) {
+        memmove(run->buffer, run->buffer + run->start, run->end - run->start);
+        run->end -= run->start;
+        run->start = 0;
+        if (size > run->capacity) {
+            run->capacity = size;
+            run->buffer = (unsigned char *) realloc(run->buffer, run->capacity);
+        }
+        while (run->end < size) {
+            ssize_t got = read(run->fd, run->buffer + run->end, run->capacity - run->end);
+            if (got < 0 && errno == EINTR) { continue; }
+            if (got <= 0) {
+                return NULL;
+            }
+            run->end += (size_t) got;
+        }
+    }
+    const unsigned char *bytes = run->buffer + run->start;
+    run->start += size;
+    return bytes;
+}
+
+/**
+ *  @brief      : (for internal use) De-allocate a run (and its 'head', if not yet output), closing its file.
+ *  @param      : [ External sort. ]
+ *                [ Run. ]
+ *  @return     : None.
+**/
+static void xs_run_destroy(xs_sorter *sorter, xs_run *run) {
+    if (!run->exhausted && sorter->f_free != NULL) {
+        sorter->f_free(run->head);
+    }
+    close(run->fd);
+    free(run->buffer);
+    free(run);
+}
+
+/**
+ *  @brief      : (for internal use) Write a record (preceded by its size, if records are of variable size) to the
+ *                  write buffer, flushing it first if the record does not fit. A record larger than the buffer is
+ *                  written on its own.
+ *  @param      : [ External sort. ]
+ *                [ File descriptor. ]
+ *                [ Pointer to the no. of bytes in the write buffer. ]
+ *                [ Item. ]
+ *  @return     : 1 if written, else 0.
+**/
+static unsigned char xs_write_record(xs_sorter *sorter, int fd, size_t *pos, DATA_TYPE data) {
+    avl_serializer *serializer = sorter->serializer;
+    size_t size = serializer->size != 0 ? serializer->size : serializer->f_size(data);
+    size_t header = serializer->size != 0 ? 0 : sizeof(uint64_t);
+    uint64_t size64 = (uint64_t) size;
+
+    if (*pos + header + size > sorter->config.buffer_size) {
+        if (!xs_write_all(fd, sorter->write_buffer, *pos)) {
+            return 0;
+        }
+        *pos = 0;
+    }
+    if (header + size > sorter->config.buffer_size) {
+        unsigned char *record = (unsigned char *) malloc(header + size);
+        memcpy(record, &size64, header);
+        serializer->f_write(data, record + header);
+        unsigned char written = xs_write_all(fd, record, header + size);
+        free(record);
+        return written;
+    }
+    memcpy(sorter->write_buffer + *pos, &size64, header);
+    serializer->f_write(data, sorter->write_buffer + *pos + header);
+    *pos += header + size;
+    return 1;
+}
+
+/**
+ *  @brief      : (for internal use) Write bytes to a file (retrying partial writes).
+ *  @param      : [ File descriptor. ]
+ *                [ Bytes. ]
+ *                [ No. of bytes. ]
+ *  @return     : 1 if written, else 0.
+**/
+static unsigned char xs_write_all(int fd, const unsigned char *bytes, size_t n) {
+    while (n != 0) {
+        ssize_t put = write(fd, bytes, n);
+        if (put < 0 && errno == EINTR) { continue; }
+        if (put <= 0) {
+            return 0;
+        }
+        bytes += put;
+        n -= (size_t) put;
+    }
+    return 1;
+}
+
+/**
+ *  @brief      : (for internal use) Start a k-way merge of runs (rewinding each, and reading its first record), and
+ *                  build its loser tree: leaves 'k..2k-1' are the runs, and internal node 'i' has children '2i' and
+ *                  '2i+1'. Matches are played bottom-up, keeping the winners in a buffer, and the losers in the tree.
+ *  @param      : [ External sort. ]
+ *                [ Merger. ]
+ *                [ Runs (the array is owned by the merger thereafter). ]
+ *                [ No. of runs. ]
+ *  @return     : None.
+**/
+static void xs_merger_init(xs_sorter *sorter, xs_merger *merger, xs_run **runs, LENGTH_DT k) {
+    merger->runs = runs;
+    merger->k = k;
+    merger->losers = (LENGTH_DT *) malloc(k * sizeof(LENGTH_DT));
+    for (LENGTH_DT i = 0; i < k; i++) {
+        xs_run_rewind(sorter, runs[i]);
+        xs_run_advance(sorter, runs[i]);
+    }
+
+    LENGTH_DT *winners = (LENGTH_DT *) malloc(2 * k * sizeof(LENGTH_DT));
+    for (LENGTH_DT i = 0; i < k; i++) {
+        winners[k + i] = i;
+    }
+    for (LENGTH_DT i = k - 1; i >= 1; i--) {
+        LENGTH_DT left = winners[2 * i], right = winners[2 * i + 1];
+        if (xs_merger_beats(sorter, merger, left, right)) {
+            winners[i] = left, merger->losers[i] = right;
+        } else {
+            winners[i] = right, merger->losers[i] = left;
+        }
+    }
+    merger->losers[0] = winners[1];
+    free(winners);
+}
+
+/**
+ *  @brief      : (for internal use) Play a match between two runs: an exhausted run always loses, and on ties, the
+ *                  earlier run wins (so the merge is stable).
+ *  @param      : [ External sort. ]
+ *                [ Merger. ]
+ *                [ Index of first run. ]
+ *                [ Index of second run. ]
+ *  @return     : 1 if the first run wins, else 0.
+**/
+static unsigned char xs_merger_beats(xs_sorter *sorter, xs_merger *merger, LENGTH_DT a, LENGTH_DT b) {
+    xs_run *run_a = merger->runs[a], *run_b = merger->runs[b];
+    if (run_b->exhausted) { return 1; }
+    if (run_a->exhausted) { return 0; }
+    if (sorter->f_compare(run_a->head, run_b->head)) { return 1; }
+    if (sorter->f_compare(run_b->head, run_a->head)) { return 0; }
+    return a < b;
+}
+
+/**
+ *  @brief      : (for internal use) Returns the item of the winning run, then reads its next record, and replays
+ *                  the matches on its path to the root, one per level (against the losers stored there), in
+ *                  O(log k) comparisons.
+ *  @param      : [ External sort. ]
+ *                [ Merger. ]
+ *  @return     : Item.
+**/
+static DATA_TYPE xs_merger_next(xs_sorter *sorter, xs_merger *merger) {
+    LENGTH_DT winner = merger->losers[0];
+    DATA_TYPE data = merger->runs[winner]->head;
+    xs_run_advance(sorter, merger->runs[winner]);
+    for (LENGTH_DT i = (merger->k + winner) / 2; i >= 1; i /= 2) {
+        if (xs_merger_beats(sorter, merger, merger->losers[i], winner)) {
+            LENGTH_DT loser = winner;
+            winner = merger->losers[i];
+            merger->losers[i] = loser;
+        }
+    }
+    merger->losers[0] = winner;
+    return data;
+}
+
+/**
+ *  @brief      : (for internal use) De-allocate a merger, and its runs.
+ *  @param      : [ External sort. ]
+ *                [ Merger. ]
+ *  @return     : None.
+**/
+static void xs_merger_destroy(xs_sorter *sorter, xs_merger *merger) {
+    for (LENGTH_DT i = 0; i < merger->k; i++) {
+        xs_run_destroy(sorter, merger->runs[i]);
+    }
+    free(merger->runs);
+    free(merger->losers);
+    merger->runs = NULL, merger->k = 0, merger->losers = NULL;
+}
+
+/**
+ *  @brief      : (for internal use) 'xs_next', as passed to 'avl_bulk_load'.
+ *  @param      : [ External sort. ]
+ *  @return     : Item.
+**/
+static DATA_TYPE xs_next_item(void *arg) {
+    return xs_next((xs_sorter *) arg);
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_EXTERNAL_SORT_             /* compile-time switch */
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+typedef struct PAIR {
+    long key;
+    long seq;
+} pair;
+
+unsigned char f_compare_pair(void *new_data, void *old_data);
+unsigned char f_compare_string(void *new_data, void *old_data);
+void f_write_pair(void *data, void *record);
+void * f_read_pair(const void *record, size_t size);
+size_t f_size_string(void *data);
+void f_write_string(void *data, void *record);
+void * f_read_string(const void *record, size_t size);
+void f_print(void *data);
+void f_clean(ll_list *list);
+
+void t_memory();
+void t_fixed();
+void t_variable();
+
+int main() {
+    t_memory();
+    t_fixed();
+    t_variable();
+    return 0;
+}
+
+void t_memory() {
+    printf("*************** TEST (IN MEMORY) ***************\n");
+    avl_serializer serializer = {sizeof(pair), NULL, f_write_pair, f_read_pair};
+    xs_sorter *sorter = xs_create(NULL, &serializer, f_compare_pair, free);
+    long keys[] = {5, 3, 9, 1, 3, 7};
+    for (int i = 0; i < LEN(keys); i++) {
+        pair *p = (pair *) malloc(sizeof(pair));
+        p->key = keys[i], p->seq = i;
+        xs_push(sorter, p);
+    }
+    xs_finish(sorter);
+    ll_list *list = xs_make_list(sorter);
+    printf("Runs: %ld\n", (long) sorter->merger.k);
+    ll_print(list, f_print, f_clean);
+    while (list->length != 0) { free(ll_pop(list)); }
+    ll_destroy(list);
+    xs_destroy(sorter);
+}
+
+void t_fixed() {
+    printf("*************** TEST (FIXED-SIZE, MERGE PASSES) ***************\n");
+    xs_config config = {4096, 1024, NULL};                  /* 128 items per run, 3 runs per merge */
+    avl_serializer serializer = {sizeof(pair), NULL, f_write_pair, f_read_pair};
+    xs_sorter *sorter = xs_create(&config, &serializer, f_compare_pair, free);
+    for (long i = 0; i < 10000; i++) {
+        pair *p = (pair *) malloc(sizeof(pair));
+        p->key = (i * 7919) % 1000, p->seq = i;             /* each key 10 times */
+        xs_push(sorter, p);
+    }
+    printf("Spilled runs: %ld\n", (long) sorter->runs->length);
+    unsigned char finished = xs_finish(sorter);
+    printf("Finished: %d, merged runs: %ld\n", finished, (long) sorter->merger.k);
+    avl_tree *tree = xs_make_tree(sorter);
+    unsigned char is_sorted = 1;
+    for (LENGTH_DT i = 1; i < tree->length; i++) {
+        pair *a = avl_get(tree, i - 1), *b = avl_get(tree, i);
+        is_sorted &= a->key < b->key || (a->key == b->key && a->seq < b->seq);
+    }
+    printf("Length: %ld, sorted (and stable): %d, height: %ld\n", (long) tree->length, is_sorted, (long) avl_height(tree));
+    while (tree->length != 0) { free(avl_pop_min(tree)); }
+    avl_destroy(tree);
+    xs_destroy(sorter);
+}
+
+void t_variable() {
+    printf("*************** TEST (VARIABLE-SIZE) ***************\n");
+    xs_config config = {512, 128, "."};
+    avl_serializer serializer = {0, f_size_string, f_write_string, f_read_string};
+    xs_sorter *sorter = xs_create(&config, &serializer, f_compare_string, free);
+    const char *words[] = {"pear", "fig", "apple", "kiwi", "banana", "cherry", "date", "plum", "lime", "grape"};
+    for (int i = 0; i < 200; i++) {
+        const char *word = words[(i * 7) % LEN(words)];
+        size_t length = i == 100 ? 300 : strlen(word);      /* a record larger than a buffer */
+        char *text = (char *) malloc(length + 1);
+        if (i == 100) {
+            memset(text, 'z', length), text[length] = '\0';
+        } else {
+            memcpy(text, word, length + 1);
+        }
+        xs_push(sorter, text);
+    }
+    printf("Spilled runs: %ld\n", (long) sorter->runs->length);
+    xs_finish(sorter);
+    unsigned char is_sorted = 1;
+    char *prev = xs_next(sorter), *text;
+    LENGTH_DT count = 1;
+    while ((text = xs_next(sorter)) != NULL) {
+        is_sorted &= strcmp(prev, text) <= 0;
+        free(prev);
+        prev = text;
+        count++;
+    }
+    printf("Count: %ld, sorted: %d, last: %.5s... (%zu chars)\n", (long) count, is_sorted, prev, strlen(prev));
+    free(prev);
+    xs_destroy(sorter);
+}
+
+unsigned char f_compare_pair(void *new_data, void *old_data) {
+    return ((pair *) new_data)->key < ((pair *) old_data)->key;
+}
+
+unsigned char f_compare_string(void *new_data, void *old_data) {
+    return strcmp((char *) new_data, (char *) old_data) < 0;
+}
+
+void f_write_pair(void *data, void *record) {
+    memcpy(record, data, sizeof(pair));
+}
+
+void * f_read_pair(const void *record, size_t size) {
+    pair *p = (pair *) malloc(sizeof(pair));
+    memcpy(p, record, sizeof(pair));
+    return p;
+}
+
+size_t f_size_string(void *data) {
+    return strlen((char *) data);
+}
+
+void f_write_string(void *data, void *record) {
+    memcpy(record, data, strlen((char *) data));
+}
+
+void * f_read_string(const void *record, size_t size) {
+    char *text = (char *) malloc(size + 1);
+    memcpy(text, record, size);
+    text[size] = '\0';
+    return text;
+}
+
+void f_print(void *data) {
+    printf("%ld(%ld), ", ((pair *) data)->key, ((pair *) data)->seq);
+}
+
+void f_clean(ll_list *list) {
+    printf("\b\b \n");
+}
+
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_EXTERNAL_SORT_            /* compile-time switch */
+
+#include <time.h>
+
+unsigned char f_compare(void *new_data, void *old_data);
+void f_write(void *data, void *record);
+void * f_read(const void *record, size_t size);
+void * f_next(void *arg);
+double now();
+
+/**
+ *  @brief      : Sorts random integer keys (stored in the pointers themselves), 10 times as many as fit in the budget,
+ *                  into a tree, externally, and then in memory (sort_merge and avl_bulk_load), for reference.
+ *                  (Usage: ./a.out [budget in MB (default: 8)] [temp dir (default: '$TMPDIR', else '/tmp')])
+**/
+int main(int argc, char **argv) {
+    xs_config config = {(size_t) (argc > 1 ? atol(argv[1]) : 8) << 20, 0, argc > 2 ? argv[2] : NULL};
+    avl_serializer serializer = {sizeof(long), NULL, f_write, f_read};
+    LENGTH_DT n = (LENGTH_DT) (10 * config.budget / (sizeof(long) + 2 * sizeof(DATA_TYPE)));
+
+    DATA_TYPE *keys = (DATA_TYPE *) malloc(n * sizeof(DATA_TYPE));
+    uint64_t seed = 88172645463325252ull;
+    for (LENGTH_DT i = 0; i < n; i++) {
+        seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+        keys[i] = (DATA_TYPE) (long) ((seed >> 2) | 1);
+    }
+
+    double t0 = now();
+    xs_sorter *sorter = xs_create(&config, &serializer, f_compare, NULL);
+    for (LENGTH_DT i = 0; i < n; i++) {
+        xs_push(sorter, keys[i]);
+    }
+    LENGTH_DT n_runs = sorter->runs->length + 1;
+    double t_push = now() - t0;
+    xs_finish(sorter);
+    double t_finish = now() - t0 - t_push;
+    avl_tree *tree = xs_make_tree(sorter);
+    double t_external = now() - t0;
+    unsigned char failed = sorter->failed;
+    xs_destroy(sorter);
+    LENGTH_DT n_external = tree->length;
+    avl_destroy(tree);
+
+    t0 = now();
+    sort_merge(keys, n, f_compare);
+    DATA_TYPE *cursor = keys;
+    tree = avl_create();
+    avl_bulk_load(tree, n, f_next, &cursor);
+    double t_memory = now() - t0;
+    free(keys);
+    avl_destroy(tree);
+
+    printf("Keys: %ld (%.1f MiB of records), budget: %.1f MiB, runs: %ld, failed: %d, loaded: %ld\n", (long) n,
+                n * sizeof(long) / 1048576.0, config.budget / 1048576.0, (long) n_runs, failed, (long) n_external);
+    printf("%-32s: %10.3f ms\n", "external (push + spill)", t_push * 1e3);
+    printf("%-32s: %10.3f ms\n", "external (finish)", t_finish * 1e3);
+    printf("%-32s: %10.3f ms\n", "external (total, into tree)", t_external * 1e3);
+    printf("%-32s: %10.3f ms\n", "in memory (sort_merge, bulk)", t_memory * 1e3);
+    return 0;
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return (long) new_data < (long) old_data;
+}
+
+void f_write(void *data, void *record) {
+    long key = (long) data;
+    memcpy(record, &key, sizeof(long));
+}
+
+void * f_read(const void *record, size_t size) {
+    long key;
+    memcpy(&key, record, sizeof(long));
+    return (void *) key;
+}
+
+void * f_next(void *arg) {
+    DATA_TYPE **cursor = (DATA_TYPE **) arg;
+    return *(*cursor)++;
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#endif
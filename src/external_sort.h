@@ -0,0 +1,157 @@
+/**
+ ****************************************************************
+ * @file            : external_sort.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the implementation of an external (out-of-core) merge sort.
+ *                      Items are pushed one by one, and gathered in memory up to a budget, then sorted and spilled (as
+ *                      records, through a user serializer) to a temporary file (a run). Runs are merged k-way (through
+ *                      a loser tree), reading each through a large buffer, and the output is streamed, item by item,
+ *                      into a list, or into a tree (bulk-loaded in O(n)).
+ *                      (Note: Requires POSIX file I/O.)
+ * **************************************************************
+ **/
+
+#ifndef _EXTERNAL_SORT_H_
+#define _EXTERNAL_SORT_H_
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L                     /* for 'mkstemp' and 'posix_fadvise' under strict C99 */
+#endif
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "shared_defs.h"
+#include "linked_list.h"
+#include "avl_tree.h"
+#include "avl_snapshot.h"                           /* for 'avl_serializer' */
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Default memory budget (in bytes), and default size of the buffer of a run.
+**/
+#define XS_DEFAULT_BUDGET           (64 << 20)
+#define XS_DEFAULT_BUFFER_SIZE      (1 << 20)
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Configuration of an external sort. Zero-initialized fields take their defaults.
+**/
+typedef struct XS_CONFIG {
+    size_t budget;                                  /* max. bytes of items (records, plus a pointer each) held in memory (default: 'XS_DEFAULT_BUDGET') */
+    size_t buffer_size;                             /* size of the buffer of a run, so at most 'budget / buffer_size - 1' runs are merged at once (default: 'XS_DEFAULT_BUFFER_SIZE') */
+    const char *temp_dir;                           /* directory of temporary files (default: '$TMPDIR', else '/tmp') */
+} xs_config;
+
+/**
+ *  @brief      : (For internal use) Run (a temporary file of sorted records), and the buffer it is read through.
+**/
+typedef struct XS_RUN {
+    int fd;
+    LENGTH_DT length;                               /* no. of records left to read */
+    unsigned char *buffer;
+    size_t capacity;
+    size_t start;                                   /* offset of the first unread byte in 'buffer' */
+    size_t end;                                     /* offset past the last read byte in 'buffer' */
+    DATA_TYPE head;                                 /* item of the last read record (during a merge) */
+    unsigned char exhausted;                        /* set once no record is left to read into 'head' */
+} xs_run;
+
+/**
+ *  @brief      : (For internal use) K-way merge of runs, through a loser tree: 'losers[1..k-1]' hold the index of
+ *                  the run that lost the match at each internal node, and 'losers[0]' the overall winner.
+**/
+typedef struct XS_MERGER {
+    xs_run **runs;
+    LENGTH_DT k;
+    LENGTH_DT *losers;
+} xs_merger;
+
+/**
+ *  @brief      : External sort.
+**/
+typedef struct XS_SORTER {
+    xs_config config;
+    avl_serializer *serializer;
+    unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data);
+    void (*f_free)(DATA_TYPE data);
+    DATA_TYPE *items;                               /* items held in memory */
+    LENGTH_DT n_items;
+    LENGTH_DT capacity;
+    size_t used;                                    /* bytes of items held in memory */
+    ll_list *runs;                                  /* queue of runs */
+    unsigned char *write_buffer;
+    LENGTH_DT length;                               /* no. of items pushed */
+    LENGTH_DT remaining;                            /* no. of items left to output (once finished) */
+    unsigned char finished;
+    unsigned char failed;                           /* set if a temporary file could not be written or read */
+    xs_merger merger;
+} xs_sorter;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Create an external sort (dynamically, on heap).
+ *  @param      : [ Configuration (or NULL for defaults). ]
+ *                [ Serializer (kept, not copied). ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *                [ Function that de-allocates an item, once spilled (or NULL if items need no de-allocation). ]
+ *  @return     : Pointer to external sort.
+**/
+xs_sorter * xs_create(xs_config *config, avl_serializer *serializer,
+                        unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data), void (*f_free)(DATA_TYPE data));
+
+/**
+ *  @brief      : Push an item (owned by the external sort thereafter). If the memory budget is exceeded, the items in
+ *                  memory are sorted and spilled to a run.
+ *  @param      : [ External sort. ]
+ *                [ Item. ]
+ *  @return     : 1 if pushed, 0 if a run could not be written (or the external sort is finished).
+**/
+unsigned char xs_push(xs_sorter *sorter, DATA_TYPE data);
+
+/**
+ *  @brief      : Finish pushing, and prepare the output. If nothing was spilled, the items are sorted in memory.
+ *                  Else, the rest are spilled, and runs are merged (in passes) until few enough are left to be merged
+ *                  at once.
+ *  @param      : [ External sort. ]
+ *  @return     : 1 if ready, 0 if a run could not be written or read.
+**/
+unsigned char xs_finish(xs_sorter *sorter);
+
+/**
+ *  @brief      : Get the next item in order (owned by the caller), once finished. When none is left, returns
+ *                  DEFAULT_VALUE stored in 'shared_defs.h' (read 'remaining' to tell it apart from an item).
+ *  @param      : [ External sort. ]
+ *  @return     : Item.
+**/
+DATA_TYPE xs_next(xs_sorter *sorter);
+
+/**
+ *  @brief      : Get the remaining items in order, once finished, in a list (dynamically, on heap).
+ *  @param      : [ External sort. ]
+ *  @return     : Pointer to list.
+**/
+ll_list * xs_make_list(xs_sorter *sorter);
+
+/**
+ *  @brief      : Get the remaining items in order, once finished, in a tree (dynamically, on heap), built in O(n).
+ *  @param      : [ External sort. ]
+ *  @return     : Pointer to tree.
+**/
+avl_tree * xs_make_tree(xs_sorter *sorter);
+
+/**
+ *  @brief      : De-allocate an external sort (and its temporary files). Items it still holds are de-allocated
+ *                  through 'f_free' (if not NULL).
+ *  @param      : [ External sort. ]
+ *  @return     : None.
+**/
+void xs_destroy(xs_sorter *sorter);
+
+#endif
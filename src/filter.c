@@ -0,0 +1,730 @@
+/**
+ ****************************************************************
+ * @file            : filter.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of approximate membership filters (blocked Bloom filter, and cuckoo filter), and of
+ *                      an AVL tree with an attached filter.
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#include "filter.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Size (in bytes) of a cache line (and of a block of a Bloom filter).
+**/
+#define BF_CACHE_LINE       64
+
+/**
+ *  @brief      : Constants of SWAR (SIMD within a register) operations on the four 16-bit fingerprints of a bucket,
+ *                  loaded as a 64-bit word.
+**/
+#define CF_LANES_LOW        0x0001000100010001ULL
+#define CF_LANES_HIGH       0x8000800080008000ULL
+
+/* ********************* static variable(s) SECTION ********************** */
+
+/**
+ *  @brief      : Odd constants that a 32-bit hash is multiplied by, to select the bit of a key in each word of its
+ *                  block (the top 6 bits of each product).
+**/
+static const uint32_t bf_salts[BF_BLOCK_WORDS] = {
+    0x47B6137BU, 0x44974D91U, 0x8824AD5BU, 0xA2B7289DU, 0x705495C7U, 0x2DF1424BU, 0x9EFC4947U, 0x5C6BFB31U
+};
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static void bf_allocate(bf_filter *filter, LENGTH_DT capacity);
+static uint64_t * bf_get_block(bf_filter *filter, uint64_t hash);
+static void cf_allocate(cf_filter *filter, LENGTH_DT capacity);
+static uint16_t cf_fingerprint(cf_filter *filter, uint64_t hash);
+static LENGTH_DT cf_alt_bucket(cf_filter *filter, LENGTH_DT i, uint16_t fp);
+static unsigned char cf_bucket_has(cf_filter *filter, LENGTH_DT i, uint16_t fp);
+static unsigned char cf_bucket_add(cf_filter *filter, LENGTH_DT i, uint16_t fp);
+static unsigned char cf_bucket_remove(cf_filter *filter, LENGTH_DT i, uint16_t fp);
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : (for internal use) Allocate the blocks of a Bloom filter (aligned to a cache line, all bits clear),
+ *                  for a no. of keys. A key sets 8 bits, which (for a standard Bloom filter) gives the false positive
+ *                  rate 'p' at '-8 / ln(1 - p^(1/8))' bits per key. Blocking adds collisions, so 10% more bits are used.
+ *                  Previous blocks are not de-allocated.
+ *  @param      : [ Filter. ]
+ *                [ Expected no. of keys. ]
+ *  @return     : None.
+**/
+static void bf_allocate(bf_filter *filter, LENGTH_DT capacity) {
+    double bits_per_key = 1.1 * -8.0 / log(1.0 - pow(filter->fp_rate, 1.0 / BF_BLOCK_WORDS));
+    LENGTH_DT n_blocks = (LENGTH_DT) ceil(capacity * bits_per_key / (BF_BLOCK_WORDS * 64));
+
+    filter->n_blocks = n_blocks < 1 ? 1 : n_blocks;
+    filter->memory = malloc(filter->n_blocks * BF_CACHE_LINE + BF_CACHE_LINE - 1);
+    filter->blocks = (uint64_t *) (((uintptr_t) filter->memory + BF_CACHE_LINE - 1) & ~((uintptr_t) BF_CACHE_LINE - 1));
+    bf_clear(filter);
+}
+
+/**
+ *  @brief      : Allocating dynamic memory for a Bloom filter structure (and its blocks), initializing and returning
+ *                  the pointer.
+ *  @param      : [ Expected no. of keys. ]
+ *                [ False positive rate. ]
+ *                [ Function that receives a key, and returns its hash. ]
+ *  @return     : Pointer to filter.
+**/
+bf_filter * bf_create(LENGTH_DT capacity, double fp_rate, uint64_t (*f_hash)(DATA_TYPE key)) {
+    bf_filter *new_filter = (bf_filter *) malloc(sizeof(bf_filter));
+    new_filter->fp_rate = fp_rate;
+    new_filter->f_hash = f_hash;
+    bf_allocate(new_filter, capacity);
+    return new_filter;
+}
+
+/**
+ *  @brief      : (for internal use) Get the block of a hash, from its top 32 bits (scaled to the no. of blocks, by a
+ *                  multiplication, rather than a division).
+ *  @param      : [ Filter. ]
+ *                [ Hash. ]
+ *  @return     : Pointer to first word of block.
+**/
+static uint64_t * bf_get_block(bf_filter *filter, uint64_t hash) {
+    return filter->blocks + BF_BLOCK_WORDS * (LENGTH_DT) (((hash >> 32) * (uint64_t) filter->n_blocks) >> 32);
+}
+
+/**
+ *  @brief      : Insert a key, by setting one bit in each word of its block, selected by the bottom 32 bits of its
+ *                  hash, multiplied by a different salt per word. (The loop has a fixed trip count, and no branches,
+ *                  so it is vectorized by the compiler.)
+ *  @param      : [ Filter. ]
+ *                [ Key. ]
+ *  @return     : None.
+**/
+void bf_insert(bf_filter *filter, DATA_TYPE key) {
+    uint64_t hash = filter->f_hash(key);
+    uint64_t *block = bf_get_block(filter, hash);
+    uint32_t h = (uint32_t) hash;
+
+    for (int j = 0; j < BF_BLOCK_WORDS; j++) {
+        block[j] |= 1ULL << ((h * bf_salts[j]) >> 26);
+    }
+    filter->length++;
+}
+
+/**
+ *  @brief      : Check if a key may be in a filter, by checking that all its bits are set (see 'bf_insert'). The bits
+ *                  missing from all words are or-ed together, rather than returning at the first, to keep the loop
+ *                  branch-free.
+ *  @param      : [ Filter. ]
+ *                [ Key. ]
+ *  @return     : 0 if the key was never inserted, else 1.
+**/
+unsigned char bf_contains(bf_filter *filter, DATA_TYPE key) {
+    uint64_t hash = filter->f_hash(key);
+    uint64_t *block = bf_get_block(filter, hash);
+    uint32_t h = (uint32_t) hash;
+    uint64_t missing = 0;
+
+    for (int j = 0; j < BF_BLOCK_WORDS; j++) {
+        missing |= ~block[j] & (1ULL << ((h * bf_salts[j]) >> 26));
+    }
+    return missing == 0;
+}
+
+/**
+ *  @brief      : Rebuild a Bloom filter from an array of keys. Its blocks are re-allocated for a no. of keys (at the
+ *                  same false positive rate), and all keys are inserted.
+ *  @param      : [ Filter. ]
+ *                [ Array of keys. ]
+ *                [ No. of keys. ]
+ *                [ Expected no. of keys. ]
+ *  @return     : None.
+**/
+void bf_rebuild(bf_filter *filter, DATA_TYPE *arr, LENGTH_DT n, LENGTH_DT capacity) {
+    free(filter->memory);
+    bf_allocate(filter, capacity < n ? n : capacity);
+    for (LENGTH_DT i = 0; i < n; i++) {
+        bf_insert(filter, arr[i]);
+    }
+}
+
+/**
+ *  @brief      : Rebuild a Bloom filter from a list of keys.
+ *                  (Note: For more information, read '@brief' of 'bf_rebuild'.)
+ *  @param      : [ Filter. ]
+ *                [ List of keys. ]
+ *                [ Expected no. of keys. ]
+ *  @return     : None.
+**/
+void bf_rebuild_list(bf_filter *filter, ll_list *list, LENGTH_DT capacity) {
+    free(filter->memory);
+    bf_allocate(filter, capacity < list->length ? list->length : capacity);
+    for (ll_node *node = list->head; node != NULL; node = node->next) {
+        bf_insert(filter, node->data);
+    }
+}
+
+/**
+ *  @brief      : Delete all keys in a Bloom filter, by clearing all bits.
+ *  @param      : [ Filter. ]
+ *  @return     : None.
+**/
+void bf_clear(bf_filter *filter) {
+    memset(filter->blocks, 0, filter->n_blocks * BF_CACHE_LINE);
+    filter->length = 0;
+}
+
+/**
+ *  @brief      : De-allocate the blocks of a Bloom filter, then the filter itself.
+ *  @param      : [ Filter. ]
+ *  @return     : None.
+**/
+void bf_destroy(bf_filter *filter) {
+    free(filter->memory);
+    free(filter);
+}
+
+/**
+ *  @brief      : (for internal use) Allocate the buckets of a cuckoo filter (all empty), for a no. of keys, at a load
+ *                  of at most 'CF_MAX_LOAD'. The no. of buckets is a power of two, so that the alternate bucket of a
+ *                  fingerprint can be derived by an XOR. Previous buckets are not de-allocated.
+ *  @param      : [ Filter. ]
+ *                [ Expected no. of keys. ]
+ *  @return     : None.
+**/
+static void cf_allocate(cf_filter *filter, LENGTH_DT capacity) {
+    LENGTH_DT n_buckets = 1;
+    while (n_buckets * CF_BUCKET_SIZE * CF_MAX_LOAD < capacity) {
+        n_buckets *= 2;
+    }
+    filter->n_buckets = n_buckets;
+    filter->buckets = (uint16_t *) malloc(n_buckets * CF_BUCKET_SIZE * sizeof(uint16_t));
+    cf_clear(filter);
+}
+
+/**
+ *  @brief      : Allocating dynamic memory for a cuckoo filter structure (and its buckets), initializing and returning
+ *                  the pointer. A lookup compares a fingerprint against (up to) '2 * CF_BUCKET_SIZE' others, so the
+ *                  false positive rate 'p' needs fingerprints of 'log2(2 * CF_BUCKET_SIZE / p)' bits (at most 16).
+ *  @param      : [ Expected no. of keys. ]
+ *                [ False positive rate. ]
+ *                [ Function that receives a key, and returns its hash. ]
+ *  @return     : Pointer to filter.
+**/
+cf_filter * cf_create(LENGTH_DT capacity, double fp_rate, uint64_t (*f_hash)(DATA_TYPE key)) {
+    cf_filter *new_filter = (cf_filter *) malloc(sizeof(cf_filter));
+    int fp_bits = (int) ceil(log2(2 * CF_BUCKET_SIZE / fp_rate));
+    new_filter->fp_bits = fp_bits < 4 ? 4 : fp_bits > 16 ? 16 : fp_bits;
+    new_filter->f_hash = f_hash;
+    cf_allocate(new_filter, capacity);
+    return new_filter;
+}
+
+/**
+ *  @brief      : (for internal use) Get the fingerprint of a hash, from its top bits (the bucket is selected by the
+ *                  bottom bits). 0 marks an empty slot, so it is mapped to 1.
+ *  @param      : [ Filter. ]
+ *                [ Hash. ]
+ *  @return     : Fingerprint.
+**/
+static uint16_t cf_fingerprint(cf_filter *filter, uint64_t hash) {
+    uint16_t fp = (uint16_t) ((hash >> 32) & ((1U << filter->fp_bits) - 1));
+    return fp == 0 ? 1 : fp;
+}
+
+/**
+ *  @brief      : (for internal use) Get the alternate bucket of a fingerprint in a bucket (XOR-ing the bucket with a
+ *                  hash of the fingerprint, so that the alternate of the alternate is the bucket itself).
+ *  @param      : [ Filter. ]
+ *                [ Bucket. ]
+ *                [ Fingerprint. ]
+ *  @return     : Alternate bucket.
+**/
+static LENGTH_DT cf_alt_bucket(cf_filter *filter, LENGTH_DT i, uint16_t fp) {
+    return (i ^ (LENGTH_DT) (fp * 0x5BD1E995U)) & (filter->n_buckets - 1);
+}
+
+/**
+ *  @brief      : (for internal use) Check if a bucket has a fingerprint. The bucket is loaded as a single word, XOR-ed
+ *                  with the fingerprint in all four 16-bit lanes, and checked for a zero lane (without branches).
+ *  @param      : [ Filter. ]
+ *                [ Bucket. ]
+ *                [ Fingerprint. ]
+ *  @return     : 1 if found, else 0.
+**/
+static unsigned char cf_bucket_has(cf_filter *filter, LENGTH_DT i, uint16_t fp) {
+    uint64_t word;
+    memcpy(&word, filter->buckets + i * CF_BUCKET_SIZE, sizeof(word));
+    word ^= fp * CF_LANES_LOW;
+    return ((word - CF_LANES_LOW) & ~word & CF_LANES_HIGH) != 0;
+}
+
+/**
+ *  @brief      : (for internal use) Add a fingerprint to an empty slot of a bucket.
+ *  @param      : [ Filter. ]
+ *                [ Bucket. ]
+ *                [ Fingerprint. ]
+ *  @return     : 1 if added, or 0 if the bucket is full.
+**/
+static unsigned char cf_bucket_add(cf_filter *filter, LENGTH_DT i, uint16_t fp) {
+    uint16_t *bucket = filter->buckets + i * CF_BUCKET_SIZE;
+    for (int k = 0; k < CF_BUCKET_SIZE; k++) {
+        if (bucket[k] == 0) {
+            bucket[k] = fp;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ *  @brief      : (for internal use) Remove (one copy of) a fingerprint from a bucket.
+ *  @param      : [ Filter. ]
+ *                [ Bucket. ]
+ *                [ Fingerprint. ]
+ *  @return     : 1 if removed, or 0 if not found.
+**/
+static unsigned char cf_bucket_remove(cf_filter *filter, LENGTH_DT i, uint16_t fp) {
+    uint16_t *bucket = filter->buckets + i * CF_BUCKET_SIZE;
+    for (int k = 0; k < CF_BUCKET_SIZE; k++) {
+        if (bucket[k] == fp) {
+            bucket[k] = 0;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ *  @brief      : Insert a key. Its fingerprint is added to either of its buckets. If both are full, a fingerprint of
+ *                  one is evicted (a random slot) to its alternate bucket, in its place, and so on, up to 'CF_MAX_KICKS'
+ *                  times. If the last evicted fingerprint cannot be placed, it is kept as the victim (so that no key
+ *                  is lost), and the filter is full (no more keys are inserted, until one is deleted).
+ *  @param      : [ Filter. ]
+ *                [ Key. ]
+ *  @return     : 1 if inserted, or 0 if the filter is full.
+**/
+unsigned char cf_insert(cf_filter *filter, DATA_TYPE key) {
+    uint64_t hash = filter->f_hash(key);
+    uint16_t fp = cf_fingerprint(filter, hash), tmp;
+    LENGTH_DT i = hash & (filter->n_buckets - 1);
+    uint32_t state = (uint32_t) (hash >> 16) | 1;
+
+    if (filter->victim != 0) {
+        return 0;
+    }
+    filter->length++;
+    if (cf_bucket_add(filter, i, fp) || cf_bucket_add(filter, cf_alt_bucket(filter, i, fp), fp)) {
+        return 1;
+    }
+    if (state & 2) {
+        i = cf_alt_bucket(filter, i, fp);
+    }
+    for (int kick = 0; kick < CF_MAX_KICKS; kick++) {
+        uint16_t *slot;
+        state ^= state << 13, state ^= state >> 17, state ^= state << 5;
+        slot = filter->buckets + i * CF_BUCKET_SIZE + (state % CF_BUCKET_SIZE);
+        tmp = *slot, *slot = fp, fp = tmp;
+        i = cf_alt_bucket(filter, i, fp);
+        if (cf_bucket_add(filter, i, fp)) {
+            return 1;
+        }
+    }
+    filter->victim = fp;
+    filter->victim_bucket = i;
+    return 1;
+}
+
+/**
+ *  @brief      : Check if a key may be in a filter, by looking for its fingerprint in its two buckets (and the victim).
+ *  @param      : [ Filter. ]
+ *                [ Key. ]
+ *  @return     : 0 if the key is not in the filter, else 1.
+**/
+unsigned char cf_contains(cf_filter *filter, DATA_TYPE key) {
+    uint64_t hash = filter->f_hash(key);
+    uint16_t fp = cf_fingerprint(filter, hash);
+    LENGTH_DT i1 = hash & (filter->n_buckets - 1), i2 = cf_alt_bucket(filter, i1, fp);
+
+    if (cf_bucket_has(filter, i1, fp) | cf_bucket_has(filter, i2, fp)) {
+        return 1;
+    }
+    return filter->victim == fp && (filter->victim_bucket == i1 || filter->victim_bucket == i2);
+}
+
+/**
+ *  @brief      : Delete a key, by removing its fingerprint from either of its buckets (or the victim). If there is a
+ *                  victim, it is then placed in its bucket, or its alternate, if one has room.
+ *  @param      : [ Filter. ]
+ *                [ Key. ]
+ *  @return     : 1 if deleted, else 0.
+**/
+unsigned char cf_delete(cf_filter *filter, DATA_TYPE key) {
+    uint64_t hash = filter->f_hash(key);
+    uint16_t fp = cf_fingerprint(filter, hash);
+    LENGTH_DT i1 = hash & (filter->n_buckets - 1), i2 = cf_alt_bucket(filter, i1, fp);
+
+    if (cf_bucket_remove(filter, i1, fp) || cf_bucket_remove(filter, i2, fp)) {
+        if (filter->victim != 0) {
+            LENGTH_DT i = filter->victim_bucket;
+            if (cf_bucket_add(filter, i, filter->victim) ||
+                cf_bucket_add(filter, cf_alt_bucket(filter, i, filter->victim), filter->victim)) {
+                filter->victim = 0;
+            }
+        }
+    } else if (filter->victim == fp && (filter->victim_bucket == i1 || filter->victim_bucket == i2)) {
+        filter->victim = 0;
+    } else {
+        return 0;
+    }
+    filter->length--;
+    return 1;
+}
+
+/**
+ *  @brief      : Rebuild a cuckoo filter from an array of keys. Its buckets are re-allocated for a no. of keys (with
+ *                  the same fingerprints), and all keys are inserted. If an insertion fails, the no. is doubled, and
+ *                  the filter is rebuilt again, up to 'CF_MAX_REBUILDS' times (since copies of a key, or keys that
+ *                  share a fingerprint and buckets, fill the same buckets at any size).
+ *  @param      : [ Filter. ]
+ *                [ Array of keys. ]
+ *                [ No. of keys. ]
+ *                [ Expected no. of keys. ]
+ *  @return     : 1 if all keys were inserted, else 0.
+**/
+unsigned char cf_rebuild(cf_filter *filter, DATA_TYPE *arr, LENGTH_DT n, LENGTH_DT capacity) {
+    LENGTH_DT i = 0;
+    int rebuilds = 0;
+    if (capacity < n) { capacity = n; }
+    do {
+        free(filter->buckets);
+        cf_allocate(filter, capacity);
+        for (i = 0; i < n && cf_insert(filter, arr[i]); i++);
+        capacity *= 2;
+    } while (i < n && rebuilds++ < CF_MAX_REBUILDS);
+    return i == n;
+}
+
+/**
+ *  @brief      : Rebuild a cuckoo filter from a list of keys.
+ *                  (Note: For more information, read '@brief' of 'cf_rebuild'.)
+ *  @param      : [ Filter. ]
+ *                [ List of keys. ]
+ *                [ Expected no. of keys. ]
+ *  @return     : 1 if all keys were inserted, else 0.
+**/
+unsigned char cf_rebuild_list(cf_filter *filter, ll_list *list, LENGTH_DT capacity) {
+    ll_node *node = list->head;
+    int rebuilds = 0;
+    if (capacity < list->length) { capacity = list->length; }
+    do {
+        free(filter->buckets);
+        cf_allocate(filter, capacity);
+        for (node = list->head; node != NULL && cf_insert(filter, node->data); node = node->next);
+        capacity *= 2;
+    } while (node != NULL && rebuilds++ < CF_MAX_REBUILDS);
+    return node == NULL;
+}
+
+/**
+ *  @brief      : Delete all keys in a cuckoo filter, by emptying all slots.
+ *  @param      : [ Filter. ]
+ *  @return     : None.
+**/
+void cf_clear(cf_filter *filter) {
+    memset(filter->buckets, 0, filter->n_buckets * CF_BUCKET_SIZE * sizeof(uint16_t));
+    filter->length = 0;
+    filter->victim = 0;
+}
+
+/**
+ *  @brief      : De-allocate the buckets of a cuckoo filter, then the filter itself.
+ *  @param      : [ Filter. ]
+ *  @return     : None.
+**/
+void cf_destroy(cf_filter *filter) {
+    free(filter->buckets);
+    free(filter);
+}
+
+/**
+ *  @brief      : Allocating dynamic memory for a filtered tree structure (and its tree and filter), initializing and
+ *                  returning the pointer.
+ *  @param      : [ Expected no. of items. ]
+ *                [ False positive rate of the filter. ]
+ *                [ Function that receives an item, and returns its hash. ]
+ *  @return     : Pointer to filtered tree.
+**/
+ft_tree * ft_create(LENGTH_DT capacity, double fp_rate, uint64_t (*f_hash)(DATA_TYPE key)) {
+    ft_tree *new_ft = (ft_tree *) malloc(sizeof(ft_tree));
+    new_ft->tree = avl_create();
+    new_ft->filter = cf_create(capacity, fp_rate, f_hash);
+    new_ft->failed = 0;
+    return new_ft;
+}
+
+/**
+ *  @brief      : Insert an item into the tree, and into its filter if no equal item is in the tree (so that copies of
+ *                  an item, which all fill the same buckets, never fill the filter). If the filter is full, it is
+ *                  rebuilt from the distinct items of the tree (exported with 'avl_make_array', in order, so copies are
+ *                  adjacent), for twice their no. If the rebuild fails, the filter is bypassed thereafter.
+ *  @param      : [ Filtered tree. ]
+ *                [ Data to insert. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : None.
+**/
+void ft_insert(ft_tree *ft, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    unsigned char is_new = !ft->failed && avl_count(ft->tree, data, f_compare) == 0;
+    avl_insert(ft->tree, data, f_compare);
+    if (is_new && !cf_insert(ft->filter, data)) {
+        DATA_TYPE *arr = (DATA_TYPE *) malloc(ft->tree->length * sizeof(DATA_TYPE));
+        LENGTH_DT n = 0;
+        avl_make_array(ft->tree, arr);
+        for (LENGTH_DT i = 0; i < ft->tree->length; i++) {
+            if (n == 0 || f_compare(arr[n - 1], arr[i])) { arr[n++] = arr[i]; }
+        }
+        ft->failed = !cf_rebuild(ft->filter, arr, n, 2 * n);
+        free(arr);
+    }
+}
+
+/**
+ *  @brief      : Find an item equal to a key. The filter is checked first (one or two cache lines), and the tree is
+ *                  only searched if the key may be in it.
+ *  @param      : [ Filtered tree. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE ft_find(ft_tree *ft, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    if (!ft->failed && !cf_contains(ft->filter, key)) {
+        return DEFAULT_VALUE;
+    }
+    return avl_find(ft->tree, key, f_compare);
+}
+
+/**
+ *  @brief      : Delete an item at an index from the tree, and from its filter if it was the last copy of the item.
+ *  @param      : [ Filtered tree. ]
+ *                [ Index. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE ft_delete(ft_tree *ft, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    LENGTH_DT length = ft->tree->length;
+    DATA_TYPE data = avl_delete(ft->tree, i, f_compare);
+    if (ft->tree->length != length && !ft->failed && avl_count(ft->tree, data, f_compare) == 0) {
+        cf_delete(ft->filter, data);
+    }
+    return data;
+}
+
+/**
+ *  @brief      : De-allocate the tree and filter of a filtered tree, then the filtered tree itself.
+ *  @param      : [ Filtered tree. ]
+ *  @return     : None.
+**/
+void ft_destroy(ft_tree *ft) {
+    avl_destroy(ft->tree);
+    cf_destroy(ft->filter);
+    free(ft);
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_FILTER_                    /* compile-time switch */
+
+#include "hash_map.h"
+
+unsigned char f_compare(void *new_data, void *old_data);
+
+void t_bloom();
+void t_cuckoo();
+void t_filtered_tree();
+void t_duplicates();
+uint64_t f_hash_same(void *key);
+
+int main() {
+    t_bloom();
+    t_cuckoo();
+    t_filtered_tree();
+    t_duplicates();
+    return 0;
+}
+
+void t_bloom() {
+    printf("*************** TEST (BLOOM) ***************\n");
+    LENGTH_DT n = 10000, trials = 100000, false_negatives = 0, false_positives = 0;
+    bf_filter *filter = bf_create(n, 0.01, hm_hash_int);
+    for (LENGTH_DT i = 1; i <= n; i++) { bf_insert(filter, (void *) (2 * i)); }
+    for (LENGTH_DT i = 1; i <= n; i++) { false_negatives += !bf_contains(filter, (void *) (2 * i)); }
+    for (LENGTH_DT i = 0; i < trials; i++) { false_positives += bf_contains(filter, (void *) (2 * i + 1)); }
+    printf("Keys: %ld, blocks: %ld, false negatives: %ld, false positive rate (target 1%%): %.2f%%\n", (long) n,
+            (long) filter->n_blocks, (long) false_negatives, 100.0 * false_positives / trials);
+
+    ll_list *list = ll_create();
+    for (LENGTH_DT i = 1; i <= 3; i++) { ll_append(list, (void *) (3 * i)); }
+    bf_rebuild_list(filter, list, 100);
+    printf("Rebuilt from list, blocks: %ld, contains 6: %d, contains 20: %d\n", (long) filter->n_blocks,
+            bf_contains(filter, (void *) 6), bf_contains(filter, (void *) 20));
+    ll_destroy(list);
+    bf_destroy(filter);
+}
+
+void t_cuckoo() {
+    printf("*************** TEST (CUCKOO) ***************\n");
+    LENGTH_DT n = 10000, trials = 100000, false_negatives = 0, false_positives = 0, failed = 0;
+    cf_filter *filter = cf_create(n, 0.01, hm_hash_int);
+    for (LENGTH_DT i = 1; i <= n; i++) { failed += !cf_insert(filter, (void *) (2 * i)); }
+    for (LENGTH_DT i = 1; i <= n; i++) { false_negatives += !cf_contains(filter, (void *) (2 * i)); }
+    for (LENGTH_DT i = 0; i < trials; i++) { false_positives += cf_contains(filter, (void *) (2 * i + 1)); }
+    printf("Keys: %ld, buckets: %ld, fingerprint bits: %d, failed inserts: %ld, false negatives: %ld\n", (long) n,
+            (long) filter->n_buckets, filter->fp_bits, (long) failed, (long) false_negatives);
+    printf("False positive rate (target 1%%): %.2f%%\n", 100.0 * false_positives / trials);
+    for (LENGTH_DT i = 1; i <= n; i += 2) { cf_delete(filter, (void *) (2 * i)); }
+    false_negatives = 0;
+    for (LENGTH_DT i = 2; i <= n; i += 2) { false_negatives += !cf_contains(filter, (void *) (2 * i)); }
+    printf("Deleted half, length: %ld, false negatives: %ld, delete absent: %d\n", (long) filter->length,
+            (long) false_negatives, cf_delete(filter, (void *) 1000001));
+
+    failed = 0;
+    cf_rebuild(filter, NULL, 0, 16);
+    for (LENGTH_DT i = 1; i <= 100; i++) { failed += !cf_insert(filter, (void *) i); }
+    printf("Rebuilt for 16 keys, inserted 100, failed inserts: %ld, length: %ld\n", (long) failed,
+            (long) filter->length);
+    cf_destroy(filter);
+}
+
+void t_filtered_tree() {
+    printf("*************** TEST (FILTERED TREE) ***************\n");
+    ft_tree *ft = ft_create(4, 0.01, hm_hash_int);
+    for (LENGTH_DT i = 1; i <= 100; i++) { ft_insert(ft, (void *) (10 * i), f_compare); }
+    printf("Length: %ld, filter buckets: %ld\n", (long) ft->tree->length, (long) ft->filter->n_buckets);
+    printf("Find 500: %ld, find 505: %ld\n", (long) ft_find(ft, (void *) 500, f_compare),
+            (long) ft_find(ft, (void *) 505, f_compare));
+    printf("Delete (i=49): %ld, ", (long) ft_delete(ft, 49, f_compare));
+    printf("find 500: %ld, filter length: %ld\n", (long) ft_find(ft, (void *) 500, f_compare),
+            (long) ft->filter->length);
+    ft_destroy(ft);
+}
+
+void t_duplicates() {
+    printf("*************** TEST (DUPLICATES) ***************\n");
+    ft_tree *ft = ft_create(4, 0.01, hm_hash_int);
+    for (int i = 0; i < 12; i++) { ft_insert(ft, (void *) 70, f_compare); }
+    for (LENGTH_DT i = 1; i <= 20; i++) { ft_insert(ft, (void *) (10 * i), f_compare); }
+    printf("Length: %ld, filter length: %ld, failed: %d\n", (long) ft->tree->length, (long) ft->filter->length,
+            ft->failed);
+    for (int i = 0; i < 12; i++) { ft_delete(ft, 6, f_compare); }
+    printf("Deleted 12 -> find 70: %ld, filter length: %ld\n", (long) ft_find(ft, (void *) 70, f_compare),
+            (long) ft->filter->length);
+    ft_delete(ft, 6, f_compare);
+    printf("Deleted last -> find 70: %ld, filter length: %ld\n", (long) ft_find(ft, (void *) 70, f_compare),
+            (long) ft->filter->length);
+    ft_destroy(ft);
+
+    ft = ft_create(4, 0.01, f_hash_same);           /* every key shares a fingerprint and buckets */
+    for (LENGTH_DT i = 1; i <= 20; i++) { ft_insert(ft, (void *) (10 * i), f_compare); }
+    printf("Same hash -> length: %ld, failed: %d, find 150: %ld, find 155: %ld\n", (long) ft->tree->length,
+            ft->failed, (long) ft_find(ft, (void *) 150, f_compare), (long) ft_find(ft, (void *) 155, f_compare));
+    ft_destroy(ft);
+}
+
+uint64_t f_hash_same(void *key) {
+    return 0x9E3779B97F4A7C15ULL;
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return (intptr_t) new_data < (intptr_t) old_data ? 1 : 0;
+}
+
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_FILTER_                   /* compile-time switch */
+
+#include <time.h>
+#include "hash_map.h"
+
+unsigned char f_compare(void *new_data, void *old_data);
+
+double elapsed_ns(clock_t start, LENGTH_DT ops);
+
+/**
+ *  @brief      : Benchmark of lookups in an AVL tree, unfiltered, and behind a Bloom or cuckoo filter (the filtered
+ *                  tree), where most lookups miss.
+ *                  (Usage: <no. of items (default: 2^22)> <no. of lookups (default: 2^22)> <percentage of misses
+ *                  (default: 90)> <false positive rate (default: 0.01)>)
+**/
+int main(int argc, char *argv[]) {
+    LENGTH_DT n = argc > 1 ? atol(argv[1]) : 1L << 22;
+    LENGTH_DT m = argc > 2 ? atol(argv[2]) : 1L << 22;
+    int miss_pct = argc > 3 ? atoi(argv[3]) : 90;
+    double fp_rate = argc > 4 ? atof(argv[4]) : 0.01;
+    void **keys = (void **) malloc(m * sizeof(void *));
+    uint64_t state = 88172645463325252ULL;
+    LENGTH_DT found[3] = {0}, bloom_fp = 0, cuckoo_fp = 0;
+    clock_t start;
+    double ns[3];
+
+    ft_tree *ft = ft_create(n, fp_rate, hm_hash_int);
+    bf_filter *bloom = bf_create(n, fp_rate, hm_hash_int);
+    for (LENGTH_DT i = 0; i < n; i++) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        ft_insert(ft, (void *) (uintptr_t) (state | 1), f_compare);                 /* odd keys are present */
+        bf_insert(bloom, (void *) (uintptr_t) (state | 1));
+    }
+    for (LENGTH_DT j = 0; j < m; j++) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        if ((LENGTH_DT) (state % 100) < miss_pct) {
+            keys[j] = (void *) (uintptr_t) (state & ~1ULL);                         /* even keys are missing */
+        } else {
+            keys[j] = avl_get(ft->tree, state % n);
+        }
+    }
+
+    start = clock();
+    for (LENGTH_DT j = 0; j < m; j++) { found[0] += avl_find(ft->tree, keys[j], f_compare) != NULL; }
+    ns[0] = elapsed_ns(start, m);
+    start = clock();
+    for (LENGTH_DT j = 0; j < m; j++) {
+        found[1] += bf_contains(bloom, keys[j]) && avl_find(ft->tree, keys[j], f_compare) != NULL;
+    }
+    ns[1] = elapsed_ns(start, m);
+    start = clock();
+    for (LENGTH_DT j = 0; j < m; j++) { found[2] += ft_find(ft, keys[j], f_compare) != NULL; }
+    ns[2] = elapsed_ns(start, m);
+
+    for (LENGTH_DT j = 0; j < m; j++) {
+        if (((uintptr_t) keys[j] & 1) == 0) {
+            bloom_fp += bf_contains(bloom, keys[j]);
+            cuckoo_fp += cf_contains(ft->filter, keys[j]);
+        }
+    }
+    printf("Items: %ld, lookups: %ld (%d%% misses)\n", (long) n, (long) m, miss_pct);
+    printf("avl_find:              %8.1f ns/lookup\n", ns[0]);
+    printf("bloom + avl_find:      %8.1f ns/lookup (false positive rate: %.3f%%, %.1f bits/item)\n", ns[1],
+            100.0 * bloom_fp / (m * miss_pct / 100.0), 512.0 * bloom->n_blocks / n);
+    printf("ft_find (cuckoo):      %8.1f ns/lookup (false positive rate: %.3f%%, %.1f bits/item)\n", ns[2],
+            100.0 * cuckoo_fp / (m * miss_pct / 100.0),
+            16.0 * CF_BUCKET_SIZE * ft->filter->n_buckets / n);
+    if (found[0] != found[1] || found[0] != found[2]) { printf("(found mismatch)\n"); }
+
+    bf_destroy(bloom);
+    ft_destroy(ft);
+    free(keys);
+    return 0;
+}
+
+double elapsed_ns(clock_t start, LENGTH_DT ops) {
+    return (double) (clock() - start) / CLOCKS_PER_SEC * 1e9 / ops;
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return (uintptr_t) new_data < (uintptr_t) old_data ? 1 : 0;
+}
+
+#endif
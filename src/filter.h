@@ -0,0 +1,266 @@
+/**
+ ****************************************************************
+ * @file            : filter.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the implementation of approximate membership filters
+ *                      (blocked Bloom filter, and cuckoo filter), and of an AVL tree with an attached filter.
+ * **************************************************************
+ **/
+
+#ifndef _FILTER_H_
+#define _FILTER_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "shared_defs.h"
+#include "avl_tree.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : No. of 64-bit words in a block of a Bloom filter (a block is a cache line). A key sets one bit in
+ *                  each word of its block.
+**/
+#define BF_BLOCK_WORDS      8
+
+/**
+ *  @brief      : No. of fingerprints in a bucket of a cuckoo filter, and the maximum load of a filter.
+**/
+#define CF_BUCKET_SIZE      4
+#define CF_MAX_LOAD         0.95
+
+/**
+ *  @brief      : Maximum no. of fingerprints relocated by an insertion into a cuckoo filter, before it fails.
+**/
+#define CF_MAX_KICKS        500
+
+/**
+ *  @brief      : Maximum no. of times a cuckoo filter is re-sized (doubled) by a rebuild, before it fails (e.g: when
+ *                  too many keys share a fingerprint and buckets, which no size can hold).
+**/
+#define CF_MAX_REBUILDS     8
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Blocked Bloom filter structure. Each key maps to a single block (of 'BF_BLOCK_WORDS' words, aligned
+ *                  to a cache line), so that a lookup reads one cache line.
+**/
+typedef struct BF_FILTER {
+    uint64_t *blocks;                               /* aligned to a cache line */
+    void *memory;                                   /* allocated memory (unaligned) */
+    LENGTH_DT n_blocks;
+    LENGTH_DT length;                               /* no. of keys inserted since last cleared */
+    double fp_rate;
+    uint64_t (*f_hash)(DATA_TYPE key);
+} bf_filter;
+
+/**
+ *  @brief      : Cuckoo filter structure. Each key has a fingerprint (of 'fp_bits' bits, never 0), stored in one of two
+ *                  buckets (of 'CF_BUCKET_SIZE' fingerprints each), the second derived from the first and the
+ *                  fingerprint alone, so that fingerprints can be moved between them (and deleted).
+**/
+typedef struct CF_FILTER {
+    uint16_t *buckets;                              /* 0 marks an empty slot */
+    LENGTH_DT n_buckets;                            /* a power of two */
+    LENGTH_DT length;
+    unsigned char fp_bits;
+    uint16_t victim;                                /* fingerprint that could not be placed (0 if none) */
+    LENGTH_DT victim_bucket;
+    uint64_t (*f_hash)(DATA_TYPE key);
+} cf_filter;
+
+/**
+ *  @brief      : Filtered tree structure. An AVL tree, with a cuckoo filter of its items, consulted before searching
+ *                  the tree by key (so that most misses do not descend the tree).
+**/
+typedef struct FT_TREE {
+    avl_tree *tree;
+    cf_filter *filter;                              /* holds each distinct item once */
+    unsigned char failed;                           /* 1 once the filter could not be rebuilt (it is bypassed thereafter) */
+} ft_tree;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Create a blocked Bloom filter (dynamically, on heap), sized for a no. of keys and a false positive rate.
+ *  @param      : [ Expected no. of keys. ]
+ *                [ False positive rate (e.g: 0.01). ]
+ *                [ Function that receives a key, and returns its hash (equal keys must have equal hashes). ]
+ *  @return     : Pointer to filter.
+**/
+bf_filter * bf_create(LENGTH_DT capacity, double fp_rate, uint64_t (*f_hash)(DATA_TYPE key));
+
+/**
+ *  @brief      : Insert a key into a Bloom filter.
+ *  @param      : [ Filter. ]
+ *                [ Key. ]
+ *  @return     : None.
+**/
+void bf_insert(bf_filter *filter, DATA_TYPE key);
+
+/**
+ *  @brief      : Check if a key may be in a Bloom filter.
+ *  @param      : [ Filter. ]
+ *                [ Key. ]
+ *  @return     : 0 if the key was never inserted, else 1 (possibly a false positive).
+**/
+unsigned char bf_contains(bf_filter *filter, DATA_TYPE key);
+
+/**
+ *  @brief      : Rebuild a Bloom filter from an array of keys (e.g: from 'avl_make_array'), re-sized for a no. of keys.
+ *  @param      : [ Filter. ]
+ *                [ Array of keys. ]
+ *                [ No. of keys. ]
+ *                [ Expected no. of keys (at least 'n'). ]
+ *  @return     : None.
+**/
+void bf_rebuild(bf_filter *filter, DATA_TYPE *arr, LENGTH_DT n, LENGTH_DT capacity);
+
+/**
+ *  @brief      : Rebuild a Bloom filter from a list of keys (e.g: from 'avl_make_list'), re-sized for a no. of keys.
+ *  @param      : [ Filter. ]
+ *                [ List of keys. ]
+ *                [ Expected no. of keys (at least the list's length). ]
+ *  @return     : None.
+**/
+void bf_rebuild_list(bf_filter *filter, ll_list *list, LENGTH_DT capacity);
+
+/**
+ *  @brief      : Delete all keys in a Bloom filter.
+ *  @param      : [ Filter. ]
+ *  @return     : None.
+**/
+void bf_clear(bf_filter *filter);
+
+/**
+ *  @brief      : Destroy Bloom filter (de-allocated off heap).
+ *  @param      : [ Filter. ]
+ *  @return     : None.
+**/
+void bf_destroy(bf_filter *filter);
+
+/**
+ *  @brief      : Create a cuckoo filter (dynamically, on heap), sized for a no. of keys and a false positive rate.
+ *  @param      : [ Expected no. of keys. ]
+ *                [ False positive rate (e.g: 0.01, not less than about 0.0001, since fingerprints are 16 bits). ]
+ *                [ Function that receives a key, and returns its hash (equal keys must have equal hashes). ]
+ *  @return     : Pointer to filter.
+**/
+cf_filter * cf_create(LENGTH_DT capacity, double fp_rate, uint64_t (*f_hash)(DATA_TYPE key));
+
+/**
+ *  @brief      : Insert a key into a cuckoo filter. A key inserted twice is stored twice (and must be deleted twice).
+ *  @param      : [ Filter. ]
+ *                [ Key. ]
+ *  @return     : 1 if inserted, or 0 if the filter is full (the key is not inserted, and no more keys are, until one
+ *                  is deleted, or the filter is rebuilt larger).
+**/
+unsigned char cf_insert(cf_filter *filter, DATA_TYPE key);
+
+/**
+ *  @brief      : Check if a key may be in a cuckoo filter.
+ *  @param      : [ Filter. ]
+ *                [ Key. ]
+ *  @return     : 0 if the key is not in the filter, else 1 (possibly a false positive).
+**/
+unsigned char cf_contains(cf_filter *filter, DATA_TYPE key);
+
+/**
+ *  @brief      : Delete a key from a cuckoo filter. Only keys that were inserted may be deleted (otherwise, the
+ *                  fingerprint of another key may be deleted).
+ *  @param      : [ Filter. ]
+ *                [ Key. ]
+ *  @return     : 1 if deleted, else 0.
+**/
+unsigned char cf_delete(cf_filter *filter, DATA_TYPE key);
+
+/**
+ *  @brief      : Rebuild a cuckoo filter from an array of keys (e.g: from 'avl_make_array'), re-sized for a no. of keys.
+ *  @param      : [ Filter. ]
+ *                [ Array of keys. ]
+ *                [ No. of keys. ]
+ *                [ Expected no. of keys (at least 'n'). ]
+ *  @return     : 1 if all keys were inserted, or 0 if they could not be within 'CF_MAX_REBUILDS' re-sizes (the filter
+ *                  then holds only some of them).
+**/
+unsigned char cf_rebuild(cf_filter *filter, DATA_TYPE *arr, LENGTH_DT n, LENGTH_DT capacity);
+
+/**
+ *  @brief      : Rebuild a cuckoo filter from a list of keys (e.g: from 'avl_make_list'), re-sized for a no. of keys.
+ *  @param      : [ Filter. ]
+ *                [ List of keys. ]
+ *                [ Expected no. of keys (at least the list's length). ]
+ *  @return     : 1 if all keys were inserted, else 0 (read '@return' of 'cf_rebuild').
+**/
+unsigned char cf_rebuild_list(cf_filter *filter, ll_list *list, LENGTH_DT capacity);
+
+/**
+ *  @brief      : Delete all keys in a cuckoo filter.
+ *  @param      : [ Filter. ]
+ *  @return     : None.
+**/
+void cf_clear(cf_filter *filter);
+
+/**
+ *  @brief      : Destroy cuckoo filter (de-allocated off heap).
+ *  @param      : [ Filter. ]
+ *  @return     : None.
+**/
+void cf_destroy(cf_filter *filter);
+
+/**
+ *  @brief      : Create a filtered tree (dynamically, on heap), an AVL tree with an attached cuckoo filter. Equal items
+ *                  may be inserted, but the filter holds each distinct item once.
+ *                  (Note: 'f_hash' must agree with the comparator passed to the other functions: items equal by it must
+ *                  have equal hashes, else 'ft_find' misses items that are in the tree.)
+ *  @param      : [ Expected no. of distinct items (the filter is grown past it, as needed). ]
+ *                [ False positive rate of the filter. ]
+ *                [ Function that receives an item, and returns its hash (items equal by the comparator of the tree must
+ *                  have equal hashes). ]
+ *  @return     : Pointer to filtered tree.
+**/
+ft_tree * ft_create(LENGTH_DT capacity, double fp_rate, uint64_t (*f_hash)(DATA_TYPE key));
+
+/**
+ *  @brief      : Insert an item into a filtered tree (and its filter, unless an equal item is in the tree already).
+ *  @param      : [ Filtered tree. ]
+ *                [ Data to insert. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : None.
+**/
+void ft_insert(ft_tree *ft, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Find an item equal to a key in a filtered tree (see 'avl_find'), descending the tree only if the
+ *                  filter may contain the key. If not found, returns DEFAULT_VALUE stored in 'shared_defs.h'.
+ *  @param      : [ Filtered tree. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE ft_find(ft_tree *ft, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Delete an item at an index from a filtered tree (and its filter, unless an equal item is left in the
+ *                  tree). If index out of bounds, returns DEFAULT_VALUE stored in 'shared_defs.h'.
+ *  @param      : [ Filtered tree. ]
+ *                [ Index. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE ft_delete(ft_tree *ft, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Destroy filtered tree (its tree and filter are de-allocated off heap).
+ *  @param      : [ Filtered tree. ]
+ *  @return     : None.
+**/
+void ft_destroy(ft_tree *ft);
+
+#endif
@@ -0,0 +1,616 @@
+/**
+ ****************************************************************
+ * @file            : hash_map.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of an open-addressing hash map, with groups of control bytes probed at once
+ *                      (SwissTable-style).
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#include "hash_map.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Macro definitions of the control bytes of slots that are not full. The control byte of a full slot
+ *                  is non-negative (7 bits of the hash of its key).
+**/
+#define HM_EMPTY            ((int8_t) -128)
+#define HM_DELETED          ((int8_t) -2)
+
+/**
+ *  @brief      : Initial capacity (no. of slots) of a map.
+**/
+#define HM_INITIAL_CAPACITY HM_GROUP_WIDTH
+
+/**
+ *  @brief      : Maximum no. of full (or deleted) slots, for a capacity (a load factor of 7/8).
+**/
+#define HM_MAX_LOAD(capacity)   ((capacity) - (capacity) / 8)
+
+/**
+ *  @brief      : The two parts of a hash. 'H1' selects the first group to probe, and 'H2' is stored in the
+ *                  control byte of the slot.
+**/
+#define HM_H1(hash)         ((LENGTH_DT) ((hash) >> 7))
+#define HM_H2(hash)         ((int8_t) ((hash) & 0x7F))
+
+/**
+ *  @brief      : Index of the lowest set bit of a (non-zero) mask.
+**/
+#if defined(__GNUC__) || defined(__clang__)
+#define HM_CTZ(mask)        __builtin_ctz(mask)
+#else
+#define HM_CTZ(mask)        hm_ctz(mask)
+#endif
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static uint32_t hm_match_byte(int8_t *group, int8_t byte);
+static uint32_t hm_match_free(int8_t *group);
+static LENGTH_DT hm_find_slot(hm_map *map, DATA_TYPE key, uint64_t hash);
+static LENGTH_DT hm_find_free(hm_map *map, uint64_t hash);
+static void hm_resize(hm_map *map, LENGTH_DT capacity);
+static void hm_allocate(hm_map *map, LENGTH_DT capacity);
+
+#if !defined(__GNUC__) && !defined(__clang__)
+static int hm_ctz(uint32_t mask);
+#endif
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Allocating dynamic memory for a map structure (and its arrays), initializing and returning the pointer.
+ *  @param      : [ Function that receives a key, and returns its hash. ]
+ *                [ Function that receives two keys, and returns 1 if equal, else 0. ]
+ *  @return     : Pointer to map.
+**/
+hm_map * hm_create(uint64_t (*f_hash)(DATA_TYPE key), unsigned char (*f_equal)(DATA_TYPE key1, DATA_TYPE key2)) {
+    hm_map *new_map = (hm_map *) malloc(sizeof(hm_map));
+    new_map->f_hash = f_hash, new_map->f_equal = f_equal;
+    hm_allocate(new_map, HM_INITIAL_CAPACITY);
+    return new_map;
+}
+
+/**
+ *  @brief      : (for internal use) Allocate the arrays of a map for a capacity, with all slots empty. Previous arrays
+ *                  are not de-allocated.
+ *  @param      : [ Map. ]
+ *                [ Capacity (a power of two, and a multiple of a group). ]
+ *  @return     : None.
+**/
+static void hm_allocate(hm_map *map, LENGTH_DT capacity) {
+    map->ctrl = (int8_t *) malloc(capacity);
+    map->slots = (hm_slot *) malloc(capacity * sizeof(hm_slot));
+    memset(map->ctrl, HM_EMPTY, capacity);
+    map->capacity = capacity;
+    map->length = 0;
+    map->growth_left = HM_MAX_LOAD(capacity);
+}
+
+/**
+ *  @brief      : (for internal use) Get a mask of the slots of a group whose control byte equals a byte. With SSE2,
+ *                  the group's control bytes are compared at once, and the mask is made of the top bit of each.
+ *  @param      : [ Control bytes of group. ]
+ *                [ Byte to match. ]
+ *  @return     : Mask (bit 'k' is set if slot 'k' of the group matches).
+**/
+static uint32_t hm_match_byte(int8_t *group, int8_t byte) {
+#ifdef __SSE2__
+    __m128i ctrl = _mm_loadu_si128((const __m128i *) group);
+    return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(byte), ctrl));
+#else
+    uint32_t mask = 0;
+    for (int k = 0; k < HM_GROUP_WIDTH; k++) {
+        mask |= (uint32_t) (group[k] == byte) << k;
+    }
+    return mask;
+#endif
+}
+
+/**
+ *  @brief      : (for internal use) Get a mask of the slots of a group that are empty or deleted (negative control
+ *                  bytes). With SSE2, the top bit of each control byte is the mask bit.
+ *  @param      : [ Control bytes of group. ]
+ *  @return     : Mask (bit 'k' is set if slot 'k' of the group is empty or deleted).
+**/
+static uint32_t hm_match_free(int8_t *group) {
+#ifdef __SSE2__
+    return (uint32_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) group));
+#else
+    uint32_t mask = 0;
+    for (int k = 0; k < HM_GROUP_WIDTH; k++) {
+        mask |= (uint32_t) (group[k] < 0) << k;
+    }
+    return mask;
+#endif
+}
+
+#if !defined(__GNUC__) && !defined(__clang__)
+/**
+ *  @brief      : (for internal use) Index of the lowest set bit of a (non-zero) mask.
+ *  @param      : [ Mask. ]
+ *  @return     : Index of bit.
+**/
+static int hm_ctz(uint32_t mask) {
+    int k = 0;
+    while ((mask & 1) == 0) { mask >>= 1, k++; }
+    return k;
+}
+#endif
+
+/**
+ *  @brief      : (for internal use) Find the slot of a key. Groups are probed, starting at the group selected by H1,
+ *                  then stepping by 1, 2, 3, ... groups (which visits every group, since the no. of groups is a power
+ *                  of two). In each group, only slots whose control byte equals H2 are compared with the key.
+ *                  Probing stops at the first group that has an empty slot, since an insertion would have used it.
+ *  @param      : [ Map. ]
+ *                [ Key. ]
+ *                [ Hash of key. ]
+ *  @return     : Index of slot, or -1 if not found.
+**/
+static LENGTH_DT hm_find_slot(hm_map *map, DATA_TYPE key, uint64_t hash) {
+    LENGTH_DT groups_mask = map->capacity / HM_GROUP_WIDTH - 1;
+    LENGTH_DT group = HM_H1(hash) & groups_mask;
+    int8_t h2 = HM_H2(hash);
+
+    for (LENGTH_DT step = 1; ; step++) {
+        int8_t *ctrl = map->ctrl + group * HM_GROUP_WIDTH;
+        uint32_t match = hm_match_byte(ctrl, h2);
+        while (match != 0) {
+            LENGTH_DT i = group * HM_GROUP_WIDTH + HM_CTZ(match);
+            if (map->f_equal(key, map->slots[i].key)) {
+                return i;
+            }
+            match &= match - 1;
+        }
+        if (hm_match_byte(ctrl, HM_EMPTY) != 0) {
+            return -1;
+        }
+        group = (group + step) & groups_mask;
+    }
+}
+
+/**
+ *  @brief      : (for internal use) Find the first empty or deleted slot along the probe sequence of a hash.
+ *                  (Note: For information on probing, read '@brief' of 'hm_find_slot'.)
+ *  @param      : [ Map. ]
+ *                [ Hash of key. ]
+ *  @return     : Index of slot.
+**/
+static LENGTH_DT hm_find_free(hm_map *map, uint64_t hash) {
+    LENGTH_DT groups_mask = map->capacity / HM_GROUP_WIDTH - 1;
+    LENGTH_DT group = HM_H1(hash) & groups_mask;
+
+    for (LENGTH_DT step = 1; ; step++) {
+        uint32_t match = hm_match_free(map->ctrl + group * HM_GROUP_WIDTH);
+        if (match != 0) {
+            return group * HM_GROUP_WIDTH + HM_CTZ(match);
+        }
+        group = (group + step) & groups_mask;
+    }
+}
+
+/**
+ *  @brief      : Get the value of a key. If key not found, returns DEFAULT_VALUE set in the header file.
+ *  @param      : [ Map. ]
+ *                [ Key. ]
+ *  @return     : Value stored.
+**/
+DATA_TYPE hm_get(hm_map *map, DATA_TYPE key) {
+    LENGTH_DT i = hm_find_slot(map, key, map->f_hash(key));
+    return i >= 0 ? map->slots[i].value : DEFAULT_VALUE;
+}
+
+/**
+ *  @brief      : Check if a key is in a map.
+ *  @param      : [ Map. ]
+ *                [ Key. ]
+ *  @return     : 1 if found, else 0.
+**/
+unsigned char hm_contains(hm_map *map, DATA_TYPE key) {
+    return hm_find_slot(map, key, map->f_hash(key)) >= 0;
+}
+
+/**
+ *  @brief      : Insert a key and its value. If the key is found, its value is replaced. Otherwise, the first empty or
+ *                  deleted slot along its probe sequence is filled. Filling an empty slot, when no more can be filled,
+ *                  first rehashes the map: Doubling its capacity if more than half of the allowed load is full slots,
+ *                  else keeping its capacity (clearing the deleted slots).
+ *  @param      : [ Map. ]
+ *                [ Key. ]
+ *                [ Value. ]
+ *  @return     : None.
+**/
+void hm_put(hm_map *map, DATA_TYPE key, DATA_TYPE value) {
+    uint64_t hash = map->f_hash(key);
+    LENGTH_DT i = hm_find_slot(map, key, hash);
+
+    if (i >= 0) {
+        map->slots[i].value = value;
+        return;
+    }
+    i = hm_find_free(map, hash);
+    if (map->ctrl[i] == HM_EMPTY && map->growth_left == 0) {
+        if (map->length + 1 > HM_MAX_LOAD(map->capacity) / 2) {
+            hm_resize(map, map->capacity * 2);
+        } else {
+            hm_resize(map, map->capacity);
+        }
+        i = hm_find_free(map, hash);
+    }
+    if (map->ctrl[i] == HM_EMPTY) {
+        map->growth_left--;
+    }
+    map->ctrl[i] = HM_H2(hash);
+    map->slots[i].key = key, map->slots[i].value = value;
+    map->length++;
+}
+
+/**
+ *  @brief      : Delete a key. If its group has an empty slot, then no probe sequence has ever passed through the group
+ *                  (it was never full), so the slot is marked empty. Otherwise, it is marked deleted (a tombstone),
+ *                  so that probing continues through it. If key not found, returns DEFAULT_VALUE set in the header file.
+ *  @param      : [ Map. ]
+ *                [ Key. ]
+ *  @return     : Value stored.
+**/
+DATA_TYPE hm_delete(hm_map *map, DATA_TYPE key) {
+    LENGTH_DT i = hm_find_slot(map, key, map->f_hash(key));
+
+    if (i >= 0) {
+        DATA_TYPE value = map->slots[i].value;
+        if (hm_match_byte(map->ctrl + (i & ~((LENGTH_DT) HM_GROUP_WIDTH - 1)), HM_EMPTY) != 0) {
+            map->ctrl[i] = HM_EMPTY;
+            map->growth_left++;
+        } else {
+            map->ctrl[i] = HM_DELETED;
+        }
+        map->length--;
+        return value;
+    }
+    return DEFAULT_VALUE;
+}
+
+/**
+ *  @brief      : (for internal use) Rebuild a map with a capacity, by moving each full slot to the first empty slot
+ *                  along its probe sequence in the new arrays (keys are known to be distinct, so none are compared).
+ *  @param      : [ Map. ]
+ *                [ Capacity (a power of two, and a multiple of a group, that fits the map's length). ]
+ *  @return     : None.
+**/
+static void hm_resize(hm_map *map, LENGTH_DT capacity) {
+    int8_t *old_ctrl = map->ctrl;
+    hm_slot *old_slots = map->slots;
+    LENGTH_DT old_capacity = map->capacity;
+
+    hm_allocate(map, capacity);
+    for (LENGTH_DT j = 0; j < old_capacity; j++) {
+        if (old_ctrl[j] >= 0) {
+            uint64_t hash = map->f_hash(old_slots[j].key);
+            LENGTH_DT i = hm_find_free(map, hash);
+            map->ctrl[i] = HM_H2(hash);
+            map->slots[i] = old_slots[j];
+            map->length++, map->growth_left--;
+        }
+    }
+    free(old_ctrl);
+    free(old_slots);
+}
+
+/**
+ *  @brief      : Make room for a number of keys. If they do not fit the map's load (counting deleted slots as full),
+ *                  the map is rehashed to fit them.
+ *  @param      : [ Map. ]
+ *                [ No. of keys. ]
+ *  @return     : None.
+**/
+void hm_reserve(hm_map *map, LENGTH_DT n) {
+    if (n > map->length + map->growth_left) {
+        hm_rehash(map, n);
+    }
+}
+
+/**
+ *  @brief      : Rebuild a map, with the smallest capacity (a power of two, and a multiple of a group) whose load fits
+ *                  a number of keys, or the map's length, if larger.
+ *  @param      : [ Map. ]
+ *                [ No. of keys. ]
+ *  @return     : None.
+**/
+void hm_rehash(hm_map *map, LENGTH_DT n) {
+    LENGTH_DT capacity = HM_INITIAL_CAPACITY;
+    if (n < map->length) { n = map->length; }
+    while (HM_MAX_LOAD(capacity) < n) {
+        capacity *= 2;
+    }
+    hm_resize(map, capacity);
+}
+
+/**
+ *  @brief      : Delete all keys in a map, by marking all slots empty (the arrays are kept, for re-use).
+ *  @param      : [ Map. ]
+ *  @return     : None.
+**/
+void hm_delete_all(hm_map *map) {
+    memset(map->ctrl, HM_EMPTY, map->capacity);
+    map->length = 0;
+    map->growth_left = HM_MAX_LOAD(map->capacity);
+}
+
+/**
+ *  @brief      : De-allocate the arrays of a map, then the map itself.
+ *  @param      : [ Map. ]
+ *  @return     : None.
+**/
+void hm_destroy(hm_map *map) {
+    free(map->ctrl);
+    free(map->slots);
+    free(map);
+}
+
+/**
+ *  @brief      : Print a map, in slot order. Must pass a two function pointers, one is used to print each key (and its
+ *                  value), and another is called at the end (passed a reference to the map).
+ *  @param      : [ Map to print. ]
+ *                [ Function to be called at each key (passed each key and its value consecutively). ]
+ *                [ Function to be called after all keys have been printed (passed map and used for clean-up). ]
+ *  @return     : None.
+**/
+void hm_print(hm_map *map, void (*f_print)(DATA_TYPE key, DATA_TYPE value), void (*f_clean)(hm_map *map)) {
+    if (map->length != 0) {
+        for (LENGTH_DT i = 0; i < map->capacity; i++) {
+            if (map->ctrl[i] >= 0) {
+                f_print(map->slots[i].key, map->slots[i].value);
+            }
+        }
+        f_clean(map);
+    }
+}
+
+/**
+ *  @brief      : Hash an integer key (stored as the data-type), by mixing its bits (the 'splitmix64' finalizer), so that
+ *                  both H1 and H2 depend on all bits of the key.
+ *  @param      : [ Key. ]
+ *  @return     : Hash.
+**/
+uint64_t hm_hash_int(DATA_TYPE key) {
+    uint64_t x = (uint64_t) (uintptr_t) key;
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ *  @brief      : Compare two integer keys (stored as the data-type).
+ *  @param      : [ Key 1. ]
+ *                [ Key 2. ]
+ *  @return     : 1 if equal, else 0.
+**/
+unsigned char hm_equal_int(DATA_TYPE key1, DATA_TYPE key2) {
+    return key1 == key2;
+}
+
+/**
+ *  @brief      : Hash a string key (FNV-1a), then mix the result through 'hm_hash_int'.
+ *  @param      : [ Key. ]
+ *  @return     : Hash.
+**/
+uint64_t hm_hash_string(DATA_TYPE key) {
+    uint64_t x = 0xCBF29CE484222325ULL;
+    for (const unsigned char *c = (const unsigned char *) key; *c != '\0'; c++) {
+        x = (x ^ *c) * 0x100000001B3ULL;
+    }
+    return hm_hash_int((DATA_TYPE) (uintptr_t) x);
+}
+
+/**
+ *  @brief      : Compare two string keys.
+ *  @param      : [ Key 1. ]
+ *                [ Key 2. ]
+ *  @return     : 1 if equal, else 0.
+**/
+unsigned char hm_equal_string(DATA_TYPE key1, DATA_TYPE key2) {
+    return strcmp((const char *) key1, (const char *) key2) == 0;
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_HASH_MAP_                  /* compile-time switch */
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+void f_print(void *key, void *value);
+void f_clean(hm_map *map);
+
+void t_put_get();
+void t_delete();
+void t_rehash();
+
+int main() {
+    t_put_get();
+    t_delete();
+    t_rehash();
+    return 0;
+}
+
+void t_put_get() {
+    printf("*************** TEST (PUT/GET) ***************\n");
+    hm_map *map = hm_create(hm_hash_string, hm_equal_string);
+    char *arr_key[] = {"one", "two", "three", "four", "five"};
+    int arr_value[] = {1, 2, 3, 4, 5};
+    for (int i = 0; i < LEN(arr_key); i++) {
+        printf("Putting: %s -> %d\n", arr_key[i], arr_value[i]);
+        hm_put(map, arr_key[i], arr_value+i);
+    }
+    char *arr_find[] = {"three", "six", "one"};
+    for (int i = 0; i < LEN(arr_find); i++) {
+        int *value = hm_get(map, arr_find[i]);
+        printf("Getting: %s -> ", arr_find[i]);
+        if (value != NULL) { printf("%d\n", *value); } else { printf("Not found\n"); }
+    }
+    printf("Putting: two -> 5\n");
+    hm_put(map, "two", arr_value+4);
+    printf("Getting: two -> %d\n", *((int *) hm_get(map, "two")));
+    printf("Length: %ld\n", (long) map->length);
+    hm_destroy(map);
+}
+
+void t_delete() {
+    printf("*************** TEST (DELETE) ***************\n");
+    hm_map *map = hm_create(hm_hash_string, hm_equal_string);
+    char *arr_key[] = {"one", "two", "three", "four", "five"};
+    int arr_value[] = {1, 2, 3, 4, 5};
+    for (int i = 0; i < LEN(arr_key); i++) {
+        hm_put(map, arr_key[i], arr_value+i);
+    }
+    char *arr_delete[] = {"two", "six", "five", "two"};
+    for (int i = 0; i < LEN(arr_delete); i++) {
+        int *value = hm_delete(map, arr_delete[i]);
+        printf("Deleting: %s -> ", arr_delete[i]);
+        if (value != NULL) { printf("%d\n", *value); } else { printf("Not found\n"); }
+    }
+    printf("Length: %ld, contains 'one': %d, contains 'two': %d\n", (long) map->length,
+            hm_contains(map, "one"), hm_contains(map, "two"));
+    hm_destroy(map);
+}
+
+void t_rehash() {
+    printf("*************** TEST (REHASH) ***************\n");
+    hm_map *map = hm_create(hm_hash_int, hm_equal_int);
+    LENGTH_DT found = 0;
+    for (LENGTH_DT i = 1; i <= 1000; i++) {
+        hm_put(map, (void *) i, (void *) (i * i));
+    }
+    printf("Length: %ld, capacity: %ld\n", (long) map->length, (long) map->capacity);
+    for (LENGTH_DT i = 1; i <= 1000; i += 2) {
+        hm_delete(map, (void *) i);
+    }
+    for (LENGTH_DT i = 1; i <= 1000; i++) {
+        found += hm_get(map, (void *) i) == (void *) (i * i);
+    }
+    printf("Length: %ld, found: %ld\n", (long) map->length, (long) found);
+    hm_rehash(map, 0);
+    printf("Rehashed, length: %ld, capacity: %ld\n", (long) map->length, (long) map->capacity);
+    hm_reserve(map, 5000);
+    printf("Reserved, length: %ld, capacity: %ld\n", (long) map->length, (long) map->capacity);
+    for (LENGTH_DT i = 0; i < 5; i++) {
+        hm_delete(map, (void *) (i * 200 + 2));
+    }
+    hm_delete_all(map);
+    hm_put(map, (void *) 7, (void *) 49);
+    hm_print(map, f_print, f_clean);
+    hm_destroy(map);
+}
+
+void f_print(void *key, void *value) {
+    printf("%ld -> %ld, ", (long) (intptr_t) key, (long) (intptr_t) value);
+}
+
+void f_clean(hm_map *map) {
+    printf("\b\b \n");
+}
+
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_HASH_MAP_                 /* compile-time switch */
+
+#include <time.h>
+#include "avl_tree.h"
+
+unsigned char f_compare(void *new_data, void *old_data);
+
+double elapsed_ns(clock_t start, LENGTH_DT ops);
+uint64_t next_random(uint64_t *state);
+
+/**
+ *  @brief      : Benchmark of the hash map against the AVL tree, for insertion, lookup (half of them misses) and
+ *                  deletion of random integer keys, at sizes growing by 10x up to a maximum. The tree has no deletion
+ *                  by key, so it deletes at random indices instead.
+ *                  (Usage: <maximum no. of keys (default: 10^6)>)
+**/
+int main(int argc, char *argv[]) {
+    LENGTH_DT max_n = argc > 1 ? atol(argv[1]) : 1000000;
+    printf("%12s %10s %14s %14s\n", "keys", "operation", "hash_map (ns)", "avl_tree (ns)");
+
+    for (LENGTH_DT n = 1000; n <= max_n; n *= 10) {
+        void **arr_key = (void **) malloc(n * sizeof(void *));
+        void **arr_miss = (void **) malloc(n * sizeof(void *));
+        uint64_t state = 1;
+        LENGTH_DT checksum = 0;
+        clock_t start;
+        double hm_ns, avl_ns;
+
+        for (LENGTH_DT i = 0; i < n; i++) {
+            arr_key[i] = (void *) (uintptr_t) (next_random(&state) | 1);          /* odd keys are present */
+            arr_miss[i] = (void *) (uintptr_t) (next_random(&state) & ~1ULL);     /* even keys are missing */
+        }
+
+        hm_map *map = hm_create(hm_hash_int, hm_equal_int);
+        avl_tree *tree = avl_create();
+
+        start = clock();
+        for (LENGTH_DT i = 0; i < n; i++) { hm_put(map, arr_key[i], arr_key[i]); }
+        hm_ns = elapsed_ns(start, n);
+        start = clock();
+        for (LENGTH_DT i = 0; i < n; i++) { avl_insert(tree, arr_key[i], f_compare); }
+        avl_ns = elapsed_ns(start, n);
+        printf("%12ld %10s %14.1f %14.1f\n", (long) n, "insert", hm_ns, avl_ns);
+
+        start = clock();
+        for (LENGTH_DT i = 0; i < n; i++) {
+            checksum += hm_get(map, arr_key[i]) != NULL;
+            checksum += hm_get(map, arr_miss[i]) != NULL;
+        }
+        hm_ns = elapsed_ns(start, 2 * n);
+        start = clock();
+        for (LENGTH_DT i = 0; i < n; i++) {
+            checksum += avl_find(tree, arr_key[i], f_compare) != NULL;
+            checksum += avl_find(tree, arr_miss[i], f_compare) != NULL;
+        }
+        avl_ns = elapsed_ns(start, 2 * n);
+        printf("%12ld %10s %14.1f %14.1f\n", (long) n, "lookup", hm_ns, avl_ns);
+
+        start = clock();
+        for (LENGTH_DT i = 0; i < n; i++) { checksum += hm_delete(map, arr_key[i]) != NULL; }
+        hm_ns = elapsed_ns(start, n);
+        start = clock();
+        for (LENGTH_DT i = 0; i < n; i++) {
+            checksum += avl_delete(tree, next_random(&state) % tree->length, f_compare) != NULL;
+        }
+        avl_ns = elapsed_ns(start, n);
+        printf("%12ld %10s %14.1f %14.1f\n", (long) n, "delete", hm_ns, avl_ns);
+
+        if (checksum != 4 * n) { printf("(checksum mismatch: %ld)\n", (long) checksum); }
+        hm_destroy(map);
+        avl_destroy(tree);
+        free(arr_key), free(arr_miss);
+    }
+    return 0;
+}
+
+double elapsed_ns(clock_t start, LENGTH_DT ops) {
+    return (double) (clock() - start) / CLOCKS_PER_SEC * 1e9 / ops;
+}
+
+uint64_t next_random(uint64_t *state) {
+    *state += 0x9E3779B97F4A7C15ULL;
+    return hm_hash_int((void *) (uintptr_t) *state);
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return (uintptr_t) new_data < (uintptr_t) old_data ? 1 : 0;
+}
+
+#endif
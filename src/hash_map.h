@@ -0,0 +1,152 @@
+/**
+ ****************************************************************
+ * @file            : hash_map.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the implementation of an open-addressing hash map, with
+ *                      groups of control bytes probed at once (SwissTable-style).
+ * **************************************************************
+ **/
+
+#ifndef _HASH_MAP_H_
+#define _HASH_MAP_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "shared_defs.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : No. of slots (and control bytes) in a group, probed at once (the width of an SSE2 register).
+**/
+#define HM_GROUP_WIDTH      16
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Slot structure (where a key and its value are stored).
+**/
+typedef struct HM_SLOT {
+    DATA_TYPE key;
+    DATA_TYPE value;
+} hm_slot;
+
+/**
+ *  @brief      : Map structure. Each slot has a control byte, which is either empty, deleted, or holds 7 bits of
+ *                  the hash of the key in the slot. Slots are split into aligned groups of 'HM_GROUP_WIDTH'.
+**/
+typedef struct HM_MAP {
+    int8_t *ctrl;
+    hm_slot *slots;
+    LENGTH_DT capacity;                             /* no. of slots (a power of two, and a multiple of a group) */
+    LENGTH_DT length;
+    LENGTH_DT growth_left;                          /* no. of empty slots that can be filled before a rehash */
+    uint64_t (*f_hash)(DATA_TYPE key);
+    unsigned char (*f_equal)(DATA_TYPE key1, DATA_TYPE key2);
+} hm_map;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Create a hash map (dynamically, on heap).
+ *  @param      : [ Function that receives a key, and returns its hash. ]
+ *                [ Function that receives two keys, and returns 1 if equal, else 0. ]
+ *  @return     : Pointer to map.
+**/
+hm_map * hm_create(uint64_t (*f_hash)(DATA_TYPE key), unsigned char (*f_equal)(DATA_TYPE key1, DATA_TYPE key2));
+
+/**
+ *  @brief      : Get the value of a key. If key not found, returns DEFAULT_VALUE stored in 'shared_defs.h'.
+ *  @param      : [ Map. ]
+ *                [ Key. ]
+ *  @return     : Value stored.
+**/
+DATA_TYPE hm_get(hm_map *map, DATA_TYPE key);
+
+/**
+ *  @brief      : Check if a key is in a map.
+ *  @param      : [ Map. ]
+ *                [ Key. ]
+ *  @return     : 1 if found, else 0.
+**/
+unsigned char hm_contains(hm_map *map, DATA_TYPE key);
+
+/**
+ *  @brief      : Insert a key and its value in a map. If the key is already in the map, its value is replaced.
+ *  @param      : [ Map. ]
+ *                [ Key. ]
+ *                [ Value. ]
+ *  @return     : None.
+**/
+void hm_put(hm_map *map, DATA_TYPE key, DATA_TYPE value);
+
+/**
+ *  @brief      : Delete a key from a map. If key not found, nothing happens, and returns DEFAULT_VALUE.
+ *  @param      : [ Map. ]
+ *                [ Key. ]
+ *  @return     : Value stored.
+**/
+DATA_TYPE hm_delete(hm_map *map, DATA_TYPE key);
+
+/**
+ *  @brief      : Make room for a number of keys, so that inserting up to it does not rehash.
+ *  @param      : [ Map. ]
+ *                [ No. of keys. ]
+ *  @return     : None.
+**/
+void hm_reserve(hm_map *map, LENGTH_DT n);
+
+/**
+ *  @brief      : Rebuild a map, with the smallest capacity that fits a number of keys (at least the map's length),
+ *                  clearing any deleted slots. May shrink the map.
+ *  @param      : [ Map. ]
+ *                [ No. of keys. ]
+ *  @return     : None.
+**/
+void hm_rehash(hm_map *map, LENGTH_DT n);
+
+/**
+ *  @brief      : Delete all keys in a map.
+ *  @param      : [ Map. ]
+ *  @return     : None.
+**/
+void hm_delete_all(hm_map *map);
+
+/**
+ *  @brief      : Destroy map (de-allocated off heap).
+ *                  (Note: If pointers are the data-type, they're de-allocated, and not the data they point to.)
+ *  @param      : [ Map. ]
+ *  @return     : None.
+**/
+void hm_destroy(hm_map *map);
+
+/**
+ *  @brief      : Print the keys and values of a map (in no particular order).
+ *  @param      : [ Map to print. ]
+ *                [ Function to be called at each key (passed each key and its value consecutively). ]
+ *                [ Function to be called after all keys have been printed (passed map and used for clean-up). ]
+ *  @return     : None.
+**/
+void hm_print(hm_map *map, void (*f_print)(DATA_TYPE key, DATA_TYPE value), void (*f_clean)(hm_map *map));
+
+/**
+ *  @brief      : Hash and equality functions for keys that are integers (or pointers compared by address).
+ *  @param      : [ Key(s). ]
+ *  @return     : Hash, or 1 if equal (else 0).
+**/
+uint64_t hm_hash_int(DATA_TYPE key);
+unsigned char hm_equal_int(DATA_TYPE key1, DATA_TYPE key2);
+
+/**
+ *  @brief      : Hash and equality functions for keys that are null-terminated strings.
+ *  @param      : [ Key(s). ]
+ *  @return     : Hash, or 1 if equal (else 0).
+**/
+uint64_t hm_hash_string(DATA_TYPE key);
+unsigned char hm_equal_string(DATA_TYPE key1, DATA_TYPE key2);
+
+#endif
@@ -0,0 +1,498 @@
+/**
+ ****************************************************************
+ * @file            : heap.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of an array-based d-ary heap (priority queue), and an indexed d-ary heap
+ *                      (with decrease-key).
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#include "heap.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Initial capacity (no. of items) of a heap.
+**/
+#define HP_INITIAL_CAPACITY     16
+
+/**
+ *  @brief      : Index of the parent, and of the first child, of an item.
+**/
+#define HP_PARENT(i, arity)         (((i) - 1) / (arity))
+#define HP_FIRST_CHILD(i, arity)    ((arity) * (i) + 1)
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static void hp_sift_up(hp_heap *heap, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static void hp_sift_down(hp_heap *heap, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static void ihp_sift_up(ihp_heap *heap, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static void ihp_sift_down(ihp_heap *heap, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Allocating dynamic memory for a heap structure (and its array), initializing and returning the pointer.
+ *  @param      : [ Arity (less than 2 means default). ]
+ *  @return     : Pointer to heap.
+**/
+hp_heap * hp_create(unsigned char arity) {
+    hp_heap *new_heap = (hp_heap *) malloc(sizeof(hp_heap));
+    new_heap->items = (DATA_TYPE *) malloc(HP_INITIAL_CAPACITY * sizeof(DATA_TYPE));
+    new_heap->length = 0, new_heap->capacity = HP_INITIAL_CAPACITY;
+    new_heap->arity = arity < 2 ? HP_DEFAULT_ARITY : arity;
+    return new_heap;
+}
+
+/**
+ *  @brief      : Create a heap from an array of items, by copying the array, then sifting down each item that has
+ *                  children, from the last to the first (bottom-up heap construction). Runs in linear time.
+ *  @param      : [ Array of items. ]
+ *                [ No. of items. ]
+ *                [ Arity (less than 2 means default). ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : Pointer to heap.
+**/
+hp_heap * hp_heapify(DATA_TYPE *arr, LENGTH_DT n, unsigned char arity,
+                        unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    hp_heap *new_heap = hp_create(arity);
+    hp_reserve(new_heap, n);
+    memcpy(new_heap->items, arr, n * sizeof(DATA_TYPE));
+    new_heap->length = n;
+    if (n > 1) {
+        for (LENGTH_DT i = HP_PARENT(n - 1, new_heap->arity); i >= 0; i--) {
+            hp_sift_down(new_heap, i, f_compare);
+        }
+    }
+    return new_heap;
+}
+
+/**
+ *  @brief      : Re-allocate the array of a heap, if smaller than a capacity.
+ *  @param      : [ Heap. ]
+ *                [ Capacity (no. of items). ]
+ *  @return     : None.
+**/
+void hp_reserve(hp_heap *heap, LENGTH_DT capacity) {
+    if (capacity > heap->capacity) {
+        heap->items = (DATA_TYPE *) realloc(heap->items, capacity * sizeof(DATA_TYPE));
+        heap->capacity = capacity;
+    }
+}
+
+/**
+ *  @brief      : (for internal use) Move an item up, while it has priority over its parent. Parents are moved down
+ *                  into the hole left by the item, which is written once, at its final position.
+ *  @param      : [ Heap. ]
+ *                [ Index of item. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : None.
+**/
+static void hp_sift_up(hp_heap *heap, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    DATA_TYPE data = heap->items[i];
+    while (i > 0) {
+        LENGTH_DT parent = HP_PARENT(i, heap->arity);
+        if (!f_compare(data, heap->items[parent])) {
+            break;
+        }
+        heap->items[i] = heap->items[parent];
+        i = parent;
+    }
+    heap->items[i] = data;
+}
+
+/**
+ *  @brief      : (for internal use) Move an item down, while one of its children has priority over it. The child with
+ *                  the highest priority is moved up into the hole left by the item, which is written once, at its
+ *                  final position.
+ *  @param      : [ Heap. ]
+ *                [ Index of item. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : None.
+**/
+static void hp_sift_down(hp_heap *heap, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    DATA_TYPE data = heap->items[i];
+    while (1) {
+        LENGTH_DT first = HP_FIRST_CHILD(i, heap->arity);
+        if (first >= heap->length) {
+            break;
+        }
+        LENGTH_DT last = first + heap->arity < heap->length ? first + heap->arity : heap->length;
+        LENGTH_DT best = first;
+        for (LENGTH_DT child = first + 1; child < last; child++) {
+            if (f_compare(heap->items[child], heap->items[best])) {
+                best = child;
+            }
+        }
+        if (!f_compare(heap->items[best], data)) {
+            break;
+        }
+        heap->items[i] = heap->items[best];
+        i = best;
+    }
+    heap->items[i] = data;
+}
+
+/**
+ *  @brief      : Push an item, by placing it at the end of the array (doubling the array, if full), then sifting it up.
+ *  @param      : [ Heap. ]
+ *                [ Data to push. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : None.
+**/
+void hp_push(hp_heap *heap, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    if (heap->length == heap->capacity) {
+        hp_reserve(heap, heap->capacity * 2);
+    }
+    heap->items[heap->length++] = data;
+    hp_sift_up(heap, heap->length - 1, f_compare);
+}
+
+/**
+ *  @brief      : Pop the top item, by moving the last item to the top, then sifting it down. If heap is empty,
+ *                  returns DEFAULT_VALUE set in the header file.
+ *  @param      : [ Heap. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE hp_pop(hp_heap *heap, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    if (heap->length != 0) {
+        DATA_TYPE data = heap->items[0];
+        heap->items[0] = heap->items[--heap->length];
+        if (heap->length > 1) {
+            hp_sift_down(heap, 0, f_compare);
+        }
+        return data;
+    }
+    return DEFAULT_VALUE;
+}
+
+/**
+ *  @brief      : Get the top item. If heap is empty, returns DEFAULT_VALUE set in the header file.
+ *  @param      : [ Heap. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE hp_peek(hp_heap *heap) {
+    return heap->length != 0 ? heap->items[0] : DEFAULT_VALUE;
+}
+
+/**
+ *  @brief      : Delete all items in a heap (the array is kept, for re-use).
+ *  @param      : [ Heap. ]
+ *  @return     : None.
+**/
+void hp_delete_all(hp_heap *heap) {
+    heap->length = 0;
+}
+
+/**
+ *  @brief      : De-allocate the array of a heap, then the heap itself.
+ *  @param      : [ Heap. ]
+ *  @return     : None.
+**/
+void hp_destroy(hp_heap *heap) {
+    free(heap->items);
+    free(heap);
+}
+
+/**
+ *  @brief      : Print a heap, in array order. Must pass a two function pointers, one is used to print each item,
+ *                  and another is called at the end (passed a reference to the heap).
+ *  @param      : [ Heap to print. ]
+ *                [ Function to be called at each item (passed each item consecutively). ]
+ *                [ Function to be called after all items have been printed (passed heap and used for clean-up). ]
+ *  @return     : None.
+**/
+void hp_print(hp_heap *heap, void (*f_print)(DATA_TYPE data), void (*f_clean)(hp_heap *heap)) {
+    if (heap->length != 0) {
+        for (LENGTH_DT i = 0; i < heap->length; i++) {
+            f_print(heap->items[i]);
+        }
+        f_clean(heap);
+    }
+}
+
+/**
+ *  @brief      : Allocating dynamic memory for an indexed heap structure (and its arrays, sized by the no. of ids),
+ *                  initializing and returning the pointer.
+ *  @param      : [ No. of ids. ]
+ *                [ Arity (less than 2 means default). ]
+ *  @return     : Pointer to indexed heap.
+**/
+ihp_heap * ihp_create(LENGTH_DT max_ids, unsigned char arity) {
+    ihp_heap *new_heap = (ihp_heap *) malloc(sizeof(ihp_heap));
+    new_heap->ids = (LENGTH_DT *) malloc(max_ids * sizeof(LENGTH_DT));
+    new_heap->pos = (LENGTH_DT *) malloc(max_ids * sizeof(LENGTH_DT));
+    new_heap->items = (DATA_TYPE *) malloc(max_ids * sizeof(DATA_TYPE));
+    for (LENGTH_DT id = 0; id < max_ids; id++) {
+        new_heap->pos[id] = IHP_ABSENT;
+    }
+    new_heap->length = 0, new_heap->max_ids = max_ids;
+    new_heap->arity = arity < 2 ? HP_DEFAULT_ARITY : arity;
+    return new_heap;
+}
+
+/**
+ *  @brief      : (for internal use) Move an id up, while its item has priority over that of its parent. Like
+ *                  'hp_sift_up', but the position of each moved id is updated.
+ *  @param      : [ Indexed heap. ]
+ *                [ Index (in heap array) of id. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : None.
+**/
+static void ihp_sift_up(ihp_heap *heap, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    LENGTH_DT id = heap->ids[i];
+    while (i > 0) {
+        LENGTH_DT parent = HP_PARENT(i, heap->arity);
+        if (!f_compare(heap->items[id], heap->items[heap->ids[parent]])) {
+            break;
+        }
+        heap->ids[i] = heap->ids[parent];
+        heap->pos[heap->ids[i]] = i;
+        i = parent;
+    }
+    heap->ids[i] = id;
+    heap->pos[id] = i;
+}
+
+/**
+ *  @brief      : (for internal use) Move an id down, while the item of one of its children has priority over its item.
+ *                  Like 'hp_sift_down', but the position of each moved id is updated.
+ *  @param      : [ Indexed heap. ]
+ *                [ Index (in heap array) of id. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : None.
+**/
+static void ihp_sift_down(ihp_heap *heap, LENGTH_DT i, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    LENGTH_DT id = heap->ids[i];
+    while (1) {
+        LENGTH_DT first = HP_FIRST_CHILD(i, heap->arity);
+        if (first >= heap->length) {
+            break;
+        }
+        LENGTH_DT last = first + heap->arity < heap->length ? first + heap->arity : heap->length;
+        LENGTH_DT best = first;
+        for (LENGTH_DT child = first + 1; child < last; child++) {
+            if (f_compare(heap->items[heap->ids[child]], heap->items[heap->ids[best]])) {
+                best = child;
+            }
+        }
+        if (!f_compare(heap->items[heap->ids[best]], heap->items[id])) {
+            break;
+        }
+        heap->ids[i] = heap->ids[best];
+        heap->pos[heap->ids[i]] = i;
+        i = best;
+    }
+    heap->ids[i] = id;
+    heap->pos[id] = i;
+}
+
+/**
+ *  @brief      : Push the item of an id. If the id is not in the heap, it is placed at the end, and sifted up.
+ *                  Otherwise, its item is replaced, and it is sifted up or down, depending on the new item.
+ *  @param      : [ Indexed heap. ]
+ *                [ Id. ]
+ *                [ Data to push. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : None.
+**/
+void ihp_push(ihp_heap *heap, LENGTH_DT id, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    if (id >= 0 && id < heap->max_ids) {
+        if (heap->pos[id] == IHP_ABSENT) {
+            heap->items[id] = data;
+            heap->ids[heap->length] = id;
+            heap->pos[id] = heap->length++;
+            ihp_sift_up(heap, heap->pos[id], f_compare);
+        } else {
+            DATA_TYPE old_data = heap->items[id];
+            heap->items[id] = data;
+            if (f_compare(data, old_data)) {
+                ihp_sift_up(heap, heap->pos[id], f_compare);
+            } else {
+                ihp_sift_down(heap, heap->pos[id], f_compare);
+            }
+        }
+    }
+}
+
+/**
+ *  @brief      : Replace the item of an id, with one of higher (or equal) priority, then sift it up.
+ *  @param      : [ Indexed heap. ]
+ *                [ Id. ]
+ *                [ New data. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : None.
+**/
+void ihp_decrease_key(ihp_heap *heap, LENGTH_DT id, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    if (ihp_contains(heap, id)) {
+        heap->items[id] = data;
+        ihp_sift_up(heap, heap->pos[id], f_compare);
+    }
+}
+
+/**
+ *  @brief      : Pop the top id, by moving the last id to the top, then sifting it down.
+ *  @param      : [ Indexed heap. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : Id, or IHP_ABSENT if heap is empty.
+**/
+LENGTH_DT ihp_pop(ihp_heap *heap, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    if (heap->length != 0) {
+        LENGTH_DT id = heap->ids[0];
+        heap->pos[id] = IHP_ABSENT;
+        if (--heap->length != 0) {
+            heap->ids[0] = heap->ids[heap->length];
+            heap->pos[heap->ids[0]] = 0;
+            ihp_sift_down(heap, 0, f_compare);
+        }
+        return id;
+    }
+    return IHP_ABSENT;
+}
+
+/**
+ *  @brief      : Get the top id.
+ *  @param      : [ Indexed heap. ]
+ *  @return     : Id, or IHP_ABSENT if heap is empty.
+**/
+LENGTH_DT ihp_peek(ihp_heap *heap) {
+    return heap->length != 0 ? heap->ids[0] : IHP_ABSENT;
+}
+
+/**
+ *  @brief      : Get the item of an id. If id is not in the heap, returns DEFAULT_VALUE set in the header file.
+ *  @param      : [ Indexed heap. ]
+ *                [ Id. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE ihp_get(ihp_heap *heap, LENGTH_DT id) {
+    return ihp_contains(heap, id) ? heap->items[id] : DEFAULT_VALUE;
+}
+
+/**
+ *  @brief      : Check if an id is in an indexed heap (in bounds, and with a position).
+ *  @param      : [ Indexed heap. ]
+ *                [ Id. ]
+ *  @return     : 1 if it is, else 0.
+**/
+unsigned char ihp_contains(ihp_heap *heap, LENGTH_DT id) {
+    return id >= 0 && id < heap->max_ids && heap->pos[id] != IHP_ABSENT;
+}
+
+/**
+ *  @brief      : De-allocate the arrays of an indexed heap, then the indexed heap itself.
+ *  @param      : [ Indexed heap. ]
+ *  @return     : None.
+**/
+void ihp_destroy(ihp_heap *heap) {
+    free(heap->ids);
+    free(heap->pos);
+    free(heap->items);
+    free(heap);
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_HEAP_                      /* compile-time switch */
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+unsigned char f_compare(void *new_data, void *old_data);
+void f_print(void *data);
+void f_clean(hp_heap *heap);
+
+void t_push_pop();
+void t_heapify();
+void t_indexed();
+
+int main() {
+    t_push_pop();
+    t_heapify();
+    t_indexed();
+    return 0;
+}
+
+void t_push_pop() {
+    printf("*************** TEST (PUSH/POP) ***************\n");
+    int arr_data[] = {8, 3, 12, 1, 15, 6, 10, 2, 14, 5, 9, 13, 4, 11, 7};
+    unsigned char arr_arity[] = {2, 4, 8};
+    for (int a = 0; a < LEN(arr_arity); a++) {
+        printf("Arity: %d\n", arr_arity[a]);
+        hp_heap *heap = hp_create(arr_arity[a]);
+        for (int i = 0; i < LEN(arr_data); i++) {
+            hp_push(heap, arr_data+i, f_compare);
+        }
+        hp_print(heap, f_print, f_clean);
+        printf("Peeking: %d\n", *((int *) hp_peek(heap)));
+        printf("Popping: ");
+        while (heap->length != 0) {
+            f_print(hp_pop(heap, f_compare));
+        }
+        f_clean(heap);
+        hp_destroy(heap);
+    }
+}
+
+void t_heapify() {
+    printf("*************** TEST (HEAPIFY) ***************\n");
+    int arr_data[] = {8, 3, 12, 1, 15, 6, 10, 2, 14, 5, 9, 13, 4, 11, 7};
+    void *arr_ptr[LEN(arr_data)];
+    for (int i = 0; i < LEN(arr_data); i++) {
+        arr_ptr[i] = arr_data+i;
+    }
+    hp_heap *heap = hp_heapify(arr_ptr, LEN(arr_ptr), 2, f_compare);
+    hp_print(heap, f_print, f_clean);
+    printf("Popping: ");
+    while (heap->length != 0) {
+        f_print(hp_pop(heap, f_compare));
+    }
+    f_clean(heap);
+    hp_destroy(heap);
+}
+
+void t_indexed() {
+    printf("*************** TEST (INDEXED, DIJKSTRA) ***************\n");
+    enum { V = 6, INF = 1 << 30 };
+    int weight[V][V] = {                                /* 0 means no edge */
+        {0, 7, 9, 0, 0, 14},
+        {7, 0, 10, 15, 0, 0},
+        {9, 10, 0, 11, 0, 2},
+        {0, 15, 11, 0, 6, 0},
+        {0, 0, 0, 6, 0, 9},
+        {14, 0, 2, 0, 9, 0}
+    };
+    int dist[V];
+    ihp_heap *heap = ihp_create(V, 4);
+    for (int v = 0; v < V; v++) {
+        dist[v] = v == 0 ? 0 : INF;
+        ihp_push(heap, v, dist+v, f_compare);
+    }
+    while (heap->length != 0) {
+        LENGTH_DT u = ihp_pop(heap, f_compare);
+        printf("Settled: %ld (distance %d)\n", (long) u, dist[u]);
+        for (int v = 0; v < V; v++) {
+            if (weight[u][v] != 0 && ihp_contains(heap, v) && dist[u] + weight[u][v] < dist[v]) {
+                dist[v] = dist[u] + weight[u][v];
+                ihp_decrease_key(heap, v, dist+v, f_compare);
+            }
+        }
+    }
+    ihp_destroy(heap);
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return *((int *) new_data) < *((int *) old_data) ? 1 : 0;
+}
+
+void f_print(void *data) {
+    printf("%d, ", *((int *) data));
+}
+
+void f_clean(hp_heap *heap) {
+    printf("\b\b \n");
+}
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ ****************************************************************
+ * @file            : heap.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the implementation of an array-based d-ary heap (priority
+ *                      queue), and an indexed d-ary heap (with decrease-key).
+ * **************************************************************
+ **/
+
+#ifndef _HEAP_H_
+#define _HEAP_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "shared_defs.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Default arity (no. of children of each item) of a heap. Arities of 4 and 8 make the heap shallower,
+ *                  and keep the children of an item within one or two cache lines.
+**/
+#define HP_DEFAULT_ARITY    4
+
+/**
+ *  @brief      : Position of an absent id in an indexed heap.
+**/
+#define IHP_ABSENT          -1
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Heap structure. The top item is at index 0, and the children of the item at index 'i'
+ *                  are at indices 'arity*i + 1' to 'arity*i + arity'.
+**/
+typedef struct HP_HEAP {
+    DATA_TYPE *items;
+    LENGTH_DT length;
+    LENGTH_DT capacity;
+    unsigned char arity;
+} hp_heap;
+
+/**
+ *  @brief      : Indexed heap structure. Items are identified by an id (from 0 to 'max_ids - 1'), and the position
+ *                  of each id in the heap is kept, so that the item of an id can be changed in place.
+**/
+typedef struct IHP_HEAP {
+    LENGTH_DT *ids;                                 /* heap array of ids */
+    LENGTH_DT *pos;                                 /* position of each id in 'ids', or IHP_ABSENT */
+    DATA_TYPE *items;                               /* item of each id */
+    LENGTH_DT length;
+    LENGTH_DT max_ids;
+    unsigned char arity;
+} ihp_heap;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Create a heap (dynamically, on heap).
+ *  @param      : [ Arity (no. of children of each item, 2, 4 or 8 are recommended, less than 2 means default). ]
+ *  @return     : Pointer to heap.
+**/
+hp_heap * hp_create(unsigned char arity);
+
+/**
+ *  @brief      : Create a heap from an array of items (copied), in linear time.
+ *  @param      : [ Array of items. ]
+ *                [ No. of items. ]
+ *                [ Arity (no. of children of each item, 2, 4 or 8 are recommended, less than 2 means default). ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : Pointer to heap.
+**/
+hp_heap * hp_heapify(DATA_TYPE *arr, LENGTH_DT n, unsigned char arity,
+                        unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Make room for a number of items, so that pushing up to it does not re-allocate.
+ *  @param      : [ Heap. ]
+ *                [ Capacity (no. of items). ]
+ *  @return     : None.
+**/
+void hp_reserve(hp_heap *heap, LENGTH_DT capacity);
+
+/**
+ *  @brief      : Push an item onto a heap.
+ *  @param      : [ Heap. ]
+ *                [ Data to push. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : None.
+**/
+void hp_push(hp_heap *heap, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Pop the top item off a heap. If heap is empty, returns DEFAULT_VALUE stored in 'shared_defs.h'.
+ *  @param      : [ Heap. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE hp_pop(hp_heap *heap, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Get the top item of a heap. If heap is empty, returns DEFAULT_VALUE stored in 'shared_defs.h'.
+ *  @param      : [ Heap. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE hp_peek(hp_heap *heap);
+
+/**
+ *  @brief      : Delete all items in a heap.
+ *  @param      : [ Heap. ]
+ *  @return     : None.
+**/
+void hp_delete_all(hp_heap *heap);
+
+/**
+ *  @brief      : Destroy heap (de-allocated off heap).
+ *                  (Note: If pointers are the data-type, they're de-allocated, and not the data they point to.)
+ *  @param      : [ Heap. ]
+ *  @return     : None.
+**/
+void hp_destroy(hp_heap *heap);
+
+/**
+ *  @brief      : Print the items of a heap, in array order.
+ *  @param      : [ Heap to print. ]
+ *                [ Function to be called at each item (passed each item consecutively). ]
+ *                [ Function to be called after all items have been printed (passed heap and used for clean-up). ]
+ *  @return     : None.
+**/
+void hp_print(hp_heap *heap, void (*f_print)(DATA_TYPE data), void (*f_clean)(hp_heap *heap));
+
+/**
+ *  @brief      : Create an indexed heap (dynamically, on heap), for ids from 0 to 'max_ids - 1'.
+ *  @param      : [ No. of ids. ]
+ *                [ Arity (no. of children of each item, 2, 4 or 8 are recommended, less than 2 means default). ]
+ *  @return     : Pointer to indexed heap.
+**/
+ihp_heap * ihp_create(LENGTH_DT max_ids, unsigned char arity);
+
+/**
+ *  @brief      : Push the item of an id onto an indexed heap. If the id is already in the heap, its item is replaced.
+ *                  If id is out of bounds, nothing happens.
+ *  @param      : [ Indexed heap. ]
+ *                [ Id. ]
+ *                [ Data to push. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : None.
+**/
+void ihp_push(ihp_heap *heap, LENGTH_DT id, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Replace the item of an id in an indexed heap, with one of higher (or equal) priority.
+ *                  If id is not in the heap, nothing happens.
+ *  @param      : [ Indexed heap. ]
+ *                [ Id. ]
+ *                [ New data. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : None.
+**/
+void ihp_decrease_key(ihp_heap *heap, LENGTH_DT id, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Pop the top id off an indexed heap (its item can be read through 'ihp_get' beforehand).
+ *  @param      : [ Indexed heap. ]
+ *                [ Function that receives two items, and returns 1 if the first has priority (is nearer the top), else 0. ]
+ *  @return     : Id, or IHP_ABSENT if heap is empty.
+**/
+LENGTH_DT ihp_pop(ihp_heap *heap, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Get the top id of an indexed heap.
+ *  @param      : [ Indexed heap. ]
+ *  @return     : Id, or IHP_ABSENT if heap is empty.
+**/
+LENGTH_DT ihp_peek(ihp_heap *heap);
+
+/**
+ *  @brief      : Get the item of an id. If id is not in the heap, returns DEFAULT_VALUE stored in 'shared_defs.h'.
+ *  @param      : [ Indexed heap. ]
+ *                [ Id. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE ihp_get(ihp_heap *heap, LENGTH_DT id);
+
+/**
+ *  @brief      : Check if an id is in an indexed heap.
+ *  @param      : [ Indexed heap. ]
+ *                [ Id. ]
+ *  @return     : 1 if it is, else 0.
+**/
+unsigned char ihp_contains(ihp_heap *heap, LENGTH_DT id);
+
+/**
+ *  @brief      : Destroy indexed heap (de-allocated off heap).
+ *  @param      : [ Indexed heap. ]
+ *  @return     : None.
+**/
+void ihp_destroy(ihp_heap *heap);
+
+#endif
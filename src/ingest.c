@@ -0,0 +1,641 @@
+/**
+ ****************************************************************
+ * @file            : ingest.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of a pipelined streaming ingest of records into a sorted list or a balanced tree.
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#define _POSIX_C_SOURCE 200809L                         /* for 'pthread' and 'sysconf' (and 'clock_gettime' in the benchmark) */
+
+#include <unistd.h>
+#include "ingest.h"
+#include "sort.h"
+#include "heap.h"
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : (For internal use) Buffer of raw bytes, holding whole records only (except at the end of stream).
+**/
+typedef struct IG_BUFFER {
+    char *data;
+    size_t capacity;
+    size_t length;
+} ig_buffer;
+
+/**
+ *  @brief      : (For internal use) Run (sorted array of items).
+**/
+typedef struct IG_RUN {
+    DATA_TYPE *items;
+    LENGTH_DT length;
+} ig_run;
+
+/**
+ *  @brief      : (For internal use) State of an ingest, shared by its threads (under 'lock'). Buffers cycle from
+ *                  'free_buffers' (taken by the reader, that blocks while none is free), to 'chunks' (taken by parsers),
+ *                  and back, so no more than 'n_buffers' are ever allocated. Parsed runs are queued in 'runs'.
+**/
+typedef struct IG_PIPELINE {
+    FILE *stream;
+    ig_config config;
+    DATA_TYPE (*f_parse)(const char *record, size_t length, void *arg);
+    void *arg;
+    unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data);
+    pthread_mutex_t lock;
+    pthread_cond_t buffer_free;
+    pthread_cond_t chunk_ready;
+    pthread_cond_t run_ready;
+    ll_list *free_buffers;
+    ll_list *chunks;
+    ll_list *runs;
+    unsigned char reader_done;
+    int parsers_active;
+} ig_pipeline;
+
+/**
+ *  @brief      : (For internal use) K-way merge of the runs left to the builder (see 'ig_merge_next').
+**/
+typedef struct IG_MERGE {
+    ig_run **runs;
+    LENGTH_DT *next;                                /* index of the next item of each run */
+    ihp_heap *heap;                                 /* head of each (non-exhausted) run, by run index */
+    unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data);
+} ig_merge;
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static ll_list * ig_run_pipeline(FILE *stream, ig_config *config, DATA_TYPE (*f_parse)(const char *record, size_t length, void *arg),
+                                    void *arg, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static ig_buffer * ig_take_buffer(ig_pipeline *pipeline);
+static void ig_grow_buffer(ig_buffer *buffer, size_t capacity);
+static void * ig_reader(void *arg);
+static void * ig_parser(void *arg);
+static ig_run * ig_merge_runs(ig_run *left, ig_run *right, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static LENGTH_DT ig_merge_init(ig_merge *merge, ll_list *stack, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static DATA_TYPE ig_merge_next(void *arg);
+static void ig_merge_destroy(ig_merge *merge);
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Ingest the records of a stream into a sorted list. The runs left by the pipeline are merged (k-way)
+ *                  into the list.
+ *  @param      : [ Stream. ]
+ *                [ Configuration (or NULL for defaults). ]
+ *                [ Function that receives a record, its length, and 'arg', and returns its item (or DEFAULT_VALUE). ]
+ *                [ Argument. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Pointer to list.
+**/
+ll_list * ig_ingest_list(FILE *stream, ig_config *config, DATA_TYPE (*f_parse)(const char *record, size_t length, void *arg),
+                            void *arg, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    ll_list *stack = ig_run_pipeline(stream, config, f_parse, arg, f_compare);
+    ll_list *list = ll_create();
+    ig_merge merge;
+    LENGTH_DT n = ig_merge_init(&merge, stack, f_compare);
+    while (n-- != 0) {
+        ll_append(list, ig_merge_next(&merge));
+    }
+    ig_merge_destroy(&merge);
+    return list;
+}
+
+/**
+ *  @brief      : Ingest the records of a stream into a balanced tree. The runs left by the pipeline are merged (k-way)
+ *                  straight into 'avl_bulk_load', so the tree is built in O(n), with no intermediate copy.
+ *  @param      : [ Stream. ]
+ *                [ Configuration (or NULL for defaults). ]
+ *                [ Function that receives a record, its length, and 'arg', and returns its item (or DEFAULT_VALUE). ]
+ *                [ Argument. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Pointer to tree.
+**/
+avl_tree * ig_ingest_tree(FILE *stream, ig_config *config, DATA_TYPE (*f_parse)(const char *record, size_t length, void *arg),
+                            void *arg, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    ll_list *stack = ig_run_pipeline(stream, config, f_parse, arg, f_compare);
+    avl_tree *tree = avl_create();
+    ig_merge merge;
+    LENGTH_DT n = ig_merge_init(&merge, stack, f_compare);
+    avl_bulk_load(tree, n, ig_merge_next, &merge);
+    ig_merge_destroy(&merge);
+    return tree;
+}
+
+/**
+ *  @brief      : (for internal use) Run the pipeline: start the reader and the parsers, then build runs on the calling
+ *                  thread while they work. Runs are kept on a stack, and whenever a new run is at least as long as the
+ *                  one on top, the two are merged (and so on), so lengths on the stack decrease geometrically (leaving
+ *                  O(log n) runs), and most merging overlaps reading and parsing.
+ *  @param      : [ Stream. ]
+ *                [ Configuration (or NULL for defaults). ]
+ *                [ Function that receives a record, its length, and 'arg', and returns its item (or DEFAULT_VALUE). ]
+ *                [ Argument. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Stack of runs (oldest at the bottom).
+**/
+static ll_list * ig_run_pipeline(FILE *stream, ig_config *config, DATA_TYPE (*f_parse)(const char *record, size_t length, void *arg),
+                                    void *arg, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    ig_pipeline pipeline;
+    memset(&pipeline.config, 0, sizeof(ig_config));
+    if (config != NULL) { pipeline.config = *config; }
+    if (pipeline.config.chunk_size == 0) { pipeline.config.chunk_size = IG_DEFAULT_CHUNK_SIZE; }
+    if (pipeline.config.n_parsers <= 0) {
+        long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        pipeline.config.n_parsers = n_cpus > 0 ? (int) n_cpus : 1;
+    }
+    if (pipeline.config.n_buffers <= 0) { pipeline.config.n_buffers = 2 * pipeline.config.n_parsers + 1; }
+    if (pipeline.config.n_buffers < 2) { pipeline.config.n_buffers = 2; }       /* the reader holds two at once */
+    if (pipeline.config.delimiter == '\0') { pipeline.config.delimiter = '\n'; }
+
+    pipeline.stream = stream;
+    pipeline.f_parse = f_parse, pipeline.arg = arg, pipeline.f_compare = f_compare;
+    pthread_mutex_init(&pipeline.lock, NULL);
+    pthread_cond_init(&pipeline.buffer_free, NULL);
+    pthread_cond_init(&pipeline.chunk_ready, NULL);
+    pthread_cond_init(&pipeline.run_ready, NULL);
+    pipeline.free_buffers = ll_create();
+    pipeline.chunks = ll_create();
+    pipeline.runs = ll_create();
+    pipeline.reader_done = 0;
+    pipeline.parsers_active = pipeline.config.n_parsers;
+    for (int i = 0; i < pipeline.config.n_buffers; i++) {
+        ig_buffer *buffer = (ig_buffer *) malloc(sizeof(ig_buffer));
+        buffer->data = (char *) malloc(pipeline.config.chunk_size);
+        buffer->capacity = pipeline.config.chunk_size, buffer->length = 0;
+        ll_enqueue(pipeline.free_buffers, buffer);
+    }
+
+    pthread_t reader;
+    pthread_t *parsers = (pthread_t *) malloc(pipeline.config.n_parsers * sizeof(pthread_t));
+    pthread_create(&reader, NULL, ig_reader, &pipeline);
+    for (int i = 0; i < pipeline.config.n_parsers; i++) {
+        pthread_create(parsers + i, NULL, ig_parser, &pipeline);
+    }
+
+    ll_list *stack = ll_create();
+    while (1) {
+        pthread_mutex_lock(&pipeline.lock);
+        while (pipeline.runs->length == 0 && pipeline.parsers_active != 0) {
+            pthread_cond_wait(&pipeline.run_ready, &pipeline.lock);
+        }
+        ig_run *run = ll_dequeue(pipeline.runs);
+        pthread_mutex_unlock(&pipeline.lock);
+        if (run == NULL) {
+            break;
+        }
+        while (stack->length != 0 && ((ig_run *) ll_top(stack))->length <= run->length) {
+            run = ig_merge_runs(ll_pop(stack), run, f_compare);
+        }
+        ll_push(stack, run);
+    }
+
+    pthread_join(reader, NULL);
+    for (int i = 0; i < pipeline.config.n_parsers; i++) {
+        pthread_join(parsers[i], NULL);
+    }
+    free(parsers);
+    while (pipeline.free_buffers->length != 0) {
+        ig_buffer *buffer = ll_dequeue(pipeline.free_buffers);
+        free(buffer->data);
+        free(buffer);
+    }
+    ll_destroy(pipeline.free_buffers);
+    ll_destroy(pipeline.chunks);
+    ll_destroy(pipeline.runs);
+    pthread_mutex_destroy(&pipeline.lock);
+    pthread_cond_destroy(&pipeline.buffer_free);
+    pthread_cond_destroy(&pipeline.chunk_ready);
+    pthread_cond_destroy(&pipeline.run_ready);
+    return stack;
+}
+
+/**
+ *  @brief      : (for internal use) Take a free buffer, waiting while none is (back-pressure on the reader, until a
+ *                  parser is done with one).
+ *  @param      : [ Pipeline. ]
+ *  @return     : Pointer to buffer.
+**/
+static ig_buffer * ig_take_buffer(ig_pipeline *pipeline) {
+    pthread_mutex_lock(&pipeline->lock);
+    while (pipeline->free_buffers->length == 0) {
+        pthread_cond_wait(&pipeline->buffer_free, &pipeline->lock);
+    }
+    ig_buffer *buffer = ll_dequeue(pipeline->free_buffers);
+    pthread_mutex_unlock(&pipeline->lock);
+    return buffer;
+}
+
+/**
+ *  @brief      : (for internal use) Grow a buffer (keeping its bytes), if smaller than a capacity.
+ *  @param      : [ Buffer. ]
+ *                [ Capacity. ]
+ *  @return     : None.
+**/
+static void ig_grow_buffer(ig_buffer *buffer, size_t capacity) {
+    if (buffer->capacity < capacity) {
+        buffer->data = (char *) realloc(buffer->data, capacity);
+        buffer->capacity = capacity;
+    }
+}
+
+/**
+ *  @brief      : (for internal use) Reader thread. Fills a buffer, and cuts it after its last whole record. The bytes
+ *                  after the cut (a partial record) are moved to the next buffer, to be completed by the next read, and
+ *                  the buffer is queued to the parsers. If a buffer holds no whole record, it is doubled. A short read
+ *                  means end of stream (or a read error), and the last buffer is queued as is.
+ *  @param      : [ Pipeline. ]
+ *  @return     : NULL.
+**/
+static void * ig_reader(void *arg) {
+    ig_pipeline *pipeline = (ig_pipeline *) arg;
+    size_t record_size = pipeline->config.record_size;
+    ig_buffer *buffer = ig_take_buffer(pipeline);
+    buffer->length = 0;
+
+    while (1) {
+        buffer->length += fread(buffer->data + buffer->length, 1, buffer->capacity - buffer->length, pipeline->stream);
+        if (buffer->length < buffer->capacity) {
+            break;
+        }
+        size_t cut = 0;
+        if (record_size != 0) {
+            cut = buffer->length - buffer->length % record_size;
+        } else {
+            for (size_t i = buffer->length; i != 0; i--) {
+                if (buffer->data[i - 1] == pipeline->config.delimiter) {
+                    cut = i;
+                    break;
+                }
+            }
+        }
+        if (cut == 0) {
+            ig_grow_buffer(buffer, buffer->capacity * 2);
+            continue;
+        }
+        ig_buffer *next = ig_take_buffer(pipeline);
+        ig_grow_buffer(next, buffer->capacity);
+        next->length = buffer->length - cut;
+        memcpy(next->data, buffer->data + cut, next->length);
+        buffer->length = cut;
+
+        pthread_mutex_lock(&pipeline->lock);
+        ll_enqueue(pipeline->chunks, buffer);
+        pthread_cond_signal(&pipeline->chunk_ready);
+        pthread_mutex_unlock(&pipeline->lock);
+        buffer = next;
+    }
+
+    pthread_mutex_lock(&pipeline->lock);
+    ll_enqueue(pipeline->chunks, buffer);
+    pipeline->reader_done = 1;
+    pthread_cond_broadcast(&pipeline->chunk_ready);
+    pthread_mutex_unlock(&pipeline->lock);
+    return NULL;
+}
+
+/**
+ *  @brief      : (for internal use) Parser thread. Takes a buffer, passes each of its records to 'f_parse', sorts the
+ *                  items into a run, returns the buffer, and queues the run to the builder. Delimited records are the
+ *                  bytes between delimiters (and after the last one, if any). Fixed-size records are the whole
+ *                  'record_size' blocks (a trailing partial record is dropped).
+ *  @param      : [ Pipeline. ]
+ *  @return     : NULL.
+**/
+static void * ig_parser(void *arg) {
+    ig_pipeline *pipeline = (ig_pipeline *) arg;
+    size_t record_size = pipeline->config.record_size;
+    char delimiter = pipeline->config.delimiter;
+
+    while (1) {
+        pthread_mutex_lock(&pipeline->lock);
+        while (pipeline->chunks->length == 0 && !pipeline->reader_done) {
+            pthread_cond_wait(&pipeline->chunk_ready, &pipeline->lock);
+        }
+        ig_buffer *buffer = ll_dequeue(pipeline->chunks);
+        if (buffer == NULL) {
+            pipeline->parsers_active--;
+            pthread_cond_signal(&pipeline->run_ready);
+            pthread_mutex_unlock(&pipeline->lock);
+            break;
+        }
+        pthread_mutex_unlock(&pipeline->lock);
+
+        ig_run *run = (ig_run *) malloc(sizeof(ig_run));
+        LENGTH_DT capacity = record_size != 0 ? (LENGTH_DT) (buffer->length / record_size) + 1 : 64;
+        run->items = (DATA_TYPE *) malloc(capacity * sizeof(DATA_TYPE));
+        run->length = 0;
+        const char *record = buffer->data, *end = buffer->data + buffer->length;
+        while (record < end) {
+            size_t length;
+            if (record_size != 0) {
+                if ((size_t) (end - record) < record_size) { break; }
+                length = record_size;
+            } else {
+                const char *delim = memchr(record, delimiter, end - record);
+                length = (delim != NULL ? delim : end) - record;
+            }
+            DATA_TYPE item = pipeline->f_parse(record, length, pipeline->arg);
+            if (item != DEFAULT_VALUE) {
+                if (run->length == capacity) {
+                    capacity *= 2;
+                    run->items = (DATA_TYPE *) realloc(run->items, capacity * sizeof(DATA_TYPE));
+                }
+                run->items[run->length++] = item;
+            }
+            record += length + (record_size == 0);
+        }
+        sort_intro(run->items, run->length, pipeline->f_compare);
+
+        pthread_mutex_lock(&pipeline->lock);
+        ll_enqueue(pipeline->free_buffers, buffer);
+        pthread_cond_signal(&pipeline->buffer_free);
+        if (run->length != 0) {
+            ll_enqueue(pipeline->runs, run);
+            pthread_cond_signal(&pipeline->run_ready);
+        } else {
+            free(run->items);
+            free(run);
+        }
+        pthread_mutex_unlock(&pipeline->lock);
+    }
+    return NULL;
+}
+
+/**
+ *  @brief      : (for internal use) Merge two runs into a new one (de-allocating both). On ties, items of the left
+ *                  (older) run go first.
+ *  @param      : [ Left run. ]
+ *                [ Right run. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Pointer to merged run.
+**/
+static ig_run * ig_merge_runs(ig_run *left, ig_run *right, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    ig_run *run = (ig_run *) malloc(sizeof(ig_run));
+    run->length = left->length + right->length;
+    run->items = (DATA_TYPE *) malloc(run->length * sizeof(DATA_TYPE));
+    LENGTH_DT i = 0, j = 0, k = 0;
+    while (i < left->length && j < right->length) {
+        if (f_compare(right->items[j], left->items[i])) {
+            run->items[k++] = right->items[j++];
+        } else {
+            run->items[k++] = left->items[i++];
+        }
+    }
+    while (i < left->length) { run->items[k++] = left->items[i++]; }
+    while (j < right->length) { run->items[k++] = right->items[j++]; }
+    free(left->items), free(left);
+    free(right->items), free(right);
+    return run;
+}
+
+/**
+ *  @brief      : (for internal use) Start a k-way merge of a stack of runs (de-allocating the stack), pushing the head
+ *                  of each run onto an indexed heap.
+ *  @param      : [ Merge. ]
+ *                [ Stack of runs. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Total no. of items.
+**/
+static LENGTH_DT ig_merge_init(ig_merge *merge, ll_list *stack, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    LENGTH_DT n_runs = stack->length, n = 0;
+    merge->runs = (ig_run **) malloc((n_runs + 1) * sizeof(ig_run *));
+    merge->next = (LENGTH_DT *) calloc(n_runs + 1, sizeof(LENGTH_DT));
+    merge->heap = ihp_create(n_runs + 1, HP_DEFAULT_ARITY);
+    merge->f_compare = f_compare;
+    for (LENGTH_DT i = 0; i < n_runs; i++) {
+        merge->runs[i] = ll_pop(stack);
+        n += merge->runs[i]->length;
+        ihp_push(merge->heap, i, merge->runs[i]->items[merge->next[i]++], f_compare);
+    }
+    merge->runs[n_runs] = NULL;
+    ll_destroy(stack);
+    return n;
+}
+
+/**
+ *  @brief      : (for internal use) Returns the next item of a k-way merge (the top of the heap), replacing it with
+ *                  the next item of its run, if any.
+ *  @param      : [ Merge. ]
+ *  @return     : Item.
+**/
+static DATA_TYPE ig_merge_next(void *arg) {
+    ig_merge *merge = (ig_merge *) arg;
+    LENGTH_DT i = ihp_peek(merge->heap);
+    DATA_TYPE data = ihp_get(merge->heap, i);
+    ihp_pop(merge->heap, merge->f_compare);
+    if (merge->next[i] < merge->runs[i]->length) {
+        ihp_push(merge->heap, i, merge->runs[i]->items[merge->next[i]++], merge->f_compare);
+    }
+    return data;
+}
+
+/**
+ *  @brief      : (for internal use) De-allocate a k-way merge, and its runs.
+ *  @param      : [ Merge. ]
+ *  @return     : None.
+**/
+static void ig_merge_destroy(ig_merge *merge) {
+    for (LENGTH_DT i = 0; merge->runs[i] != NULL; i++) {
+        free(merge->runs[i]->items);
+        free(merge->runs[i]);
+    }
+    free(merge->runs);
+    free(merge->next);
+    ihp_destroy(merge->heap);
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_INGEST_                    /* compile-time switch */
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+unsigned char f_compare(void *new_data, void *old_data);
+void * f_parse(const char *record, size_t length, void *arg);
+void * f_parse_binary(const char *record, size_t length, void *arg);
+void f_print(void *data);
+void f_clean(ll_list *list);
+
+void t_list();
+void t_tree();
+void t_binary();
+
+int main() {
+    t_list();
+    t_tree();
+    t_binary();
+    return 0;
+}
+
+void t_list() {
+    printf("*************** TEST (LIST) ***************\n");
+    FILE *file = tmpfile();
+    fputs("42\n7\n\n19\n3\n1234567890123\n-5\n7\n100", file);         /* a blank record, and no final delimiter */
+    rewind(file);
+    ig_config config = {8, 2, 2, 0, '\0'};                                /* small buffers, so records are cut and carried */
+    ll_list *list = ig_ingest_list(file, &config, f_parse, NULL, f_compare);
+    ll_print(list, f_print, f_clean);
+    while (list->length != 0) { free(ll_pop(list)); }
+    ll_destroy(list);
+    fclose(file);
+}
+
+void t_tree() {
+    printf("*************** TEST (TREE) ***************\n");
+    FILE *file = tmpfile();
+    for (int i = 0; i < 10000; i++) {
+        fprintf(file, "%d;", (i * 7919) % 10000);
+    }
+    rewind(file);
+    ig_config config = {256, 3, 3, 0, ';'};
+    avl_tree *tree = ig_ingest_tree(file, &config, f_parse, NULL, f_compare);
+    unsigned char is_sorted = 1;
+    for (LENGTH_DT i = 0; i < tree->length; i++) {
+        is_sorted &= *((long *) avl_get(tree, i)) == i;
+    }
+    printf("Length: %ld, sorted: %d, height: %ld\n", (long) tree->length, is_sorted, (long) avl_height(tree));
+    while (tree->length != 0) { free(avl_pop_min(tree)); }
+    avl_destroy(tree);
+    fclose(file);
+}
+
+void t_binary() {
+    printf("*************** TEST (BINARY) ***************\n");
+    FILE *file = tmpfile();
+    for (long i = 0; i < 1000; i++) {
+        long key = 999 - i;
+        fwrite(&key, sizeof(long), 1, file);
+    }
+    fputc('x', file);                                                       /* partial record, dropped */
+    rewind(file);
+    ig_config config = {100, 0, 0, sizeof(long), '\0'};
+    avl_tree *tree = ig_ingest_tree(file, &config, f_parse_binary, NULL, f_compare);
+    printf("Length: %ld, min: %ld, max: %ld\n", (long) tree->length, *((long *) avl_min(tree)), *((long *) avl_max(tree)));
+    while (tree->length != 0) { free(avl_pop_min(tree)); }
+    avl_destroy(tree);
+    fclose(file);
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return *((long *) new_data) < *((long *) old_data);
+}
+
+void * f_parse(const char *record, size_t length, void *arg) {
+    char text[32];
+    if (length == 0 || length >= sizeof(text)) {
+        return NULL;
+    }
+    memcpy(text, record, length);
+    text[length] = '\0';
+    long *data = (long *) malloc(sizeof(long));
+    *data = strtol(text, NULL, 10);
+    return data;
+}
+
+void * f_parse_binary(const char *record, size_t length, void *arg) {
+    long *data = (long *) malloc(sizeof(long));
+    memcpy(data, record, sizeof(long));
+    return data;
+}
+
+void f_print(void *data) {
+    printf("%ld, ", *((long *) data));
+}
+
+void f_clean(ll_list *list) {
+    printf("\b\b \n");
+}
+
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_INGEST_                   /* compile-time switch */
+
+#include <time.h>
+
+unsigned char f_compare(void *new_data, void *old_data);
+void * f_parse(const char *record, size_t length, void *arg);
+double now();
+
+/**
+ *  @brief      : Writes a file of random integer keys (one per line), then compares reading it alone ('fread'), with
+ *                  loading it serially ('fgets', 'strtol' and 'avl_insert' per line), and with the pipeline. Keys are
+ *                  stored in the pointers themselves (no allocation per item).
+ *                  (Usage: ./a.out [no. of keys (default: 10^6)] [no. of parsers (default: no. of online processors)])
+**/
+int main(int argc, char **argv) {
+    LENGTH_DT n = argc > 1 ? atol(argv[1]) : 1000000;
+    ig_config config = {0, 0, argc > 2 ? atoi(argv[2]) : 0, 0, '\0'};
+    const char *path = "ingest_bench.txt";
+
+    FILE *file = fopen(path, "w");
+    uint64_t seed = 88172645463325252ull;
+    for (LENGTH_DT i = 0; i < n; i++) {
+        seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+        fprintf(file, "%ld\n", (long) (seed >> 2));
+    }
+    fclose(file);
+
+    char *chunk = (char *) malloc(IG_DEFAULT_CHUNK_SIZE);
+    double t0 = now();
+    file = fopen(path, "r");
+    size_t bytes = 0, got;
+    while ((got = fread(chunk, 1, IG_DEFAULT_CHUNK_SIZE, file)) != 0) { bytes += got; }
+    fclose(file);
+    double t_read = now() - t0;
+    free(chunk);
+
+    t0 = now();
+    file = fopen(path, "r");
+    avl_tree *tree = avl_create();
+    char line[64];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        avl_insert(tree, (void *) strtol(line, NULL, 10), f_compare);
+    }
+    fclose(file);
+    double t_serial = now() - t0;
+    LENGTH_DT n_serial = tree->length;
+    avl_destroy(tree);
+
+    t0 = now();
+    file = fopen(path, "r");
+    tree = ig_ingest_tree(file, &config, f_parse, NULL, f_compare);
+    fclose(file);
+    double t_pipeline = now() - t0;
+
+    printf("Keys: %ld (%.1f MB), serial: %ld, pipeline: %ld\n", (long) n, bytes / 1e6, (long) n_serial, (long) tree->length);
+    printf("%-32s: %10.3f ms\n", "read only (fread)", t_read * 1e3);
+    printf("%-32s: %10.3f ms\n", "serial (fgets + avl_insert)", t_serial * 1e3);
+    printf("%-32s: %10.3f ms\n", "pipeline (ig_ingest_tree)", t_pipeline * 1e3);
+    avl_destroy(tree);
+    remove(path);
+    return 0;
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return (long) new_data < (long) old_data;
+}
+
+/**
+ *  @brief      : Parses a key (keys are positive, so 0 is never returned for a valid one).
+**/
+void * f_parse(const char *record, size_t length, void *arg) {
+    long key = 0;
+    for (size_t i = 0; i < length; i++) {
+        key = key * 10 + (record[i] - '0');
+    }
+    return (void *) key;
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#endif
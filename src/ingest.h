@@ -0,0 +1,79 @@
+/**
+ ****************************************************************
+ * @file            : ingest.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the implementation of a pipelined streaming ingest of records
+ *                      (from a file or a pipe) into a sorted list or a balanced tree. A reader thread fills buffers,
+ *                      parser threads decode and sort the records of each buffer (a run), and the calling thread merges
+ *                      runs as they arrive, then builds the output from them.
+ *                      (Note: Requires POSIX threads.)
+ * **************************************************************
+ **/
+
+#ifndef _INGEST_H_
+#define _INGEST_H_
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L                     /* for 'pthread' and 'sysconf' under strict C99 */
+#endif
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include "shared_defs.h"
+#include "linked_list.h"
+#include "avl_tree.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Default size of a buffer (grown if a single record does not fit in it).
+**/
+#define IG_DEFAULT_CHUNK_SIZE       (1 << 20)
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Configuration of an ingest. Zero-initialized fields take their defaults.
+**/
+typedef struct IG_CONFIG {
+    size_t chunk_size;                              /* size of a buffer (default: 'IG_DEFAULT_CHUNK_SIZE') */
+    int n_buffers;                                  /* max. no. of buffers in flight, that bounds memory (default: 2 per parser + 1) */
+    int n_parsers;                                  /* no. of parser threads (default: no. of online processors) */
+    size_t record_size;                             /* size of fixed-size (binary) records, or 0 if delimited */
+    char delimiter;                                 /* delimiter of records, if 'record_size' is 0 (default: '\0', meaning '\n') */
+} ig_config;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Ingest the records of a stream into a sorted list (read until end of stream, or a read error).
+ *  @param      : [ Stream (e.g: a file, or 'stdin'). ]
+ *                [ Configuration (or NULL for defaults). ]
+ *                [ Function that receives a record (not terminated), its length, and 'arg', and returns its item, or
+ *                  DEFAULT_VALUE to skip it. It is called from many threads at once. ]
+ *                [ Argument. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Pointer to list.
+**/
+ll_list * ig_ingest_list(FILE *stream, ig_config *config, DATA_TYPE (*f_parse)(const char *record, size_t length, void *arg),
+                            void *arg, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Ingest the records of a stream into a balanced tree (read until end of stream, or a read error).
+ *  @param      : [ Stream (e.g: a file, or 'stdin'). ]
+ *                [ Configuration (or NULL for defaults). ]
+ *                [ Function that receives a record (not terminated), its length, and 'arg', and returns its item, or
+ *                  DEFAULT_VALUE to skip it. It is called from many threads at once. ]
+ *                [ Argument. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Pointer to tree.
+**/
+avl_tree * ig_ingest_tree(FILE *stream, ig_config *config, DATA_TYPE (*f_parse)(const char *record, size_t length, void *arg),
+                            void *arg, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+#endif
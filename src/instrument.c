@@ -0,0 +1,238 @@
+/**
+ ****************************************************************
+ * @file            : instrument.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of the (compile-time optional) instrumentation of lists and trees.
+ *                      (Compile: gcc -D_INSTRUMENT_ [-D_INSTRUMENT_TIMING_] ... instrument.c linked_list.c avl_tree.c)
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#define _POSIX_C_SOURCE 200809L                         /* for 'clock_gettime' */
+
+#include <time.h>
+#include "instrument.h"
+
+#ifdef _INSTRUMENT_                     /* compile-time switch */
+
+/* ********************* static variable(s) SECTION ********************** */
+
+/**
+ *  @brief      : Hooks called on entry to (and exit from) public functions (NULL if unset).
+**/
+static void (*instr_f_enter)(const char *func, void *container) = NULL;
+static void (*instr_f_exit)(const char *func, void *container) = NULL;
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+#ifdef _INSTRUMENT_TIMING_
+static uint64_t instr_clock();
+#endif
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Set the hooks called on entry to (and exit from) every public function.
+ *  @param      : [ Function called on entry. ]
+ *                [ Function called on exit. ]
+ *  @return     : None.
+**/
+void instr_set_hooks(void (*f_enter)(const char *func, void *container), void (*f_exit)(const char *func, void *container)) {
+    instr_f_enter = f_enter;
+    instr_f_exit = f_exit;
+}
+
+#ifdef _INSTRUMENT_TIMING_
+/**
+ *  @brief      : (for internal use) Returns the time of a monotonic clock, in nanoseconds.
+ *  @param      : None.
+ *  @return     : Time (ns).
+**/
+static uint64_t instr_clock() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+#endif
+
+/**
+ *  @brief      : Called on entry to a public function. If it is the outermost call, an operation starts (its path
+ *                  length is reset, and its start time taken). The hook is called last, so its own time is not counted.
+ *  @param      : [ Counters. ]
+ *                [ Name of function. ]
+ *                [ Container. ]
+ *  @return     : None.
+**/
+void instr_enter(instr_stats *stats, const char *func, void *container) {
+    if (instr_f_enter != NULL) { instr_f_enter(func, container); }
+    stats->calls++;
+    if (stats->depth++ == 0) {
+        stats->op_path = 0;
+#ifdef _INSTRUMENT_TIMING_
+        stats->op_start = instr_clock();
+#endif
+    }
+}
+
+/**
+ *  @brief      : Called on exit from a public function. If it is the outermost call, the operation ends: its path
+ *                  length is added to the total (and the max.), and its duration to the bucket of its power of two.
+ *  @param      : [ Counters. ]
+ *                [ Name of function. ]
+ *                [ Container. ]
+ *  @return     : None.
+**/
+void instr_exit(instr_stats *stats, const char *func, void *container) {
+    if (--stats->depth == 0) {
+#ifdef _INSTRUMENT_TIMING_
+        uint64_t ns = instr_clock() - stats->op_start;
+        int bucket = 0;
+        while (ns > 1 && bucket < INSTR_BUCKETS - 1) {
+            ns >>= 1;
+            bucket++;
+        }
+        stats->histogram[bucket]++;
+#endif
+        stats->ops++;
+        stats->path_length += stats->op_path;
+        if (stats->op_path > stats->max_path_length) { stats->max_path_length = stats->op_path; }
+    }
+    if (instr_f_exit != NULL) { instr_f_exit(func, container); }
+}
+
+/**
+ *  @brief      : Reset counters.
+ *  @param      : [ Counters. ]
+ *  @return     : None.
+**/
+void instr_reset(instr_stats *stats) {
+    memset(stats, 0, sizeof(instr_stats));
+}
+
+/**
+ *  @brief      : Print counters, one per line, along with averages per operation.
+ *  @param      : [ Counters. ]
+ *                [ Name to print them under. ]
+ *                [ Stream to print to. ]
+ *  @return     : None.
+**/
+void instr_dump(instr_stats *stats, const char *name, FILE *out) {
+    double ops = stats->ops != 0 ? (double) stats->ops : 1.0;
+
+    fprintf(out, "[%s]\n", name);
+    fprintf(out, "  calls           : %llu\n", (unsigned long long) stats->calls);
+    fprintf(out, "  ops             : %llu\n", (unsigned long long) stats->ops);
+    fprintf(out, "  compares        : %llu (%.2f/op)\n", (unsigned long long) stats->compares, stats->compares / ops);
+    fprintf(out, "  rotations       : %llu (%.2f/op)\n", (unsigned long long) stats->rotations, stats->rotations / ops);
+    fprintf(out, "  allocs          : %llu\n", (unsigned long long) stats->allocs);
+    fprintf(out, "  frees           : %llu\n", (unsigned long long) stats->frees);
+    fprintf(out, "  stack pushes    : %llu (%.2f/op)\n", (unsigned long long) stats->stack_pushes, stats->stack_pushes / ops);
+    fprintf(out, "  path length     : %llu (%.2f/op, max. %llu)\n", (unsigned long long) stats->path_length,
+                stats->path_length / ops, (unsigned long long) stats->max_path_length);
+#ifdef _INSTRUMENT_TIMING_
+    fprintf(out, "  time (ns)       : ops\n");
+    for (int b = 0; b < INSTR_BUCKETS; b++) {
+        if (stats->histogram[b] != 0) {
+            fprintf(out, "  %s%-14llu : %llu\n", b == INSTR_BUCKETS - 1 ? ">=" : "< ",
+                        1ull << (b == INSTR_BUCKETS - 1 ? b : b + 1), (unsigned long long) stats->histogram[b]);
+        }
+    }
+#endif
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_INSTRUMENT_                /* compile-time switch */
+
+#include "linked_list.h"
+#include "avl_tree.h"
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+unsigned char f_compare(void *new_data, void *old_data);
+void f_enter(const char *func, void *container);
+void f_exit(const char *func, void *container);
+
+void t_list();
+void t_tree();
+void t_hooks();
+
+static LENGTH_DT n_enter = 0, n_exit = 0;
+
+int main() {
+    t_list();
+    t_tree();
+    t_hooks();
+    return 0;
+}
+
+void t_list() {
+    printf("*************** TEST (LIST) ***************\n");
+    ll_list *list = ll_create();
+    int arr[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    for (int i = 0; i < LEN(arr); i++) {
+        ll_append(list, arr + i);
+    }
+    ll_get(list, 7);                                    /* path of 7 nodes */
+    ll_delete(list, 0);
+    ll_delete(list, 3);                                 /* path of 2 nodes (to the previous node) */
+    INSTR_DUMP(list, "list", stdout);
+    printf("allocs - frees = %lld (length = %ld)\n",
+                (long long) (list->stats.allocs - list->stats.frees), list->length);
+    ll_destroy(list);
+}
+
+void t_tree() {
+    printf("*************** TEST (TREE) ***************\n");
+    avl_tree *tree = avl_create();
+    int arr[1000];
+    for (int i = 0; i < LEN(arr); i++) {
+        arr[i] = i;
+        avl_insert(tree, arr + i, f_compare);           /* ascending, so many rotations */
+    }
+    INSTR_DUMP(tree, "tree (insert, ascending)", stdout);
+    instr_reset(&tree->stats);
+    for (int i = 0; i < LEN(arr); i++) {
+        avl_find(tree, arr + i, f_compare);
+    }
+    INSTR_DUMP(tree, "tree (find)", stdout);
+    printf("max. path length = %llu (height = %ld)\n", (unsigned long long) tree->stats.max_path_length, avl_height(tree));
+    instr_reset(&tree->stats);
+    while (tree->length != 0) {
+        avl_pop_min(tree);                              /* one operation per call (through 'avl_delete') */
+    }
+    INSTR_DUMP(tree, "tree (pop_min)", stdout);
+    avl_destroy(tree);
+}
+
+void t_hooks() {
+    printf("*************** TEST (HOOKS) ***************\n");
+    ll_list *list = ll_create();
+    int x = 1;
+    instr_set_hooks(f_enter, f_exit);
+    ll_append(list, &x);
+    ll_get(list, 0);
+    ll_delete(list, 0);
+    instr_set_hooks(NULL, NULL);
+    printf("enter = %ld, exit = %ld, calls = %llu\n", n_enter, n_exit, (unsigned long long) list->stats.calls);
+    ll_destroy(list);
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return *((int *) new_data) < *((int *) old_data);
+}
+
+void f_enter(const char *func, void *container) {
+    printf("> %s\n", func);
+    n_enter++;
+}
+
+void f_exit(const char *func, void *container) {
+    printf("< %s\n", func);
+    n_exit++;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,153 @@
+/**
+ ****************************************************************
+ * @file            : instrument.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the (compile-time optional) instrumentation of lists and
+ *                      trees: per-container operation counters, timing histograms, and user hooks on entry and exit of
+ *                      public functions.
+ *                      (Note: Enabled by compiling with '-D_INSTRUMENT_' (and '-D_INSTRUMENT_TIMING_' for timing), and
+ *                      linking 'instrument.c'. Otherwise, all macros expand to nothing, and containers hold no counters.)
+ * **************************************************************
+ **/
+
+#ifndef _INSTRUMENT_H_
+#define _INSTRUMENT_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "shared_defs.h"
+
+/* ********************* #define SECTION ********************** */
+
+#ifdef _INSTRUMENT_
+
+/**
+ *  @brief      : No. of buckets of a timing histogram. Bucket 'b' counts the operations that took '2^b' to '2^(b+1) - 1'
+ *                  nanoseconds (the last bucket counts all longer ones).
+**/
+#define INSTR_BUCKETS               32
+
+/**
+ *  @brief      : Reset the counters of a container (on creation).
+**/
+#define INSTR_INIT(c)               memset(&(c)->stats, 0, sizeof(instr_stats))
+
+/**
+ *  @brief      : Increment a counter of a container (e.g: 'INSTR_COUNT(tree, rotations)').
+**/
+#define INSTR_COUNT(c, field)       ((void) (c)->stats.field++)
+
+/**
+ *  @brief      : Count one node traversed by the current operation of a container.
+**/
+#define INSTR_PATH(c)               ((void) (c)->stats.op_path++)
+
+/**
+ *  @brief      : Count a call of a comparison function, and evaluate to its result (e.g: 'if (INSTR_COMPARE(tree,
+ *                  f_compare(key, node->data)))').
+**/
+#define INSTR_COMPARE(c, call)      (INSTR_COUNT(c, compares), (call))
+
+/**
+ *  @brief      : Mark the entry to (and exit from) a public function of a container.
+**/
+#define INSTR_ENTER(c)              instr_enter(&(c)->stats, __func__, (void *) (c))
+#define INSTR_EXIT(c)               instr_exit(&(c)->stats, __func__, (void *) (c))
+
+/**
+ *  @brief      : Print the counters of a container.
+**/
+#define INSTR_DUMP(c, name, out)    instr_dump(&(c)->stats, name, out)
+
+#else
+
+#define INSTR_INIT(c)               ((void) 0)
+#define INSTR_COUNT(c, field)       ((void) 0)
+#define INSTR_PATH(c)               ((void) 0)
+#define INSTR_COMPARE(c, call)      (call)
+#define INSTR_ENTER(c)              ((void) 0)
+#define INSTR_EXIT(c)               ((void) 0)
+#define INSTR_DUMP(c, name, out)    ((void) 0)
+
+#endif
+
+/* ********************* struct(s) SECTION ********************** */
+
+#ifdef _INSTRUMENT_
+
+/**
+ *  @brief      : Counters of a container (embedded in it, as 'stats'). Only the outermost public function called counts
+ *                  as an operation (e.g: 'avl_pop_min' calling 'avl_delete' is one operation), while every call is
+ *                  passed to the hooks.
+**/
+typedef struct INSTR_STATS {
+    uint64_t calls;                                 /* no. of public function calls */
+    uint64_t ops;                                   /* no. of operations (outermost calls) */
+    uint64_t compares;                              /* no. of 'f_compare' calls */
+    uint64_t rotations;
+    uint64_t allocs;                                /* no. of nodes allocated */
+    uint64_t frees;                                 /* no. of nodes de-allocated */
+    uint64_t stack_pushes;                          /* no. of pushes onto a traversal stack (or queue) */
+    uint64_t path_length;                           /* no. of nodes traversed, over all operations */
+    uint64_t max_path_length;                       /* no. of nodes traversed, by the longest operation */
+    uint64_t op_path;                               /* no. of nodes traversed, by the current operation */
+    unsigned int depth;                             /* no. of nested public function calls */
+#ifdef _INSTRUMENT_TIMING_
+    uint64_t op_start;                              /* start time (ns) of the current operation */
+    uint64_t histogram[INSTR_BUCKETS];
+#endif
+} instr_stats;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Set the hooks called on entry to (and exit from) every public function of every list and tree, that
+ *                  receive the name of the function, and the container. Either may be NULL (default).
+ *                  (Note: Not thread-safe, should be set before any container is in use.)
+ *  @param      : [ Function called on entry. ]
+ *                [ Function called on exit. ]
+ *  @return     : None.
+**/
+void instr_set_hooks(void (*f_enter)(const char *func, void *container), void (*f_exit)(const char *func, void *container));
+
+/**
+ *  @brief      : (for internal use) Called on entry to a public function, through 'INSTR_ENTER'.
+ *  @param      : [ Counters. ]
+ *                [ Name of function. ]
+ *                [ Container. ]
+ *  @return     : None.
+**/
+void instr_enter(instr_stats *stats, const char *func, void *container);
+
+/**
+ *  @brief      : (for internal use) Called on exit from a public function, through 'INSTR_EXIT'.
+ *  @param      : [ Counters. ]
+ *                [ Name of function. ]
+ *                [ Container. ]
+ *  @return     : None.
+**/
+void instr_exit(instr_stats *stats, const char *func, void *container);
+
+/**
+ *  @brief      : Reset counters (outside any operation of their container).
+ *  @param      : [ Counters. ]
+ *  @return     : None.
+**/
+void instr_reset(instr_stats *stats);
+
+/**
+ *  @brief      : Print counters (and the non-empty buckets of the timing histogram, if enabled).
+ *  @param      : [ Counters. ]
+ *                [ Name to print them under. ]
+ *                [ Stream to print to (e.g: 'stdout'). ]
+ *  @return     : None.
+**/
+void instr_dump(instr_stats *stats, const char *name, FILE *out);
+
+#endif
+
+#endif
@@ -0,0 +1,332 @@
+/**
+ ****************************************************************
+ * @file            : interval_tree.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of an interval tree, an AVL tree of intervals augmented with the max. high endpoint
+ *                      of each subtree.
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#include "interval_tree.h"
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static void it_summarize(void *summary, DATA_TYPE data);
+static void it_combine(void *summary, const void *left, const void *right);
+
+/* ********************* static variable(s) SECTION ********************** */
+
+/**
+ *  @brief      : Augmentation of interval trees: the summary of intervals is their max. high endpoint (a 'long', and
+ *                  'LONG_MIN' for no intervals).
+**/
+static const long it_identity = LONG_MIN;
+static const avl_augment it_augment = {sizeof(long), it_summarize, it_combine, &it_identity};
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Create (dynamically, on heap) an interval tree, an AVL tree augmented by 'it_augment'.
+ *  @param      : [ Allocator (NULL for 'malloc'). ]
+ *  @return     : Pointer to tree (NULL on failure).
+**/
+avl_tree * it_create(alloc_allocator *allocator) {
+    return avl_create_augmented(&it_augment, allocator);
+}
+
+/**
+ *  @brief      : (for internal use) Sets the summary of an interval (its high endpoint).
+ *  @param      : [ Summary. ]
+ *                [ Interval. ]
+ *  @return     : None.
+**/
+static void it_summarize(void *summary, DATA_TYPE data) {
+    *((long *) summary) = ((it_interval *) data)->high;
+}
+
+/**
+ *  @brief      : (for internal use) Sets the summary of two ranges of intervals (the max. of their summaries).
+ *  @param      : [ Summary (may be either of the other two). ]
+ *                [ Summary of the left range. ]
+ *                [ Summary of the right range. ]
+ *  @return     : None.
+**/
+static void it_combine(void *summary, const void *left, const void *right) {
+    long l = *((const long *) left), r = *((const long *) right);
+    *((long *) summary) = l > r ? l : r;
+}
+
+/**
+ *  @brief      : Compare two intervals by their low endpoints.
+ *  @param      : [ New interval. ]
+ *                [ Interval of the current traverse node. ]
+ *  @return     : 1 if the new interval is on the left, else 0.
+**/
+unsigned char it_compare(DATA_TYPE new_data, DATA_TYPE old_data) {
+    return ((it_interval *) new_data)->low < ((it_interval *) old_data)->low ? 1 : 0;
+}
+
+/**
+ *  @brief      : Insert an interval into the tree, by 'avl_insert' (which keeps the summaries of its path correct).
+ *  @param      : [ Interval tree. ]
+ *                [ Interval. ]
+ *  @return     : None.
+**/
+void it_insert(avl_tree *tree, it_interval *interval) {
+    avl_insert(tree, interval, it_compare);
+}
+
+/**
+ *  @brief      : Delete an interval. Intervals of equal low endpoints are adjacent, starting at the rank of the interval
+ *                  (read '@brief' of 'avl_rank'), so they are scanned by index until the interval itself is met (then
+ *                  deleted at its index by 'avl_delete'), or one of another low endpoint is.
+ *  @param      : [ Interval tree. ]
+ *                [ Interval. ]
+ *  @return     : Interval deleted (NULL if not found).
+**/
+it_interval * it_delete(avl_tree *tree, it_interval *interval) {
+    for (LENGTH_DT i = avl_rank(tree, interval, it_compare); i < tree->length; i++) {
+        it_interval *data = (it_interval *) avl_get(tree, i);
+        if (data->low != interval->low) {
+            break;
+        }
+        if (data == interval) {
+            return (it_interval *) avl_delete(tree, i, it_compare);
+        }
+    }
+    return NULL;
+}
+
+/**
+ *  @brief      : Get the intervals that overlap a range, through in-order traversal (read '@brief' of 'avl_make_list'),
+ *                  pruned on both sides. A subtree whose max. high endpoint is below the low endpoint of the range holds
+ *                  no overlapping interval, so it is never pushed (nor descended). Once an interval popped has a low
+ *                  endpoint above the high endpoint of the range, so do all that follow it, so the traversal stops.
+ *                  Any other interval popped overlaps the range if its high endpoint is not below its low endpoint.
+ *                  A subtree is only descended if it holds an overlapping interval (the one of its max. high endpoint,
+ *                  unless past the range), so the nodes visited are the ancestors of those reported, and a path.
+ *  @param      : [ Interval tree. ]
+ *                [ Low endpoint of the range. ]
+ *                [ High endpoint of the range. ]
+ *  @return     : Pointer to list.
+**/
+ll_list * it_overlaps(avl_tree *tree, long low, long high) {
+    ll_list *list = ll_create();
+    ll_list *stack = ll_create();
+
+    if (tree->buffer_length != 0) { avl_flush(tree); }
+    avl_node *curr_node = tree->root;
+    while (curr_node != NULL || stack->length != 0) {
+        while (curr_node != NULL && *((long *) AVL_SUMMARY(curr_node)) >= low) {
+            ll_push(stack, curr_node);
+            curr_node = curr_node->lchild;
+        }
+        if (stack->length == 0) {
+            break;
+        }
+        curr_node = ll_pop(stack);
+        it_interval *interval = (it_interval *) curr_node->data;
+        if (interval->low > high) {
+            break;
+        }
+        if (interval->high >= low) {
+            ll_append(list, interval);
+        }
+        curr_node = curr_node->rchild;
+    }
+    ll_destroy(stack);
+    return list;
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_INTERVAL_TREE_             /* compile-time switch */
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+void t_overlaps();
+void t_max_high();
+unsigned char t_check(avl_tree *tree, long low, long high);
+
+int main() {
+    t_overlaps();
+    t_max_high();
+    return 0;
+}
+
+void t_overlaps() {
+    printf("*************** TEST (OVERLAPS) ***************\n");
+    avl_tree *tree = it_create(NULL);
+    it_interval arr_data[3000];
+    unsigned char is_correct = 1;
+    for (int i = 0; i < LEN(arr_data); i++) {
+        arr_data[i].low = (i * 7919) % 10000;
+        arr_data[i].high = arr_data[i].low + (i * 104729) % (i % 10 == 0 ? 2000 : 50);
+        it_insert(tree, arr_data + i);
+    }
+    ll_list *list = it_overlaps(tree, 5000, 5000), *none = it_overlaps(tree, -10, -1);
+    printf("Inserted -> length: %ld, stab(5000): %ld, none(-10, -1): %ld\n", (long) tree->length, (long) list->length,
+            (long) none->length);
+    ll_destroy(list);
+    ll_destroy(none);
+    for (int q = 0; q < 300; q++) {
+        long low = (q * 7919) % 10100 - 50;
+        is_correct &= t_check(tree, low, low + (q % 3 == 0 ? 0 : (q * 31) % 500));
+    }
+    printf("Overlaps -> correct: %d\n", is_correct);
+
+    LENGTH_DT deleted = 0;
+    for (int i = 0; i < LEN(arr_data); i += 3) {
+        deleted += it_delete(tree, arr_data + i) == arr_data + i;
+    }
+    it_interval missing = arr_data[0];
+    for (int q = 0; q < 300; q++) {
+        long low = (q * 7919) % 10100 - 50;
+        is_correct &= t_check(tree, low, low + (q % 3 == 0 ? 0 : (q * 31) % 500));
+    }
+    printf("Deleted: %ld -> length: %ld, missing: %s, correct: %d\n", (long) deleted, (long) tree->length,
+            it_delete(tree, &missing) == NULL ? "not found" : "found", is_correct);
+    avl_destroy(tree);
+}
+
+void t_max_high() {
+    printf("*************** TEST (MAX HIGH) ***************\n");
+    avl_tree *tree = it_create(NULL);
+    it_interval arr_data[2000], lo, hi;
+    unsigned char is_correct = 1;
+    long summary;
+    for (int i = 0; i < LEN(arr_data); i++) {
+        arr_data[i].low = (i * 7919) % 1000;
+        arr_data[i].high = arr_data[i].low + (i * 104729) % 300;
+        it_insert(tree, arr_data + i);
+        if (i % 4 == 3) { avl_pop_min(tree); }
+    }
+    DATA_TYPE *arr = (DATA_TYPE *) malloc(tree->length * sizeof(DATA_TYPE));
+    avl_make_array(tree, arr);
+    for (int q = 0; q < 200; q++) {
+        lo.low = (q * 7919) % 1100 - 50, hi.low = lo.low + (q * 31) % 200;
+        long expected = LONG_MIN;
+        for (LENGTH_DT i = 0; i < tree->length; i++) {
+            it_interval *interval = (it_interval *) arr[i];
+            if (interval->low >= lo.low && interval->low <= hi.low && interval->high > expected) {
+                expected = interval->high;
+            }
+        }
+        avl_reduce_range(tree, &lo, &hi, &summary, it_compare);
+        is_correct &= summary == expected;
+    }
+    lo.low = 0, hi.low = 999;
+    avl_reduce_range(tree, &lo, &hi, &summary, it_compare);
+    printf("Length: %ld, max. high: %ld, correct: %d\n", (long) tree->length, summary, is_correct);
+    free(arr);
+    avl_destroy(tree);
+}
+
+unsigned char t_check(avl_tree *tree, long low, long high) {
+    ll_list *list = it_overlaps(tree, low, high);
+    ll_list *all = avl_make_list(tree);
+    LENGTH_DT j = 0;
+    unsigned char is_correct = 1;
+    for (LENGTH_DT i = 0; i < all->length; i++) {
+        it_interval *interval = (it_interval *) ll_get(all, i);
+        if (interval->low <= high && interval->high >= low) {
+            is_correct &= j < list->length && ll_get(list, j++) == interval;
+        }
+    }
+    is_correct &= j == list->length;
+    ll_destroy(list);
+    ll_destroy(all);
+    return is_correct;
+}
+
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_INTERVAL_TREE_            /* compile-time switch */
+
+#include <time.h>
+
+double elapsed_ns(clock_t start, LENGTH_DT ops);
+
+/**
+ *  @brief      : Benchmark of range queries answered by summaries ('avl_reduce_range' for the max. high endpoint of
+ *                  intervals by low endpoint, and 'it_overlaps' for stabbing queries), against scanning all intervals.
+ *                  (Usage: <no. of intervals (default: 2^20)> <no. of queries (default: 2^16)>)
+**/
+int main(int argc, char *argv[]) {
+    LENGTH_DT n = argc > 1 ? atol(argv[1]) : 1L << 20;
+    LENGTH_DT m = argc > 2 ? atol(argv[2]) : 1L << 16;
+    LENGTH_DT m_scan = m / 256 + 1;
+    it_interval *arr_data = (it_interval *) malloc(n * sizeof(it_interval));
+    long *arr_points = (long *) malloc(m * sizeof(long));
+    uint64_t state = 88172645463325252ULL;
+    long checksum[2] = {0}, span = 100 * n;
+    clock_t start;
+
+    avl_tree *tree = it_create(NULL);
+    for (LENGTH_DT i = 0; i < n; i++) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        arr_data[i].low = (long) (state % span);
+        arr_data[i].high = arr_data[i].low + (long) (state >> 40) % 1000;
+        it_insert(tree, arr_data + i);
+    }
+    for (LENGTH_DT j = 0; j < m; j++) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        arr_points[j] = (long) (state % span);
+    }
+    DATA_TYPE *arr = (DATA_TYPE *) malloc(n * sizeof(DATA_TYPE));
+    avl_make_array(tree, arr);
+    printf("Intervals: %ld, queries: %ld (scans: %ld)\n", (long) n, (long) m, (long) m_scan);
+
+    start = clock();
+    for (LENGTH_DT j = 0; j < m; j++) {
+        it_interval lo = {arr_points[j], 0}, hi = {arr_points[j] + span / 10, 0};
+        long summary;
+        avl_reduce_range(tree, &lo, &hi, &summary, it_compare);
+        checksum[0] += j < m_scan ? summary : 0;
+    }
+    printf("avl_reduce_range (max. high):  %10.1f ns/query\n", elapsed_ns(start, m));
+    start = clock();
+    for (LENGTH_DT j = 0; j < m_scan; j++) {
+        long summary = LONG_MIN;
+        for (LENGTH_DT i = 0; i < n; i++) {
+            it_interval *interval = (it_interval *) arr[i];
+            if (interval->low >= arr_points[j] && interval->low <= arr_points[j] + span / 10
+                    && interval->high > summary) {
+                summary = interval->high;
+            }
+        }
+        checksum[1] += summary;
+    }
+    printf("scan (max. high):              %10.1f ns/query\n", elapsed_ns(start, m_scan));
+
+    start = clock();
+    for (LENGTH_DT j = 0; j < m; j++) {
+        ll_list *list = it_overlaps(tree, arr_points[j], arr_points[j]);
+        checksum[0] += j < m_scan ? list->length : 0;
+        ll_destroy(list);
+    }
+    printf("it_overlaps (stab):            %10.1f ns/query\n", elapsed_ns(start, m));
+    start = clock();
+    for (LENGTH_DT j = 0; j < m_scan; j++) {
+        for (LENGTH_DT i = 0; i < n; i++) {
+            it_interval *interval = (it_interval *) arr[i];
+            checksum[1] += interval->low <= arr_points[j] && interval->high >= arr_points[j];
+        }
+    }
+    printf("scan (stab):                   %10.1f ns/query\n", elapsed_ns(start, m_scan));
+    if (checksum[0] != checksum[1]) { printf("(checksum mismatch)\n"); }
+
+    avl_destroy(tree);
+    free(arr), free(arr_data), free(arr_points);
+    return 0;
+}
+
+double elapsed_ns(clock_t start, LENGTH_DT ops) {
+    return (double) (clock() - start) / CLOCKS_PER_SEC * 1e9 / ops;
+}
+
+#endif
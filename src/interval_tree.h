@@ -0,0 +1,80 @@
+/**
+ ****************************************************************
+ * @file            : interval_tree.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the implementation of an interval tree, an AVL tree of
+ *                      intervals (ordered by their low endpoints), augmented with the max. high endpoint of each subtree.
+ * **************************************************************
+ **/
+
+#ifndef _INTERVAL_TREE_H_
+#define _INTERVAL_TREE_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "shared_defs.h"
+#include "avl_tree.h"
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Interval structure (closed, so 'low' must not exceed 'high'). Items of an interval tree are pointers to
+ *                  intervals, which may be the first member of a larger structure of the user's.
+**/
+typedef struct IT_INTERVAL {
+    long low;
+    long high;
+} it_interval;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Create an interval tree (an augmented AVL tree, see 'avl_create_augmented'), whose summaries are the
+ *                  max. high endpoint of the intervals of each subtree. Any AVL tree function may be used on it (with
+ *                  'it_compare'), and 'avl_reduce_range' gives the max. high endpoint of intervals by low endpoint.
+ *                  (Note: Intervals must be inserted one per node, so not by 'avl_insert_multi'. It is de-allocated
+ *                  by 'avl_destroy'.)
+ *  @param      : [ Allocator (NULL for 'malloc'). ]
+ *  @return     : Pointer to tree (NULL on failure).
+**/
+avl_tree * it_create(alloc_allocator *allocator);
+
+/**
+ *  @brief      : Compare two intervals by their low endpoints (the order of an interval tree).
+ *  @param      : [ New interval. ]
+ *                [ Interval of the current traverse node. ]
+ *  @return     : 1 if the new interval is on the left (its low endpoint is smaller), else 0.
+**/
+unsigned char it_compare(DATA_TYPE new_data, DATA_TYPE old_data);
+
+/**
+ *  @brief      : Insert an interval into an interval tree (after those of equal low endpoints).
+ *  @param      : [ Interval tree. ]
+ *                [ Interval. ]
+ *  @return     : None.
+**/
+void it_insert(avl_tree *tree, it_interval *interval);
+
+/**
+ *  @brief      : Delete an interval (the very one, not an equal one) from an interval tree. If not found, returns NULL.
+ *  @param      : [ Interval tree. ]
+ *                [ Interval. ]
+ *  @return     : Interval deleted.
+**/
+it_interval * it_delete(avl_tree *tree, it_interval *interval);
+
+/**
+ *  @brief      : Get the intervals of an interval tree that overlap a range (share at least a point with it), in order
+ *                  of low endpoints, in O(log n + k) for 'k' overlapping intervals that are near each other in that
+ *                  order (e.g: when stabbing short intervals at a point), and in O(k log n) at worst.
+ *  @param      : [ Interval tree. ]
+ *                [ Low endpoint of the range. ]
+ *                [ High endpoint of the range (a point, if equal to the low endpoint). ]
+ *  @return     : Pointer to list of intervals.
+**/
+ll_list * it_overlaps(avl_tree *tree, long low, long high);
+
+#endif
@@ -0,0 +1,680 @@
+/**
+ ****************************************************************
+ * @file            : intrusive_avl_tree.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of an intrusive AVL Binary Search Tree (BST).
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#include "intrusive_avl_tree.h"
+#include "linked_list.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Macro definitions of the side of a parent a subtree is on.
+**/
+#define LEFT        1
+#define RIGHT       0
+
+/**
+ *  @brief      : Macro definitions of possible balance values (e.g: 'LHIGH' means Left-side higher by one).
+**/
+#define BAL         0
+#define LHIGH       1
+#define RHIGH       -1
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static void iavl_replace_child(iavl_tree *tree, iavl_hook *parent, iavl_hook *old_child, iavl_hook *new_child);
+static LENGTH_DT iavl_height(iavl_tree *tree);
+
+static iavl_hook * left_balance_insert(iavl_tree *tree, iavl_hook *hook);
+static iavl_hook * left_balance_delete(iavl_tree *tree, iavl_hook *hook, unsigned char *signal);
+static iavl_hook * right_balance_insert(iavl_tree *tree, iavl_hook *hook);
+static iavl_hook * right_balance_delete(iavl_tree *tree, iavl_hook *hook, unsigned char *signal);
+static iavl_hook * rotate_left(iavl_tree *tree, iavl_hook *hook);
+static iavl_hook * rotate_right(iavl_tree *tree, iavl_hook *hook);
+
+static void putchar_n(char c, unsigned int n);
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Create (dynamically, on heap) and intialize an intrusive AVL tree, and return a pointer to it.
+ *                  (Note: This is the only allocation an intrusive tree makes, hooks are owned by the user.)
+ *  @param      : None.
+ *  @return     : Pointer to tree.
+**/
+iavl_tree * iavl_create() {
+    iavl_tree *new_tree = (iavl_tree *) malloc(sizeof(iavl_tree));
+    new_tree->length = 0, new_tree->root = NULL;
+    return new_tree;
+}
+
+/**
+ *  @brief      : (for internal use) Make a parent point to a new child, in place of an old one. If the parent is NULL,
+ *                  the old child is the root, and the root is replaced instead.
+ *  @param      : [ Tree. ]
+ *                [ Parent (may be NULL). ]
+ *                [ Old child. ]
+ *                [ New child (may be NULL). ]
+ *  @return     : None.
+**/
+static void iavl_replace_child(iavl_tree *tree, iavl_hook *parent, iavl_hook *old_child, iavl_hook *new_child) {
+    if (parent == NULL) {
+        tree->root = new_child;
+    } else if (parent->lchild == old_child) {
+        parent->lchild = new_child;
+    } else {
+        parent->rchild = new_child;
+    }
+}
+
+/**
+ *  @brief      : Inserts a new hook into the tree, balancing the tree thereafter (AVL BST style). The tree is traversed
+ *                  like a sorted binary tree, until a NULL child is reached, where the hook is linked. Then, the path is
+ *                  traced back through the parent pointers, adjusting balances, until a subtree's height is unchanged,
+ *                  or it is rebalanced.
+ *                  (Note: AVL insertion algorithm is complex, and demands a reference to understand.)
+ *  @param      : [ Tree. ]
+ *                [ Hook to insert. ]
+ *                [ Function that receives the new hook and the hook of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : None.
+**/
+void iavl_insert(iavl_tree *tree, iavl_hook *hook, unsigned char (*f_compare)(iavl_hook *new_hook, iavl_hook *old_hook)) {
+    iavl_hook *parent = NULL;
+    iavl_hook **child_ptr = &tree->root;
+
+    while (*child_ptr != NULL) {
+        parent = *child_ptr;
+        if (f_compare(hook, parent)) {
+            child_ptr = &parent->lchild;
+        } else {
+            child_ptr = &parent->rchild;
+        }
+    }
+    hook->lchild = hook->rchild = NULL;
+    hook->parent = parent, hook->balance = BAL;
+    *child_ptr = hook;
+    tree->length++;
+
+    while (parent != NULL) {
+        if (parent->lchild == hook) {
+            if (parent->balance == RHIGH) {
+                parent->balance = BAL;
+                break;
+            } else if (parent->balance == BAL) {
+                parent->balance = LHIGH;
+            } else {
+                left_balance_insert(tree, parent);                  /* 2x LHIGH */
+                break;
+            }
+        } else {
+            if (parent->balance == LHIGH) {
+                parent->balance = BAL;
+                break;
+            } else if (parent->balance == BAL) {
+                parent->balance = RHIGH;
+            } else {
+                right_balance_insert(tree, parent);                 /* 2x RHIGH */
+                break;
+            }
+        }
+        hook = parent;
+        parent = parent->parent;
+    }
+}
+
+/**
+ *  @brief      : Removes a hook from the tree, balancing the tree thereafter (AVL BST style). Three cases are adhered to:
+ *                  No children, one child, and two children. In the last case, the next in-order hook is unlinked from
+ *                  its position, and put in the position of the removed hook (hooks are relinked, since no data can be
+ *                  copied between them). Then, the path is traced back from the parent of the position that lost
+ *                  height, through the parent pointers, adjusting balances and rebalancing.
+ *                  (Note: AVL deletion algorithm is complex, and demands a reference to understand.)
+ *  @param      : [ Tree. ]
+ *                [ Hook to remove. ]
+ *  @return     : None.
+**/
+void iavl_remove(iavl_tree *tree, iavl_hook *hook) {
+    iavl_hook *parent;
+    unsigned char side, signal;
+
+    if (hook->lchild != NULL && hook->rchild != NULL) {                     /* Case: Two children. */
+        iavl_hook *next_hook = hook->rchild;                    /* get next in-order */
+        while (next_hook->lchild != NULL) {
+            next_hook = next_hook->lchild;
+        }
+        if (next_hook->parent == hook) {
+            parent = next_hook, side = RIGHT;
+        } else {
+            parent = next_hook->parent, side = LEFT;
+            parent->lchild = next_hook->rchild;
+            if (next_hook->rchild != NULL) { next_hook->rchild->parent = parent; }
+            next_hook->rchild = hook->rchild;
+            hook->rchild->parent = next_hook;
+        }
+        next_hook->lchild = hook->lchild;
+        hook->lchild->parent = next_hook;
+        next_hook->balance = hook->balance;
+        next_hook->parent = hook->parent;
+        iavl_replace_child(tree, hook->parent, hook, next_hook);
+    } else {                                                                /* Case: One or no children. */
+        iavl_hook *child = hook->lchild != NULL ? hook->lchild : hook->rchild;
+        parent = hook->parent;
+        side = (parent != NULL && parent->lchild == hook) ? LEFT : RIGHT;
+        iavl_replace_child(tree, parent, hook, child);
+        if (child != NULL) { child->parent = parent; }
+    }
+    hook->lchild = hook->rchild = hook->parent = NULL;
+    tree->length--;
+
+    while (parent != NULL) {
+        iavl_hook *grand_parent = parent->parent;               /* determined before any rotation */
+        unsigned char parent_side = (grand_parent != NULL && grand_parent->lchild == parent) ? LEFT : RIGHT;
+        if (side == LEFT) {
+            if (parent->balance == BAL) {
+                parent->balance = RHIGH;
+                break;
+            } else if (parent->balance == LHIGH) {
+                parent->balance = BAL;
+            } else {                                                /* 2x RHIGH */
+                signal = 0;
+                right_balance_delete(tree, parent, &signal);
+                if (signal) {
+                    break;
+                }
+            }
+        } else {
+            if (parent->balance == BAL) {
+                parent->balance = LHIGH;
+                break;
+            } else if (parent->balance == RHIGH) {
+                parent->balance = BAL;
+            } else {                                                /* 2x LHIGH */
+                signal = 0;
+                left_balance_delete(tree, parent, &signal);
+                if (signal) {
+                    break;
+                }
+            }
+        }
+        parent = grand_parent;
+        side = parent_side;
+    }
+}
+
+/**
+ *  @brief      : Balance a 2x LHIGH hook in an AVL tree (for deletion).
+ *  @param      : [ Tree. ]
+ *                [ Hook to rebalance. ]
+ *                [ Signal, set if the height of the subtree is unchanged. ]
+ *  @return     : [ Hook after rebalancing (may not be the same hook). ]
+**/
+static iavl_hook * left_balance_delete(iavl_tree *tree, iavl_hook *hook, unsigned char *signal) {
+    iavl_hook *lsub, *lrsub;
+    lsub = hook->lchild;
+    switch (lsub->balance) {
+        case LHIGH:                                                 /* single rotation */
+            hook->balance = BAL;
+            lsub->balance = BAL;
+            hook = rotate_right(tree, hook);
+            break;
+        case BAL:                                                   /* single rotation */
+            hook->balance = LHIGH;
+            lsub->balance = RHIGH;
+            hook = rotate_right(tree, hook);
+            *signal = 1;               /* height unchanged */
+            break;
+        case RHIGH:                                                 /* double rotation */
+            lrsub = lsub->rchild;
+            switch(lrsub->balance) {
+                case LHIGH:
+                    hook->balance = RHIGH;
+                    lsub->balance = BAL;
+                    break;
+                case BAL:
+                    hook->balance = BAL;
+                    lsub->balance = BAL;
+                    break;
+                case RHIGH:
+                    hook->balance = BAL;
+                    lsub->balance = LHIGH;
+                    break;
+            }
+            lrsub->balance = BAL;
+            rotate_left(tree, lsub);
+            hook = rotate_right(tree, hook);
+            break;
+    }
+    return hook;
+}
+
+/**
+ *  @brief      : Balance a 2x RHIGH hook in an AVL tree (for deletion).
+ *  @param      : [ Tree. ]
+ *                [ Hook to rebalance. ]
+ *                [ Signal, set if the height of the subtree is unchanged. ]
+ *  @return     : [ Hook after rebalancing (may not be the same hook). ]
+**/
+static iavl_hook * right_balance_delete(iavl_tree *tree, iavl_hook *hook, unsigned char *signal) {
+    iavl_hook *rsub, *rlsub;
+    rsub = hook->rchild;
+    switch (rsub->balance) {
+        case RHIGH:                                                 /* single rotation */
+            hook->balance = BAL;
+            rsub->balance = BAL;
+            hook = rotate_left(tree, hook);
+            break;
+        case BAL:                                                   /* single rotation */
+            hook->balance = RHIGH;
+            rsub->balance = LHIGH;
+            hook = rotate_left(tree, hook);
+            *signal = 1;                /* height unchanged */
+            break;
+        case LHIGH:                                                 /* double rotation */
+            rlsub = rsub->lchild;
+            switch(rlsub->balance) {
+                case RHIGH:
+                    hook->balance = LHIGH;
+                    rsub->balance = BAL;
+                    break;
+                case BAL:
+                    hook->balance = BAL;
+                    rsub->balance = BAL;
+                    break;
+                case LHIGH:
+                    hook->balance = BAL;
+                    rsub->balance = RHIGH;
+                    break;
+            }
+            rlsub->balance = BAL;
+            rotate_right(tree, rsub);
+            hook = rotate_left(tree, hook);
+            break;
+    }
+    return hook;
+}
+
+/**
+ *  @brief      : Balance a 2x LHIGH hook in an AVL tree (for insertion).
+ *  @param      : [ Tree. ]
+ *                [ Hook to rebalance. ]
+ *  @return     : [ Hook after rebalancing (may not be the same hook). ]
+**/
+static iavl_hook * left_balance_insert(iavl_tree *tree, iavl_hook *hook) {
+    iavl_hook *lsub, *lrsub;
+    lsub = hook->lchild;
+    switch (lsub->balance) {
+        case LHIGH:                                                 /* single rotation */
+            hook->balance = BAL;
+            lsub->balance = BAL;
+            hook = rotate_right(tree, hook);
+            break;
+        case RHIGH:                                                 /* double rotation */
+            lrsub = lsub->rchild;
+            switch(lrsub->balance) {
+                case LHIGH:
+                    hook->balance = RHIGH;
+                    lsub->balance = BAL;
+                    break;
+                case BAL:
+                    hook->balance = BAL;
+                    lsub->balance = BAL;
+                    break;
+                case RHIGH:
+                    hook->balance = BAL;
+                    lsub->balance = LHIGH;
+                    break;
+            }
+            lrsub->balance = BAL;
+            rotate_left(tree, lsub);
+            hook = rotate_right(tree, hook);
+            break;
+    }
+    return hook;
+}
+
+/**
+ *  @brief      : Balance a 2x RHIGH hook in an AVL tree (for insertion).
+ *  @param      : [ Tree. ]
+ *                [ Hook to rebalance. ]
+ *  @return     : [ Hook after rebalancing (may not be the same hook). ]
+**/
+static iavl_hook * right_balance_insert(iavl_tree *tree, iavl_hook *hook) {
+    iavl_hook *rsub, *rlsub;
+    rsub = hook->rchild;
+    switch (rsub->balance) {
+        case RHIGH:                                                 /* single rotation */
+            hook->balance = BAL;
+            rsub->balance = BAL;
+            hook = rotate_left(tree, hook);
+            break;
+        case LHIGH:                                                 /* double rotation */
+            rlsub = rsub->lchild;
+            switch(rlsub->balance) {
+                case RHIGH:
+                    hook->balance = LHIGH;
+                    rsub->balance = BAL;
+                    break;
+                case BAL:
+                    hook->balance = BAL;
+                    rsub->balance = BAL;
+                    break;
+                case LHIGH:
+                    hook->balance = BAL;
+                    rsub->balance = RHIGH;
+                    break;
+            }
+            rlsub->balance = BAL;
+            rotate_right(tree, rsub);
+            hook = rotate_left(tree, hook);
+            break;
+    }
+    return hook;
+}
+
+/**
+ *  @brief      : Left rotation (AVL BST terminology). Parent pointers are updated, and the rotated subtree is linked
+ *                  to the parent of the hook (or set as the root).
+ *  @param      : [ Tree. ]
+ *                [ Hook to rotate. ]
+ *  @return     : [ Hook after rotation (may not be the same hook). ]
+**/
+static iavl_hook * rotate_left(iavl_tree *tree, iavl_hook *hook) {
+    iavl_hook *tmp = hook->rchild;
+    hook->rchild = tmp->lchild;
+    if (tmp->lchild != NULL) { tmp->lchild->parent = hook; }
+    tmp->parent = hook->parent;
+    iavl_replace_child(tree, hook->parent, hook, tmp);
+    tmp->lchild = hook;
+    hook->parent = tmp;
+    return tmp;
+}
+
+/**
+ *  @brief      : Right rotation (AVL BST terminology). Parent pointers are updated, and the rotated subtree is linked
+ *                  to the parent of the hook (or set as the root).
+ *  @param      : [ Tree. ]
+ *                [ Hook to rotate. ]
+ *  @return     : [ Hook after rotation (may not be the same hook). ]
+**/
+static iavl_hook * rotate_right(iavl_tree *tree, iavl_hook *hook) {
+    iavl_hook *tmp = hook->lchild;
+    hook->lchild = tmp->rchild;
+    if (tmp->rchild != NULL) { tmp->rchild->parent = hook; }
+    tmp->parent = hook->parent;
+    iavl_replace_child(tree, hook->parent, hook, tmp);
+    tmp->rchild = hook;
+    hook->parent = tmp;
+    return tmp;
+}
+
+/**
+ *  @brief      : Get the first (left-most) hook in a tree.
+ *  @param      : [ Tree. ]
+ *  @return     : Pointer to hook, or NULL if tree is empty.
+**/
+iavl_hook * iavl_first(iavl_tree *tree) {
+    iavl_hook *hook = tree->root;
+    if (hook != NULL) {
+        while (hook->lchild != NULL) { hook = hook->lchild; }
+    }
+    return hook;
+}
+
+/**
+ *  @brief      : Get the last (right-most) hook in a tree.
+ *  @param      : [ Tree. ]
+ *  @return     : Pointer to hook, or NULL if tree is empty.
+**/
+iavl_hook * iavl_last(iavl_tree *tree) {
+    iavl_hook *hook = tree->root;
+    if (hook != NULL) {
+        while (hook->rchild != NULL) { hook = hook->rchild; }
+    }
+    return hook;
+}
+
+/**
+ *  @brief      : Get the next (in-order) hook. It is the left-most hook of the right subtree, if any, otherwise,
+ *                  the first ancestor that the hook is in the left subtree of.
+ *  @param      : [ Hook. ]
+ *  @return     : Pointer to hook, or NULL if it is the last.
+**/
+iavl_hook * iavl_next(iavl_hook *hook) {
+    if (hook->rchild != NULL) {
+        hook = hook->rchild;
+        while (hook->lchild != NULL) { hook = hook->lchild; }
+        return hook;
+    }
+    while (hook->parent != NULL && hook->parent->rchild == hook) {
+        hook = hook->parent;
+    }
+    return hook->parent;
+}
+
+/**
+ *  @brief      : Get the previous (in-order) hook. It is the right-most hook of the left subtree, if any, otherwise,
+ *                  the first ancestor that the hook is in the right subtree of.
+ *  @param      : [ Hook. ]
+ *  @return     : Pointer to hook, or NULL if it is the first.
+**/
+iavl_hook * iavl_prev(iavl_hook *hook) {
+    if (hook->lchild != NULL) {
+        hook = hook->lchild;
+        while (hook->rchild != NULL) { hook = hook->rchild; }
+        return hook;
+    }
+    while (hook->parent != NULL && hook->parent->lchild == hook) {
+        hook = hook->parent;
+    }
+    return hook->parent;
+}
+
+/**
+ *  @brief      : (for internal use) Get the height of a tree, descending along the higher side of each hook,
+ *                  as indicated by its balance.
+ *  @param      : [ Tree. ]
+ *  @return     : Height of tree.
+**/
+static LENGTH_DT iavl_height(iavl_tree *tree) {
+    LENGTH_DT height = 0;
+    iavl_hook *hook = tree->root;
+    while (hook != NULL) {
+        height++;
+        hook = hook->balance == RHIGH ? hook->rchild : hook->lchild;
+    }
+    return height;
+}
+
+/**
+ *  @brief      : Removes all hooks in a tree, by resetting the tree root pointer and length. The hooks themselves are
+ *                  left as is, and are re-initialized when inserted again.
+ *  @param      : [ Tree. ]
+ *  @return     : None.
+**/
+void iavl_delete_all(iavl_tree *tree) {
+    tree->root = NULL, tree->length = 0;
+}
+
+/**
+ *  @brief      : Deletes the tree itself. The structures containing the hooks are not de-allocated.
+ *  @param      : [ Tree. ]
+ *  @return     : None.
+**/
+void iavl_destroy(iavl_tree *tree) {
+    free(tree);
+}
+
+/**
+ *  @brief      : Prints a tree, level-by-level, like 'avl_print'. 'f_print' receives each hook (the user gets its
+ *                  structure through 'iavl_entry'), and must print it to be of a consistent no. of chars.
+ *                  'unit_size' is the fixed no. of chars 'f_print' uses.
+ *  @param      : [ Tree to print. ]
+ *                [ Function that is passed each hook. ]
+ *                [ Unit size (no. of chars) of each 'f_print' call. ]
+ *  @return     : None.
+**/
+void iavl_print(iavl_tree *tree, void (*f_print)(iavl_hook *hook), unsigned char unit_size) {
+    LENGTH_DT height = iavl_height(tree);
+    ll_list *queue = ll_create();
+    iavl_hook *hook = NULL;
+    unsigned int factor = 0;
+    LENGTH_DT fixed_length;
+
+    for (int i = 1; i < height; i++) { factor = factor * 2 + 1; }
+    ll_enqueue(queue, tree->root);
+    while (height-- != 0) {
+        fixed_length = queue->length;
+        while (fixed_length-- != 0) {
+            hook = ll_dequeue(queue);
+            if (hook != NULL) {
+                putchar_n(' ', factor*unit_size);
+                f_print(hook);
+                putchar_n(' ', (factor+1)*unit_size);
+                ll_enqueue(queue, hook->lchild);
+                ll_enqueue(queue, hook->rchild);
+            } else {
+                putchar_n(' ', ((factor + 1) << 1)*unit_size);
+                ll_enqueue(queue, NULL);
+                ll_enqueue(queue, NULL);
+            }
+        }
+        factor = (factor - 1) >> 1;
+        putchar('\n');
+    }
+    ll_destroy(queue);
+}
+
+/**
+ *  @brief      : Prints a 'char' a repeated number of times.
+ *  @param      : [ 'char' to print. ]
+ *                [ Number of repitions. ]
+ *  @return     : None.
+**/
+static void putchar_n(char c, unsigned int n) {
+    while (n-- > 0) { putchar(c); }
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_INTRUSIVE_AVL_TREE_        /* compile-time switch */
+
+#include "intrusive_list.h"
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+typedef struct ITEM {
+    int key;
+    iavl_hook by_key;
+    iavl_hook by_key_desc;
+    il_hook in_list;
+} item;
+
+unsigned char f_compare(iavl_hook *new_hook, iavl_hook *old_hook);
+unsigned char f_compare_desc(iavl_hook *new_hook, iavl_hook *old_hook);
+void f_print(iavl_hook *hook);
+void f_print_desc(iavl_hook *hook);
+
+void t_insert();
+void t_remove();
+void t_iterate();
+
+int main() {
+    t_insert();
+    t_remove();
+    t_iterate();
+    return 0;
+}
+
+void t_insert() {
+    printf("*************** TEST (INSERT) ***************\n");
+    iavl_tree *tree = iavl_create();
+    item arr_data1[] = {{1}, {2}, {3}, {4}, {5}, {6}, {7}};
+    for (int i = 0; i < LEN(arr_data1); i++) {
+        printf("Inserting: %d\n", arr_data1[i].key);
+        iavl_insert(tree, &arr_data1[i].by_key, f_compare);
+        iavl_print(tree, f_print, 4);
+    }
+    iavl_delete_all(tree);
+    printf("\n!!!!!!!!!!!!!!!! All deleted. !!!!!!!!!!!!!!!!\n\n");
+    item arr_data2[] = {{2}, {1}, {5}, {4}, {6}, {3}};
+    for (int i = 0; i < LEN(arr_data2); i++) {
+        printf("Inserting: %d\n", arr_data2[i].key);
+        iavl_insert(tree, &arr_data2[i].by_key, f_compare);
+        iavl_print(tree, f_print, 4);
+    }
+    iavl_destroy(tree);
+}
+
+void t_remove() {
+    printf("*************** TEST (REMOVE) ***************\n");
+    iavl_tree *tree = iavl_create();
+    item arr_data[] = {{1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}, {9}, {10}, {11}, {12}, {13}, {14}, {15}};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        iavl_insert(tree, &arr_data[i].by_key, f_compare);
+    }
+    iavl_print(tree, f_print, 4);
+    int arr_remove[] = {7, 8, 6, 5, 0, 9, 1, 3, 4, 10, 14, 2, 13, 12, 11};
+    for (int i = 0; i < LEN(arr_remove); i++) {
+        printf("Removing: %d\n", arr_data[arr_remove[i]].key);
+        iavl_remove(tree, &arr_data[arr_remove[i]].by_key);
+        iavl_print(tree, f_print, 4);
+    }
+    iavl_destroy(tree);
+}
+
+void t_iterate() {
+    printf("*************** TEST (ITERATE, TWO TREES AND A LIST) ***************\n");
+    iavl_tree *asc = iavl_create();
+    iavl_tree *desc = iavl_create();
+    il_list *list = il_create();
+    item arr_data[] = {{4}, {9}, {1}, {7}, {3}, {8}, {2}};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        iavl_insert(asc, &arr_data[i].by_key, f_compare);
+        iavl_insert(desc, &arr_data[i].by_key_desc, f_compare_desc);
+        il_append(list, &arr_data[i].in_list);
+    }
+    iavl_hook *hook;
+    iavl_for_each(hook, asc) { f_print(hook); }
+    putchar('\n');
+    iavl_for_each(hook, desc) { f_print_desc(hook); }
+    putchar('\n');
+    for (hook = iavl_last(asc); hook != NULL; hook = iavl_prev(hook)) { f_print(hook); }
+    putchar('\n');
+    printf("Removing: 7 (from ascending tree and list only)\n");
+    iavl_remove(asc, &arr_data[3].by_key);
+    il_remove(list, &arr_data[3].in_list);
+    iavl_for_each(hook, asc) { f_print(hook); }
+    putchar('\n');
+    iavl_for_each(hook, desc) { f_print_desc(hook); }
+    putchar('\n');
+    il_hook *list_hook;
+    il_for_each(list_hook, list) { printf("[%2d]", il_entry(list_hook, item, in_list)->key); }
+    putchar('\n');
+    iavl_destroy(asc);
+    iavl_destroy(desc);
+    il_destroy(list);
+}
+
+unsigned char f_compare(iavl_hook *new_hook, iavl_hook *old_hook) {
+    return iavl_entry(new_hook, item, by_key)->key < iavl_entry(old_hook, item, by_key)->key ? 1 : 0;
+}
+
+unsigned char f_compare_desc(iavl_hook *new_hook, iavl_hook *old_hook) {
+    return iavl_entry(new_hook, item, by_key_desc)->key > iavl_entry(old_hook, item, by_key_desc)->key ? 1 : 0;
+}
+
+void f_print(iavl_hook *hook) {
+    printf("[%2d]", iavl_entry(hook, item, by_key)->key);
+}
+
+void f_print_desc(iavl_hook *hook) {
+    printf("[%2d]", iavl_entry(hook, item, by_key_desc)->key);
+}
+
+#endif
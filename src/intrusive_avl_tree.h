@@ -0,0 +1,130 @@
+/**
+ ****************************************************************
+ * @file            : intrusive_avl_tree.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the implementation of an intrusive AVL Binary Search Tree (BST).
+ * **************************************************************
+ **/
+
+#ifndef _INTRUSIVE_AVL_TREE_H_
+#define _INTRUSIVE_AVL_TREE_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "shared_defs.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Get a pointer to the user's structure, from a pointer to the hook embedded in it.
+**/
+#define iavl_entry(hook, type, member)  CONTAINER_OF(hook, type, member)
+
+/**
+ *  @brief      : Iterate over each hook in a tree, in-order (left-to-right). The current hook must not be removed
+ *                  within the loop.
+**/
+#define iavl_for_each(hook, tree)       for ((hook) = iavl_first(tree); (hook) != NULL; (hook) = iavl_next(hook))
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Hook structure, embedded by the user in the structure to be stored (one hook per tree it is in).
+ *                  (Note: The parent pointer allows removal and iteration, given the hook alone.)
+**/
+typedef struct IAVL_HOOK {
+    struct IAVL_HOOK *lchild;
+    struct IAVL_HOOK *rchild;
+    struct IAVL_HOOK *parent;
+    signed char balance;
+} iavl_hook;
+
+/**
+ *  @brief      : Tree structure.
+**/
+typedef struct IAVL_TREE {
+    iavl_hook *root;
+    LENGTH_DT length;
+} iavl_tree;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Create and intialize an intrusive AVL tree, and return a pointer to it.
+ *  @param      : None.
+ *  @return     : Pointer to tree.
+**/
+iavl_tree * iavl_create();
+
+/**
+ *  @brief      : Insert a hook in a tree, and balance (AVL BST insertion).
+ *  @param      : [ Tree. ]
+ *                [ Hook to insert (must not be in this tree already). ]
+ *                [ Function that receives the new hook and the hook of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : None.
+**/
+void iavl_insert(iavl_tree *tree, iavl_hook *hook, unsigned char (*f_compare)(iavl_hook *new_hook, iavl_hook *old_hook));
+
+/**
+ *  @brief      : Remove a hook from the tree it is in, and balance (AVL BST deletion). Needs no comparisons.
+ *  @param      : [ Tree. ]
+ *                [ Hook to remove. ]
+ *  @return     : None.
+**/
+void iavl_remove(iavl_tree *tree, iavl_hook *hook);
+
+/**
+ *  @brief      : Get the first (left-most) hook in a tree.
+ *  @param      : [ Tree. ]
+ *  @return     : Pointer to hook, or NULL if tree is empty.
+**/
+iavl_hook * iavl_first(iavl_tree *tree);
+
+/**
+ *  @brief      : Get the last (right-most) hook in a tree.
+ *  @param      : [ Tree. ]
+ *  @return     : Pointer to hook, or NULL if tree is empty.
+**/
+iavl_hook * iavl_last(iavl_tree *tree);
+
+/**
+ *  @brief      : Get the next (in-order) hook.
+ *  @param      : [ Hook. ]
+ *  @return     : Pointer to hook, or NULL if it is the last.
+**/
+iavl_hook * iavl_next(iavl_hook *hook);
+
+/**
+ *  @brief      : Get the previous (in-order) hook.
+ *  @param      : [ Hook. ]
+ *  @return     : Pointer to hook, or NULL if it is the first.
+**/
+iavl_hook * iavl_prev(iavl_hook *hook);
+
+/**
+ *  @brief      : Removes all hooks in a tree (resets a tree). The structures containing them are not de-allocated.
+ *  @param      : [ Tree. ]
+ *  @return     : None.
+**/
+void iavl_delete_all(iavl_tree *tree);
+
+/**
+ *  @brief      : De-allocates a tree. The structures containing the hooks are not de-allocated.
+ *  @param      : [ Tree. ]
+ *  @return     : None.
+**/
+void iavl_destroy(iavl_tree *tree);
+
+/**
+ *  @brief      : Prints a tree, level-by-level.
+ *  @param      : [ Tree. ]
+ *                [ Function that is passed each hook. ]
+ *                [ Unit size (no. of chars) of each 'f_print' call. ]
+ *  @return     : None.
+**/
+void iavl_print(iavl_tree *tree, void (*f_print)(iavl_hook *hook), unsigned char unit_size);
+
+#endif
@@ -0,0 +1,305 @@
+/**
+ ****************************************************************
+ * @file            : intrusive_list.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of an intrusive (doubly) linked list, with stack and queue functions.
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#include "intrusive_list.h"
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static il_hook * il_get_hook(il_list *list, LENGTH_DT i);
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Allocating dynamic memory for a list structure, initializing and returning the pointer.
+ *                  (Note: This is the only allocation an intrusive list makes, hooks are owned by the user.)
+ *  @param      : None.
+ *  @return     : Pointer to the dynamically allocated list.
+**/
+il_list * il_create() {
+    il_list *new_list = (il_list *) malloc(sizeof(il_list));
+    new_list->length = 0, new_list->head = NULL, new_list->tail = NULL;
+    return new_list;
+}
+
+/**
+ *  @brief      : (For internal use) Get the hook at an index in the list, traversing from the nearer end.
+ *                  Does not perform any checking on the index. Assumes it is correct.
+ *  @param      : [ List to search in. ]
+ *                [ Index to use. ]
+ *  @return     : Pointer to the hook.
+**/
+static il_hook * il_get_hook(il_list *list, LENGTH_DT i) {
+    il_hook *hook;
+    if (i < list->length / 2) {
+        hook = list->head;
+        for (LENGTH_DT j = 0; j < i; j++) {
+            hook = hook->next;
+        }
+    } else {
+        hook = list->tail;
+        for (LENGTH_DT j = list->length - 1; j > i; j--) {
+            hook = hook->prev;
+        }
+    }
+    return hook;
+}
+
+/**
+ *  @brief      : Get the hook at an index in the list. If fails, because index is out of bounds, then, return NULL.
+ *                  (Note: Allows negative indexing if LENGTH_DT is signed.)
+ *  @param      : [ List to search in. ]
+ *                [ Index to use. ]
+ *  @return     : Pointer to hook.
+**/
+il_hook * il_get(il_list *list, LENGTH_DT i) {
+    if (i < 0) { i += list->length; }                    /* to allow reverse indexing */
+
+    if (i >= 0 && i < list->length) {
+        return il_get_hook(list, i);
+    }
+    return NULL;
+}
+
+/**
+ *  @brief      : Inserting hook at a specific index. It will occupy that index, and shift any other hooks to the right.
+ *                  Insertion at the end is an append, otherwise, the hook is linked before the hook at that index.
+ *                  If index is out of bounds, insertion does not happen.
+ *  @param      : [ List to work with. ]
+ *                [ Hook to insert. ]
+ *                [ Index to insert at. ]
+ *  @return     : None.
+**/
+void il_insert(il_list *list, il_hook *hook, LENGTH_DT i) {
+    if (i == list->length) {                                /* Case: Inserting at end of list (or list empty). */
+        il_append(list, hook);
+    } else if (i == 0) {                                    /* Case: Inserting at beginning of list. */
+        il_prepend(list, hook);
+    } else if (i > 0 && i < list->length) {                 /* Case: Inserting anywhere else. */
+        il_hook *next_hook = il_get_hook(list, i);
+        hook->next = next_hook;
+        hook->prev = next_hook->prev;
+        next_hook->prev->next = hook;
+        next_hook->prev = hook;
+        list->length++;
+    }
+}
+
+/**
+ *  @brief      : Deleting (unlinking) the hook at a specific index. Index must be already existing, otherwise deletion
+ *                  is not done, and NULL is returned.
+ *  @param      : [ List to delete from. ]
+ *                [ Index to work with. ]
+ *  @return     : Pointer to hook.
+**/
+il_hook * il_delete(il_list *list, LENGTH_DT i) {
+    if (i >= 0 && i < list->length) {
+        il_hook *hook = il_get_hook(list, i);
+        il_remove(list, hook);
+        return hook;
+    }
+    return NULL;
+}
+
+/**
+ *  @brief      : Remove (unlink) a hook, given the hook itself, in constant time. The neighbours (or the list's head
+ *                  or tail, if at either end) are linked to each other. The hook's pointers are reset.
+ *  @param      : [ List the hook is in. ]
+ *                [ Hook to remove. ]
+ *  @return     : None.
+**/
+void il_remove(il_list *list, il_hook *hook) {
+    if (hook->prev != NULL) {
+        hook->prev->next = hook->next;
+    } else {
+        list->head = hook->next;
+    }
+    if (hook->next != NULL) {
+        hook->next->prev = hook->prev;
+    } else {
+        list->tail = hook->prev;
+    }
+    hook->prev = hook->next = NULL;
+    list->length--;
+}
+
+/**
+ *  @brief      : Append to a list. Must handle case where list is empty.
+ *  @param      : [ List. ]
+ *                [ Hook. ]
+ *  @return     : None.
+**/
+void il_append(il_list *list, il_hook *hook) {
+    hook->next = NULL;
+    hook->prev = list->tail;
+    if (list->tail != NULL) {
+        list->tail = list->tail->next = hook;           /* Case: List not empty. */
+    } else {
+        list->tail = list->head = hook;                 /* Case: List empty. */
+    }
+    list->length++;
+}
+
+/**
+ *  @brief      : Prepend to a list. Must handle case where list is empty.
+ *  @param      : [ List. ]
+ *                [ Hook. ]
+ *  @return     : None.
+**/
+void il_prepend(il_list *list, il_hook *hook) {
+    hook->prev = NULL;
+    hook->next = list->head;
+    if (list->head != NULL) {
+        list->head = list->head->prev = hook;           /* Case: List not empty. */
+    } else {
+        list->head = list->tail = hook;                 /* Case: List empty. */
+    }
+    list->length++;
+}
+
+/**
+ *  @brief      : Unlink all hooks in a list, without deallocating the list itself, or the structures containing them.
+ *  @param      : [ List to unlink hooks of. ]
+ *  @return     : None.
+**/
+void il_delete_all(il_list *list) {
+    il_hook *hook = list->head, *next_hook;
+    while (hook != NULL) {
+        next_hook = hook->next;
+        hook->prev = hook->next = NULL;
+        hook = next_hook;
+    }
+    list->head = list->tail = NULL, list->length = 0;
+}
+
+/**
+ *  @brief      : Unlink all hooks in a list, then deallocate the list itself. Pointer to list should not be used
+ *                  thereafter, because it points to already deallocated memory.
+ *  @param      : [ List to deallocate. ]
+ *  @return     : None.
+**/
+void il_destroy(il_list *list) {
+    il_delete_all(list);
+    free(list);
+}
+
+/**
+ *  @brief      : Print a list. Must pass a two function pointers, one is used to print each hook (the user gets its
+ *                  structure through 'il_entry'), and another is called at the end (passed a reference to the list).
+ *  @param      : [ List to print. ]
+ *                [ Function to be called at each hook (passed each hook consecutively). ]
+ *                [ Function to be called after all hooks have been printed (passed list and used for clean-up). ]
+ *  @return     : None.
+**/
+void il_print(il_list *list, void (*f_print)(il_hook *hook), void (*f_clean)(il_list *list)) {
+    if (list->length != 0) {
+        il_hook *hook;
+        il_for_each(hook, list) {
+            f_print(hook);
+        }
+        f_clean(list);
+    }
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_INTRUSIVE_LIST_            /* compile-time switch */
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+typedef struct ITEM {
+    int value;
+    il_hook in_first;
+    il_hook in_second;
+} item;
+
+void t_insert_delete();
+void t_remove();
+void t_two_lists();
+
+void f_print_first(il_hook *hook);
+void f_print_second(il_hook *hook);
+void f_clean(il_list *list);
+
+int main() {
+    t_insert_delete();
+    t_remove();
+    t_two_lists();
+    return 0;
+}
+
+void t_insert_delete() {
+    printf("*************** TEST (INSERT/DELETE) ***************\n");
+    il_list *list = il_create();
+    item arr_data[] = {{1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}};
+    int arr_index[] = {0, 0, 1, 2, 3, 2, 6, 7};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        printf("Inserting: %d at (i=%d)\n", arr_data[i].value, arr_index[i]);
+        il_insert(list, &arr_data[i].in_first, arr_index[i]);
+        il_print(list, f_print_first, f_clean);
+    }
+    int arr_delete[] = {0, 5, 2, 4};
+    for (int i = 0; i < LEN(arr_delete); i++) {
+        printf("Deleting (i=%d)\n", arr_delete[i]);
+        printf("%d\n", il_entry(il_delete(list, arr_delete[i]), item, in_first)->value);
+        il_print(list, f_print_first, f_clean);
+    }
+    il_destroy(list);
+}
+
+void t_remove() {
+    printf("*************** TEST (REMOVE) ***************\n");
+    il_list *list = il_create();
+    item arr_data[] = {{1}, {2}, {3}, {4}, {5}};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        il_enqueue(list, &arr_data[i].in_first);
+    }
+    il_print(list, f_print_first, f_clean);
+    int arr_remove[] = {4, 0, 2, 1, 3};
+    for (int i = 0; i < LEN(arr_remove); i++) {
+        printf("Removing: %d\n", arr_data[arr_remove[i]].value);
+        il_remove(list, &arr_data[arr_remove[i]].in_first);
+        il_print(list, f_print_first, f_clean);
+    }
+    printf("Length: %ld\n", (long) list->length);
+    il_destroy(list);
+}
+
+void t_two_lists() {
+    printf("*************** TEST (TWO LISTS) ***************\n");
+    il_list *first = il_create();
+    il_list *second = il_create();
+    item arr_data[] = {{1}, {2}, {3}, {4}, {5}};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        il_append(first, &arr_data[i].in_first);
+        il_push(second, &arr_data[i].in_second);
+    }
+    il_print(first, f_print_first, f_clean);
+    il_print(second, f_print_second, f_clean);
+    printf("Removing: 3 (from first list only)\n");
+    il_remove(first, &arr_data[2].in_first);
+    il_print(first, f_print_first, f_clean);
+    il_print(second, f_print_second, f_clean);
+    il_destroy(first);
+    il_destroy(second);
+}
+
+void f_print_first(il_hook *hook) {
+    printf("%d, ", il_entry(hook, item, in_first)->value);
+}
+
+void f_print_second(il_hook *hook) {
+    printf("%d, ", il_entry(hook, item, in_second)->value);
+}
+
+void f_clean(il_list *list) {
+    printf("\b\b \n");
+}
+
+#endif
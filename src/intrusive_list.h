@@ -0,0 +1,146 @@
+/**
+ ****************************************************************
+ * @file            : intrusive_list.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of an intrusive (doubly) linked list, with stack and queue functions.
+ * **************************************************************
+ **/
+
+#ifndef _INTRUSIVE_LIST_H_
+#define _INTRUSIVE_LIST_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "shared_defs.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Get a pointer to the user's structure, from a pointer to the hook embedded in it.
+**/
+#define il_entry(hook, type, member)    CONTAINER_OF(hook, type, member)
+
+/**
+ *  @brief      : Iterate over each hook in a list, front-to-back. The current hook must not be removed within the loop.
+**/
+#define il_for_each(hook, list)         for ((hook) = (list)->head; (hook) != NULL; (hook) = (hook)->next)
+
+/**
+ *  @brief      : Stack functions, implemented as macro functions, aliasing list functions.
+**/
+#define il_push(list, hook)             il_prepend(list, hook)
+#define il_pop(list)                    il_delete(list, 0)
+#define il_top(list)                    il_get(list, 0)
+
+/**
+ *  @brief      : Queue functions, implemented as macro functions, aliasing list functions.
+**/
+#define il_enqueue(list, hook)          il_append(list, hook)
+#define il_dequeue(list)                il_delete(list, 0)
+#define il_front(list)                  il_get(list, 0)
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Hook structure, embedded by the user in the structure to be stored (one hook per list it is in).
+**/
+typedef struct IL_HOOK {
+    struct IL_HOOK *prev;
+    struct IL_HOOK *next;
+} il_hook;
+
+/**
+ *  @brief      : List structure.
+**/
+typedef struct IL_LIST {
+    il_hook *head;
+    il_hook *tail;
+    LENGTH_DT length;
+} il_list;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Create an intrusive list (dynamically, on heap).
+ *  @param      : None.
+ *  @return     : Pointer to list.
+**/
+il_list * il_create();
+
+/**
+ *  @brief      : Get the hook at an index in the list. If fails, because index is out of bounds, then, return NULL.
+ *                  (Note: Allows negative indexing if LENGTH_DT is signed.)
+ *  @param      : [ List to search in. ]
+ *                [ Index to use. ]
+ *  @return     : Pointer to hook.
+**/
+il_hook * il_get(il_list *list, LENGTH_DT i);
+
+/**
+ *  @brief      : Insert hook at an index. Allows appending. If index is out of bounds, nothing happens.
+ *  @param      : [ List to work with. ]
+ *                [ Hook to insert (must not be in this list already). ]
+ *                [ Index to insert at. ]
+ *  @return     : None.
+**/
+void il_insert(il_list *list, il_hook *hook, LENGTH_DT i);
+
+/**
+ *  @brief      : Deleting (unlinking) hook at index. If index does not exist, nothing happens. Returns hook.
+ *  @param      : [ List to delete from. ]
+ *                [ Index to work with. ]
+ *  @return     : Pointer to hook, or NULL.
+**/
+il_hook * il_delete(il_list *list, LENGTH_DT i);
+
+/**
+ *  @brief      : Remove (unlink) a hook from the list it is in, in constant time.
+ *  @param      : [ List the hook is in. ]
+ *                [ Hook to remove. ]
+ *  @return     : None.
+**/
+void il_remove(il_list *list, il_hook *hook);
+
+/**
+ *  @brief      : Append hook to list.
+ *  @param      : [ List to append to. ]
+ *                [ Hook to append. ]
+ *  @return     : None.
+**/
+void il_append(il_list *list, il_hook *hook);
+
+/**
+ *  @brief      : Prepend hook to list.
+ *  @param      : [ List to prepend to. ]
+ *                [ Hook to prepend. ]
+ *  @return     : None.
+**/
+void il_prepend(il_list *list, il_hook *hook);
+
+/**
+ *  @brief      : Delete (unlink) all hooks in a list. The structures containing them are not de-allocated.
+ *  @param      : [ List to delete all hooks from. ]
+ *  @return     : None.
+**/
+void il_delete_all(il_list *list);
+
+/**
+ *  @brief      : Destroy list (de-allocated off heap). The structures containing the hooks are not de-allocated.
+ *  @param      : [ List to destroy. ]
+ *  @return     : None.
+**/
+void il_destroy(il_list *list);
+
+/**
+ *  @brief      : Print a list of hooks.
+ *  @param      : [ List to print. ]
+ *                [ Function to be called at each hook (passed each hook consecutively). ]
+ *                [ Function to be called after all hooks have been printed (passed list and used for clean-up). ]
+ *  @return     : None.
+**/
+void il_print(il_list *list, void (*f_print)(il_hook *hook), void (*f_clean)(il_list *list));
+
+#endif
@@ -10,11 +10,33 @@
 
 #include "linked_list.h"
 
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Size of a node of a sized list, storing the item in-place, starting at 'data'.
+**/
+#define LL_NODE_SIZE(elem_size)     (offsetof(ll_node, data) + (elem_size) > sizeof(ll_node) ? \
+                                        offsetof(ll_node, data) + (elem_size) : sizeof(ll_node))
+
+/**
+ *  @brief      : The item of a node, as returned to the user (a pointer to the in-place value, if a sized list).
+**/
+#define LL_DATA(list, node)         ((list)->elem_size != 0 ? (DATA_TYPE) &(node)->data : (node)->data)
+
+/**
+ *  @brief      : Size of a node of a list, and de-allocation of a node (through the set function, if any, else through
+ *                  the allocator).
+**/
+#define LL_SIZE(list)               ((list)->elem_size != 0 ? LL_NODE_SIZE((list)->elem_size) : sizeof(ll_node))
+#define LL_FREE(list, node)         ((list)->f_free != NULL ? (list)->f_free(node) \
+                                        : ALLOC_FREE((list)->allocator, node, LL_SIZE(list)))
+
 /* ********************* static function declaration(s) SECTION ********************** */
 
-static ll_node * ll_create_node(DATA_TYPE data);
+static ll_node * ll_create_node(ll_list *list, DATA_TYPE data);
 static ll_node * ll_get_node(ll_list *list, LENGTH_DT i);
 static ll_node * ll_get_previous_node(ll_list *list, LENGTH_DT i);
+static ll_node * ll_unlink_node(ll_list *list, LENGTH_DT i);
 static void ll_deallocate_all(ll_list *list);
 
 /* ********************* function definition(s) SECTION ********************** */
@@ -25,19 +47,71 @@ static void ll_deallocate_all(ll_list *list);
  *  @return     : Pointer to the dynamically allocated list.
 **/
 ll_list * ll_create() {
+    return ll_create_sized(0);
+}
+
+/**
+ *  @brief      : Allocating dynamic memory for a sized list structure, initializing and returning the pointer.
+ *                  An element size of zero creates a regular list (items stored as DATA_TYPE).
+ *  @param      : [ Size (in bytes) of each item. ]
+ *  @return     : Pointer to the dynamically allocated list.
+**/
+ll_list * ll_create_sized(size_t elem_size) {
+    return ll_create_alloc(elem_size, NULL);
+}
+
+/**
+ *  @brief      : Allocating dynamic memory for a list structure, whose nodes are allocated through an allocator,
+ *                  initializing and returning the pointer. Without an allocator, nodes are de-allocated by 'free'
+ *                  (as set by 'll_set_free'), else by the allocator.
+ *  @param      : [ Size (in bytes) of each item (0 for a regular list). ]
+ *                [ Allocator (NULL for 'malloc'). ]
+ *  @return     : Pointer to the dynamically allocated list (NULL on failure).
+**/
+ll_list * ll_create_alloc(size_t elem_size, alloc_allocator *allocator) {
     ll_list *new_list = (ll_list *) malloc(sizeof(ll_list));
-    new_list->length = 0, new_list->head = NULL, new_list->tail = NULL;   
+    if (new_list != NULL) {
+        new_list->length = 0, new_list->head = NULL, new_list->tail = NULL;
+        new_list->elem_size = elem_size;
+        new_list->f_free = allocator == NULL ? free : NULL;
+        new_list->allocator = allocator;
+        new_list->failed = 0;
+        INSTR_INIT(new_list);
+    }
     return new_list;
 }
 
+/**
+ *  @brief      : Set the function that de-allocates the nodes deleted from a list.
+ *  @param      : [ List. ]
+ *                [ Function that receives a node, and de-allocates it. ]
+ *  @return     : None.
+**/
+void ll_set_free(ll_list *list, void (*f_free)(void *node)) {
+    list->f_free = f_free;
+}
+
 /**
  *  @brief      : (For internal use) Allocating dynamic memory for a list node, initializing and returning the pointer.
- *  @param      : [ Data to store. ]
- *  @return     : Pointer to the dynamically allocated node.
+ *                  In a sized list, the value pointed to by 'data' is copied into the node, in a single allocation.
+ *                  If the allocation fails, the list is marked as failed.
+ *  @param      : [ List the node belongs to. ]
+ *                [ Data to store. ]
+ *  @return     : Pointer to the dynamically allocated node (NULL on failure).
 **/
-static ll_node * ll_create_node(DATA_TYPE data) {
-    ll_node *new_node = (ll_node *) malloc(sizeof(ll_node));
-    new_node->data = data, new_node->next = NULL;
+static ll_node * ll_create_node(ll_list *list, DATA_TYPE data) {
+    ll_node *new_node = (ll_node *) ALLOC_ALLOC(list->allocator, LL_SIZE(list));
+    if (new_node == NULL) {
+        list->failed = 1;
+        return NULL;
+    }
+    if (list->elem_size != 0) {
+        memcpy(&new_node->data, data, list->elem_size);
+    } else {
+        new_node->data = data;
+    }
+    new_node->next = NULL;
+    INSTR_COUNT(list, allocs);
     return new_node;
 }
 
@@ -52,6 +126,7 @@ static ll_node * ll_get_node(ll_list *list, LENGTH_DT i) {
     ll_node *node = list->head;
     for (LENGTH_DT j = 0; j < i; j++) {
         node = node->next;
+        INSTR_PATH(list);
     }
     return node;
 }
@@ -67,6 +142,7 @@ static ll_node * ll_get_previous_node(ll_list *list, LENGTH_DT i) {
     ll_node *node = list->head;
     for (LENGTH_DT j = 1; j < i; j++) {
         node = node->next;
+        INSTR_PATH(list);
     }
     return node;
 }
@@ -80,12 +156,15 @@ static ll_node * ll_get_previous_node(ll_list *list, LENGTH_DT i) {
  *  @return     : Stored data.
 **/
 DATA_TYPE ll_get(ll_list *list, LENGTH_DT i) {
+    DATA_TYPE data = DEFAULT_VALUE;
+    INSTR_ENTER(list);
     if (i < 0) { i += list->length; }                    /* to allow reverse indexing */
 
     if (i < list->length) {
-        return ll_get_node(list, i)->data;
+        data = LL_DATA(list, ll_get_node(list, i));
     }
-    return DEFAULT_VALUE;
+    INSTR_EXIT(list);
+    return data;
 }
 
 /**
@@ -96,9 +175,15 @@ DATA_TYPE ll_get(ll_list *list, LENGTH_DT i) {
  *  @return     : None.
 **/
 void ll_replace(ll_list *list, DATA_TYPE data, LENGTH_DT i) {
+    INSTR_ENTER(list);
     if (i < list->length) {
-        ll_get_node(list, i)->data = data;
+        if (list->elem_size != 0) {
+            memcpy(&ll_get_node(list, i)->data, data, list->elem_size);
+        } else {
+            ll_get_node(list, i)->data = data;
+        }
     }
+    INSTR_EXIT(list);
 }
 
 /**
@@ -112,8 +197,9 @@ void ll_replace(ll_list *list, DATA_TYPE data, LENGTH_DT i) {
  *  @return     : None.
 **/
 void ll_insert(ll_list *list, DATA_TYPE data, LENGTH_DT i) {
-    if (i <= list->length) {
-        ll_node *new_node = ll_create_node(data);
+    INSTR_ENTER(list);
+    ll_node *new_node;
+    if (i <= list->length && (new_node = ll_create_node(list, data)) != NULL) {
         if (list->head == NULL) {                           /* Case: List empty. */
             list->head = list->tail = new_node;
         } else if (i == list->length) {                     /* Case: Inserting at end of list. */
@@ -128,47 +214,90 @@ void ll_insert(ll_list *list, DATA_TYPE data, LENGTH_DT i) {
         }
         list->length++;
     }
+    INSTR_EXIT(list);
 }
 
 /**
- *  @brief      : Deleting a node at a specific index. Index must be already existing, otherwise deletion is not done.
- *                  Index checking handles the case where the list's length is zero. Three cases remain, then:
- *                  Deleting from single-element list, deleting at the start of a list, and deleting anywhere else.
- *                  A sub-case of deleting at the end of a list is handled, where the tail needs to change.
- *                  (Note: You cannot delete a tail directly, since this is a singly linked list.)
- *                  The data of the node to-be-deleted is returned for convenience. If no deletion occurs,
- *                  A default value is returned, set in the header file.
- *  @param      : [ List to delete from. ]
+ *  @brief      : (For internal use) Unlinking a node at a specific index, without deallocating it. Index must be already
+ *                  existing, otherwise NULL is returned. Index checking handles the case where the list's length is zero.
+ *                  Three cases remain, then: Unlinking from single-element list, unlinking at the start of a list, and
+ *                  unlinking anywhere else. A sub-case of unlinking at the end of a list is handled, where the tail
+ *                  needs to change.
+ *                  (Note: You cannot unlink a tail directly, since this is a singly linked list.)
+ *  @param      : [ List to unlink from. ]
  *                [ Index to work with. ]
- *  @return     : Stored data.
+ *  @return     : Pointer to the unlinked node.
 **/
-DATA_TYPE ll_delete(ll_list *list, LENGTH_DT i) {
+static ll_node * ll_unlink_node(ll_list *list, LENGTH_DT i) {
+    ll_node *node_to_unlink = NULL;
     if (i < list->length) {
-        DATA_TYPE data;
         if (list->length == 1) {                            /* Case: List with one element only. */
-            data = list->head->data;
-            free(list->head);
+            node_to_unlink = list->head;
             list->head = NULL;
             list->tail = NULL;
-        } else if (i == 0) {                                /* Case: Deleting at start of list. */
-            ll_node *node_to_delete = list->head;
+        } else if (i == 0) {                                /* Case: Unlinking at start of list. */
+            node_to_unlink = list->head;
             list->head = list->head->next;
-            data = node_to_delete->data;
-            free(node_to_delete);
-        } else {                                            /* Case: Deleting anywhere else. */
+        } else {                                            /* Case: Unlinking anywhere else. */
             ll_node *previous_node = ll_get_previous_node(list, i);
-            ll_node *node_to_delete = previous_node->next;
-            previous_node->next = node_to_delete->next;
-            data = node_to_delete->data;
-            free(node_to_delete);                               /* Sub-case: Deleting at end of list. */
-            if (i == list->length-1) {
+            node_to_unlink = previous_node->next;
+            previous_node->next = node_to_unlink->next;
+            if (i == list->length-1) {                          /* Sub-case: Unlinking at end of list. */
                 list->tail = previous_node;
             }
         }
         list->length--;
-        return data;
     }
-    return DEFAULT_VALUE;
+    return node_to_unlink;
+}
+
+/**
+ *  @brief      : Deleting a node at a specific index. Index must be already existing, otherwise deletion is not done.
+ *                  (Note: For the cases handled, read '@brief' of 'll_unlink_node'.)
+ *                  The data of the node to-be-deleted is returned for convenience. If no deletion occurs, or the list
+ *                  is sized (the data is stored in the deallocated node), a default value is returned, set in the header file.
+ *  @param      : [ List to delete from. ]
+ *                [ Index to work with. ]
+ *  @return     : Stored data.
+**/
+DATA_TYPE ll_delete(ll_list *list, LENGTH_DT i) {
+    DATA_TYPE data = DEFAULT_VALUE;
+    INSTR_ENTER(list);
+    ll_node *node_to_delete = ll_unlink_node(list, i);
+    if (node_to_delete != NULL) {
+        if (list->elem_size == 0) { data = node_to_delete->data; }
+        LL_FREE(list, node_to_delete);
+        INSTR_COUNT(list, frees);
+    }
+    INSTR_EXIT(list);
+    return data;
+}
+
+/**
+ *  @brief      : Deleting a node at a specific index, after copying its item into a destination. Index must be already
+ *                  existing, otherwise deletion is not done, and a default value is returned, set in the header file.
+ *                  For a sized list, the value is copied ('elem_size' bytes), otherwise, the DATA_TYPE is.
+ *  @param      : [ List to delete from. ]
+ *                [ Index to work with. ]
+ *                [ Destination to copy item into. ]
+ *  @return     : Destination.
+**/
+DATA_TYPE ll_delete_copy(ll_list *list, LENGTH_DT i, void *dest) {
+    DATA_TYPE data = DEFAULT_VALUE;
+    INSTR_ENTER(list);
+    ll_node *node_to_delete = ll_unlink_node(list, i);
+    if (node_to_delete != NULL) {
+        if (list->elem_size != 0) {
+            memcpy(dest, &node_to_delete->data, list->elem_size);
+        } else {
+            *((DATA_TYPE *) dest) = node_to_delete->data;
+        }
+        LL_FREE(list, node_to_delete);
+        INSTR_COUNT(list, frees);
+        data = dest;
+    }
+    INSTR_EXIT(list);
+    return data;
 }
 
 /**
@@ -178,13 +307,17 @@ DATA_TYPE ll_delete(ll_list *list, LENGTH_DT i) {
  *  @return     : None.
 **/
 void ll_append(ll_list *list, DATA_TYPE data) {
-    ll_node *new_node = ll_create_node(data);
-    if (list->tail != NULL) {
-        list->tail = list->tail->next = new_node;     /* Case: List not empty. */
-    } else {
-        list->tail = list->head = new_node;           /* Case: List empty. */
+    INSTR_ENTER(list);
+    ll_node *new_node = ll_create_node(list, data);
+    if (new_node != NULL) {
+        if (list->tail != NULL) {
+            list->tail = list->tail->next = new_node;     /* Case: List not empty. */
+        } else {
+            list->tail = list->head = new_node;           /* Case: List empty. */
+        }
+        list->length++;
     }
-    list->length++;
+    INSTR_EXIT(list);
 }
 
 /**
@@ -194,27 +327,78 @@ void ll_append(ll_list *list, DATA_TYPE data) {
  *  @return     : None.
 **/
 void ll_prepend(ll_list *list, DATA_TYPE data) {
-    ll_node *new_node = ll_create_node(data);
-    if (list->head != NULL) {
-        new_node->next = list->head;                  /* Case: List not empty. */
-        list->head = new_node;
-    } else {
-        list->head = list->tail = new_node;           /* Case: List empty. */
+    INSTR_ENTER(list);
+    ll_node *new_node = ll_create_node(list, data);
+    if (new_node != NULL) {
+        if (list->head != NULL) {
+            new_node->next = list->head;                  /* Case: List not empty. */
+            list->head = new_node;
+        } else {
+            list->head = list->tail = new_node;           /* Case: List empty. */
+        }
+        list->length++;
+    }
+    INSTR_EXIT(list);
+}
+
+/**
+ *  @brief      : Move all items of a list to the end of another, leaving it empty. Nodes are linked as they are, unless
+ *                  the lists de-allocate them differently, where copies are chained first (so a failure leaves both
+ *                  lists unchanged).
+ *  @param      : [ List to append to. ]
+ *                [ List to move items from. ]
+ *  @return     : None.
+**/
+void ll_concat(ll_list *list, ll_list *other) {
+    ll_node *head = other->head, *tail = other->tail;
+    INSTR_ENTER(list);
+    if (other->length != 0 && (list->f_free != other->f_free || list->allocator != other->allocator)) {
+        head = tail = NULL;
+        for (ll_node *node = other->head; node != NULL; node = node->next) {
+            ll_node *new_node = ll_create_node(list, LL_DATA(other, node));
+            if (new_node == NULL) {
+                while (head != NULL) {
+                    ll_node *next_node = head->next;
+                    LL_FREE(list, head);
+                    INSTR_COUNT(list, frees);
+                    head = next_node;
+                }
+                INSTR_EXIT(list);
+                return;
+            }
+            if (tail != NULL) { tail = tail->next = new_node; }
+            else { head = tail = new_node; }
+            INSTR_PATH(list);
+        }
+        ll_deallocate_all(other);
+    }
+    if (head != NULL) {
+        if (list->tail != NULL) { list->tail->next = head; }
+        else { list->head = head; }
+        list->tail = tail;
+        list->length += other->length;
     }
-    list->length++;
+    other->head = other->tail = NULL, other->length = 0;
+    INSTR_EXIT(list);
 }
 
 /**
  *  @brief      : (internal use only) Deallocate (free) each node in a list, without deallocating the list itself,
- *                  or setting the head or tail pointers to NULL, or list length.
+ *                  or setting the head or tail pointers to NULL, or list length. If the allocator supports it (and no
+ *                  de-allocation function is set), all nodes are de-allocated at once, with no traversal.
  *  @param      : [ List to deallocate items of. ]
  *  @return     : None.
 **/
 static void ll_deallocate_all(ll_list *list) {
     ll_node *node = list->head, *next_node;
-    if (node != NULL) {
+    if (list->f_free == NULL && list->allocator != NULL && list->allocator->f_free_all != NULL) {
+        list->allocator->f_free_all(list->allocator->ctx);
+        node = NULL;
+    }
+    while (node != NULL) {
         next_node = node->next;
-        free(node);
+        LL_FREE(list, node);
+        INSTR_COUNT(list, frees);
         node = next_node;
     }
 }
@@ -225,8 +409,10 @@ static void ll_deallocate_all(ll_list *list) {
  *  @return     : None.
 **/
 void ll_delete_all(ll_list *list) {
+    INSTR_ENTER(list);
     ll_deallocate_all(list);
     list->head = list->tail = NULL, list->length = 0;
+    INSTR_EXIT(list);
 }
 
 /**
@@ -236,13 +422,16 @@ void ll_delete_all(ll_list *list) {
  *  @return     : None.
 **/
 ll_list * ll_copy(ll_list *list, unsigned char rev_flag) {
-    ll_list * new_list = ll_create();
+    ll_list * new_list = ll_create_sized(list->elem_size);
     ll_node * traverse_node = list->head;
     void (*f_ptr)(ll_list *list, DATA_TYPE data) = rev_flag ? ll_prepend : ll_append;
+    INSTR_ENTER(list);
     while (traverse_node != NULL) {
-        f_ptr(new_list, traverse_node->data);
+        f_ptr(new_list, LL_DATA(list, traverse_node));
         traverse_node = traverse_node->next;
+        INSTR_PATH(list);
     }
+    INSTR_EXIT(list);
     return new_list;
 }
 
@@ -253,7 +442,9 @@ ll_list * ll_copy(ll_list *list, unsigned char rev_flag) {
  *  @return     : None.
 **/
 void ll_destroy(ll_list *list) {
+    INSTR_ENTER(list);
     ll_deallocate_all(list);
+    INSTR_EXIT(list);
     free(list);
 }
 
@@ -268,14 +459,16 @@ void ll_destroy(ll_list *list) {
  *  @return     : None.
 **/
 void ll_print(ll_list *list, void (*f_print)(DATA_TYPE data), void (*f_clean)(ll_list *list)) {
+    INSTR_ENTER(list);
     if (list->length != 0) {
         ll_node *node = list->head;
         while (node != NULL) {
-            f_print(node->data);
+            f_print(LL_DATA(list, node));
             node = node->next;
         }
         f_clean(list);
     }
+    INSTR_EXIT(list);
 }
 
 /* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
@@ -291,6 +484,8 @@ void t_delete();
 void t_append_prepend();
 void t_delete_all();
 void t_copy();
+void t_concat();
+void t_sized();
 
 void print(void *data);
 
@@ -305,6 +500,8 @@ int main() {
     t_append_prepend();
     t_delete_all();
     t_copy();
+    t_concat();
+    t_sized();
     return 0;
 }
 
@@ -428,6 +625,74 @@ void t_copy() {
     ll_destroy(rev);
 }
 
+void t_concat() {
+    printf("*************** TEST (CONCAT) ***************\n");
+    ll_list *list = ll_create(), *other = ll_create();
+    int arr_data[] = {1, 2, 3, 4, 5, 6};
+    ll_concat(list, other);
+    printf("Empty: length: %ld\n", (long) list->length);
+    for (int i = 0; i < 3; i++) {
+        ll_append(other, arr_data+i);
+    }
+    ll_concat(list, other);
+    printf("Moved: length: %ld, other: %ld\n", (long) list->length, (long) other->length);
+    ll_print(list, f_print, f_clean);
+    ll_set_free(other, free);
+    for (int i = 3; i < LEN(arr_data); i++) {
+        ll_append(other, arr_data+i);
+    }
+    ll_concat(list, other);
+    printf("Copied: length: %ld, other: %ld\n", (long) list->length, (long) other->length);
+    ll_print(list, f_print, f_clean);
+    ll_append(list, arr_data);
+    ll_print(list, f_print, f_clean);
+    ll_destroy(list);
+    ll_destroy(other);
+}
+
+typedef struct RECORD {
+    int id;
+    double weight;
+    char tag[8];
+} record;
+
+void f_print_record(void *data) {
+    record *r = (record *) data;
+    printf("(%d, %.1f, %s), ", r->id, r->weight, r->tag);
+}
+
+void t_sized() {
+    printf("*************** TEST (SIZED) ***************\n");
+    ll_list *list = ll_create_sized(sizeof(record));
+    record arr_data[] = {{1, 0.5, "a"}, {2, 1.5, "b"}, {3, 2.5, "c"}, {4, 3.5, "d"}};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        ll_enqueue(list, arr_data+i);
+        arr_data[i].id = -1;                                /* list holds its own copy */
+    }
+    ll_print(list, f_print_record, f_clean);
+    record extra = {0, 9.5, "z"};
+    printf("Inserting (0, 9.5, z) at (i=2)\n");
+    ll_insert(list, &extra, 2);
+    ll_print(list, f_print_record, f_clean);
+    printf("Getting (i=-1)\n");
+    f_print_record(ll_get(list, -1));
+    f_clean(list);
+    printf("Replacing at (i=0) with (0, 9.5, z)\n");
+    ll_replace(list, &extra, 0);
+    ll_print(list, f_print_record, f_clean);
+    printf("Reversing...\n");
+    ll_list *rev = ll_copy(list, 1);
+    ll_print(rev, f_print_record, f_clean);
+    record out;
+    while (rev->length != 0) {
+        printf("Dequeuing\n");
+        f_print_record(ll_dequeue_copy(rev, &out));
+        f_clean(rev);
+    }
+    ll_destroy(list);
+    ll_destroy(rev);
+}
+
 void print(void *data) {
     printf("%d\n", *((int *) data));
 }
@@ -14,7 +14,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <stddef.h>
+#include <string.h>
 #include "shared_defs.h"
+#include "instrument.h"
+#include "allocator.h"
 
 /* ********************* #define SECTION ********************** */
 
@@ -32,10 +36,17 @@
 #define ll_dequeue(list)            ll_delete(list, 0)
 #define ll_front(list)              ll_get(list, 0)
 
+/**
+ *  @brief      : Stack and queue functions of a sized list (see 'll_create_sized'), copying the removed item out.
+**/
+#define ll_pop_copy(list, dest)     ll_delete_copy(list, 0, dest)
+#define ll_dequeue_copy(list, dest) ll_delete_copy(list, 0, dest)
+
 /* ********************* struct(s) SECTION ********************** */
 
 /**
  *  @brief      : Node structure (where items are stored).
+ *                  (Note: In a sized list, the item is stored in-place, starting at 'data', and may extend past it.)
 **/
 typedef struct LL_NODE {
     struct LL_NODE *next;
@@ -49,6 +60,13 @@ typedef struct LL_LIST {
     ll_node *head;
     ll_node *tail;
     LENGTH_DT length;
+    size_t elem_size;                                   /* 0 if items are stored as DATA_TYPE, else size of in-place items */
+    void (*f_free)(void *node);                         /* de-allocates deleted nodes ('free', unless set by 'll_set_free') */
+    alloc_allocator *allocator;                         /* allocates nodes ('malloc' if NULL, see 'll_create_alloc') */
+    unsigned char failed;                               /* 1 once a node allocation failed (that item was not added) */
+#ifdef _INSTRUMENT_
+    instr_stats stats;                                  /* counters (see 'instrument.h') */
+#endif
 } ll_list;
 
 /* ********************* #include SECTION (2) ********************** */
@@ -64,6 +82,37 @@ typedef struct LL_LIST {
 **/
 ll_list * ll_create();
 
+/**
+ *  @brief      : Create a sized list (dynamically, on heap), where each item is a value of a fixed size, copied into
+ *                  the storage of its node. Functions that receive data, receive a pointer to the value to copy, and
+ *                  functions that return data, return a pointer to the value inside its node.
+ *                  (Note: Stored values are aligned as a pointer.)
+ *  @param      : [ Size (in bytes) of each item. ]
+ *  @return     : Pointer to list.
+**/
+ll_list * ll_create_sized(size_t elem_size);
+
+/**
+ *  @brief      : Create a list (dynamically, on heap), sized or not (see 'll_create_sized'), whose nodes are allocated
+ *                  and de-allocated through an allocator (see 'allocator.h'), unless a de-allocation function is set
+ *                  (see 'll_set_free'). If a node cannot be allocated, the item is not added, and 'failed' is set.
+ *                  (Note: The list structure itself is allocated by 'malloc'.)
+ *  @param      : [ Size (in bytes) of each item (0 for a regular list). ]
+ *                [ Allocator (NULL for 'malloc'). ]
+ *  @return     : Pointer to list (NULL on failure).
+**/
+ll_list * ll_create_alloc(size_t elem_size, alloc_allocator *allocator);
+
+/**
+ *  @brief      : Set the function that de-allocates the nodes deleted from a list (e.g: 'ebr_free', so that nodes are
+ *                  only de-allocated once no concurrent reader can still hold them). Default is 'free', or the allocator's
+ *                  de-allocation, which is restored by setting NULL (so 'free', if the list has no allocator).
+ *  @param      : [ List. ]
+ *                [ Function that receives a node, and de-allocates it. ]
+ *  @return     : None.
+**/
+void ll_set_free(ll_list *list, void (*f_free)(void *node));
+
 /**
  *  @brief      : Get the item at an index in the list. If fails, because index is out of bounds,
  *                  then, return a default value, set in the header file.
@@ -94,12 +143,23 @@ void ll_insert(ll_list *list, DATA_TYPE data, LENGTH_DT i);
 
 /**
  *  @brief      : Deleting item at index. If index does not exist, nothing happens. Returns item.
+ *                  (Note: A sized list returns the default value, use 'll_delete_copy' instead.)
  *  @param      : [ List to delete from. ]
  *                [ Index to work with. ]
  *  @return     : Stored data.
 **/
 DATA_TYPE ll_delete(ll_list *list, LENGTH_DT i);
 
+/**
+ *  @brief      : Deleting item at index, after copying it into a destination. If index does not exist, nothing happens.
+ *                  (Note: Meant for sized lists, where 'll_delete' cannot return the item, since its storage is freed.)
+ *  @param      : [ List to delete from. ]
+ *                [ Index to work with. ]
+ *                [ Destination to copy item into (a value for a sized list, a DATA_TYPE otherwise). ]
+ *  @return     : Destination, or default value if no deletion occurs.
+**/
+DATA_TYPE ll_delete_copy(ll_list *list, LENGTH_DT i, void *dest);
+
 /**
  *  @brief      : Append item to list.
  *  @param      : [ List to append to. ]
@@ -116,8 +176,20 @@ void ll_append(ll_list *list, DATA_TYPE data);
 **/
 void ll_prepend(ll_list *list, DATA_TYPE data);
 
+/**
+ *  @brief      : Move all items of a list to the end of another, leaving it empty. Nodes are moved as they are if both
+ *                  lists de-allocate them alike (same free function and allocator), else items are copied into new
+ *                  nodes, and the old ones deleted. If an allocation fails, both lists are left unchanged.
+ *                  (Note: Both lists must have the same item size.)
+ *  @param      : [ List to append to. ]
+ *                [ List to move items from. ]
+ *  @return     : None.
+**/
+void ll_concat(ll_list *list, ll_list *other);
+
 /**
  *  @brief      : Copy a list into a new list, in the same order, or in reverse.
+ *                  (Note: The copy allocates its nodes through 'malloc', since an allocator may serve a single list.)
  *  @param      : [ List to copy. ]
  *                [ Reverse flag (1 to reverse). ]
  *  @return     : None.
@@ -0,0 +1,404 @@
+/**
+ ****************************************************************
+ * @file            : search.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of binary search kernels over sorted arrays of the data-type (classic, branchless,
+ *                      batched), and over sorted arrays of 64-bit integers (AVX2).
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#include "search.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : No. of integers, at or below which 'search_lower_bound_int64' stops halving, and compares all.
+**/
+#define SEARCH_LINEAR_THRESHOLD     16
+
+/**
+ *  @brief      : Hint to fetch memory into cache ahead of its use, where supported by the compiler.
+**/
+#if defined(__GNUC__) || defined(__clang__)
+#define SEARCH_PREFETCH(addr)       __builtin_prefetch(addr)
+#else
+#define SEARCH_PREFETCH(addr)       ((void) 0)
+#endif
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Get the lower bound of a key, with the classic binary search. The range ['lo', 'hi') holds the
+ *                  answer, and is halved by comparing the key with its middle item.
+ *  @param      : [ Sorted array of items. ]
+ *                [ No. of items. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Index.
+**/
+LENGTH_DT search_lower_bound(DATA_TYPE *arr, LENGTH_DT n, DATA_TYPE key,
+                                unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    LENGTH_DT lo = 0, hi = n;
+    while (lo < hi) {
+        LENGTH_DT mid = lo + (hi - lo) / 2;
+        if (f_compare(arr[mid], key)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ *  @brief      : Get the upper bound of a key, with the classic binary search.
+ *                  (Note: For information on the algorithm, read '@brief' of 'search_lower_bound'.)
+ *  @param      : [ Sorted array of items. ]
+ *                [ No. of items. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Index.
+**/
+LENGTH_DT search_upper_bound(DATA_TYPE *arr, LENGTH_DT n, DATA_TYPE key,
+                                unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    LENGTH_DT lo = 0, hi = n;
+    while (lo < hi) {
+        LENGTH_DT mid = lo + (hi - lo) / 2;
+        if (f_compare(key, arr[mid])) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+/**
+ *  @brief      : Get the range of items equal to a key. The lower bound is searched first, then the upper bound is
+ *                  searched only to its right.
+ *  @param      : [ Sorted array of items. ]
+ *                [ No. of items. ]
+ *                [ Key. ]
+ *                [ Pointer to store the start of the range in. ]
+ *                [ Pointer to store the end of the range (exclusive) in. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+void search_equal_range(DATA_TYPE *arr, LENGTH_DT n, DATA_TYPE key, LENGTH_DT *lo, LENGTH_DT *hi,
+                            unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    *lo = search_lower_bound(arr, n, key, f_compare);
+    *hi = *lo + search_upper_bound(arr + *lo, n - *lo, key, f_compare);
+}
+
+/**
+ *  @brief      : Get the lower bound of a key, without data-dependent branches. A 'base' and a length 'len' are kept,
+ *                  where all items before 'base' go before the key, and all items from 'base + len' on do not. Each step
+ *                  compares the item at 'base + len/2', and moves 'base' there or not (a conditional move), then
+ *                  subtracts 'len/2' from 'len'. So, the no. of steps only depends on 'n', and the branch predictor
+ *                  is never wrong. Since the next probe is one of two items, both are prefetched.
+ *  @param      : [ Sorted array of items. ]
+ *                [ No. of items. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Index.
+**/
+LENGTH_DT search_lower_bound_branchless(DATA_TYPE *arr, LENGTH_DT n, DATA_TYPE key,
+                                            unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    DATA_TYPE *base = arr;
+    LENGTH_DT len = n;
+
+    if (n == 0) {
+        return 0;
+    }
+    while (len > 1) {
+        LENGTH_DT half = len / 2;
+        len -= half;
+        SEARCH_PREFETCH(base + len / 2);
+        SEARCH_PREFETCH(base + half + len / 2);
+        base = f_compare(base[half], key) ? base + half : base;
+    }
+    return (base - arr) + f_compare(*base, key);
+}
+
+/**
+ *  @brief      : Get the lower bounds of many keys, 'SEARCH_BATCH_SIZE' keys at a time. Each key of a batch keeps its
+ *                  own 'base' (see 'search_lower_bound_branchless'), but all share 'len', since it only depends on 'n'.
+ *                  So, a batch proceeds in lock-step, with one step of every key per round, and the next probe of each
+ *                  key prefetched as soon as it is known, to be loaded while the other keys are stepped.
+ *  @param      : [ Sorted array of items. ]
+ *                [ No. of items. ]
+ *                [ Array of keys. ]
+ *                [ No. of keys. ]
+ *                [ Array to store the index of each key in. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+void search_lower_bound_many(DATA_TYPE *arr, LENGTH_DT n, DATA_TYPE *keys, LENGTH_DT m, LENGTH_DT *results,
+                                unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    DATA_TYPE *base[SEARCH_BATCH_SIZE];
+
+    for (LENGTH_DT b = 0; b < m; b += SEARCH_BATCH_SIZE) {
+        int count = m - b < SEARCH_BATCH_SIZE ? (int) (m - b) : SEARCH_BATCH_SIZE;
+        LENGTH_DT len = n;
+
+        if (n == 0) {
+            for (int k = 0; k < count; k++) { results[b + k] = 0; }
+            continue;
+        }
+        for (int k = 0; k < count; k++) {
+            base[k] = arr;
+        }
+        while (len > 1) {
+            LENGTH_DT half = len / 2;
+            len -= half;
+            for (int k = 0; k < count; k++) {
+                base[k] = f_compare(base[k][half], keys[b + k]) ? base[k] + half : base[k];
+                SEARCH_PREFETCH(base[k] + len / 2);
+            }
+        }
+        for (int k = 0; k < count; k++) {
+            results[b + k] = (base[k] - arr) + f_compare(*base[k], keys[b + k]);
+        }
+    }
+}
+
+/**
+ *  @brief      : Get the lower bound of an integer key. The range is halved without branches (see
+ *                  'search_lower_bound_branchless'), until at most 'SEARCH_LINEAR_THRESHOLD' candidates are left. Then,
+ *                  the lower bound is 'base' plus the no. of candidates less than the key, counted four at a time with
+ *                  AVX2 (a compare, and a popcount of its mask), or one at a time without it.
+ *  @param      : [ Sorted array of integers. ]
+ *                [ No. of integers. ]
+ *                [ Key. ]
+ *  @return     : Index.
+**/
+LENGTH_DT search_lower_bound_int64(const int64_t *arr, LENGTH_DT n, int64_t key) {
+    const int64_t *base = arr;
+    LENGTH_DT len = n, i = 0, count = 0;
+
+    while (len > SEARCH_LINEAR_THRESHOLD) {
+        LENGTH_DT half = len / 2;
+        len -= half;
+        SEARCH_PREFETCH(base + len / 2);
+        SEARCH_PREFETCH(base + half + len / 2);
+        base = base[half] < key ? base + half : base;
+    }
+#ifdef __AVX2__
+    __m256i v_key = _mm256_set1_epi64x(key);
+    for (; i + 4 <= len; i += 4) {
+        __m256i v_data = _mm256_loadu_si256((const __m256i *) (base + i));
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(v_key, v_data)));
+        count += __builtin_popcount(mask);
+    }
+#endif
+    for (; i < len; i++) {
+        count += base[i] < key;
+    }
+    return (base - arr) + count;
+}
+
+/**
+ *  @brief      : Get the upper bound of an integer key, as the lower bound of the next integer.
+ *  @param      : [ Sorted array of integers. ]
+ *                [ No. of integers. ]
+ *                [ Key. ]
+ *  @return     : Index.
+**/
+LENGTH_DT search_upper_bound_int64(const int64_t *arr, LENGTH_DT n, int64_t key) {
+    return key == INT64_MAX ? n : search_lower_bound_int64(arr, n, key + 1);
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_SEARCH_                    /* compile-time switch */
+
+#include "avl_tree.h"
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+unsigned char f_compare(void *new_data, void *old_data);
+
+void t_bounds();
+void t_many();
+void t_int64();
+
+int main() {
+    t_bounds();
+    t_many();
+    t_int64();
+    return 0;
+}
+
+void t_bounds() {
+    printf("*************** TEST (BOUNDS) ***************\n");
+    avl_tree *tree = avl_create();
+    int arr_data[] = {5, 17, 19, 26, 54, 17, 3, 19, 17};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        avl_insert(tree, arr_data+i, f_compare);
+    }
+    void *arr[LEN(arr_data)];
+    avl_make_array(tree, arr);
+    for (int i = 0; i < LEN(arr); i++) { printf("%d, ", *((int *) arr[i])); }
+    printf("\b\b \n");
+    int arr_key[] = {17, 18, 2, 54, 60};
+    for (int i = 0; i < LEN(arr_key); i++) {
+        LENGTH_DT lo, hi;
+        search_equal_range(arr, LEN(arr), arr_key+i, &lo, &hi, f_compare);
+        printf("Key: %d, lower bound: %ld, upper bound: %ld, branchless lower bound: %ld\n", arr_key[i], (long) lo,
+                (long) hi, (long) search_lower_bound_branchless(arr, LEN(arr), arr_key+i, f_compare));
+    }
+    avl_destroy(tree);
+}
+
+void t_many() {
+    printf("*************** TEST (MANY) ***************\n");
+    int n = 1000, m = 3 * SEARCH_BATCH_SIZE + 5, mismatches = 0;
+    int *arr_data = (int *) malloc(n * sizeof(int)), *arr_key = (int *) malloc(m * sizeof(int));
+    void **arr = (void **) malloc(n * sizeof(void *)), **keys = (void **) malloc(m * sizeof(void *));
+    LENGTH_DT *results = (LENGTH_DT *) malloc(m * sizeof(LENGTH_DT));
+    for (int i = 0; i < n; i++) { arr_data[i] = 2 * i, arr[i] = arr_data+i; }
+    for (int i = 0; i < m; i++) { arr_key[i] = (i * 97) % (2 * n + 3) - 1, keys[i] = arr_key+i; }
+    search_lower_bound_many(arr, n, keys, m, results, f_compare);
+    for (int i = 0; i < m; i++) {
+        mismatches += results[i] != search_lower_bound(arr, n, keys[i], f_compare);
+    }
+    printf("Keys: %d, mismatches: %d\n", m, mismatches);
+    free(arr_data), free(arr_key), free(arr), free(keys), free(results);
+}
+
+void t_int64() {
+    printf("*************** TEST (INT64) ***************\n");
+    int64_t arr[] = {-40, -3, 0, 0, 7, 7, 7, 12, 12, 15, 20, 21, 30, 31, 44, 45, 50, 60, 61, 70, 80, 99, INT64_MAX};
+    int64_t arr_key[] = {-41, 0, 7, 13, 61, 100, INT64_MAX};
+    for (int i = 0; i < LEN(arr_key); i++) {
+        printf("Key: %lld, lower bound: %ld, upper bound: %ld\n", (long long) arr_key[i],
+                (long) search_lower_bound_int64(arr, LEN(arr), arr_key[i]),
+                (long) search_upper_bound_int64(arr, LEN(arr), arr_key[i]));
+    }
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return *((int *) new_data) < *((int *) old_data) ? 1 : 0;
+}
+
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_SEARCH_                   /* compile-time switch */
+
+#include <time.h>
+#include "avl_tree.h"
+
+/**
+ *  @brief      : Max no. of items for which the AVL tree is benchmarked too (its nodes take ~6x the memory of the array).
+**/
+#define BENCH_AVL_MAX       (1L << 23)
+
+unsigned char f_compare(void *new_data, void *old_data);
+LENGTH_DT binary_search(int64_t elem, const int64_t *arr, LENGTH_DT len);
+
+double elapsed_ns(clock_t start, LENGTH_DT ops);
+
+/**
+ *  @brief      : Benchmark of the search kernels against the notebook's binary search and the AVL tree's descent, for
+ *                  random lookups (of present keys) in arrays of 64-bit integers, from 2^10 items (in L1) up to a max.
+ *                  (Usage: <max no. of items (default: 2^24, use 2^26 or more to exceed a large LLC)>
+ *                          <no. of lookups per size (default: 2^20)>)
+**/
+int main(int argc, char *argv[]) {
+    LENGTH_DT max_n = argc > 1 ? atol(argv[1]) : 1L << 24;
+    LENGTH_DT m = argc > 2 ? atol(argv[2]) : 1L << 20;
+    void **keys = (void **) malloc(m * sizeof(void *));
+    int64_t *keys_int64 = (int64_t *) malloc(m * sizeof(int64_t));
+    LENGTH_DT *results = (LENGTH_DT *) malloc(m * sizeof(LENGTH_DT));
+
+    printf("%10s %10s %10s %10s %10s %10s %10s\n", "items", "notebook", "classic", "branchless", "many", "int64",
+            "avl_find");
+    for (LENGTH_DT n = 1L << 10; n <= max_n; n *= 4) {
+        int64_t *arr_int64 = (int64_t *) malloc(n * sizeof(int64_t));
+        void **arr = (void **) malloc(n * sizeof(void *));
+        LENGTH_DT checksum = 0, expected = 0;
+        uint64_t state = 88172645463325252ULL;
+        double ns[6] = {0};
+        clock_t start;
+
+        for (LENGTH_DT i = 0; i < n; i++) {
+            arr_int64[i] = 2 * i + 1, arr[i] = (void *) (uintptr_t) arr_int64[i];
+        }
+        for (LENGTH_DT j = 0; j < m; j++) {
+            state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+            keys_int64[j] = 2 * (int64_t) (state % n) + 1, keys[j] = (void *) (uintptr_t) keys_int64[j];
+            expected += state % n;
+        }
+
+        start = clock();
+        for (LENGTH_DT j = 0; j < m; j++) { checksum += binary_search(keys_int64[j], arr_int64, n); }
+        ns[0] = elapsed_ns(start, m);
+        start = clock();
+        for (LENGTH_DT j = 0; j < m; j++) { checksum += search_lower_bound(arr, n, keys[j], f_compare); }
+        ns[1] = elapsed_ns(start, m);
+        start = clock();
+        for (LENGTH_DT j = 0; j < m; j++) { checksum += search_lower_bound_branchless(arr, n, keys[j], f_compare); }
+        ns[2] = elapsed_ns(start, m);
+        start = clock();
+        search_lower_bound_many(arr, n, keys, m, results, f_compare);
+        for (LENGTH_DT j = 0; j < m; j++) { checksum += results[j]; }
+        ns[3] = elapsed_ns(start, m);
+        start = clock();
+        for (LENGTH_DT j = 0; j < m; j++) { checksum += search_lower_bound_int64(arr_int64, n, keys_int64[j]); }
+        ns[4] = elapsed_ns(start, m);
+        free(arr_int64);
+
+        if (n <= BENCH_AVL_MAX) {
+            avl_tree *tree = avl_create();
+            for (LENGTH_DT i = 0; i < n; i++) { avl_insert(tree, arr[i], f_compare); }
+            start = clock();
+            for (LENGTH_DT j = 0; j < m; j++) { checksum += avl_find(tree, keys[j], f_compare) == keys[j]; }
+            ns[5] = elapsed_ns(start, m);
+            avl_destroy(tree);
+            checksum -= m;
+        }
+        free(arr);
+
+        printf("%10ld %10.1f %10.1f %10.1f %10.1f %10.1f ", (long) n, ns[0], ns[1], ns[2], ns[3], ns[4]);
+        if (n <= BENCH_AVL_MAX) { printf("%10.1f\n", ns[5]); } else { printf("%10s\n", "-"); }
+        if (checksum != 5 * expected) { printf("(checksum mismatch)\n"); }
+    }
+    free(keys), free(keys_int64), free(results);
+    return 0;
+}
+
+/**
+ *  @brief      : The binary search of 'data_structures_and_algorithms.ipynb' (on 64-bit integers).
+**/
+LENGTH_DT binary_search(int64_t elem, const int64_t *arr, LENGTH_DT len) {
+    LENGTH_DT lower = 0, upper = len - 1, mid;
+    while (lower <= upper) {
+        mid = (lower + upper) / 2;
+        if (elem == arr[mid]) {
+            return mid;
+        } else if (elem > arr[mid]) {
+            lower = mid + 1;
+        } else {
+            upper = mid - 1;
+        }
+    }
+    return -1;
+}
+
+double elapsed_ns(clock_t start, LENGTH_DT ops) {
+    return (double) (clock() - start) / CLOCKS_PER_SEC * 1e9 / ops;
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return (intptr_t) new_data < (intptr_t) old_data ? 1 : 0;
+}
+
+#endif
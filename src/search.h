@@ -0,0 +1,109 @@
+/**
+ ****************************************************************
+ * @file            : search.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations and macros of the implementation of binary search kernels over sorted arrays of the
+ *                      data-type (classic, branchless, batched), and over sorted arrays of 64-bit integers (AVX2).
+ * **************************************************************
+ **/
+
+#ifndef _SEARCH_H_
+#define _SEARCH_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "shared_defs.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : No. of keys searched at once (interleaved) by 'search_lower_bound_many'.
+**/
+#define SEARCH_BATCH_SIZE   16
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Get the index of the first item of a sorted array that does not go before a key (or 'n' if none).
+ *  @param      : [ Sorted array of items. ]
+ *                [ No. of items. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Index.
+**/
+LENGTH_DT search_lower_bound(DATA_TYPE *arr, LENGTH_DT n, DATA_TYPE key,
+                                unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Get the index of the first item of a sorted array that a key goes before (or 'n' if none).
+ *  @param      : [ Sorted array of items. ]
+ *                [ No. of items. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Index.
+**/
+LENGTH_DT search_upper_bound(DATA_TYPE *arr, LENGTH_DT n, DATA_TYPE key,
+                                unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Get the range ['lower bound', 'upper bound') of items of a sorted array that are equal to a key.
+ *  @param      : [ Sorted array of items. ]
+ *                [ No. of items. ]
+ *                [ Key. ]
+ *                [ Pointer to store the start of the range in. ]
+ *                [ Pointer to store the end of the range (exclusive) in. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+void search_equal_range(DATA_TYPE *arr, LENGTH_DT n, DATA_TYPE key, LENGTH_DT *lo, LENGTH_DT *hi,
+                            unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Same as 'search_lower_bound', but without data-dependent branches, and prefetching the next probes.
+ *  @param      : [ Sorted array of items. ]
+ *                [ No. of items. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Index.
+**/
+LENGTH_DT search_lower_bound_branchless(DATA_TYPE *arr, LENGTH_DT n, DATA_TYPE key,
+                                            unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Get the lower bounds of many keys in a sorted array (see 'search_lower_bound'), searching
+ *                  'SEARCH_BATCH_SIZE' keys at once, so that their cache misses overlap.
+ *  @param      : [ Sorted array of items. ]
+ *                [ No. of items. ]
+ *                [ Array of keys. ]
+ *                [ No. of keys. ]
+ *                [ Array to store the index of each key in (of at least 'm' indices). ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+void search_lower_bound_many(DATA_TYPE *arr, LENGTH_DT n, DATA_TYPE *keys, LENGTH_DT m, LENGTH_DT *results,
+                                unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Get the index of the first integer of a sorted array that is not less than a key (or 'n' if none).
+ *                  With AVX2, the last 16 (or less) candidates are compared at once.
+ *  @param      : [ Sorted array of integers. ]
+ *                [ No. of integers. ]
+ *                [ Key. ]
+ *  @return     : Index.
+**/
+LENGTH_DT search_lower_bound_int64(const int64_t *arr, LENGTH_DT n, int64_t key);
+
+/**
+ *  @brief      : Get the index of the first integer of a sorted array that is greater than a key (or 'n' if none).
+ *  @param      : [ Sorted array of integers. ]
+ *                [ No. of integers. ]
+ *                [ Key. ]
+ *  @return     : Index.
+**/
+LENGTH_DT search_upper_bound_int64(const int64_t *arr, LENGTH_DT n, int64_t key);
+
+#endif
@@ -0,0 +1,461 @@
+/**
+ ****************************************************************
+ * @file            : sharded_tree.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of a sharded sorted list, that spreads its items over many AVL trees (by hash or
+ *                      by range), each guarded by its own reader-writer lock.
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#include "sharded_tree.h"
+#include "heap.h"
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static st_tree * st_create(LENGTH_DT n_shards);
+static st_shard * st_shard_of(st_tree *st, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : (for internal use) Allocating dynamic memory for a sharded tree structure (and its shards, aligned to
+ *                  a cache line), initializing and returning a pointer to it.
+ *  @param      : [ No. of shards. ]
+ *  @return     : Pointer to tree.
+**/
+static st_tree * st_create(LENGTH_DT n_shards) {
+    st_tree *st = (st_tree *) malloc(sizeof(st_tree));
+    st->n_shards = n_shards < 1 ? 1 : n_shards;
+    st->memory = malloc(st->n_shards * sizeof(st_shard) + ST_CACHE_LINE - 1);
+    st->shards = (st_shard *) (((uintptr_t) st->memory + ST_CACHE_LINE - 1) & ~((uintptr_t) ST_CACHE_LINE - 1));
+    for (LENGTH_DT i = 0; i < st->n_shards; i++) {
+        pthread_rwlock_init(&st->shards[i].s.lock, NULL);
+        st->shards[i].s.tree = avl_create();
+    }
+    st->f_hash = NULL;
+    st->bounds = NULL;
+    return st;
+}
+
+/**
+ *  @brief      : Allocating dynamic memory for a tree sharded by hash, initializing and returning a pointer to it.
+ *  @param      : [ No. of shards. ]
+ *                [ Function that receives a key, and returns its hash. ]
+ *  @return     : Pointer to tree.
+**/
+st_tree * st_create_hash(LENGTH_DT n_shards, uint64_t (*f_hash)(DATA_TYPE key)) {
+    st_tree *st = st_create(n_shards);
+    st->f_hash = f_hash;
+    return st;
+}
+
+/**
+ *  @brief      : Allocating dynamic memory for a tree sharded by range, initializing and returning a pointer to it.
+ *  @param      : [ Array of bounds. ]
+ *                [ No. of bounds. ]
+ *  @return     : Pointer to tree.
+**/
+st_tree * st_create_range(DATA_TYPE *bounds, LENGTH_DT n_bounds) {
+    st_tree *st = st_create(n_bounds + 1);
+    if (st->n_shards > 1) {
+        st->bounds = (DATA_TYPE *) malloc((st->n_shards - 1) * sizeof(DATA_TYPE));
+        memcpy(st->bounds, bounds, (st->n_shards - 1) * sizeof(DATA_TYPE));
+    }
+    return st;
+}
+
+/**
+ *  @brief      : (for internal use) Get the shard of a key. By hash, the top 32 bits of the hash are scaled to the no.
+ *                  of shards (by a multiply and a shift, rather than a division). By range, the bounds are binary searched
+ *                  for the first one on the right of the key.
+ *  @param      : [ Tree. ]
+ *                [ Key. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : Pointer to shard.
+**/
+static st_shard * st_shard_of(st_tree *st, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    if (st->f_hash != NULL) {
+        return st->shards + (LENGTH_DT) (((st->f_hash(key) >> 32) * (uint64_t) st->n_shards) >> 32);
+    }
+    LENGTH_DT lo = 0, hi = st->n_shards - 1;
+    while (lo < hi) {
+        LENGTH_DT mid = lo + (hi - lo) / 2;
+        if (f_compare(key, st->bounds[mid])) { hi = mid; }
+        else { lo = mid + 1; }
+    }
+    return st->shards + lo;
+}
+
+/**
+ *  @brief      : Insert data in a tree.
+ *  @param      : [ Tree. ]
+ *                [ Data to insert. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : None.
+**/
+void st_insert(st_tree *st, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    st_shard *shard = st_shard_of(st, data, f_compare);
+    pthread_rwlock_wrlock(&shard->s.lock);
+    avl_insert(shard->s.tree, data, f_compare);
+    pthread_rwlock_unlock(&shard->s.lock);
+}
+
+/**
+ *  @brief      : Find data equal to a key.
+ *  @param      : [ Tree. ]
+ *                [ Key to find. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE st_find(st_tree *st, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    st_shard *shard = st_shard_of(st, key, f_compare);
+    pthread_rwlock_rdlock(&shard->s.lock);
+    DATA_TYPE data = avl_find(shard->s.tree, key, f_compare);
+    pthread_rwlock_unlock(&shard->s.lock);
+    return data;
+}
+
+/**
+ *  @brief      : Delete data equal to a key. The item is located by its rank (the index of the first item equal to
+ *                  the key, if any), then deleted by index.
+ *  @param      : [ Tree. ]
+ *                [ Key to delete. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE st_delete(st_tree *st, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    st_shard *shard = st_shard_of(st, key, f_compare);
+    DATA_TYPE data = DEFAULT_VALUE;
+    pthread_rwlock_wrlock(&shard->s.lock);
+    LENGTH_DT i = avl_rank(shard->s.tree, key, f_compare);
+    if (i < shard->s.tree->length && !f_compare(key, avl_get(shard->s.tree, i))) {
+        data = avl_delete(shard->s.tree, i, f_compare);
+    }
+    pthread_rwlock_unlock(&shard->s.lock);
+    return data;
+}
+
+/**
+ *  @brief      : Get the no. of items in a tree.
+ *  @param      : [ Tree. ]
+ *  @return     : No. of items.
+**/
+LENGTH_DT st_length(st_tree *st) {
+    LENGTH_DT length = 0;
+    for (LENGTH_DT i = 0; i < st->n_shards; i++) {
+        pthread_rwlock_rdlock(&st->shards[i].s.lock);
+        length += st->shards[i].s.tree->length;
+        pthread_rwlock_unlock(&st->shards[i].s.lock);
+    }
+    return length;
+}
+
+/**
+ *  @brief      : Returns a list from a tree (left-to-right). Shards are locked in order (and a writer locks one shard
+ *                  only, so this never deadlocks). By range, the list of each shard is appended to the result as a whole.
+ *                  By hash, each shard is copied into an array (so that locks are released early), and the arrays are
+ *                  merged through an indexed heap of the next item of each shard.
+ *  @param      : [ Tree. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : Pointer to list.
+**/
+ll_list * st_make_list(st_tree *st, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    ll_list *list = ll_create();
+    for (LENGTH_DT i = 0; i < st->n_shards; i++) {
+        pthread_rwlock_rdlock(&st->shards[i].s.lock);
+    }
+
+    if (st->f_hash == NULL) {
+        for (LENGTH_DT i = 0; i < st->n_shards; i++) {
+            ll_list *part = avl_make_list(st->shards[i].s.tree);
+            pthread_rwlock_unlock(&st->shards[i].s.lock);
+            ll_concat(list, part);
+            ll_destroy(part);
+        }
+        return list;
+    }
+
+    LENGTH_DT *ends = (LENGTH_DT *) malloc((st->n_shards + 1) * sizeof(LENGTH_DT));
+    ends[0] = 0;
+    for (LENGTH_DT i = 0; i < st->n_shards; i++) {
+        ends[i + 1] = ends[i] + st->shards[i].s.tree->length;
+    }
+    DATA_TYPE *arr = (DATA_TYPE *) malloc(ends[st->n_shards] * sizeof(DATA_TYPE));
+    for (LENGTH_DT i = 0; i < st->n_shards; i++) {
+        avl_make_array(st->shards[i].s.tree, arr + ends[i]);
+        pthread_rwlock_unlock(&st->shards[i].s.lock);
+    }
+
+    ihp_heap *heap = ihp_create(st->n_shards, HP_DEFAULT_ARITY);
+    LENGTH_DT *next = (LENGTH_DT *) malloc(st->n_shards * sizeof(LENGTH_DT));
+    for (LENGTH_DT i = 0; i < st->n_shards; i++) {
+        next[i] = ends[i];
+        if (next[i] < ends[i + 1]) { ihp_push(heap, i, arr[next[i]++], f_compare); }
+    }
+    while (heap->length > 0) {
+        LENGTH_DT i = ihp_peek(heap);
+        ll_append(list, ihp_get(heap, i));
+        ihp_pop(heap, f_compare);
+        if (next[i] < ends[i + 1]) { ihp_push(heap, i, arr[next[i]++], f_compare); }
+    }
+
+    ihp_destroy(heap);
+    free(next);
+    free(arr);
+    free(ends);
+    return list;
+}
+
+/**
+ *  @brief      : De-allocates a tree, its shards, and all its items.
+ *  @param      : [ Tree. ]
+ *  @return     : None.
+**/
+void st_destroy(st_tree *st) {
+    for (LENGTH_DT i = 0; i < st->n_shards; i++) {
+        pthread_rwlock_destroy(&st->shards[i].s.lock);
+        avl_destroy(st->shards[i].s.tree);
+    }
+    free(st->memory);
+    free(st->bounds);
+    free(st);
+}
+
+/* ********************* 'main' function defintion SECTION (TEST) ********************** */
+
+#ifdef _MAIN_SHARDED_TREE_              /* compile-time switch */
+
+#include "hash_map.h"
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+/**
+ *  @brief      : No. of threads, and no. of keys per thread, of the concurrent test.
+**/
+#define T_THREADS       4
+#define T_KEYS          20000
+
+unsigned char f_compare(void *new_data, void *old_data);
+void f_print(void *data);
+void f_clean(ll_list *list);
+
+void t_insert_delete(st_tree *st);
+void t_concurrent(st_tree *st);
+
+int main() {
+    void *arr_bounds[] = {(void *) 25, (void *) 50, (void *) 75};
+    printf("*************** TREE (HASH, 4 SHARDS) ***************\n");
+    st_tree *st = st_create_hash(4, hm_hash_int);
+    t_insert_delete(st);
+    t_concurrent(st);
+    st_destroy(st);
+    printf("*************** TREE (RANGE, 4 SHARDS) ***************\n");
+    st = st_create_range(arr_bounds, LEN(arr_bounds));
+    t_insert_delete(st);
+    t_concurrent(st);
+    st_destroy(st);
+    printf("*************** TREE (RANGE, 1 SHARD) ***************\n");
+    st = st_create_range(NULL, 0);
+    t_insert_delete(st);
+    st_destroy(st);
+    return 0;
+}
+
+void t_insert_delete(st_tree *st) {
+    printf("*************** TEST (INSERT/DELETE) ***************\n");
+    long arr_data[] = {50, 20, 80, 10, 30, 20, 70, 90, 60, 40, 25, 75};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        st_insert(st, (void *) arr_data[i], f_compare);
+    }
+    ll_list *items = st_make_list(st, f_compare);
+    ll_print(items, f_print, f_clean);
+    ll_destroy(items);
+    long arr_key[] = {20, 35, 90, 10, 20, 75};
+    for (int i = 0; i < LEN(arr_key); i++) {
+        printf("Deleting: %ld -> %ld\n", arr_key[i], (long) st_delete(st, (void *) arr_key[i], f_compare));
+    }
+    printf("Find 30: %ld, find 90: %ld, length: %ld\n", (long) st_find(st, (void *) 30, f_compare),
+            (long) st_find(st, (void *) 90, f_compare), (long) st_length(st));
+    items = st_make_list(st, f_compare);
+    ll_print(items, f_print, f_clean);
+    ll_destroy(items);
+}
+
+/**
+ *  @brief      : Each thread inserts its own keys (interleaved with the other threads' keys), deletes the even ones,
+ *                  and looks up all of them.
+**/
+void * t_worker(void *arg) {
+    st_tree *st = ((void **) arg)[0];
+    long id = (long) ((void **) arg)[1], errors = 0;
+    for (long i = 0; i < T_KEYS; i++) {
+        st_insert(st, (void *) (i * T_THREADS + id + 100), f_compare);
+    }
+    for (long i = 0; i < T_KEYS; i += 2) {
+        errors += st_delete(st, (void *) (i * T_THREADS + id + 100), f_compare) == NULL;
+    }
+    for (long i = 0; i < T_KEYS; i++) {
+        errors += (st_find(st, (void *) (i * T_THREADS + id + 100), f_compare) != NULL) != (i % 2 == 1);
+    }
+    return (void *) errors;
+}
+
+void t_concurrent(st_tree *st) {
+    printf("*************** TEST (CONCURRENT) ***************\n");
+    pthread_t threads[T_THREADS];
+    void *args[T_THREADS][2];
+    long errors = 0, sorted = 1;
+
+    for (long t = 0; t < T_THREADS; t++) {
+        args[t][0] = st, args[t][1] = (void *) t;
+        pthread_create(threads + t, NULL, t_worker, args[t]);
+    }
+    for (long t = 0; t < T_THREADS; t++) {
+        void *result;
+        pthread_join(threads[t], &result);
+        errors += (long) result;
+    }
+    ll_list *items = st_make_list(st, f_compare);
+    for (ll_node *node = items->head; node != NULL && node->next != NULL; node = node->next) {
+        sorted &= !f_compare(node->next->data, node->data);
+    }
+    printf("Threads: %d, errors: %ld, length: %ld, listed: %ld, sorted: %ld\n", T_THREADS, errors,
+            (long) st_length(st), (long) items->length, sorted);
+    ll_destroy(items);
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return (long) new_data < (long) old_data ? 1 : 0;
+}
+
+void f_print(void *data) {
+    printf("%ld, ", (long) data);
+}
+
+void f_clean(ll_list *list) {
+    printf("\b\b \n");
+}
+
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_SHARDED_TREE_             /* compile-time switch */
+
+#include <time.h>
+#include "hash_map.h"
+
+/**
+ *  @brief      : Benchmark parameters (shared by all threads).
+**/
+typedef struct BENCH {
+    st_tree *st;
+    avl_tree *tree;
+    pthread_mutex_t lock;
+    LENGTH_DT ops;                                  /* per thread */
+    LENGTH_DT key_range;
+    LENGTH_DT n_shards;
+    int insert_pct;
+} bench;
+
+unsigned char f_compare(void *new_data, void *old_data);
+void * run_sharded_tree(void *arg);
+void * run_avl_tree(void *arg);
+double run(bench *b, int threads, void * (*f_run)(void *));
+
+/**
+ *  @brief      : Benchmark of the scalability of the sharded tree (by hash) against an AVL tree guarded by a mutex, for
+ *                  a mix of inserts, deletes and lookups of random keys, at 1, 2, 4, ... threads (each doing the same
+ *                  no. of operations).
+ *                  (Usage: <max no. of threads (default: 64)> <operations per thread (default: 2^18)>
+ *                          <percentage of writes, half inserts and half deletes (default: 50)> <no. of shards (default: 64)>)
+**/
+int main(int argc, char *argv[]) {
+    int max_threads = argc > 1 ? atoi(argv[1]) : 64;
+    bench b;
+    b.ops = argc > 2 ? atol(argv[2]) : 1L << 18;
+    b.insert_pct = argc > 3 ? atoi(argv[3]) : 50;
+    b.n_shards = argc > 4 ? atol(argv[4]) : 64;
+    b.key_range = 1L << 22;
+    pthread_mutex_init(&b.lock, NULL);
+
+    printf("%8s %21s %18s\n", "threads", "sharded_tree (Mops/s)", "avl+mutex (Mops/s)");
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        double st_mops = run(&b, threads, run_sharded_tree);
+        double avl_mops = run(&b, threads, run_avl_tree);
+        printf("%8d %21.2f %18.2f\n", threads, st_mops, avl_mops);
+    }
+    pthread_mutex_destroy(&b.lock);
+    return 0;
+}
+
+/**
+ *  @brief      : Fill a fresh sharded tree and tree with half the key range (every other key), run the threads, and
+ *                  return the throughput (in millions of operations per second, wall-clock).
+**/
+double run(bench *b, int threads, void * (*f_run)(void *)) {
+    pthread_t *tids = (pthread_t *) malloc(threads * sizeof(pthread_t));
+    struct timespec start, end;
+
+    b->st = st_create_hash(b->n_shards, hm_hash_int);
+    b->tree = avl_create();
+    for (LENGTH_DT k = 0; k < b->key_range; k += 2) {
+        if (f_run == run_sharded_tree) { st_insert(b->st, (void *) k, f_compare); }
+        else { avl_insert(b->tree, (void *) k, f_compare); }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int t = 0; t < threads; t++) {
+        pthread_create(tids + t, NULL, f_run, b);
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    st_destroy(b->st);
+    avl_destroy(b->tree);
+    free(tids);
+    return threads * b->ops / ((end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3);
+}
+
+void * run_sharded_tree(void *arg) {
+    bench *b = (bench *) arg;
+    uint64_t state = (uint64_t) (uintptr_t) &state | 1;
+    for (LENGTH_DT i = 0; i < b->ops; i++) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        void *key = (void *) (uintptr_t) ((state >> 8) % b->key_range);
+        int op = (int) (state % 100);
+        if (op < b->insert_pct / 2) { st_insert(b->st, key, f_compare); }
+        else if (op < b->insert_pct) { st_delete(b->st, key, f_compare); }
+        else { st_find(b->st, key, f_compare); }
+    }
+    return NULL;
+}
+
+void * run_avl_tree(void *arg) {
+    bench *b = (bench *) arg;
+    uint64_t state = (uint64_t) (uintptr_t) &state | 1;
+    for (LENGTH_DT i = 0; i < b->ops; i++) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        void *key = (void *) (uintptr_t) ((state >> 8) % b->key_range);
+        int op = (int) (state % 100);
+        pthread_mutex_lock(&b->lock);
+        if (op < b->insert_pct / 2) {
+            avl_insert(b->tree, key, f_compare);
+        } else if (op < b->insert_pct) {
+            LENGTH_DT j = avl_rank(b->tree, key, f_compare);
+            if (j < b->tree->length && !f_compare(key, avl_get(b->tree, j))) { avl_delete(b->tree, j, f_compare); }
+        } else {
+            avl_find(b->tree, key, f_compare);
+        }
+        pthread_mutex_unlock(&b->lock);
+    }
+    return NULL;
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return (uintptr_t) new_data < (uintptr_t) old_data ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ ****************************************************************
+ * @file            : sharded_tree.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the implementation of a sharded sorted list, that spreads its
+ *                      items over many AVL trees (by hash or by range), each guarded by its own reader-writer lock.
+ *                      (Note: Requires POSIX threads.)
+ * **************************************************************
+ **/
+
+#ifndef _SHARDED_TREE_H_
+#define _SHARDED_TREE_H_
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L                     /* for 'pthread_rwlock_t' under strict C99 */
+#endif
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include "shared_defs.h"
+#include "avl_tree.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Size of a cache line, that each shard is padded (and aligned) to, so that threads working on different
+ *                  shards never write to the same line.
+**/
+#define ST_CACHE_LINE       64
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Shard structure (a tree, and the lock guarding it), padded to a whole no. of cache lines.
+**/
+typedef union ST_SHARD {
+    struct {
+        pthread_rwlock_t lock;
+        avl_tree *tree;
+    } s;
+    char padding[(sizeof(pthread_rwlock_t) + sizeof(avl_tree *) + ST_CACHE_LINE - 1) / ST_CACHE_LINE * ST_CACHE_LINE];
+} st_shard;
+
+/**
+ *  @brief      : Sharded tree structure. Items are spread by the hash of their key ('f_hash'), or by range ('bounds',
+ *                  where shard 'i' holds the items from 'bounds[i-1]' up to, and not including, 'bounds[i]').
+**/
+typedef struct ST_TREE {
+    st_shard *shards;                               /* aligned to a cache line */
+    void *memory;                                   /* allocated memory (unaligned) */
+    LENGTH_DT n_shards;
+    uint64_t (*f_hash)(DATA_TYPE key);              /* NULL if sharded by range */
+    DATA_TYPE *bounds;                              /* 'n_shards - 1' sorted keys (NULL if none) */
+} st_tree;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Create a tree sharded by hash (dynamically, on heap). Point operations spread evenly over the shards,
+ *                  whatever the order of the keys, but ordered operations must merge all shards.
+ *  @param      : [ No. of shards (e.g: a few times the no. of threads). ]
+ *                [ Function that receives a key, and returns its hash (equal keys must have equal hashes). ]
+ *  @return     : Pointer to tree.
+**/
+st_tree * st_create_hash(LENGTH_DT n_shards, uint64_t (*f_hash)(DATA_TYPE key));
+
+/**
+ *  @brief      : Create a tree sharded by range (dynamically, on heap), with one more shard than bounds. Ordered operations
+ *                  only concatenate the shards, but point operations spread evenly only if the keys do.
+ *  @param      : [ Array of bounds (sorted, and copied). ]
+ *                [ No. of bounds. ]
+ *  @return     : Pointer to tree.
+**/
+st_tree * st_create_range(DATA_TYPE *bounds, LENGTH_DT n_bounds);
+
+/**
+ *  @brief      : Insert data in a tree (locking its shard for writing).
+ *  @param      : [ Tree. ]
+ *                [ Data to insert. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : None.
+**/
+void st_insert(st_tree *st, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Find data equal to a key (locking its shard for reading). If not found, returns DEFAULT_VALUE stored in
+ *                  'shared_defs.h'.
+ *  @param      : [ Tree. ]
+ *                [ Key to find. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE st_find(st_tree *st, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Delete data equal to a key (locking its shard for writing). If not found, nothing happens, and returns
+ *                  DEFAULT_VALUE stored in 'shared_defs.h'.
+ *  @param      : [ Tree. ]
+ *                [ Key to delete. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE st_delete(st_tree *st, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Get the no. of items in a tree (locking each shard for reading, in turn).
+ *  @param      : [ Tree. ]
+ *  @return     : No. of items.
+**/
+LENGTH_DT st_length(st_tree *st);
+
+/**
+ *  @brief      : Returns a list from a tree (left-to-right), locking all shards for reading at once, so that the list is a
+ *                  snapshot. Shards are concatenated (if sharded by range), or merged (if sharded by hash). Tree is unmodified.
+ *  @param      : [ Tree. ]
+ *                [ Function that receives the new data and the data of the current traverse node, and returns 0 (right) or 1 (left). ]
+ *  @return     : Pointer to list.
+**/
+ll_list * st_make_list(st_tree *st, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : De-allocates a tree, its shards, and all its items.
+ *  @param      : [ Tree. ]
+ *  @return     : None.
+**/
+void st_destroy(st_tree *st);
+
+#endif
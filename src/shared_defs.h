@@ -1,4 +1,6 @@
 
+#include <stddef.h>
+
 /**
  *  @brief      : The data-type of choice stored in the structures.
  *                  (Note: Should be 'void *' for generality, and for many functions, that depend on other structures.)
@@ -18,3 +20,9 @@
  *                  (Note: When negative, it permits negative or reverse indexing.)
 **/
 #define LENGTH_DT signed long int
+
+/**
+ *  @brief      : Get a pointer to the structure containing a member, from a pointer to that member.
+ *                  (Note: Used by intrusive structures, to get the user's structure from its embedded hook.)
+**/
+#define CONTAINER_OF(ptr, type, member) ((type *) ((char *) (ptr) - offsetof(type, member)))
@@ -0,0 +1,711 @@
+/**
+ ****************************************************************
+ * @file            : skip_list.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of a lock-free (concurrent) skip list, a sorted set that many threads may insert
+ *                      into, delete from, and search at once.
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#include "skip_list.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Macro functions of marked pointers (the lowest bit of a next pointer marks its node as deleted).
+**/
+#define SL_MARK                 ((uintptr_t) 1)
+#define SL_IS_MARKED(next)      (((next) & SL_MARK) != 0)
+#define SL_PTR(next)            ((sl_node *) ((next) & ~SL_MARK))
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static sl_node * sl_create_node(DATA_TYPE data, int height);
+static int sl_random_height();
+static unsigned char sl_search(sl_list *list, DATA_TYPE key, sl_node **preds, sl_node **succs,
+                                unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static ebr_thread * sl_enter(sl_list *list);
+static void sl_exit(ebr_thread *thread);
+static void sl_release(sl_list *list, sl_node *node);
+static void sl_retire(sl_list *list, sl_node *node);
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : Allocating dynamic memory for a list structure (and its head), initializing and returning the pointer.
+ *  @param      : None.
+ *  @return     : Pointer to list.
+**/
+sl_list * sl_create() {
+    return sl_create_ebr(NULL);
+}
+
+/**
+ *  @brief      : Allocating dynamic memory for a list structure (and its head), whose deleted nodes are retired in a
+ *                  domain, initializing and returning the pointer.
+ *  @param      : [ Domain (or NULL). ]
+ *  @return     : Pointer to list.
+**/
+sl_list * sl_create_ebr(ebr_domain *domain) {
+    sl_list *new_list = (sl_list *) malloc(sizeof(sl_list));
+    new_list->head = sl_create_node(DEFAULT_VALUE, SL_MAX_HEIGHT);
+    atomic_init(&new_list->length, 0);
+    new_list->domain = domain;
+    atomic_init(&new_list->retired, NULL);
+    return new_list;
+}
+
+/**
+ *  @brief      : (for internal use) Allocating dynamic memory for a node (with a next pointer per level, all NULL).
+ *  @param      : [ Data to store. ]
+ *                [ Height of node. ]
+ *  @return     : Pointer to node.
+**/
+static sl_node * sl_create_node(DATA_TYPE data, int height) {
+    sl_node *new_node = (sl_node *) malloc(sizeof(sl_node) + height * sizeof(_Atomic uintptr_t));
+    new_node->data = data;
+    new_node->retired_next = NULL;
+    atomic_init(&new_node->owners, 2);
+    new_node->height = height;
+    for (int l = 0; l < height; l++) {
+        atomic_init(&new_node->next[l], (uintptr_t) NULL);
+    }
+    return new_node;
+}
+
+/**
+ *  @brief      : (for internal use) Get a random height for a new node, from a per-thread random number generator
+ *                  (xorshift, seeded by the address of its state, which differs per thread). Each extra level is
+ *                  taken with probability 1/4 (two random bits being zero).
+ *  @param      : None.
+ *  @return     : Height.
+**/
+static int sl_random_height() {
+    static _Thread_local uint64_t state = 0;
+    int height = 1;
+
+    if (state == 0) {
+        state = (uint64_t) (uintptr_t) &state * 0x9E3779B97F4A7C15ULL | 1;
+    }
+    state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+    for (uint64_t bits = state; (bits & 3) == 0 && height < SL_MAX_HEIGHT; bits >>= 2) {
+        height++;
+    }
+    return height;
+}
+
+/**
+ *  @brief      : (for internal use) Find the predecessor and successor of a key at each level, descending from the top
+ *                  level of the head. At each level, nodes smaller than the key are passed, and a node that is marked
+ *                  (deleted) is unlinked from its predecessor (with a CAS), helping the thread that deleted it. If the
+ *                  CAS fails (the predecessor changed, or is itself deleted), the search restarts from the head.
+ *  @param      : [ List. ]
+ *                [ Key. ]
+ *                [ Array to store the predecessor at each level in (or NULL). ]
+ *                [ Array to store the successor at each level in (or NULL). ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : 1 if the successor at the bottom level is equal to the key, else 0.
+**/
+static unsigned char sl_search(sl_list *list, DATA_TYPE key, sl_node **preds, sl_node **succs,
+                                unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    sl_node *pred, *curr = NULL;
+
+retry:
+    pred = list->head;
+    for (int l = SL_MAX_HEIGHT - 1; l >= 0; l--) {
+        curr = SL_PTR(atomic_load(&pred->next[l]));
+        while (curr != NULL) {
+            uintptr_t next = atomic_load(&curr->next[l]);
+            if (SL_IS_MARKED(next)) {
+                uintptr_t expected = (uintptr_t) curr;
+                if (!atomic_compare_exchange_strong(&pred->next[l], &expected, next & ~SL_MARK)) {
+                    goto retry;
+                }
+                curr = SL_PTR(next);
+            } else if (f_compare(curr->data, key)) {
+                pred = curr;
+                curr = SL_PTR(next);
+            } else {
+                break;
+            }
+        }
+        if (preds != NULL) {
+            preds[l] = pred, succs[l] = curr;
+        }
+    }
+    return curr != NULL && !f_compare(key, curr->data);
+}
+
+/**
+ *  @brief      : Insert an item. Its node is first linked at the bottom level (with a CAS on its predecessor), which
+ *                  makes it part of the list, then at each higher level of its height, bottom-up. If a CAS fails, the
+ *                  predecessors and successors are searched again. If the node is deleted while being linked, linking
+ *                  stops, and a last search unlinks it from any level it was linked at after its deletion (a level may
+ *                  be linked after the deleter's search, so the node is only retired once both threads released it).
+ *  @param      : [ List. ]
+ *                [ Data to insert. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : 1 if inserted, else 0.
+**/
+unsigned char sl_insert(sl_list *list, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    sl_node *preds[SL_MAX_HEIGHT], *succs[SL_MAX_HEIGHT];
+    sl_node *new_node = NULL;
+    int height = sl_random_height();
+    ebr_thread *thread = sl_enter(list);
+
+    while (1) {
+        uintptr_t expected;
+        if (sl_search(list, data, preds, succs, f_compare)) {
+            free(new_node);
+            sl_exit(thread);
+            return 0;
+        }
+        if (new_node == NULL) {
+            new_node = sl_create_node(data, height);
+        }
+        for (int l = 0; l < height; l++) {
+            atomic_store_explicit(&new_node->next[l], (uintptr_t) succs[l], memory_order_relaxed);
+        }
+        expected = (uintptr_t) succs[0];
+        if (atomic_compare_exchange_strong(&preds[0]->next[0], &expected, (uintptr_t) new_node)) {
+            break;
+        }
+    }
+    atomic_fetch_add(&list->length, 1);
+
+    for (int l = 1; l < height; l++) {
+        while (1) {
+            uintptr_t next = atomic_load(&new_node->next[l]), expected = (uintptr_t) succs[l];
+            if (SL_IS_MARKED(next)) {
+                goto deleted;
+            }
+            if (SL_PTR(next) != succs[l] &&
+                !atomic_compare_exchange_strong(&new_node->next[l], &next, (uintptr_t) succs[l])) {
+                continue;
+            }
+            if (atomic_compare_exchange_strong(&preds[l]->next[l], &expected, (uintptr_t) new_node)) {
+                break;
+            }
+            sl_search(list, data, preds, succs, f_compare);
+            if (succs[0] != new_node) {
+                goto deleted;
+            }
+        }
+    }
+deleted:
+    if (SL_IS_MARKED(atomic_load(&new_node->next[0]))) {
+        sl_search(list, data, NULL, NULL, f_compare);
+    }
+    sl_release(list, new_node);
+    sl_exit(thread);
+    return 1;
+}
+
+/**
+ *  @brief      : Delete an item. Its node is first deleted logically, by marking its next pointers top-down (the
+ *                  thread that marks the bottom level is the one that deletes it), then physically, by a search
+ *                  that unlinks it from all levels. The node is then released, and retired once its inserter released
+ *                  it too (not de-allocated, since other threads may still be reading it).
+ *  @param      : [ List. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE sl_delete(sl_list *list, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    sl_node *preds[SL_MAX_HEIGHT], *succs[SL_MAX_HEIGHT];
+    ebr_thread *thread = sl_enter(list);
+
+    while (sl_search(list, key, preds, succs, f_compare)) {
+        sl_node *node = succs[0];
+        for (int l = node->height - 1; l >= 1; l--) {
+            atomic_fetch_or(&node->next[l], SL_MARK);
+        }
+        if (!SL_IS_MARKED(atomic_fetch_or(&node->next[0], SL_MARK))) {
+            DATA_TYPE data = node->data;
+            sl_search(list, key, NULL, NULL, f_compare);
+            atomic_fetch_sub(&list->length, 1);
+            sl_release(list, node);
+            sl_exit(thread);
+            return data;
+        }
+    }
+    sl_exit(thread);
+    return DEFAULT_VALUE;
+}
+
+/**
+ *  @brief      : (for internal use) Enter a critical section of the list's domain, through the calling thread, if it
+ *                  is registered in it, and not already in a critical section (they must not be nested).
+ *  @param      : [ List. ]
+ *  @return     : Thread entered through (to exit through), or NULL if none.
+**/
+static ebr_thread * sl_enter(sl_list *list) {
+    ebr_thread *thread = list->domain != NULL ? ebr_current() : NULL;
+    if (thread == NULL || thread->domain != list->domain ||
+            (atomic_load_explicit(&thread->state, memory_order_relaxed) & 1) != 0) {
+        return NULL;
+    }
+    ebr_enter(thread);
+    return thread;
+}
+
+/**
+ *  @brief      : (for internal use) Exit a critical section entered by 'sl_enter'.
+ *  @param      : [ Thread (or NULL, if none was entered). ]
+ *  @return     : None.
+**/
+static void sl_exit(ebr_thread *thread) {
+    if (thread != NULL) {
+        ebr_exit(thread);
+    }
+}
+
+/**
+ *  @brief      : (for internal use) Release a node, by its inserter (once done linking it, and unlinking it if it was
+ *                  deleted meanwhile), or by its deleter (once it unlinked it). The last to release it retires it, so
+ *                  a node is never relinked by its inserter after it's retired.
+ *  @param      : [ List. ]
+ *                [ Node. ]
+ *  @return     : None.
+**/
+static void sl_release(sl_list *list, sl_node *node) {
+    if (atomic_fetch_sub(&node->owners, 1) == 1) {
+        sl_retire(list, node);
+    }
+}
+
+/**
+ *  @brief      : (for internal use) Retire a deleted node, through the calling thread if it is registered in the list's
+ *                  domain (to be de-allocated once no thread can still be reading it), else by pushing it onto the list
+ *                  of retired nodes (with a CAS).
+ *  @param      : [ List. ]
+ *                [ Node. ]
+ *  @return     : None.
+**/
+static void sl_retire(sl_list *list, sl_node *node) {
+    ebr_thread *thread = list->domain != NULL ? ebr_current() : NULL;
+    if (thread != NULL && thread->domain == list->domain) {
+        ebr_retire(thread, node, free);
+        return;
+    }
+    sl_node *head = atomic_load(&list->retired);
+    do {
+        node->retired_next = head;
+    } while (!atomic_compare_exchange_weak(&list->retired, &head, node));
+}
+
+/**
+ *  @brief      : Get the node of the first item not smaller than a key. Unlike 'sl_search', deleted nodes are stepped
+ *                  over rather than unlinked, so that no writes are made.
+ *  @param      : [ List. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : Pointer to node, or NULL if none.
+**/
+sl_node * sl_lower_bound(sl_list *list, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    sl_node *pred = list->head, *curr = NULL;
+
+    for (int l = SL_MAX_HEIGHT - 1; l >= 0; l--) {
+        curr = SL_PTR(atomic_load(&pred->next[l]));
+        while (curr != NULL) {
+            uintptr_t next = atomic_load(&curr->next[l]);
+            if (SL_IS_MARKED(next) || f_compare(curr->data, key)) {
+                if (!SL_IS_MARKED(next)) {
+                    pred = curr;
+                }
+                curr = SL_PTR(next);
+            } else {
+                break;
+            }
+        }
+    }
+    return curr;
+}
+
+/**
+ *  @brief      : Find the item equal to a key, as its lower bound, if equal.
+ *  @param      : [ List. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE sl_find(sl_list *list, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    ebr_thread *thread = sl_enter(list);
+    sl_node *node = sl_lower_bound(list, key, f_compare);
+    DATA_TYPE data = node != NULL && !f_compare(key, node->data) ? node->data : DEFAULT_VALUE;
+    sl_exit(thread);
+    return data;
+}
+
+/**
+ *  @brief      : Get the node of the first item (the first node after the head, at the bottom level, not deleted).
+ *  @param      : [ List. ]
+ *  @return     : Pointer to node.
+**/
+sl_node * sl_first(sl_list *list) {
+    return sl_next(list->head);
+}
+
+/**
+ *  @brief      : Get the node of the next item, stepping over deleted nodes at the bottom level.
+ *  @param      : [ Node. ]
+ *  @return     : Pointer to node.
+**/
+sl_node * sl_next(sl_node *node) {
+    sl_node *curr = SL_PTR(atomic_load(&node->next[0]));
+    while (curr != NULL && SL_IS_MARKED(atomic_load(&curr->next[0]))) {
+        curr = SL_PTR(atomic_load(&curr->next[0]));
+    }
+    return curr;
+}
+
+/**
+ *  @brief      : Returns a list of the items in a range of keys, by iterating from the lower bound of the lowest key.
+ *  @param      : [ List. ]
+ *                [ Lowest key (inclusive). ]
+ *                [ Highest key (exclusive). ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : Pointer to list.
+**/
+ll_list * sl_range(sl_list *list, DATA_TYPE lo, DATA_TYPE hi, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    ll_list *range = ll_create();
+    ebr_thread *thread = sl_enter(list);
+    for (sl_node *node = sl_lower_bound(list, lo, f_compare); node != NULL && f_compare(node->data, hi);
+            node = sl_next(node)) {
+        ll_append(range, node->data);
+    }
+    sl_exit(thread);
+    return range;
+}
+
+/**
+ *  @brief      : Returns a list of all items, by iterating from the first.
+ *  @param      : [ List. ]
+ *  @return     : Pointer to list.
+**/
+ll_list * sl_make_list(sl_list *list) {
+    ll_list *items = ll_create();
+    ebr_thread *thread = sl_enter(list);
+    for (sl_node *node = sl_first(list); node != NULL; node = sl_next(node)) {
+        ll_append(items, node->data);
+    }
+    sl_exit(thread);
+    return items;
+}
+
+/**
+ *  @brief      : De-allocate all nodes retired to the list (not through a domain).
+ *  @param      : [ List. ]
+ *  @return     : None.
+**/
+void sl_reclaim(sl_list *list) {
+    sl_node *node = atomic_exchange(&list->retired, NULL);
+    while (node != NULL) {
+        sl_node *next = node->retired_next;
+        free(node);
+        node = next;
+    }
+}
+
+/**
+ *  @brief      : De-allocate all nodes of a list (linked at the bottom level, or retired), then the list itself.
+ *  @param      : [ List. ]
+ *  @return     : None.
+**/
+void sl_destroy(sl_list *list) {
+    sl_node *node = list->head;
+    while (node != NULL) {
+        sl_node *next = SL_PTR(atomic_load(&node->next[0]));
+        free(node);
+        node = next;
+    }
+    sl_reclaim(list);
+    free(list);
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_SKIP_LIST_                 /* compile-time switch */
+
+#include <pthread.h>
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+/**
+ *  @brief      : No. of threads, and no. of keys per thread, of the concurrent test.
+**/
+#define T_THREADS       4
+#define T_KEYS          20000
+
+unsigned char f_compare(void *new_data, void *old_data);
+void f_print(void *data);
+void f_clean(ll_list *list);
+
+void t_insert_delete();
+void t_range();
+void t_concurrent();
+void t_ebr();
+
+int main() {
+    t_insert_delete();
+    t_range();
+    t_concurrent();
+    t_ebr();
+    return 0;
+}
+
+void t_insert_delete() {
+    printf("*************** TEST (INSERT/DELETE) ***************\n");
+    sl_list *list = sl_create();
+    long arr_data[] = {50, 20, 80, 10, 30, 20, 70, 90, 60, 40};
+    for (int i = 0; i < LEN(arr_data); i++) {
+        printf("Inserting: %ld -> %d\n", arr_data[i], sl_insert(list, (void *) arr_data[i], f_compare));
+    }
+    ll_list *items = sl_make_list(list);
+    ll_print(items, f_print, f_clean);
+    ll_destroy(items);
+    long arr_key[] = {20, 25, 90, 10, 20};
+    for (int i = 0; i < LEN(arr_key); i++) {
+        printf("Deleting: %ld -> %ld\n", arr_key[i], (long) sl_delete(list, (void *) arr_key[i], f_compare));
+    }
+    printf("Find 30: %ld, find 90: %ld, length: %ld\n", (long) sl_find(list, (void *) 30, f_compare),
+            (long) sl_find(list, (void *) 90, f_compare), (long) list->length);
+    items = sl_make_list(list);
+    ll_print(items, f_print, f_clean);
+    ll_destroy(items);
+    sl_destroy(list);
+}
+
+void t_range() {
+    printf("*************** TEST (RANGE) ***************\n");
+    sl_list *list = sl_create();
+    for (long i = 1; i <= 20; i++) {
+        sl_insert(list, (void *) (5 * i), f_compare);
+    }
+    printf("Lower bound of 33: %ld\n", (long) sl_lower_bound(list, (void *) 33, f_compare)->data);
+    ll_list *range = sl_range(list, (void *) 33, (void *) 60, f_compare);
+    ll_print(range, f_print, f_clean);
+    ll_destroy(range);
+    sl_destroy(list);
+}
+
+/**
+ *  @brief      : Each thread inserts its own keys (interleaved with the other threads' keys), deletes the even ones,
+ *                  and looks up all of them.
+**/
+void * t_worker(void *arg) {
+    sl_list *list = ((void **) arg)[0];
+    long id = (long) ((void **) arg)[1], errors = 0;
+    for (long i = 0; i < T_KEYS; i++) {
+        errors += !sl_insert(list, (void *) (i * T_THREADS + id + 1), f_compare);
+    }
+    for (long i = 0; i < T_KEYS; i += 2) {
+        errors += sl_delete(list, (void *) (i * T_THREADS + id + 1), f_compare) == NULL;
+    }
+    for (long i = 0; i < T_KEYS; i++) {
+        errors += (sl_find(list, (void *) (i * T_THREADS + id + 1), f_compare) != NULL) != (i % 2 == 1);
+    }
+    return (void *) errors;
+}
+
+void t_concurrent() {
+    printf("*************** TEST (CONCURRENT) ***************\n");
+    sl_list *list = sl_create();
+    pthread_t threads[T_THREADS];
+    void *args[T_THREADS][2];
+    long errors = 0, sorted = 1, count = 0;
+
+    for (long t = 0; t < T_THREADS; t++) {
+        args[t][0] = list, args[t][1] = (void *) t;
+        pthread_create(threads + t, NULL, t_worker, args[t]);
+    }
+    for (long t = 0; t < T_THREADS; t++) {
+        void *result;
+        pthread_join(threads[t], &result);
+        errors += (long) result;
+    }
+    for (sl_node *node = sl_first(list), *next; node != NULL; node = next, count++) {
+        next = sl_next(node);
+        sorted &= next == NULL || f_compare(node->data, next->data);
+    }
+    printf("Threads: %d, errors: %ld, length: %ld, counted: %ld, sorted: %ld\n", T_THREADS, errors,
+            (long) list->length, count, sorted);
+    sl_destroy(list);
+}
+
+/**
+ *  @brief      : Each thread (registered in the list's domain) inserts, deletes and looks up random keys of a small
+ *                  range shared by all threads, so that nodes are often deleted while still being linked.
+**/
+void * t_ebr_worker(void *arg) {
+    sl_list *list = (sl_list *) arg;
+    ebr_thread *thread = ebr_register(list->domain);
+    uint64_t state = (uint64_t) (uintptr_t) &state | 1;
+    long deleted = 0;
+    for (long i = 0; i < T_KEYS * 5; i++) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        void *key = (void *) (long) (state % 64 + 1);
+        if (state >> 62 == 0) { deleted += sl_delete(list, key, f_compare) != NULL; }
+        else if (state >> 62 == 1) { sl_insert(list, key, f_compare); }
+        else { sl_find(list, key, f_compare); }
+    }
+    ebr_unregister(thread);
+    return (void *) deleted;
+}
+
+void t_ebr() {
+    printf("*************** TEST (EBR) ***************\n");
+    ebr_domain *domain = ebr_create();
+    sl_list *list = sl_create_ebr(domain);
+    pthread_t threads[T_THREADS];
+    long deleted = 0, pending = 0, count = 0;
+
+    for (long t = 0; t < T_THREADS; t++) {
+        pthread_create(threads + t, NULL, t_ebr_worker, list);
+    }
+    for (long t = 0; t < T_THREADS; t++) {
+        void *result;
+        pthread_join(threads[t], &result);
+        deleted += (long) result;
+    }
+    for (ebr_thread *thread = atomic_load(&domain->threads); thread != NULL; thread = thread->next) {
+        for (int i = 0; i < 3; i++) {
+            pending += thread->bags[i].length;
+        }
+    }
+    for (sl_node *node = sl_first(list); node != NULL; node = sl_next(node)) {
+        count++;
+    }
+    printf("Threads: %d, length counted: %d, kept on list: %d, reclaimed while in use: %d\n", T_THREADS,
+            list->length == count, atomic_load(&list->retired) != NULL, deleted > 0 && pending < deleted);
+    sl_destroy(list);
+    ebr_destroy(domain);
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return (long) new_data < (long) old_data ? 1 : 0;
+}
+
+void f_print(void *data) {
+    printf("%ld, ", (long) data);
+}
+
+void f_clean(ll_list *list) {
+    printf("\b\b \n");
+}
+
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_SKIP_LIST_                /* compile-time switch */
+
+#include <pthread.h>
+#include <time.h>
+#include "avl_tree.h"
+
+/**
+ *  @brief      : Benchmark parameters (shared by all threads).
+**/
+typedef struct BENCH {
+    sl_list *list;
+    avl_tree *tree;
+    pthread_mutex_t lock;
+    LENGTH_DT ops;                                  /* per thread */
+    LENGTH_DT key_range;
+    int insert_pct;
+} bench;
+
+unsigned char f_compare(void *new_data, void *old_data);
+void * run_skip_list(void *arg);
+void * run_avl_tree(void *arg);
+double run(bench *b, int threads, void * (*f_run)(void *));
+
+/**
+ *  @brief      : Benchmark of the scalability of the skip list against an AVL tree guarded by a mutex, for a mix of
+ *                  inserts and lookups of random keys, at 1, 2, 4, ... threads (each doing the same no. of operations).
+ *                  (Usage: <max no. of threads (default: 64)> <operations per thread (default: 2^18)>
+ *                          <percentage of inserts (default: 50)>)
+**/
+int main(int argc, char *argv[]) {
+    int max_threads = argc > 1 ? atoi(argv[1]) : 64;
+    bench b;
+    b.ops = argc > 2 ? atol(argv[2]) : 1L << 18;
+    b.insert_pct = argc > 3 ? atoi(argv[3]) : 50;
+    b.key_range = 1L << 22;
+    pthread_mutex_init(&b.lock, NULL);
+
+    printf("%8s %18s %18s\n", "threads", "skip_list (Mops/s)", "avl+mutex (Mops/s)");
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        double sl_mops = run(&b, threads, run_skip_list);
+        double avl_mops = run(&b, threads, run_avl_tree);
+        printf("%8d %18.2f %18.2f\n", threads, sl_mops, avl_mops);
+    }
+    pthread_mutex_destroy(&b.lock);
+    return 0;
+}
+
+/**
+ *  @brief      : Fill a fresh list and tree with half the key range (every other key), run the threads, and return the
+ *                  throughput (in millions of operations per second, wall-clock).
+**/
+double run(bench *b, int threads, void * (*f_run)(void *)) {
+    pthread_t *tids = (pthread_t *) malloc(threads * sizeof(pthread_t));
+    struct timespec start, end;
+
+    b->list = sl_create();
+    b->tree = avl_create();
+    for (LENGTH_DT k = 0; k < b->key_range; k += 2) {
+        if (f_run == run_skip_list) { sl_insert(b->list, (void *) k, f_compare); }
+        else { avl_insert(b->tree, (void *) k, f_compare); }
+    }
+    timespec_get(&start, TIME_UTC);
+    for (int t = 0; t < threads; t++) {
+        pthread_create(tids + t, NULL, f_run, b);
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    timespec_get(&end, TIME_UTC);
+    sl_destroy(b->list);
+    avl_destroy(b->tree);
+    free(tids);
+    return threads * b->ops / ((end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3);
+}
+
+void * run_skip_list(void *arg) {
+    bench *b = (bench *) arg;
+    uint64_t state = (uint64_t) (uintptr_t) &state | 1;
+    for (LENGTH_DT i = 0; i < b->ops; i++) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        void *key = (void *) (uintptr_t) ((state >> 8) % b->key_range);
+        if ((LENGTH_DT) (state % 100) < b->insert_pct) { sl_insert(b->list, key, f_compare); }
+        else { sl_find(b->list, key, f_compare); }
+    }
+    return NULL;
+}
+
+void * run_avl_tree(void *arg) {
+    bench *b = (bench *) arg;
+    uint64_t state = (uint64_t) (uintptr_t) &state | 1;
+    for (LENGTH_DT i = 0; i < b->ops; i++) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        void *key = (void *) (uintptr_t) ((state >> 8) % b->key_range);
+        pthread_mutex_lock(&b->lock);
+        if ((LENGTH_DT) (state % 100) < b->insert_pct) {
+            if (avl_find(b->tree, key, f_compare) == NULL) { avl_insert(b->tree, key, f_compare); }
+        } else {
+            avl_find(b->tree, key, f_compare);
+        }
+        pthread_mutex_unlock(&b->lock);
+    }
+    return NULL;
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return (uintptr_t) new_data < (uintptr_t) old_data ? 1 : 0;
+}
+
+#endif
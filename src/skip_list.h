@@ -0,0 +1,168 @@
+/**
+ ****************************************************************
+ * @file            : skip_list.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the implementation of a lock-free (concurrent) skip list,
+ *                      a sorted set that many threads may insert into, delete from, and search at once.
+ *                      (Note: Requires C11 atomics.)
+ * **************************************************************
+ **/
+
+#ifndef _SKIP_LIST_H_
+#define _SKIP_LIST_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "shared_defs.h"
+#include "ebr.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Maximum height (no. of levels) of a node. A node has height 'h' with probability '(1/4)^(h-1) * 3/4',
+ *                  which keeps the list balanced up to about 4^SL_MAX_HEIGHT items.
+**/
+#define SL_MAX_HEIGHT       24
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Node structure (where items are stored). The next pointers (one per level) are stored as integers,
+ *                  whose lowest bit marks the node as deleted (at that level).
+**/
+typedef struct SL_NODE {
+    DATA_TYPE data;
+    struct SL_NODE *retired_next;                   /* next node in the list of retired nodes */
+    _Atomic int owners;                             /* threads yet to release it before it's retired (inserter, deleter) */
+    int height;
+    _Atomic uintptr_t next[];
+} sl_node;
+
+/**
+ *  @brief      : List structure. The head is a sentinel node of height 'SL_MAX_HEIGHT' (with no data). Deleted nodes
+ *                  are retired through the calling thread, if registered in the list's domain, else kept on the list.
+**/
+typedef struct SL_LIST {
+    sl_node *head;
+    _Atomic LENGTH_DT length;
+    ebr_domain *domain;                             /* domain deleted nodes are retired in (NULL if none, see 'sl_create_ebr') */
+    sl_node *_Atomic retired;                       /* deleted nodes, not yet de-allocated (see 'sl_reclaim') */
+} sl_list;
+
+/* ********************* #include SECTION (2) ********************** */
+
+#include "linked_list.h"                            /* This section is for #include's that must follow the struct definitions */
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Create a skip list (dynamically, on heap).
+ *  @param      : None.
+ *  @return     : Pointer to list.
+**/
+sl_list * sl_create();
+
+/**
+ *  @brief      : Create a skip list (dynamically, on heap), whose deleted nodes are retired through epoch-based
+ *                  reclamation (see 'ebr.h'), so they're de-allocated while the list is in use. Threads must register in
+ *                  the domain ('ebr_register') before operating on the list (nodes deleted by unregistered threads are
+ *                  kept until 'sl_reclaim'). Operations enter a critical section themselves, unless called within one,
+ *                  but nodes from 'sl_lower_bound', 'sl_first' and 'sl_next' may only be used within one ('ebr_enter').
+ *  @param      : [ Domain (NULL for none, as 'sl_create'). ]
+ *  @return     : Pointer to list.
+**/
+sl_list * sl_create_ebr(ebr_domain *domain);
+
+/**
+ *  @brief      : Insert an item into a list, if no equal item is in it (thread-safe, lock-free).
+ *  @param      : [ List. ]
+ *                [ Data to insert. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : 1 if inserted, or 0 if an equal item is in the list.
+**/
+unsigned char sl_insert(sl_list *list, DATA_TYPE data, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Delete the item equal to a key from a list (thread-safe, lock-free). If not found, returns
+ *                  DEFAULT_VALUE stored in 'shared_defs.h'.
+ *  @param      : [ List. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE sl_delete(sl_list *list, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Find the item equal to a key in a list (thread-safe, wait-free for a bounded no. of deletions).
+ *                  If not found, returns DEFAULT_VALUE stored in 'shared_defs.h'.
+ *  @param      : [ List. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE sl_find(sl_list *list, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Get the node of the first item that is not smaller than a key (thread-safe). Items can then be
+ *                  iterated in order, from the node, with 'sl_next'.
+ *  @param      : [ List. ]
+ *                [ Key. ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : Pointer to node, or NULL if none.
+**/
+sl_node * sl_lower_bound(sl_list *list, DATA_TYPE key, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Get the node of the first (smallest) item of a list (thread-safe).
+ *  @param      : [ List. ]
+ *  @return     : Pointer to node, or NULL if list is empty.
+**/
+sl_node * sl_first(sl_list *list);
+
+/**
+ *  @brief      : Get the node of the next item in order (thread-safe). Iteration is weakly consistent: Items inserted
+ *                  or deleted during iteration may or may not be visited, but all others are, in order, once.
+ *  @param      : [ Node. ]
+ *  @return     : Pointer to next node, or NULL if none.
+**/
+sl_node * sl_next(sl_node *node);
+
+/**
+ *  @brief      : Returns a list of the items in a range of keys ['lo', 'hi'), in order (thread-safe, weakly consistent).
+ *  @param      : [ List. ]
+ *                [ Lowest key (inclusive). ]
+ *                [ Highest key (exclusive). ]
+ *                [ Function that receives two items, and returns 1 if the first is smaller, else 0. ]
+ *  @return     : Pointer to list.
+**/
+ll_list * sl_range(sl_list *list, DATA_TYPE lo, DATA_TYPE hi, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Returns a list of all items, in order (thread-safe, weakly consistent).
+ *  @param      : [ List. ]
+ *  @return     : Pointer to list.
+**/
+ll_list * sl_make_list(sl_list *list);
+
+/**
+ *  @brief      : De-allocate deleted nodes kept on a list (all of them, unless it has a domain). Must only be called when no other thread is operating on the list (or
+ *                  holds a node of it), since a thread may still be reading a node it found before its deletion.
+ *  @param      : [ List. ]
+ *  @return     : None.
+**/
+void sl_reclaim(sl_list *list);
+
+/**
+ *  @brief      : Destroy list (de-allocated off heap). Must only be called when no other thread is operating on it.
+ *                  (Note: If pointers are the data-type, they're de-allocated, and not the data they point to.)
+ *  @param      : [ List. ]
+ *  @return     : None.
+**/
+void sl_destroy(sl_list *list);
+
+#endif
@@ -0,0 +1,596 @@
+/**
+ ****************************************************************
+ * @file            : sort.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of sorting algorithms on arrays of the data-type (introsort, stable merge sort,
+ *                      radix sort, and parallel merge sort).
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#define _POSIX_C_SOURCE 200809L                         /* for 'pthread' (and 'clock_gettime' in the benchmark) */
+
+#include <pthread.h>
+#include "sort.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Size of the stack of ranges left to sort by introsort. Since the larger range is always pushed, and
+ *                  the smaller one sorted first, no more than 'log2(n)' ranges are ever pushed.
+**/
+#define SORT_STACK_SIZE             64
+
+/**
+ *  @brief      : No. of bits of a key sorted per pass of radix sort, and the no. of buckets of a pass.
+**/
+#define SORT_RADIX_BITS             8
+#define SORT_RADIX_BUCKETS          (1 << SORT_RADIX_BITS)
+#define SORT_RADIX_PASSES           (64 / SORT_RADIX_BITS)
+
+/**
+ *  @brief      : Swap two items of an array.
+**/
+#define SORT_SWAP(arr, i, j)        do { DATA_TYPE tmp = (arr)[i]; (arr)[i] = (arr)[j]; (arr)[j] = tmp; } while (0)
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : (For internal use) Task of a thread of parallel merge sort. Either sorts the range ['lo', 'hi') of
+ *                  'src' (into 'src'), or merges the sorted ranges ['lo', 'mid') and ['mid', 'hi') of 'src' into 'dst'.
+**/
+typedef struct SORT_TASK {
+    DATA_TYPE *src;
+    DATA_TYPE *dst;
+    LENGTH_DT lo, mid, hi;
+    unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data);
+} sort_task;
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static void sort_insertion(DATA_TYPE *arr, LENGTH_DT lo, LENGTH_DT hi,
+                            unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static void sort_sift_down(DATA_TYPE *arr, LENGTH_DT i, LENGTH_DT n,
+                            unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static void sort_heap(DATA_TYPE *arr, LENGTH_DT n, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static LENGTH_DT sort_partition(DATA_TYPE *arr, LENGTH_DT lo, LENGTH_DT hi,
+                                    unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static void sort_merge_runs(DATA_TYPE *src, DATA_TYPE *dst, LENGTH_DT lo, LENGTH_DT mid, LENGTH_DT hi,
+                                unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static void sort_merge_buffered(DATA_TYPE *arr, DATA_TYPE *buf, LENGTH_DT n,
+                                    unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+static void * sort_task_sort(void *arg);
+static void * sort_task_merge(void *arg);
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : (For internal use) Sort the range ['lo', 'hi') of an array, with insertion sort. Stable, since an
+ *                  item is only shifted past items it goes strictly before.
+ *  @param      : [ Array of items. ]
+ *                [ Start of range. ]
+ *                [ End of range (exclusive). ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+static void sort_insertion(DATA_TYPE *arr, LENGTH_DT lo, LENGTH_DT hi,
+                            unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    for (LENGTH_DT i = lo + 1; i < hi; i++) {
+        DATA_TYPE data = arr[i];
+        LENGTH_DT j = i;
+        while (j > lo && f_compare(data, arr[j - 1])) {
+            arr[j] = arr[j - 1];
+            j--;
+        }
+        arr[j] = data;
+    }
+}
+
+/**
+ *  @brief      : (For internal use) Sift an item down a binary max-heap (in-place in an array), until it goes before
+ *                  neither of its children.
+ *  @param      : [ Array of items. ]
+ *                [ Index of item. ]
+ *                [ No. of items in heap. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+static void sort_sift_down(DATA_TYPE *arr, LENGTH_DT i, LENGTH_DT n,
+                            unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    DATA_TYPE data = arr[i];
+    for (LENGTH_DT child = 2 * i + 1; child < n; child = 2 * i + 1) {
+        if (child + 1 < n && f_compare(arr[child], arr[child + 1])) {
+            child++;
+        }
+        if (!f_compare(data, arr[child])) {
+            break;
+        }
+        arr[i] = arr[child];
+        i = child;
+    }
+    arr[i] = data;
+}
+
+/**
+ *  @brief      : (For internal use) Sort an array with heap sort (a binary max-heap is built in-place, then its top
+ *                  is repeatedly swapped to the end). Used by introsort, when quick sort recurses too deeply.
+ *  @param      : [ Array of items. ]
+ *                [ No. of items. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+static void sort_heap(DATA_TYPE *arr, LENGTH_DT n, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    for (LENGTH_DT i = n / 2 - 1; i >= 0; i--) {
+        sort_sift_down(arr, i, n, f_compare);
+    }
+    for (LENGTH_DT end = n - 1; end > 0; end--) {
+        SORT_SWAP(arr, 0, end);
+        sort_sift_down(arr, 0, end, f_compare);
+    }
+}
+
+/**
+ *  @brief      : (For internal use) Partition the range ['lo', 'hi') of an array (of at least 3 items), around the
+ *                  median of its first, middle and last items (Hoare's scheme). The first and last items are ordered
+ *                  first, so that they stop the scans, with no bound checks.
+ *  @param      : [ Array of items. ]
+ *                [ Start of range. ]
+ *                [ End of range (exclusive). ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : Index 'p', where items in ['lo', 'p') do not go after items in ['p', 'hi'). Both are non-empty.
+**/
+static LENGTH_DT sort_partition(DATA_TYPE *arr, LENGTH_DT lo, LENGTH_DT hi,
+                                    unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    LENGTH_DT mid = lo + (hi - lo) / 2, i = lo, j = hi - 1;
+
+    if (f_compare(arr[mid], arr[lo])) { SORT_SWAP(arr, mid, lo); }
+    if (f_compare(arr[j], arr[mid])) {
+        SORT_SWAP(arr, j, mid);
+        if (f_compare(arr[mid], arr[lo])) { SORT_SWAP(arr, mid, lo); }
+    }
+    DATA_TYPE pivot = arr[mid];
+
+    while (1) {
+        do { i++; } while (f_compare(arr[i], pivot));
+        do { j--; } while (f_compare(pivot, arr[j]));
+        if (i >= j) {
+            return j + 1;
+        }
+        SORT_SWAP(arr, i, j);
+    }
+}
+
+/**
+ *  @brief      : Sort an array, with introsort. Ranges are partitioned (quick sort), and a stack of ranges left to sort
+ *                  is kept (the larger range is pushed, and the smaller one sorted next). A range that is partitioned
+ *                  more than '2 * log2(n)' times is heap sorted instead, and a range of at most
+ *                  'SORT_INSERTION_THRESHOLD' items is insertion sorted.
+ *  @param      : [ Array of items. ]
+ *                [ No. of items. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+void sort_intro(DATA_TYPE *arr, LENGTH_DT n, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    LENGTH_DT stack[SORT_STACK_SIZE][3];                    /* 'lo', 'hi', and depth left */
+    LENGTH_DT top = 0, lo = 0, hi = n, depth = 0;
+
+    for (LENGTH_DT m = n; m > 1; m >>= 1) {
+        depth += 2;
+    }
+    while (1) {
+        if (hi - lo <= SORT_INSERTION_THRESHOLD) {
+            sort_insertion(arr, lo, hi, f_compare);
+        } else if (depth == 0) {
+            sort_heap(arr + lo, hi - lo, f_compare);
+        } else {
+            LENGTH_DT p = sort_partition(arr, lo, hi, f_compare);
+            depth--;
+            stack[top][2] = depth;
+            if (p - lo < hi - p) {
+                stack[top][0] = p, stack[top][1] = hi;
+                hi = p;
+            } else {
+                stack[top][0] = lo, stack[top][1] = p;
+                lo = p;
+            }
+            top++;
+            continue;
+        }
+        if (top == 0) {
+            break;
+        }
+        top--;
+        lo = stack[top][0], hi = stack[top][1], depth = stack[top][2];
+    }
+}
+
+/**
+ *  @brief      : (For internal use) Merge the sorted ranges ['lo', 'mid') and ['mid', 'hi') of an array into the same
+ *                  range of another. On ties, the item of the first range is taken, so that merging is stable.
+ *  @param      : [ Source array. ]
+ *                [ Destination array. ]
+ *                [ Start of first range. ]
+ *                [ End of first range (and start of second range). ]
+ *                [ End of second range (exclusive). ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+static void sort_merge_runs(DATA_TYPE *src, DATA_TYPE *dst, LENGTH_DT lo, LENGTH_DT mid, LENGTH_DT hi,
+                                unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    LENGTH_DT i = lo, j = mid, k = lo;
+
+    if (mid == lo || mid == hi || !f_compare(src[mid], src[mid - 1])) {  /* already in order */
+        memcpy(dst + lo, src + lo, (hi - lo) * sizeof(DATA_TYPE));
+        return;
+    }
+    while (i < mid && j < hi) {
+        dst[k++] = f_compare(src[j], src[i]) ? src[j++] : src[i++];
+    }
+    memcpy(dst + k, src + i, (mid - i) * sizeof(DATA_TYPE));
+    k += mid - i;
+    memcpy(dst + k, src + j, (hi - j) * sizeof(DATA_TYPE));
+}
+
+/**
+ *  @brief      : (For internal use) Sort an array, with bottom-up merge sort. Runs of 'SORT_INSERTION_THRESHOLD'
+ *                  items are insertion sorted, then runs are merged pair-wise, back and forth between the array and
+ *                  a buffer, doubling their length each pass.
+ *  @param      : [ Array of items. ]
+ *                [ Buffer (of at least 'n' items). ]
+ *                [ No. of items. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+static void sort_merge_buffered(DATA_TYPE *arr, DATA_TYPE *buf, LENGTH_DT n,
+                                    unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    DATA_TYPE *src = arr;
+    DATA_TYPE *dst = buf;
+    DATA_TYPE *tmp;
+
+    for (LENGTH_DT lo = 0; lo < n; lo += SORT_INSERTION_THRESHOLD) {
+        sort_insertion(arr, lo, lo + SORT_INSERTION_THRESHOLD < n ? lo + SORT_INSERTION_THRESHOLD : n, f_compare);
+    }
+    for (LENGTH_DT width = SORT_INSERTION_THRESHOLD; width < n; width *= 2) {
+        for (LENGTH_DT lo = 0; lo < n; lo += 2 * width) {
+            LENGTH_DT mid = lo + width < n ? lo + width : n;
+            LENGTH_DT hi = lo + 2 * width < n ? lo + 2 * width : n;
+            sort_merge_runs(src, dst, lo, mid, hi, f_compare);
+        }
+        tmp = src, src = dst, dst = tmp;
+    }
+    if (src != arr) {
+        memcpy(arr, src, n * sizeof(DATA_TYPE));
+    }
+}
+
+/**
+ *  @brief      : Sort an array, with stable merge sort.
+ *                  (Note: For information on the algorithm, read '@brief' of 'sort_merge_buffered'.)
+ *  @param      : [ Array of items. ]
+ *                [ No. of items. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+void sort_merge(DATA_TYPE *arr, LENGTH_DT n, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    DATA_TYPE *buf = (DATA_TYPE *) malloc(n * sizeof(DATA_TYPE));
+    sort_merge_buffered(arr, buf, n, f_compare);
+    free(buf);
+}
+
+/**
+ *  @brief      : Sort an array by keys, with LSD radix sort. The key of each item is computed once. Then, the counts
+ *                  of all 8 digits (bytes) of the keys are computed in a single pass, and each digit (least significant
+ *                  first) is sorted by a stable counting sort, back and forth between the arrays and buffers.
+ *                  A digit that is the same for all keys is skipped.
+ *  @param      : [ Array of items. ]
+ *                [ No. of items. ]
+ *                [ Function that receives an item, and returns its key. ]
+ *  @return     : None.
+**/
+void sort_radix(DATA_TYPE *arr, LENGTH_DT n, uint64_t (*f_key)(DATA_TYPE data)) {
+    LENGTH_DT counts[SORT_RADIX_PASSES][SORT_RADIX_BUCKETS] = {{0}};
+    uint64_t *keys = (uint64_t *) malloc(2 * n * sizeof(uint64_t)), *keys_dst = keys + n, *keys_tmp;
+    DATA_TYPE *buf = (DATA_TYPE *) malloc(n * sizeof(DATA_TYPE));
+    DATA_TYPE *src = arr;
+    DATA_TYPE *dst = buf;
+    DATA_TYPE *tmp;
+
+    for (LENGTH_DT i = 0; i < n; i++) {
+        uint64_t key = keys[i] = f_key(arr[i]);
+        for (int pass = 0; pass < SORT_RADIX_PASSES; pass++) {
+            counts[pass][(key >> (pass * SORT_RADIX_BITS)) & (SORT_RADIX_BUCKETS - 1)]++;
+        }
+    }
+    for (int pass = 0; pass < SORT_RADIX_PASSES; pass++) {
+        LENGTH_DT *count = counts[pass], offset = 0;
+        int shift = pass * SORT_RADIX_BITS;
+        if (n == 0 || count[(keys[0] >> shift) & (SORT_RADIX_BUCKETS - 1)] == n) {
+            continue;
+        }
+        for (int b = 0; b < SORT_RADIX_BUCKETS; b++) {      /* counts into offsets */
+            LENGTH_DT c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (LENGTH_DT i = 0; i < n; i++) {
+            LENGTH_DT k = count[(keys[i] >> shift) & (SORT_RADIX_BUCKETS - 1)]++;
+            keys_dst[k] = keys[i];
+            dst[k] = src[i];
+        }
+        keys_tmp = keys, keys = keys_dst, keys_dst = keys_tmp;
+        tmp = src, src = dst, dst = tmp;
+    }
+    if (src != arr) {
+        memcpy(arr, src, n * sizeof(DATA_TYPE));
+    }
+    free(keys < keys_dst ? keys : keys_dst);
+    free(buf);
+}
+
+/**
+ *  @brief      : (For internal use) Thread routines of parallel merge sort, receiving a 'sort_task'. The first sorts
+ *                  a range (using the same range of 'dst' as a buffer), and the second merges two ranges.
+ *  @param      : [ Task. ]
+ *  @return     : NULL.
+**/
+static void * sort_task_sort(void *arg) {
+    sort_task *task = (sort_task *) arg;
+    sort_merge_buffered(task->src + task->lo, task->dst + task->lo, task->hi - task->lo, task->f_compare);
+    return NULL;
+}
+
+static void * sort_task_merge(void *arg) {
+    sort_task *task = (sort_task *) arg;
+    sort_merge_runs(task->src, task->dst, task->lo, task->mid, task->hi, task->f_compare);
+    return NULL;
+}
+
+/**
+ *  @brief      : Sort an array, with parallel merge sort. The array is split into 'T' chunks ('T' is the largest power
+ *                  of two, not more than the no. of threads, that keeps chunks of at least 'SORT_PARALLEL_THRESHOLD'
+ *                  items), each sorted in its own thread. Then, chunks are merged pair-wise, each pair in its own
+ *                  thread, back and forth between the array and a buffer, halving the no. of chunks each pass.
+ *  @param      : [ Array of items. ]
+ *                [ No. of items. ]
+ *                [ Max no. of threads. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+void sort_merge_parallel(DATA_TYPE *arr, LENGTH_DT n, int threads,
+                            unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data)) {
+    DATA_TYPE *buf = (DATA_TYPE *) malloc(n * sizeof(DATA_TYPE));
+    DATA_TYPE *src = arr;
+    DATA_TYPE *dst = buf;
+    DATA_TYPE *tmp;
+    LENGTH_DT chunks = 1;
+
+    while (chunks * 2 <= threads && n / (chunks * 2) >= SORT_PARALLEL_THRESHOLD) {
+        chunks *= 2;
+    }
+    pthread_t *tids = (pthread_t *) malloc(chunks * sizeof(pthread_t));
+    sort_task *tasks = (sort_task *) malloc(chunks * sizeof(sort_task));
+
+    for (LENGTH_DT c = 0; c < chunks; c++) {
+        tasks[c] = (sort_task) { arr, buf, n * c / chunks, 0, n * (c + 1) / chunks, f_compare };
+        pthread_create(tids + c, NULL, sort_task_sort, tasks + c);
+    }
+    for (LENGTH_DT c = 0; c < chunks; c++) {
+        pthread_join(tids[c], NULL);
+    }
+    for (LENGTH_DT width = 1; width < chunks; width *= 2) {
+        LENGTH_DT pairs = chunks / (2 * width);
+        for (LENGTH_DT c = 0; c < pairs; c++) {
+            LENGTH_DT first = 2 * width * c;
+            tasks[c] = (sort_task) { src, dst, n * first / chunks, n * (first + width) / chunks,
+                                        n * (first + 2 * width) / chunks, f_compare };
+            pthread_create(tids + c, NULL, sort_task_merge, tasks + c);
+        }
+        for (LENGTH_DT c = 0; c < pairs; c++) {
+            pthread_join(tids[c], NULL);
+        }
+        tmp = src, src = dst, dst = tmp;
+    }
+    if (src != arr) {
+        memcpy(arr, src, n * sizeof(DATA_TYPE));
+    }
+    free(tids);
+    free(tasks);
+    free(buf);
+}
+
+/* ********************* 'main' function defintion SECTION (UNIT-TEST) ********************** */
+
+#ifdef _MAIN_SORT_                      /* compile-time switch */
+
+#define LEN(ARR) (*(&ARR+1)-ARR)
+
+/**
+ *  @brief      : Record (sorted by key, to check that stable sorts keep the order of equal keys).
+**/
+typedef struct RECORD {
+    int key;
+    char tag;
+} record;
+
+unsigned char f_compare(void *new_data, void *old_data);
+uint64_t f_key(void *data);
+
+void print(void *arr[], int n);
+
+void t_intro();
+void t_merge();
+void t_radix();
+void t_merge_parallel();
+
+int main() {
+    t_intro();
+    t_merge();
+    t_radix();
+    t_merge_parallel();
+    return 0;
+}
+
+void t_intro() {
+    printf("*************** TEST (INTROSORT) ***************\n");
+    record arr_data[] = {{5, 'a'}, {3, 'b'}, {9, 'c'}, {1, 'd'}, {5, 'e'}, {7, 'f'}, {2, 'g'}, {8, 'h'}, {3, 'i'},
+                         {6, 'j'}, {4, 'k'}, {0, 'l'}, {9, 'm'}, {2, 'n'}, {7, 'o'}, {1, 'p'}, {8, 'q'}, {6, 'r'},
+                         {0, 's'}, {4, 't'}};
+    void *arr[LEN(arr_data)];
+    for (int i = 0; i < LEN(arr_data); i++) { arr[i] = arr_data+i; }
+    sort_intro(arr, LEN(arr), f_compare);
+    print(arr, LEN(arr));
+}
+
+void t_merge() {
+    printf("*************** TEST (MERGE SORT) ***************\n");
+    record arr_data[] = {{5, 'a'}, {3, 'b'}, {9, 'c'}, {1, 'd'}, {5, 'e'}, {7, 'f'}, {2, 'g'}, {8, 'h'}, {3, 'i'},
+                         {6, 'j'}, {4, 'k'}, {0, 'l'}, {9, 'm'}, {2, 'n'}, {7, 'o'}, {1, 'p'}, {8, 'q'}, {6, 'r'},
+                         {0, 's'}, {4, 't'}};
+    void *arr[LEN(arr_data)];
+    for (int i = 0; i < LEN(arr_data); i++) { arr[i] = arr_data+i; }
+    sort_merge(arr, LEN(arr), f_compare);
+    print(arr, LEN(arr));
+}
+
+void t_radix() {
+    printf("*************** TEST (RADIX SORT) ***************\n");
+    record arr_data[] = {{500, 'a'}, {3, 'b'}, {90000, 'c'}, {1, 'd'}, {500, 'e'}, {-7, 'f'}, {2, 'g'}, {-80, 'h'},
+                         {3, 'i'}, {6, 'j'}};
+    void *arr[LEN(arr_data)];
+    for (int i = 0; i < LEN(arr_data); i++) { arr[i] = arr_data+i; }
+    sort_radix(arr, LEN(arr), f_key);
+    print(arr, LEN(arr));
+}
+
+void t_merge_parallel() {
+    printf("*************** TEST (PARALLEL MERGE SORT) ***************\n");
+    int n = 4 * SORT_PARALLEL_THRESHOLD + 3, sorted = 1, stable = 1;
+    record *arr_data = (record *) malloc(n * sizeof(record));
+    void **arr = (void **) malloc(n * sizeof(void *));
+    for (int i = 0; i < n; i++) {
+        arr_data[i].key = (i * 7919) % 1000, arr_data[i].tag = 0;
+        arr[i] = arr_data+i;
+    }
+    sort_merge_parallel(arr, n, 4, f_compare);
+    for (int i = 1; i < n; i++) {
+        sorted &= !f_compare(arr[i], arr[i-1]);
+        stable &= ((record *) arr[i])->key != ((record *) arr[i-1])->key || arr[i] > arr[i-1];
+    }
+    printf("Items: %d, sorted: %d, stable: %d\n", n, sorted, stable);
+    free(arr_data);
+    free(arr);
+}
+
+void print(void *arr[], int n) {
+    for (int i = 0; i < n; i++) {
+        printf("%d%c, ", ((record *) arr[i])->key, ((record *) arr[i])->tag);
+    }
+    printf("\b\b \n");
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return ((record *) new_data)->key < ((record *) old_data)->key ? 1 : 0;
+}
+
+uint64_t f_key(void *data) {
+    return (uint64_t) (uint32_t) ((record *) data)->key ^ 0x80000000u;     /* flip sign bit, to order negatives first */
+}
+
+#endif
+
+/* ********************* 'main' function defintion SECTION (BENCHMARK) ********************** */
+
+#ifdef _BENCH_SORT_                     /* compile-time switch */
+
+#include <time.h>
+#include "avl_tree.h"
+
+unsigned char f_compare(void *new_data, void *old_data);
+int f_compare_qsort(const void *data1, const void *data2);
+uint64_t f_key(void *data);
+
+double elapsed_ms(struct timespec *start);
+void fill(void **arr, LENGTH_DT n);
+void check(const char *name, void **arr, LENGTH_DT n, double ms);
+
+/**
+ *  @brief      : Benchmark of the sorting algorithms against 'qsort', and against sorting through the AVL tree
+ *                  (inserting all items, then 'avl_make_list'), on random 64-bit integer keys.
+ *                  (Wall-clock time is measured, since parallel merge sort uses several threads.)
+ *                  (Usage: <no. of items (default: 10^6)> <no. of threads (default: 4)>)
+**/
+int main(int argc, char *argv[]) {
+    LENGTH_DT n = argc > 1 ? atol(argv[1]) : 1000000;
+    int threads = argc > 2 ? atoi(argv[2]) : 4;
+    void **arr = (void **) malloc(n * sizeof(void *));
+    struct timespec start;
+
+    fill(arr, n), clock_gettime(CLOCK_MONOTONIC, &start);
+    qsort(arr, n, sizeof(void *), f_compare_qsort);
+    check("qsort", arr, n, elapsed_ms(&start));
+
+    fill(arr, n), clock_gettime(CLOCK_MONOTONIC, &start);
+    sort_intro(arr, n, f_compare);
+    check("sort_intro", arr, n, elapsed_ms(&start));
+
+    fill(arr, n), clock_gettime(CLOCK_MONOTONIC, &start);
+    sort_merge(arr, n, f_compare);
+    check("sort_merge", arr, n, elapsed_ms(&start));
+
+    fill(arr, n), clock_gettime(CLOCK_MONOTONIC, &start);
+    sort_radix(arr, n, f_key);
+    check("sort_radix", arr, n, elapsed_ms(&start));
+
+    fill(arr, n), clock_gettime(CLOCK_MONOTONIC, &start);
+    sort_merge_parallel(arr, n, threads, f_compare);
+    check("sort_merge_parallel", arr, n, elapsed_ms(&start));
+
+    fill(arr, n), clock_gettime(CLOCK_MONOTONIC, &start);
+    avl_tree *tree = avl_create();
+    for (LENGTH_DT i = 0; i < n; i++) { avl_insert(tree, arr[i], f_compare); }
+    ll_list *list = avl_make_list(tree);
+    LENGTH_DT i = 0;
+    for (ll_node *node = list->head; node != NULL; node = node->next) { arr[i++] = node->data; }
+    check("avl_tree", arr, n, elapsed_ms(&start));
+    ll_destroy(list);
+    avl_destroy(tree);
+
+    free(arr);
+    return 0;
+}
+
+double elapsed_ms(struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) * 1e3 + (end.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+void fill(void **arr, LENGTH_DT n) {
+    uint64_t state = 88172645463325252ULL;
+    for (LENGTH_DT i = 0; i < n; i++) {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        arr[i] = (void *) (uintptr_t) state;
+    }
+}
+
+void check(const char *name, void **arr, LENGTH_DT n, double ms) {
+    LENGTH_DT i = 1;
+    while (i < n && !f_compare(arr[i], arr[i-1])) { i++; }
+    printf("%-20s %10.1f ms%s\n", name, ms, i < n ? " (NOT SORTED)" : "");
+}
+
+unsigned char f_compare(void *new_data, void *old_data) {
+    return (uintptr_t) new_data < (uintptr_t) old_data ? 1 : 0;
+}
+
+int f_compare_qsort(const void *data1, const void *data2) {
+    uintptr_t a = *((const uintptr_t *) data1), b = *((const uintptr_t *) data2);
+    return (a > b) - (a < b);
+}
+
+uint64_t f_key(void *data) {
+    return (uint64_t) (uintptr_t) data;
+}
+
+#endif
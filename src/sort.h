@@ -0,0 +1,77 @@
+/**
+ ****************************************************************
+ * @file            : sort.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations and macros of the implementation of sorting algorithms on arrays of the data-type
+ *                      (introsort, stable merge sort, radix sort, and parallel merge sort).
+ * **************************************************************
+ **/
+
+#ifndef _SORT_H_
+#define _SORT_H_
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "shared_defs.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Length of a range, at or below which it is sorted by insertion sort (in introsort and merge sort).
+**/
+#define SORT_INSERTION_THRESHOLD    16
+
+/**
+ *  @brief      : Length of a range, below which parallel merge sort stops spawning threads.
+**/
+#define SORT_PARALLEL_THRESHOLD     (1 << 14)
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Sort an array in-place, with introsort (quick sort, falling back to heap sort if it recurses too
+ *                  deeply, and to insertion sort for small ranges). Not stable. O(n log n) worst-case.
+ *  @param      : [ Array of items. ]
+ *                [ No. of items. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+void sort_intro(DATA_TYPE *arr, LENGTH_DT n, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Sort an array in-place, with (bottom-up) merge sort. Stable. Uses a buffer of 'n' items.
+ *  @param      : [ Array of items. ]
+ *                [ No. of items. ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+void sort_merge(DATA_TYPE *arr, LENGTH_DT n, unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+/**
+ *  @brief      : Sort an array in-place, by unsigned integer keys, with LSD radix sort (8 bits per pass). Stable.
+ *                  Uses a buffer of 'n' items and '2n' keys.
+ *  @param      : [ Array of items. ]
+ *                [ No. of items. ]
+ *                [ Function that receives an item, and returns its key (signed keys should be offset, e.g: by
+ *                  flipping the sign bit). ]
+ *  @return     : None.
+**/
+void sort_radix(DATA_TYPE *arr, LENGTH_DT n, uint64_t (*f_key)(DATA_TYPE data));
+
+/**
+ *  @brief      : Sort an array in-place, with merge sort, sorting halves in separate threads (up to a no. of threads).
+ *                  Stable. Uses a buffer of 'n' items.
+ *  @param      : [ Array of items. ]
+ *                [ No. of items. ]
+ *                [ Max no. of threads (1 or less sorts in the calling thread). ]
+ *                [ Function that receives two items, and returns 1 if the first goes before the second, else 0. ]
+ *  @return     : None.
+**/
+void sort_merge_parallel(DATA_TYPE *arr, LENGTH_DT n, int threads,
+                            unsigned char (*f_compare)(DATA_TYPE new_data, DATA_TYPE old_data));
+
+#endif
@@ -0,0 +1,566 @@
+/**
+ ****************************************************************
+ * @file            : thread_pool.c
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Implementation of a work-stealing (Chase-Lev) deque, and a fork/join thread pool, whose workers
+ *                      each own a deque and steal from each other's.
+ * **************************************************************
+ **/
+
+/* ********************* #include SECTION ********************** */
+
+#include "thread_pool.h"
+#include <sched.h>
+#include <unistd.h>
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : No. of rounds (each trying its own deque, then every other) a worker makes without finding a task,
+ *                  yielding after each, before it sleeps.
+**/
+#define TP_SPINS            64
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : (for internal use) Chunk of a parallel loop, split further while it has more than 'grain' indices.
+**/
+typedef struct TP_RANGE {
+    tp_pool *pool;
+    tp_group *group;
+    LENGTH_DT begin;
+    LENGTH_DT end;
+    LENGTH_DT grain;
+    void (*f_body)(LENGTH_DT begin, LENGTH_DT end, void *arg);
+    void *arg;
+} tp_range;
+
+/* ********************* static variable(s) SECTION ********************** */
+
+/**
+ *  @brief      : Worker of the calling thread (NULL if it is no worker).
+**/
+static _Thread_local tp_worker *tp_self = NULL;
+
+/* ********************* static function declaration(s) SECTION ********************** */
+
+static wsd_array * wsd_create_array(LENGTH_DT capacity, wsd_array *prev);
+static tp_worker * tp_worker_of(tp_pool *pool);
+static tp_task * tp_take(tp_worker *worker);
+static void tp_run(tp_task *task);
+static void * tp_work(void *arg);
+static void tp_range_run(void *arg);
+
+/* ********************* function definition(s) SECTION ********************** */
+
+/**
+ *  @brief      : (for internal use) Allocate the circular array of a deque.
+ *  @param      : [ Capacity (a power of two). ]
+ *                [ Previous array (or NULL). ]
+ *  @return     : Pointer to array.
+**/
+static wsd_array * wsd_create_array(LENGTH_DT capacity, wsd_array *prev) {
+    wsd_array *array = (wsd_array *) malloc(sizeof(wsd_array) + capacity * sizeof(_Atomic(DATA_TYPE)));
+    array->prev = prev;
+    array->capacity = capacity;
+    return array;
+}
+
+/**
+ *  @brief      : Allocating dynamic memory for a deque structure, initializing and returning a pointer to it.
+ *  @param      : None.
+ *  @return     : Pointer to deque.
+**/
+wsd_deque * wsd_create() {
+    wsd_deque *deque = (wsd_deque *) malloc(sizeof(wsd_deque));
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->array, wsd_create_array(WSD_INIT_CAPACITY, NULL));
+    return deque;
+}
+
+/**
+ *  @brief      : Push data at the bottom of a deque. If the array is full, its items are copied into one of double
+ *                  the capacity, which is then published (release), so that a thief that reads it also reads the items.
+ *                  The item itself is published by the release fence before 'bottom' is advanced.
+ *  @param      : [ Deque. ]
+ *                [ Data to push. ]
+ *  @return     : None.
+**/
+void wsd_push(wsd_deque *deque, DATA_TYPE data) {
+    LENGTH_DT b = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    LENGTH_DT t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    wsd_array *array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+    if (b - t > array->capacity - 1) {
+        wsd_array *grown = wsd_create_array(2 * array->capacity, array);
+        for (LENGTH_DT i = t; i < b; i++) {
+            atomic_store_explicit(&grown->items[i & (grown->capacity - 1)],
+                    atomic_load_explicit(&array->items[i & (array->capacity - 1)], memory_order_relaxed), memory_order_relaxed);
+        }
+        atomic_store_explicit(&deque->array, grown, memory_order_release);
+        array = grown;
+    }
+    atomic_store_explicit(&array->items[b & (array->capacity - 1)], data, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+}
+
+/**
+ *  @brief      : Pop data off the bottom of a deque. 'bottom' is decremented first, and then 'top' is read (with a
+ *                  full fence between), so that a thief either sees the item as taken, or the owner sees it stolen.
+ *                  Only for the last item may both race, and a CAS on 'top' decides.
+ *  @param      : [ Deque. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE wsd_pop(wsd_deque *deque) {
+    LENGTH_DT b = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    wsd_array *array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+    DATA_TYPE data = DEFAULT_VALUE;
+
+    atomic_store_explicit(&deque->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    LENGTH_DT t = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    if (t <= b) {
+        data = atomic_load_explicit(&array->items[b & (array->capacity - 1)], memory_order_relaxed);
+        if (t == b) {
+            if (!atomic_compare_exchange_strong_explicit(&deque->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+                data = DEFAULT_VALUE;
+            }
+            atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+        }
+    } else {
+        atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+    }
+    return data;
+}
+
+/**
+ *  @brief      : Steal data off the top of a deque. The item is read before the CAS on 'top' claims it, since the
+ *                  owner may overwrite its slot as soon as it is claimed.
+ *  @param      : [ Deque. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE wsd_steal(wsd_deque *deque) {
+    LENGTH_DT t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    LENGTH_DT b = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if (t >= b) {
+        return DEFAULT_VALUE;
+    }
+    wsd_array *array = atomic_load_explicit(&deque->array, memory_order_acquire);
+    DATA_TYPE data = atomic_load_explicit(&array->items[t & (array->capacity - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+        return DEFAULT_VALUE;
+    }
+    return data;
+}
+
+/**
+ *  @brief      : De-allocate the arrays of a deque (current and previous), then the deque itself.
+ *  @param      : [ Deque. ]
+ *  @return     : None.
+**/
+void wsd_destroy(wsd_deque *deque) {
+    wsd_array *array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+    while (array != NULL) {
+        wsd_array *prev = array->prev;
+        free(array);
+        array = prev;
+    }
+    free(deque);
+}
+
+/**
+ *  @brief      : Allocating dynamic memory for a pool structure (and a deque per worker), starting its workers (but
+ *                  the first, which is the calling thread), and returning a pointer to it.
+ *  @param      : [ No. of workers. ]
+ *  @return     : Pointer to pool.
+**/
+tp_pool * tp_create(LENGTH_DT n_workers) {
+    tp_pool *pool = (tp_pool *) malloc(sizeof(tp_pool));
+    if (n_workers < 1) {
+        n_workers = (LENGTH_DT) sysconf(_SC_NPROCESSORS_ONLN);
+        n_workers = n_workers < 1 ? 1 : n_workers;
+    }
+    pool->n_workers = n_workers;
+    pool->workers = (tp_worker *) malloc(n_workers * sizeof(tp_worker));
+    atomic_init(&pool->n_tasks, 0);
+    atomic_init(&pool->n_sleeping, 0);
+    atomic_init(&pool->stop, 0);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+
+    for (LENGTH_DT i = 0; i < n_workers; i++) {
+        pool->workers[i].deque = wsd_create();
+        pool->workers[i].pool = pool;
+        pool->workers[i].id = i;
+        pool->workers[i].seed = (uint64_t) (i + 1) * 0x9E3779B97F4A7C15ULL;
+    }
+    pool->workers[0].thread = pthread_self();
+    tp_self = pool->workers;
+    for (LENGTH_DT i = 1; i < n_workers; i++) {
+        pthread_create(&pool->workers[i].thread, NULL, tp_work, pool->workers + i);
+    }
+    return pool;
+}
+
+/**
+ *  @brief      : Initialize a group.
+ *  @param      : [ Group. ]
+ *  @return     : None.
+**/
+void tp_group_init(tp_group *group) {
+    atomic_init(&group->pending, 0);
+}
+
+/**
+ *  @brief      : (for internal use) Get the worker of the calling thread in a pool (worker 0, if it is none of them).
+ *  @param      : [ Pool. ]
+ *  @return     : Pointer to worker.
+**/
+static tp_worker * tp_worker_of(tp_pool *pool) {
+    return tp_self != NULL && tp_self->pool == pool ? tp_self : pool->workers;
+}
+
+/**
+ *  @brief      : (for internal use) Take a task, popped off a worker's own deque, else stolen off the others' (starting
+ *                  at a random one, and trying each once). If none, returns NULL.
+ *  @param      : [ Worker. ]
+ *  @return     : Pointer to task.
+**/
+static tp_task * tp_take(tp_worker *worker) {
+    tp_pool *pool = worker->pool;
+    tp_task *task = (tp_task *) wsd_pop(worker->deque);
+
+    if (task == NULL && pool->n_workers > 1) {
+        worker->seed ^= worker->seed << 13, worker->seed ^= worker->seed >> 7, worker->seed ^= worker->seed << 17;
+        LENGTH_DT start = (LENGTH_DT) (worker->seed % (uint64_t) (pool->n_workers - 1));
+        for (LENGTH_DT k = 0; task == NULL && k < pool->n_workers - 1; k++) {
+            LENGTH_DT victim = (worker->id + 1 + (start + k) % (pool->n_workers - 1)) % pool->n_workers;
+            task = (tp_task *) wsd_steal(pool->workers[victim].deque);
+        }
+    }
+    if (task != NULL) {
+        atomic_fetch_sub(&pool->n_tasks, 1);
+    }
+    return task;
+}
+
+/**
+ *  @brief      : (for internal use) Run a task, de-allocate it, and count it as finished in its group (release, so
+ *                  that whatever it wrote is seen by the thread that syncs on the group).
+ *  @param      : [ Task. ]
+ *  @return     : None.
+**/
+static void tp_run(tp_task *task) {
+    tp_group *group = task->group;
+    task->f_run(task->arg);
+    free(task);
+    atomic_fetch_sub_explicit(&group->pending, 1, memory_order_release);
+}
+
+/**
+ *  @brief      : (for internal use) Loop of a worker thread. A worker that finds no task for 'TP_SPINS' rounds
+ *                  announces that it sleeps, and only then checks for spawned tasks (under the lock), so that a spawner
+ *                  either sees it sleeping (and wakes it), or it sees the spawned task.
+ *  @param      : [ Worker. ]
+ *  @return     : NULL.
+**/
+static void * tp_work(void *arg) {
+    tp_worker *worker = (tp_worker *) arg;
+    tp_pool *pool = worker->pool;
+    int idle = 0;
+
+    tp_self = worker;
+    while (!atomic_load(&pool->stop)) {
+        tp_task *task = tp_take(worker);
+        if (task != NULL) {
+            tp_run(task);
+            idle = 0;
+        } else if (++idle < TP_SPINS) {
+            sched_yield();
+        } else {
+            atomic_fetch_add(&pool->n_sleeping, 1);
+            pthread_mutex_lock(&pool->lock);
+            while (atomic_load(&pool->n_tasks) <= 0 && !atomic_load(&pool->stop)) {
+                pthread_cond_wait(&pool->wake, &pool->lock);
+            }
+            pthread_mutex_unlock(&pool->lock);
+            atomic_fetch_sub(&pool->n_sleeping, 1);
+            idle = 0;
+        }
+    }
+    return NULL;
+}
+
+/**
+ *  @brief      : Spawn a task in a group, pushed on the deque of the calling worker. A sleeping worker is woken.
+ *  @param      : [ Pool. ]
+ *                [ Group. ]
+ *                [ Function to run. ]
+ *                [ Argument. ]
+ *  @return     : None.
+**/
+void tp_spawn(tp_pool *pool, tp_group *group, void (*f_run)(void *arg), void *arg) {
+    tp_task *task = (tp_task *) malloc(sizeof(tp_task));
+    task->f_run = f_run;
+    task->arg = arg;
+    task->group = group;
+
+    atomic_fetch_add_explicit(&group->pending, 1, memory_order_relaxed);
+    atomic_fetch_add(&pool->n_tasks, 1);
+    wsd_push(tp_worker_of(pool)->deque, task);
+    if (atomic_load(&pool->n_sleeping) > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_signal(&pool->wake);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+/**
+ *  @brief      : Wait for all tasks of a group to finish. Meanwhile, the calling worker runs tasks (its own first, so
+ *                  usually those of the group), rather than block, so that nested syncs never deadlock.
+ *  @param      : [ Pool. ]
+ *                [ Group. ]
+ *  @return     : None.
+**/
+void tp_sync(tp_pool *pool, tp_group *group) {
+    tp_worker *worker = tp_worker_of(pool);
+    while (atomic_load_explicit(&group->pending, memory_order_acquire) > 0) {
+        tp_task *task = tp_take(worker);
+        if (task != NULL) { tp_run(task); }
+        else { sched_yield(); }
+    }
+}
+
+/**
+ *  @brief      : (for internal use) Run a chunk of a parallel loop, spawning its right half until it is small enough.
+ *  @param      : [ Chunk. ]
+ *  @return     : None.
+**/
+static void tp_range_run(void *arg) {
+    tp_range *range = (tp_range *) arg;
+    while (range->end - range->begin > range->grain) {
+        tp_range *half = (tp_range *) malloc(sizeof(tp_range));
+        *half = *range;
+        half->begin = range->begin + (range->end - range->begin) / 2;
+        range->end = half->begin;
+        tp_spawn(range->pool, range->group, tp_range_run, half);
+    }
+    range->f_body(range->begin, range->end, range->arg);
+    free(range);
+}
+
+/**
+ *  @brief      : Run a function over a range of indices in parallel, and wait for it.
+ *  @param      : [ Pool. ]
+ *                [ First index. ]
+ *                [ Last index + 1. ]
+ *                [ Max. no. of indices per chunk. ]
+ *                [ Function that receives a chunk, and 'arg'. ]
+ *                [ Argument. ]
+ *  @return     : None.
+**/
+void tp_parallel_for(tp_pool *pool, LENGTH_DT begin, LENGTH_DT end, LENGTH_DT grain,
+                        void (*f_body)(LENGTH_DT begin, LENGTH_DT end, void *arg), void *arg) {
+    if (begin >= end) {
+        return;
+    }
+    tp_group group;
+    tp_range *range = (tp_range *) malloc(sizeof(tp_range));
+    tp_group_init(&group);
+    range->pool = pool;
+    range->group = &group;
+    range->begin = begin;
+    range->end = end;
+    range->grain = grain > 0 ? grain : (end - begin) / (8 * pool->n_workers);
+    range->grain = range->grain < 1 ? 1 : range->grain;
+    range->f_body = f_body;
+    range->arg = arg;
+
+    tp_range_run(range);
+    tp_sync(pool, &group);
+}
+
+/**
+ *  @brief      : Wake and join the workers of a pool, then de-allocate their deques, and the pool itself.
+ *  @param      : [ Pool. ]
+ *  @return     : None.
+**/
+void tp_destroy(tp_pool *pool) {
+    atomic_store(&pool->stop, 1);
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (LENGTH_DT i = 1; i < pool->n_workers; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    for (LENGTH_DT i = 0; i < pool->n_workers; i++) {
+        wsd_destroy(pool->workers[i].deque);
+    }
+    if (tp_self == pool->workers) {
+        tp_self = NULL;
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    free(pool->workers);
+    free(pool);
+}
+
+/* ********************* 'main' function defintion SECTION (TEST) ********************** */
+
+#ifdef _MAIN_THREAD_POOL_               /* compile-time switch */
+
+/**
+ *  @brief      : No. of thieves, and no. of items pushed, of the concurrent deque test. No. of workers of the pool tests.
+**/
+#define T_THIEVES       3
+#define T_ITEMS         200000
+#define T_WORKERS       4
+
+void t_deque();
+void t_deque_concurrent();
+void t_spawn_sync();
+void t_parallel_for();
+
+int main() {
+    t_deque();
+    t_deque_concurrent();
+    t_spawn_sync();
+    t_parallel_for();
+    return 0;
+}
+
+void t_deque() {
+    printf("*************** TEST (DEQUE) ***************\n");
+    wsd_deque *deque = wsd_create();
+    for (long i = 1; i <= 100; i++) {
+        wsd_push(deque, (void *) i);
+    }
+    long popped[2], stolen[2];
+    for (int i = 0; i < 2; i++) {
+        popped[i] = (long) wsd_pop(deque);
+        stolen[i] = (long) wsd_steal(deque);
+    }
+    printf("Popped: %ld, %ld, stolen: %ld, %ld\n", popped[0], popped[1], stolen[0], stolen[1]);
+    long count = 0;
+    while (wsd_pop(deque) != NULL) {
+        count++;
+    }
+    printf("Popped the remaining: %ld, pop (empty): %ld, steal (empty): %ld\n", count, (long) wsd_pop(deque),
+            (long) wsd_steal(deque));
+    wsd_destroy(deque);
+}
+
+/**
+ *  @brief      : Each thief steals until the owner is done, and counts each item it takes.
+**/
+void * t_thief(void *arg) {
+    wsd_deque *deque = ((void **) arg)[0];
+    _Atomic unsigned char *done = ((void **) arg)[1];
+    unsigned char *seen = ((void **) arg)[2];
+    long taken = 0;
+    while (!atomic_load(done)) {
+        long item = (long) wsd_steal(deque);
+        if (item != 0) {
+            seen[item - 1]++;
+            taken++;
+        }
+    }
+    return (void *) taken;
+}
+
+void t_deque_concurrent() {
+    printf("*************** TEST (DEQUE, CONCURRENT) ***************\n");
+    wsd_deque *deque = wsd_create();
+    unsigned char *seen = (unsigned char *) calloc(T_ITEMS, 1);
+    _Atomic unsigned char done = 0;
+    pthread_t threads[T_THIEVES];
+    void *args[3] = {deque, (void *) &done, seen};
+    long stolen = 0, popped = 0, errors = 0;
+
+    for (int t = 0; t < T_THIEVES; t++) {
+        pthread_create(threads + t, NULL, t_thief, args);
+    }
+    for (long i = 1; i <= T_ITEMS; i++) {                       /* the owner pops one item of every three it pushes */
+        wsd_push(deque, (void *) i);
+        if (i % 3 == 0) {
+            long item = (long) wsd_pop(deque);
+            if (item != 0) { seen[item - 1]++; popped++; }
+        }
+    }
+    for (long item; (item = (long) wsd_pop(deque)) != 0; popped++) {
+        seen[item - 1]++;
+    }
+    atomic_store(&done, 1);
+    for (int t = 0; t < T_THIEVES; t++) {
+        void *result;
+        pthread_join(threads[t], &result);
+        stolen += (long) result;
+    }
+    for (long i = 0; i < T_ITEMS; i++) {
+        errors += seen[i] != 1;
+    }
+    printf("Items: %d, popped + stolen: %ld, errors (taken not exactly once): %ld\n", T_ITEMS, popped + stolen, errors);
+    free(seen);
+    wsd_destroy(deque);
+}
+
+/**
+ *  @brief      : Fibonacci, spawning one of the two recursive calls.
+**/
+typedef struct FIB {
+    tp_pool *pool;
+    long n;
+    long result;
+} fib;
+
+void t_fib(void *arg) {
+    fib *f = (fib *) arg;
+    if (f->n < 2) {
+        f->result = f->n;
+        return;
+    }
+    fib a = {f->pool, f->n - 1, 0}, b = {f->pool, f->n - 2, 0};
+    tp_group group;
+    tp_group_init(&group);
+    tp_spawn(f->pool, &group, t_fib, &a);
+    t_fib(&b);
+    tp_sync(f->pool, &group);
+    f->result = a.result + b.result;
+}
+
+void t_spawn_sync() {
+    printf("*************** TEST (SPAWN/SYNC) ***************\n");
+    tp_pool *pool = tp_create(T_WORKERS);
+    fib f = {pool, 24, 0};
+    t_fib(&f);
+    printf("Workers: %d, fib(%ld): %ld\n", T_WORKERS, f.n, f.result);
+    tp_destroy(pool);
+}
+
+void t_square(LENGTH_DT begin, LENGTH_DT end, void *arg) {
+    for (LENGTH_DT i = begin; i < end; i++) {
+        ((long *) arg)[i] = (long) i * i;
+    }
+}
+
+void t_parallel_for() {
+    printf("*************** TEST (PARALLEL FOR) ***************\n");
+    tp_pool *pool = tp_create(T_WORKERS);
+    long *arr = (long *) calloc(T_ITEMS, sizeof(long));
+    long errors = 0;
+    tp_parallel_for(pool, 0, T_ITEMS, 0, t_square, arr);
+    tp_parallel_for(pool, 5, 5, 0, t_square, arr);
+    for (long i = 0; i < T_ITEMS; i++) {
+        errors += arr[i] != i * i;
+    }
+    printf("Workers: %d, indices: %d, errors: %ld\n", T_WORKERS, T_ITEMS, errors);
+    free(arr);
+    tp_destroy(pool);
+}
+
+#endif
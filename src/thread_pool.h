@@ -0,0 +1,201 @@
+/**
+ ****************************************************************
+ * @file            : thread_pool.h
+ * @author          : Eng. Hazem Mostafa Abdelaziz Anwer
+ * @brief           : Declarations, macros, and structs of the implementation of a work-stealing (Chase-Lev) deque,
+ *                      and a fork/join thread pool, whose workers each own a deque and steal from each other's.
+ *                      (Note: Requires C11 atomics, and POSIX threads.)
+ * **************************************************************
+ **/
+
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L                     /* for 'sched_yield' and 'sysconf' under strict C11 */
+#endif
+
+/* ********************* #include SECTION ********************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "shared_defs.h"
+
+/* ********************* #define SECTION ********************** */
+
+/**
+ *  @brief      : Size of a cache line, that the two ends of a deque are kept apart by (the owner writes one end, and
+ *                  thieves write the other).
+**/
+#define TP_CACHE_LINE       64
+
+/**
+ *  @brief      : Initial capacity of a deque (a power of two, doubled whenever full).
+**/
+#define WSD_INIT_CAPACITY   64
+
+/* ********************* struct(s) SECTION ********************** */
+
+/**
+ *  @brief      : Circular array of a deque. When a deque grows, its old array is kept (thieves may still be reading
+ *                  from it), until the deque is de-allocated.
+**/
+typedef struct WSD_ARRAY {
+    struct WSD_ARRAY *prev;                         /* previous (smaller) array */
+    LENGTH_DT capacity;                             /* a power of two */
+    _Atomic(DATA_TYPE) items[];
+} wsd_array;
+
+/**
+ *  @brief      : Deque structure. The owner pushes and pops at the bottom, and thieves steal from the top.
+ *                  Items are at indices 'top' to 'bottom - 1' (modulo the capacity of the array).
+**/
+typedef struct WSD_DEQUE {
+    _Atomic LENGTH_DT top;
+    char padding[TP_CACHE_LINE - sizeof(LENGTH_DT)];
+    _Atomic LENGTH_DT bottom;
+    wsd_array *_Atomic array;
+} wsd_deque;
+
+/**
+ *  @brief      : Group structure (a no. of spawned tasks, that are waited for at once by 'tp_sync').
+**/
+typedef struct TP_GROUP {
+    _Atomic LENGTH_DT pending;                      /* no. of tasks spawned, and not yet finished */
+} tp_group;
+
+/**
+ *  @brief      : Task structure (a function, its argument, and the group it was spawned in).
+**/
+typedef struct TP_TASK {
+    void (*f_run)(void *arg);
+    void *arg;
+    tp_group *group;
+} tp_task;
+
+/**
+ *  @brief      : Worker structure (a thread, and the deque it owns). Worker 0 is the thread that created the pool.
+**/
+typedef struct TP_WORKER {
+    wsd_deque *deque;
+    pthread_t thread;
+    struct TP_POOL *pool;
+    LENGTH_DT id;
+    uint64_t seed;                                  /* state of the random choice of victims */
+} tp_worker;
+
+/**
+ *  @brief      : Pool structure. Workers that find no tasks to run or steal sleep, until a task is spawned.
+**/
+typedef struct TP_POOL {
+    tp_worker *workers;
+    LENGTH_DT n_workers;
+    _Atomic LENGTH_DT n_tasks;                      /* no. of tasks spawned, and not yet taken by a worker */
+    _Atomic LENGTH_DT n_sleeping;
+    _Atomic unsigned char stop;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+} tp_pool;
+
+/* ********************* function declaration(S) SECTION ********************** */
+
+/**
+ *  @brief      : Create a work-stealing deque (dynamically, on heap).
+ *  @param      : None.
+ *  @return     : Pointer to deque.
+**/
+wsd_deque * wsd_create();
+
+/**
+ *  @brief      : Push data at the bottom of a deque (by its owner only).
+ *  @param      : [ Deque. ]
+ *                [ Data to push (not DEFAULT_VALUE). ]
+ *  @return     : None.
+**/
+void wsd_push(wsd_deque *deque, DATA_TYPE data);
+
+/**
+ *  @brief      : Pop data off the bottom of a deque (by its owner only). If empty, or the last item was stolen,
+ *                  returns DEFAULT_VALUE stored in 'shared_defs.h'.
+ *  @param      : [ Deque. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE wsd_pop(wsd_deque *deque);
+
+/**
+ *  @brief      : Steal data off the top of a deque (by any thread). If empty, or another thread took the item first,
+ *                  returns DEFAULT_VALUE stored in 'shared_defs.h'.
+ *  @param      : [ Deque. ]
+ *  @return     : Data stored.
+**/
+DATA_TYPE wsd_steal(wsd_deque *deque);
+
+/**
+ *  @brief      : Destroy deque (de-allocated off heap), when no thread uses it anymore.
+ *                  (Note: If pointers are the data-type, they're de-allocated, and not the data they point to.)
+ *  @param      : [ Deque. ]
+ *  @return     : None.
+**/
+void wsd_destroy(wsd_deque *deque);
+
+/**
+ *  @brief      : Create a thread pool (dynamically, on heap). The calling thread is worker 0, and runs tasks while it
+ *                  waits in 'tp_sync', so only 'n_workers - 1' threads are started.
+ *  @param      : [ No. of workers (0 means the no. of online processors). ]
+ *  @return     : Pointer to pool.
+**/
+tp_pool * tp_create(LENGTH_DT n_workers);
+
+/**
+ *  @brief      : Initialize a group (before any task is spawned in it).
+ *  @param      : [ Group. ]
+ *  @return     : None.
+**/
+void tp_group_init(tp_group *group);
+
+/**
+ *  @brief      : Spawn a task in a group, to be run by any worker. Tasks may only be spawned by the thread that created
+ *                  the pool, or by tasks running on it.
+ *  @param      : [ Pool. ]
+ *                [ Group. ]
+ *                [ Function to run, that receives 'arg'. ]
+ *                [ Argument. ]
+ *  @return     : None.
+**/
+void tp_spawn(tp_pool *pool, tp_group *group, void (*f_run)(void *arg), void *arg);
+
+/**
+ *  @brief      : Wait for all tasks of a group to finish, running (or stealing) other tasks meanwhile.
+ *  @param      : [ Pool. ]
+ *                [ Group. ]
+ *  @return     : None.
+**/
+void tp_sync(tp_pool *pool, tp_group *group);
+
+/**
+ *  @brief      : Run a function over a range of indices in parallel, and wait for it. The range is split in halves
+ *                  (spawning one half, and splitting the other further) down to chunks of at most 'grain' indices.
+ *  @param      : [ Pool. ]
+ *                [ First index. ]
+ *                [ Last index + 1. ]
+ *                [ Max. no. of indices per chunk (0 means about 8 chunks per worker). ]
+ *                [ Function that receives a chunk (its first index, and last index + 1), and 'arg'. ]
+ *                [ Argument. ]
+ *  @return     : None.
+**/
+void tp_parallel_for(tp_pool *pool, LENGTH_DT begin, LENGTH_DT end, LENGTH_DT grain,
+                        void (*f_body)(LENGTH_DT begin, LENGTH_DT end, void *arg), void *arg);
+
+/**
+ *  @brief      : Stop the workers of a pool (after they finish their current task), and destroy it. No tasks may be
+ *                  pending.
+ *  @param      : [ Pool. ]
+ *  @return     : None.
+**/
+void tp_destroy(tp_pool *pool);
+
+#endif